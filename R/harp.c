@@ -754,18 +754,20 @@ SEXP rharp_import_product(SEXP sname, SEXP soperations, SEXP soptions)
     SEXP product;
     const char **productfields;
     harp_product *hp;
-    const char *filename;
+    const char **filename;
     const char *operations = NULL;
     const char *options = NULL;
+    int num_files;
     int protected = 0;
+    int result;
     int i;
 
-    /* check filename */
-    if (TYPEOF(sname) != STRSXP || LENGTH(sname) != 1)
+    /* check filename (a single filename or a vector of filenames) */
+    if (TYPEOF(sname) != STRSXP || LENGTH(sname) < 1)
     {
         error("filename argument not a string");
     }
-    filename = CHAR(STRING_ELT(sname, 0));
+    num_files = LENGTH(sname);
 
     /* check operations */
     if (soperations != R_NilValue)
@@ -788,7 +790,26 @@ SEXP rharp_import_product(SEXP sname, SEXP soperations, SEXP soptions)
     }
 
     /* harp import */
-    if (harp_import(filename, operations, options, &hp) != 0)
+    filename = (const char **)malloc(num_files * sizeof(const char *));
+    if (filename == NULL)
+    {
+        error("out of memory");
+    }
+    for (i = 0; i < num_files; i++)
+    {
+        filename[i] = CHAR(STRING_ELT(sname, i));
+    }
+    if (num_files == 1)
+    {
+        result = harp_import(filename[0], operations, options, &hp);
+    }
+    else
+    {
+        /* import and merge all files, parsing the operations and options only once */
+        result = harp_import_multiple(num_files, filename, operations, options, NULL, &hp);
+    }
+    free(filename);
+    if (result != 0)
     {
         rharp_error();
     }
@@ -0,0 +1,1888 @@
+/*
+ * Copyright (C) 2015-2020 S[&]T, The Netherlands.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Benchmark suite that runs timed scenarios on synthetic products.
+ *
+ * The generated products have a swath-like geolocation (scanlines of ground pixels with latitude/longitude bounds),
+ * vertical profiles, spectra, and string data, so no (non-redistributable) mission data is needed. Results are written
+ * as JSON such that they can be compared between releases.
+ */
+
+#include "config.h"
+
+#include "harp.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef HAVE_GETTIMEOFDAY
+#include <sys/time.h>
+#endif
+
+/* matchup entry point of harpcollocate (tools/harpcollocate/harpcollocate-matchup.c) */
+int matchup(int argc, char *argv[]);
+
+#define NUM_ACROSS_TRACK_PIXELS 60
+#define NUM_APPEND_GRANULES 10
+#define MAX_SMOOTH_SAMPLES 1000
+#define NUM_STATIONS 100
+#define NUM_STATION_SAMPLES 2000
+#define NUM_BIN_CHECK_SAMPLES 20000
+#define NUM_BIN_CHECK_KEYS 1000
+#define MAX_FILENAME_LENGTH 4096
+
+/* inputs that are generated before the selected scenarios are run (only the ones that these scenarios need) */
+#define INPUT_PRODUCT 0x01      /* main product (and its netCDF file) */
+#define INPUT_GRANULES 0x02
+#define INPUT_COLLOCATED 0x04
+#define INPUT_STATIONS 0x08     /* station product and its netCDF file */
+#define INPUT_BIN 0x10
+#define INPUT_BIN_CHECK 0x20
+
+typedef struct benchmark_struct
+{
+    long num_time;
+    long num_vertical;
+    long num_spectral;
+    long num_bin_samples;
+    long num_bins;
+    int num_repeats;
+    const char *work_dir;
+    int num_selections;
+    const char **selection;     /* name prefixes of the scenarios that should be run (all if num_selections is 0) */
+
+    harp_product *product;
+    harp_product *collocated_product;
+    harp_product *station_product;
+    harp_product *granule[NUM_APPEND_GRANULES];
+    harp_product *bin_product;
+    harp_product *bin_check_product;
+
+    char netcdf_filename[MAX_FILENAME_LENGTH];
+    char hdf5_filename[MAX_FILENAME_LENGTH];
+    char station_filename[MAX_FILENAME_LENGTH];
+    char matchup_filename[MAX_FILENAME_LENGTH];
+    char bin_collocation_filename[MAX_FILENAME_LENGTH];
+    char bin_check_collocation_filename[MAX_FILENAME_LENGTH];
+    char unsupported_filename[MAX_FILENAME_LENGTH];
+    int has_netcdf_file;
+    int has_hdf5_file;
+} benchmark;
+
+typedef struct scenario_struct scenario;
+
+/* run a scenario once; the function should only time the part that is benchmarked (not the setup) */
+typedef int (*scenario_function) (benchmark *b, const scenario *s, double *duration);
+
+struct scenario_struct
+{
+    const char *name;
+    scenario_function run;
+    const char *operations;
+    int inputs;
+};
+
+static double get_time(void)
+{
+#ifdef HAVE_GETTIMEOFDAY
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + tv.tv_usec * 1.0e-6;
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/* deterministic pseudo random numbers in [0, 1) (so each run benchmarks the same data) */
+static double next_random(unsigned long *state)
+{
+    *state = (*state * 1103515245UL + 12345UL) & 0x7fffffffUL;
+    return (double)*state / 2147483648.0;
+}
+
+static void print_version()
+{
+    printf("harp_benchmarks version %s\n", libharp_version);
+    printf("Copyright (C) 2015-2020 S[&]T, The Netherlands.\n");
+}
+
+static void print_help()
+{
+    printf("Usage:\n");
+    printf("    harp_benchmarks [options]\n");
+    printf("        Run timed scenarios on synthetic products and write the results\n");
+    printf("        as JSON.\n");
+    printf("\n");
+    printf("        Options:\n");
+    printf("            -t, --time <length>\n");
+    printf("                Length of the time dimension (number of ground pixels) of\n");
+    printf("                the generated product. Default is 10000.\n");
+    printf("\n");
+    printf("            -z, --vertical <length>\n");
+    printf("                Length of the vertical dimension. Default is 40.\n");
+    printf("\n");
+    printf("            -s, --spectral <length>\n");
+    printf("                Length of the spectral dimension. Default is 100.\n");
+    printf("\n");
+    printf("            -n, --bin-samples <length>\n");
+    printf("                Length of the time dimension of the product that is used\n");
+    printf("                for the bin_large_* scenarios. The collocation result file\n");
+    printf("                for these scenarios gets one line per sample. Default is\n");
+    printf("                10000000.\n");
+    printf("\n");
+    printf("            -k, --bins <n>\n");
+    printf("                Number of bins for the bin_large_* scenarios. Default is\n");
+    printf("                100000.\n");
+    printf("\n");
+    printf("            -S, --scenario <prefix>\n");
+    printf("                Only run the scenarios whose name starts with <prefix>\n");
+    printf("                (e.g. 'bin_large' or 'startup'). This option can be\n");
+    printf("                provided multiple times. Only the products that the\n");
+    printf("                selected scenarios need are generated. By default all\n");
+    printf("                scenarios are run.\n");
+    printf("\n");
+    printf("            -r, --repeat <n>\n");
+    printf("                Number of times each scenario is run. Default is 5.\n");
+    printf("\n");
+    printf("            -d, --work-dir <directory>\n");
+    printf("                Directory in which temporary product files are created.\n");
+    printf("                Default is the current directory.\n");
+    printf("\n");
+    printf("            -o, --output <file>\n");
+    printf("                Write the JSON results to the given file instead of stdout.\n");
+    printf("\n");
+    printf("        Progress is reported on stderr.\n");
+    printf("\n");
+    printf("    harp_benchmarks -h, --help\n");
+    printf("        Show help (this text).\n");
+    printf("\n");
+    printf("    harp_benchmarks -v, --version\n");
+    printf("        Print the version number of HARP and exit.\n");
+    printf("\n");
+}
+
+static int add_variable(harp_product *product, const char *name, harp_data_type data_type, int num_dimensions,
+                        const harp_dimension_type *dimension_type, const long *dimension, const char *unit,
+                        harp_variable **new_variable)
+{
+    harp_variable *variable;
+
+    if (harp_variable_new(name, data_type, num_dimensions, dimension_type, dimension, &variable) != 0)
+    {
+        return -1;
+    }
+    if (unit != NULL)
+    {
+        if (harp_variable_set_unit(variable, unit) != 0)
+        {
+            harp_variable_delete(variable);
+            return -1;
+        }
+    }
+    if (harp_product_add_variable(product, variable) != 0)
+    {
+        harp_variable_delete(variable);
+        return -1;
+    }
+
+    *new_variable = variable;
+
+    return 0;
+}
+
+static double get_altitude(long num_vertical, long k)
+{
+    return 0.5 + k * 60.0 / num_vertical;
+}
+
+/* Add the geolocation of a swath: each scanline has NUM_ACROSS_TRACK_PIXELS ground pixels and the scanlines follow
+ * an orbit from south to north (wrapping around at 80N).
+ */
+static int add_swath_geolocation(harp_product *product, long num_time, long time_offset, unsigned long *seed)
+{
+    harp_dimension_type dimension_type[2] = { harp_dimension_time, harp_dimension_independent };
+    long dimension[2] = { num_time, 4 };
+    harp_variable *datetime;
+    harp_variable *latitude;
+    harp_variable *longitude;
+    harp_variable *latitude_bounds;
+    harp_variable *longitude_bounds;
+    harp_variable *scanline_index;
+    harp_variable *collocation_index;
+    harp_variable *cloud_fraction;
+    harp_variable *location_name;
+    long i;
+
+    if (add_variable(product, "datetime", harp_type_double, 1, dimension_type, dimension, "s since 2000-01-01",
+                     &datetime) != 0)
+    {
+        return -1;
+    }
+    if (add_variable(product, "latitude", harp_type_double, 1, dimension_type, dimension, "degree_north",
+                     &latitude) != 0)
+    {
+        return -1;
+    }
+    if (add_variable(product, "longitude", harp_type_double, 1, dimension_type, dimension, "degree_east",
+                     &longitude) != 0)
+    {
+        return -1;
+    }
+    if (add_variable(product, "latitude_bounds", harp_type_double, 2, dimension_type, dimension, "degree_north",
+                     &latitude_bounds) != 0)
+    {
+        return -1;
+    }
+    if (add_variable(product, "longitude_bounds", harp_type_double, 2, dimension_type, dimension, "degree_east",
+                     &longitude_bounds) != 0)
+    {
+        return -1;
+    }
+    if (add_variable(product, "scanline_index", harp_type_int32, 1, dimension_type, dimension, NULL,
+                     &scanline_index) != 0)
+    {
+        return -1;
+    }
+    if (add_variable(product, "collocation_index", harp_type_int32, 1, dimension_type, dimension, NULL,
+                     &collocation_index) != 0)
+    {
+        return -1;
+    }
+    if (add_variable(product, "cloud_fraction", harp_type_float, 1, dimension_type, dimension, "", &cloud_fraction)
+        != 0)
+    {
+        return -1;
+    }
+    if (add_variable(product, "location_name", harp_type_string, 1, dimension_type, dimension, NULL, &location_name)
+        != 0)
+    {
+        return -1;
+    }
+
+    for (i = 0; i < num_time; i++)
+    {
+        long scanline = (time_offset + i) / NUM_ACROSS_TRACK_PIXELS;
+        long pixel = (time_offset + i) % NUM_ACROSS_TRACK_PIXELS;
+        double half_size = 0.15;
+        double lat;
+        double lon;
+        char name[16];
+
+        lat = -80.0 + fmod(scanline * 0.5, 160.0);
+        lon = fmod(scanline * 0.05 + (pixel - NUM_ACROSS_TRACK_PIXELS / 2) * 2 * half_size + 540.0, 360.0) - 180.0;
+
+        datetime->data.double_data[i] = 6.5e8 + scanline;
+        latitude->data.double_data[i] = lat;
+        longitude->data.double_data[i] = lon;
+        latitude_bounds->data.double_data[i * 4] = lat - half_size;
+        latitude_bounds->data.double_data[i * 4 + 1] = lat - half_size;
+        latitude_bounds->data.double_data[i * 4 + 2] = lat + half_size;
+        latitude_bounds->data.double_data[i * 4 + 3] = lat + half_size;
+        longitude_bounds->data.double_data[i * 4] = lon - half_size;
+        longitude_bounds->data.double_data[i * 4 + 1] = lon + half_size;
+        longitude_bounds->data.double_data[i * 4 + 2] = lon + half_size;
+        longitude_bounds->data.double_data[i * 4 + 3] = lon - half_size;
+        scanline_index->data.int32_data[i] = (int32_t)scanline;
+        collocation_index->data.int32_data[i] = (int32_t)(time_offset + i);
+        cloud_fraction->data.float_data[i] = (float)next_random(seed);
+
+        sprintf(name, "site_%03ld", (time_offset + i) % 100);
+        if (harp_variable_set_string_data_element(location_name, i, name) != 0)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int add_profiles(harp_product *product, long num_time, long num_vertical, unsigned long *seed)
+{
+    harp_dimension_type dimension_type[2] = { harp_dimension_time, harp_dimension_vertical };
+    long dimension[2] = { num_time, num_vertical };
+    harp_variable *altitude;
+    harp_variable *pressure;
+    harp_variable *temperature;
+    harp_variable *vmr;
+    long i;
+    long k;
+
+    if (add_variable(product, "altitude", harp_type_double, 2, dimension_type, dimension, "km", &altitude) != 0)
+    {
+        return -1;
+    }
+    if (add_variable(product, "pressure", harp_type_double, 2, dimension_type, dimension, "hPa", &pressure) != 0)
+    {
+        return -1;
+    }
+    if (add_variable(product, "temperature", harp_type_double, 2, dimension_type, dimension, "K", &temperature) != 0)
+    {
+        return -1;
+    }
+    if (add_variable(product, "O3_volume_mixing_ratio", harp_type_double, 2, dimension_type, dimension, "ppv", &vmr)
+        != 0)
+    {
+        return -1;
+    }
+
+    for (i = 0; i < num_time; i++)
+    {
+        for (k = 0; k < num_vertical; k++)
+        {
+            long index = i * num_vertical + k;
+            double alt = get_altitude(num_vertical, k);
+            double x = (alt - 25.0) / 8.0;
+
+            altitude->data.double_data[index] = alt;
+            pressure->data.double_data[index] = 1013.25 * exp(-alt / 7.0);
+            temperature->data.double_data[index] = 288.15 - 6.5 * (alt < 11.0 ? alt : 11.0) + 0.1 * next_random(seed);
+            vmr->data.double_data[index] = 8.0e-6 * exp(-x * x) * (0.9 + 0.2 * next_random(seed)) + 1.0e-8;
+        }
+    }
+
+    return 0;
+}
+
+static int add_spectra(harp_product *product, long num_time, long num_spectral, unsigned long *seed)
+{
+    harp_dimension_type dimension_type[2] = { harp_dimension_time, harp_dimension_spectral };
+    long dimension[2] = { num_time, num_spectral };
+    harp_variable *wavelength;
+    harp_variable *radiance;
+    long i;
+    long j;
+
+    if (add_variable(product, "wavelength", harp_type_double, 1, &dimension_type[1], &dimension[1], "nm",
+                     &wavelength) != 0)
+    {
+        return -1;
+    }
+    if (add_variable(product, "radiance", harp_type_float, 2, dimension_type, dimension, "W/m2/sr/nm", &radiance) != 0)
+    {
+        return -1;
+    }
+
+    for (j = 0; j < num_spectral; j++)
+    {
+        wavelength->data.double_data[j] = 300.0 + j * 200.0 / num_spectral;
+    }
+    for (i = 0; i < num_time; i++)
+    {
+        for (j = 0; j < num_spectral; j++)
+        {
+            radiance->data.float_data[i * num_spectral + j] = (float)(0.1 + 0.01 * next_random(seed));
+        }
+    }
+
+    return 0;
+}
+
+/* Generate a synthetic satellite product. The time_offset is the index of the first ground pixel, which allows
+ * generating consecutive granules of the same orbit.
+ */
+static int generate_product(const char *source_product, long num_time, long time_offset, long num_vertical,
+                            long num_spectral, harp_product **new_product)
+{
+    harp_product *product;
+    unsigned long seed = (unsigned long)(time_offset + 1);
+
+    if (harp_product_new(&product) != 0)
+    {
+        return -1;
+    }
+    if (harp_product_set_source_product(product, source_product) != 0)
+    {
+        harp_product_delete(product);
+        return -1;
+    }
+    if (add_swath_geolocation(product, num_time, time_offset, &seed) != 0)
+    {
+        harp_product_delete(product);
+        return -1;
+    }
+    if (num_vertical > 0)
+    {
+        if (add_profiles(product, num_time, num_vertical, &seed) != 0)
+        {
+            harp_product_delete(product);
+            return -1;
+        }
+    }
+    if (num_spectral > 0)
+    {
+        if (add_spectra(product, num_time, num_spectral, &seed) != 0)
+        {
+            harp_product_delete(product);
+            return -1;
+        }
+    }
+
+    *new_product = product;
+
+    return 0;
+}
+
+/* Generate a product with averaging kernels, a-priori profiles, and vertical grids for the first num_time samples of
+ * the satellite product (matched via collocation_index), to be used for smoothing.
+ */
+static int generate_collocated_product(long num_time, long num_vertical, harp_product **new_product)
+{
+    harp_dimension_type dimension_type[3] = { harp_dimension_time, harp_dimension_vertical, harp_dimension_vertical };
+    long dimension[3] = { num_time, num_vertical, num_vertical };
+    harp_product *product;
+    harp_variable *collocation_index;
+    harp_variable *altitude;
+    harp_variable *avk;
+    harp_variable *apriori;
+    long i;
+    long j;
+    long k;
+
+    if (harp_product_new(&product) != 0)
+    {
+        return -1;
+    }
+    if (add_variable(product, "collocation_index", harp_type_int32, 1, dimension_type, dimension, NULL,
+                     &collocation_index) != 0 ||
+        add_variable(product, "altitude", harp_type_double, 2, dimension_type, dimension, "km", &altitude) != 0 ||
+        add_variable(product, "O3_volume_mixing_ratio_avk", harp_type_double, 3, dimension_type, dimension, NULL,
+                     &avk) != 0 ||
+        add_variable(product, "O3_volume_mixing_ratio_apriori", harp_type_double, 2, dimension_type, dimension, "ppv",
+                     &apriori) != 0)
+    {
+        harp_product_delete(product);
+        return -1;
+    }
+
+    for (i = 0; i < num_time; i++)
+    {
+        collocation_index->data.int32_data[i] = (int32_t)i;
+        for (j = 0; j < num_vertical; j++)
+        {
+            double x = (get_altitude(num_vertical, j) - 25.0) / 8.0;
+
+            /* use a coarser (shifted) grid than the satellite product so the product needs to be regridded */
+            altitude->data.double_data[i * num_vertical + j] = get_altitude(num_vertical, j) + 0.25;
+            apriori->data.double_data[i * num_vertical + j] = 7.0e-6 * exp(-x * x) + 1.0e-8;
+            for (k = 0; k < num_vertical; k++)
+            {
+                double d = (double)(j - k);
+
+                avk->data.double_data[(i * num_vertical + j) * num_vertical + k] = 0.5 * exp(-d * d / 4.0);
+            }
+        }
+    }
+
+    *new_product = product;
+
+    return 0;
+}
+
+/* Generate a dataset of ground station measurements (hourly samples of NUM_STATIONS stations) for the matchup. */
+static int generate_station_product(harp_product **new_product)
+{
+    harp_dimension_type dimension_type[1] = { harp_dimension_time };
+    long dimension[1] = { NUM_STATION_SAMPLES };
+    harp_product *product;
+    harp_variable *datetime;
+    harp_variable *latitude;
+    harp_variable *longitude;
+    long i;
+
+    if (harp_product_new(&product) != 0)
+    {
+        return -1;
+    }
+    if (harp_product_set_source_product(product, "harp_benchmarks_stations") != 0 ||
+        add_variable(product, "datetime", harp_type_double, 1, dimension_type, dimension, "s since 2000-01-01",
+                     &datetime) != 0 ||
+        add_variable(product, "latitude", harp_type_double, 1, dimension_type, dimension, "degree_north",
+                     &latitude) != 0 ||
+        add_variable(product, "longitude", harp_type_double, 1, dimension_type, dimension, "degree_east",
+                     &longitude) != 0)
+    {
+        harp_product_delete(product);
+        return -1;
+    }
+
+    for (i = 0; i < NUM_STATION_SAMPLES; i++)
+    {
+        long station = i % NUM_STATIONS;
+
+        datetime->data.double_data[i] = 6.5e8 + (i / NUM_STATIONS - NUM_STATION_SAMPLES / NUM_STATIONS / 2) * 3600.0;
+        latitude->data.double_data[i] = -80.0 + 160.0 * station / NUM_STATIONS;
+        longitude->data.double_data[i] = -180.0 + 360.0 * ((station * 37) % NUM_STATIONS) / NUM_STATIONS;
+    }
+
+    *new_product = product;
+
+    return 0;
+}
+
+/* Write a collocation result that matches sample i of the product with collocation_index i in dataset a with sample
+ * sample_b[i] of product product_name_b[product_b[i]] in dataset b.
+ */
+static int write_bin_collocation_result(const char *filename, const char *source_product_a, long num_time,
+                                        const char **product_name_b, const int32_t *product_b,
+                                        const int32_t *sample_b)
+{
+    harp_collocation_result *collocation_result;
+    long i;
+
+    if (harp_collocation_result_new(&collocation_result, 0, NULL, NULL) != 0)
+    {
+        return -1;
+    }
+    for (i = 0; i < num_time; i++)
+    {
+        if (harp_collocation_result_add_pair(collocation_result, i, source_product_a, i,
+                                             product_name_b[product_b == NULL ? 0 : product_b[i]], sample_b[i], 0,
+                                             NULL) != 0)
+        {
+            harp_collocation_result_delete(collocation_result);
+            return -1;
+        }
+    }
+    if (harp_collocation_result_write(filename, collocation_result) != 0)
+    {
+        harp_collocation_result_delete(collocation_result);
+        return -1;
+    }
+    harp_collocation_result_delete(collocation_result);
+
+    return 0;
+}
+
+/* Generate the product for the bin_large_* scenarios. Each sample is assigned to one of num_bins bins (in random
+ * order) via bin_key, and the collocation result that is written to filename matches each sample with the sample of
+ * dataset b that has bin_key as index. Both bin(bin_key) and bin(filename, b) will therefore result in num_bins bins.
+ */
+static int generate_bin_product(long num_time, long num_bins, const char *filename, harp_product **new_product)
+{
+    harp_dimension_type dimension_type[1] = { harp_dimension_time };
+    long dimension[1] = { num_time };
+    const char *product_name_b = "harp_benchmarks_bin_b";
+    unsigned long seed = 3;
+    harp_product *product;
+    harp_variable *collocation_index;
+    harp_variable *bin_key;
+    harp_variable *value;
+    long i;
+
+    if (harp_product_new(&product) != 0)
+    {
+        return -1;
+    }
+    if (harp_product_set_source_product(product, "harp_benchmarks_bin") != 0 ||
+        add_variable(product, "collocation_index", harp_type_int32, 1, dimension_type, dimension, NULL,
+                     &collocation_index) != 0 ||
+        add_variable(product, "bin_key", harp_type_int32, 1, dimension_type, dimension, NULL, &bin_key) != 0 ||
+        add_variable(product, "value", harp_type_double, 1, dimension_type, dimension, "K", &value) != 0)
+    {
+        harp_product_delete(product);
+        return -1;
+    }
+
+    for (i = 0; i < num_time; i++)
+    {
+        collocation_index->data.int32_data[i] = (int32_t)i;
+        bin_key->data.int32_data[i] = (int32_t)(next_random(&seed) * num_bins);
+        value->data.double_data[i] = 200.0 + 100.0 * next_random(&seed);
+    }
+
+    if (write_bin_collocation_result(filename, product->source_product, num_time, &product_name_b, NULL,
+                                     bin_key->data.int32_data) != 0)
+    {
+        harp_product_delete(product);
+        return -1;
+    }
+
+    *new_product = product;
+
+    return 0;
+}
+
+/* Generate the product for the bin_check_* scenarios. The keys contain (signed) NaN values, both -0.0 and 0.0, NULL
+ * strings, and empty strings, and the collocation result that is written to filename matches the samples with
+ * samples of two different products in dataset b (given by check_product_b and check_sample_b).
+ */
+static int generate_bin_check_product(const char *filename, harp_product **new_product)
+{
+    harp_dimension_type dimension_type[1] = { harp_dimension_time };
+    long dimension[1] = { NUM_BIN_CHECK_SAMPLES };
+    const char *product_name_b[2] = { "harp_benchmarks_bin_check_b0", "harp_benchmarks_bin_check_b1" };
+    unsigned long seed = 5;
+    harp_product *product;
+    harp_variable *collocation_index;
+    harp_variable *check_double;
+    harp_variable *check_string;
+    harp_variable *product_b;
+    harp_variable *sample_b;
+    harp_variable *value;
+    long i;
+
+    if (harp_product_new(&product) != 0)
+    {
+        return -1;
+    }
+    if (harp_product_set_source_product(product, "harp_benchmarks_bin_check") != 0 ||
+        add_variable(product, "collocation_index", harp_type_int32, 1, dimension_type, dimension, NULL,
+                     &collocation_index) != 0 ||
+        add_variable(product, "check_double", harp_type_double, 1, dimension_type, dimension, NULL,
+                     &check_double) != 0 ||
+        add_variable(product, "check_string", harp_type_string, 1, dimension_type, dimension, NULL,
+                     &check_string) != 0 ||
+        add_variable(product, "check_product_b", harp_type_int32, 1, dimension_type, dimension, NULL,
+                     &product_b) != 0 ||
+        add_variable(product, "check_sample_b", harp_type_int32, 1, dimension_type, dimension, NULL,
+                     &sample_b) != 0 ||
+        add_variable(product, "value", harp_type_double, 1, dimension_type, dimension, "K", &value) != 0)
+    {
+        harp_product_delete(product);
+        return -1;
+    }
+
+    for (i = 0; i < NUM_BIN_CHECK_SAMPLES; i++)
+    {
+        long key = (long)(next_random(&seed) * NUM_BIN_CHECK_KEYS);
+        char name[32];
+
+        collocation_index->data.int32_data[i] = (int32_t)i;
+        switch (key % 20)
+        {
+            case 0:
+                check_double->data.double_data[i] = harp_nan();
+                break;
+            case 1:
+                check_double->data.double_data[i] = -harp_nan();
+                break;
+            case 2:
+                check_double->data.double_data[i] = -0.0;
+                break;
+            case 3:
+                check_double->data.double_data[i] = 0.0;
+                break;
+            default:
+                check_double->data.double_data[i] = key / 4.0;
+                break;
+        }
+
+        /* string elements of a new variable are NULL */
+        key = (long)(next_random(&seed) * 20);
+        if (key != 0)
+        {
+            if (key == 1)
+            {
+                name[0] = '\0';
+            }
+            else
+            {
+                sprintf(name, "key_%02ld", key);
+            }
+            if (harp_variable_set_string_data_element(check_string, i, name) != 0)
+            {
+                harp_product_delete(product);
+                return -1;
+            }
+        }
+
+        product_b->data.int32_data[i] = (int32_t)(next_random(&seed) * 2);
+        sample_b->data.int32_data[i] = (int32_t)(next_random(&seed) * NUM_BIN_CHECK_KEYS / 2);
+        value->data.double_data[i] = (double)i;
+    }
+
+    if (write_bin_collocation_result(filename, product->source_product, NUM_BIN_CHECK_SAMPLES, product_name_b,
+                                     product_b->data.int32_data, sample_b->data.int32_data) != 0)
+    {
+        harp_product_delete(product);
+        return -1;
+    }
+
+    *new_product = product;
+
+    return 0;
+}
+
+/* generate the given inputs (a combination of INPUT_* flags) */
+static int benchmark_init(benchmark *b, int inputs)
+{
+    long granule_length;
+    long num_smooth_samples;
+    int i;
+
+    sprintf(b->netcdf_filename, "%s/harp_benchmarks.nc", b->work_dir);
+    sprintf(b->hdf5_filename, "%s/harp_benchmarks.h5", b->work_dir);
+    sprintf(b->station_filename, "%s/harp_benchmarks_stations.nc", b->work_dir);
+    sprintf(b->matchup_filename, "%s/harp_benchmarks_matchup.csv", b->work_dir);
+    sprintf(b->bin_collocation_filename, "%s/harp_benchmarks_bin.csv", b->work_dir);
+    sprintf(b->bin_check_collocation_filename, "%s/harp_benchmarks_bin_check.csv", b->work_dir);
+    sprintf(b->unsupported_filename, "%s/harp_benchmarks_unsupported.txt", b->work_dir);
+
+    if (inputs & INPUT_PRODUCT)
+    {
+        if (generate_product("harp_benchmarks", b->num_time, 0, b->num_vertical, b->num_spectral, &b->product) != 0)
+        {
+            return -1;
+        }
+        /* the file for the import and matchup scenarios */
+        if (harp_export(b->netcdf_filename, "netcdf", b->product) != 0)
+        {
+            return -1;
+        }
+        b->has_netcdf_file = 1;
+    }
+
+    if (inputs & INPUT_GRANULES)
+    {
+        granule_length = b->num_time / NUM_APPEND_GRANULES;
+        if (granule_length == 0)
+        {
+            granule_length = 1;
+        }
+        for (i = 0; i < NUM_APPEND_GRANULES; i++)
+        {
+            if (generate_product("harp_benchmarks_granule", granule_length, i * granule_length, b->num_vertical,
+                                 b->num_spectral, &b->granule[i]) != 0)
+            {
+                return -1;
+            }
+        }
+    }
+
+    if ((inputs & INPUT_COLLOCATED) && b->num_vertical > 0)
+    {
+        num_smooth_samples = b->num_time < MAX_SMOOTH_SAMPLES ? b->num_time : MAX_SMOOTH_SAMPLES;
+        if (generate_collocated_product(num_smooth_samples, b->num_vertical, &b->collocated_product) != 0)
+        {
+            return -1;
+        }
+    }
+
+    if (inputs & INPUT_STATIONS)
+    {
+        if (generate_station_product(&b->station_product) != 0)
+        {
+            return -1;
+        }
+        if (harp_export(b->station_filename, "netcdf", b->station_product) != 0)
+        {
+            return -1;
+        }
+    }
+
+    if (inputs & INPUT_BIN)
+    {
+        if (generate_bin_product(b->num_bin_samples, b->num_bins, b->bin_collocation_filename, &b->bin_product) != 0)
+        {
+            return -1;
+        }
+    }
+    if (inputs & INPUT_BIN_CHECK)
+    {
+        if (generate_bin_check_product(b->bin_check_collocation_filename, &b->bin_check_product) != 0)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static void benchmark_done(benchmark *b)
+{
+    int i;
+
+    if (b->product != NULL)
+    {
+        harp_product_delete(b->product);
+    }
+    if (b->collocated_product != NULL)
+    {
+        harp_product_delete(b->collocated_product);
+    }
+    if (b->station_product != NULL)
+    {
+        harp_product_delete(b->station_product);
+    }
+    for (i = 0; i < NUM_APPEND_GRANULES; i++)
+    {
+        if (b->granule[i] != NULL)
+        {
+            harp_product_delete(b->granule[i]);
+        }
+    }
+    if (b->bin_product != NULL)
+    {
+        harp_product_delete(b->bin_product);
+    }
+    if (b->bin_check_product != NULL)
+    {
+        harp_product_delete(b->bin_check_product);
+    }
+    if (b->has_netcdf_file)
+    {
+        remove(b->netcdf_filename);
+    }
+    if (b->has_hdf5_file)
+    {
+        remove(b->hdf5_filename);
+    }
+    remove(b->station_filename);
+    remove(b->matchup_filename);
+    remove(b->bin_collocation_filename);
+    remove(b->bin_check_collocation_filename);
+    remove(b->unsupported_filename);
+    if (b->selection != NULL)
+    {
+        free(b->selection);
+    }
+}
+
+static int run_export(benchmark *b, const char *filename, const char *format, double *duration)
+{
+    double start_time = get_time();
+
+    if (harp_export(filename, format, b->product) != 0)
+    {
+        return -1;
+    }
+    *duration = get_time() - start_time;
+
+    return 0;
+}
+
+static int run_export_netcdf(benchmark *b, const scenario *s, double *duration)
+{
+    (void)s;
+
+    if (run_export(b, b->netcdf_filename, "netcdf", duration) != 0)
+    {
+        return -1;
+    }
+    b->has_netcdf_file = 1;
+
+    return 0;
+}
+
+static int run_export_hdf5(benchmark *b, const scenario *s, double *duration)
+{
+    (void)s;
+
+    if (run_export(b, b->hdf5_filename, "hdf5", duration) != 0)
+    {
+        return -1;
+    }
+    b->has_hdf5_file = 1;
+
+    return 0;
+}
+
+static int run_import(const char *filename, double *duration)
+{
+    harp_product *product;
+    double start_time = get_time();
+
+    if (harp_import(filename, NULL, NULL, &product) != 0)
+    {
+        return -1;
+    }
+    *duration = get_time() - start_time;
+    harp_product_delete(product);
+
+    return 0;
+}
+
+/* Time the import of a file that is not in HARP format. This goes through the ingestion path (initialization of the
+ * ingestion modules and identification of the product using CODA). The file is not a supported product, so the import
+ * is expected to fail with HARP_ERROR_UNSUPPORTED_PRODUCT.
+ */
+static int run_ingestion_unsupported(benchmark *b, double *duration)
+{
+    harp_product *product;
+    double start_time;
+    FILE *f;
+
+    f = fopen(b->unsupported_filename, "w");
+    if (f == NULL)
+    {
+        harp_set_error(HARP_ERROR_FILE_OPEN, "could not create %s", b->unsupported_filename);
+        return -1;
+    }
+    fprintf(f, "harp_benchmarks\n");
+    if (fclose(f) != 0)
+    {
+        harp_set_error(HARP_ERROR_FILE_WRITE, "could not write %s", b->unsupported_filename);
+        return -1;
+    }
+
+    start_time = get_time();
+    if (harp_import(b->unsupported_filename, NULL, NULL, &product) == 0)
+    {
+        harp_product_delete(product);
+    }
+    else if (harp_errno != HARP_ERROR_UNSUPPORTED_PRODUCT)
+    {
+        return -1;
+    }
+    *duration = get_time() - start_time;
+
+    return 0;
+}
+
+static int run_import_netcdf(benchmark *b, const scenario *s, double *duration)
+{
+    (void)s;
+
+    return run_import(b->netcdf_filename, duration);
+}
+
+static int run_import_hdf5(benchmark *b, const scenario *s, double *duration)
+{
+    (void)s;
+
+    if (!b->has_hdf5_file)
+    {
+        /* the export_hdf5 scenario did not run (or failed); this fails if there is no HDF5 support */
+        if (harp_export(b->hdf5_filename, "hdf5", b->product) != 0)
+        {
+            return -1;
+        }
+        b->has_hdf5_file = 1;
+    }
+
+    return run_import(b->hdf5_filename, duration);
+}
+
+/* time the execution of the operations of the scenario on a copy of the generated product */
+static int run_operations(benchmark *b, const scenario *s, double *duration)
+{
+    harp_product *product;
+    double start_time;
+
+    if (harp_product_copy(b->product, &product) != 0)
+    {
+        return -1;
+    }
+    start_time = get_time();
+    if (harp_product_execute_operations(product, s->operations) != 0)
+    {
+        harp_product_delete(product);
+        return -1;
+    }
+    *duration = get_time() - start_time;
+    harp_product_delete(product);
+
+    return 0;
+}
+
+static int run_smooth(benchmark *b, const scenario *s, double *duration)
+{
+    const char *smooth_variable = "O3_volume_mixing_ratio";
+    harp_product *product;
+    char operations[64];
+    double start_time;
+
+    (void)s;
+
+    if (b->collocated_product == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "product has no vertical dimension");
+        return -1;
+    }
+
+    if (harp_product_copy(b->product, &product) != 0)
+    {
+        return -1;
+    }
+    /* only keep the samples for which there is an averaging kernel */
+    sprintf(operations, "collocation_index < %ld", b->collocated_product->dimension[harp_dimension_time]);
+    if (harp_product_execute_operations(product, operations) != 0)
+    {
+        harp_product_delete(product);
+        return -1;
+    }
+
+    start_time = get_time();
+    if (harp_product_smooth_vertical_with_collocated_product(product, 1, &smooth_variable, "altitude", "km",
+                                                             b->collocated_product) != 0)
+    {
+        harp_product_delete(product);
+        return -1;
+    }
+    *duration = get_time() - start_time;
+    harp_product_delete(product);
+
+    return 0;
+}
+
+static int run_append(benchmark *b, const scenario *s, double *duration)
+{
+    harp_product *product;
+    double start_time;
+    int i;
+
+    (void)s;
+
+    if (harp_product_copy(b->granule[0], &product) != 0)
+    {
+        return -1;
+    }
+    start_time = get_time();
+    for (i = 1; i < NUM_APPEND_GRANULES; i++)
+    {
+        if (harp_product_append(product, b->granule[i]) != 0)
+        {
+            harp_product_delete(product);
+            return -1;
+        }
+    }
+    *duration = get_time() - start_time;
+    harp_product_delete(product);
+
+    return 0;
+}
+
+static int run_matchup(benchmark *b, const scenario *s, double *duration)
+{
+    char datetime_criterium[] = "datetime 3 [h]";
+    char distance_criterium[] = "point_distance 500 [km]";
+    char *argv[8];
+    double start_time;
+    int result;
+
+    (void)s;
+
+    if (!b->has_netcdf_file)
+    {
+        harp_set_error(HARP_ERROR_FILE_NOT_FOUND, "could not find '%s'", b->netcdf_filename);
+        return -1;
+    }
+
+    argv[0] = "harpcollocate";
+    argv[1] = "-d";
+    argv[2] = datetime_criterium;
+    argv[3] = "-d";
+    argv[4] = distance_criterium;
+    argv[5] = b->netcdf_filename;
+    argv[6] = b->station_filename;
+    argv[7] = b->matchup_filename;
+
+    start_time = get_time();
+    result = matchup(8, argv);
+    if (result != 0)
+    {
+        if (result == 1)
+        {
+            harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "invalid matchup arguments");
+        }
+        return -1;
+    }
+    *duration = get_time() - start_time;
+
+    return 0;
+}
+
+/* time the execution of the operations on a copy of the product for the bin_large_* scenarios */
+static int run_bin_large(benchmark *b, const char *operations, double *duration)
+{
+    harp_product *product;
+    double start_time;
+
+    if (harp_product_copy(b->bin_product, &product) != 0)
+    {
+        return -1;
+    }
+    start_time = get_time();
+    if (harp_product_execute_operations(product, operations) != 0)
+    {
+        harp_product_delete(product);
+        return -1;
+    }
+    *duration = get_time() - start_time;
+    harp_product_delete(product);
+
+    return 0;
+}
+
+static int run_bin_large_variable(benchmark *b, const scenario *s, double *duration)
+{
+    (void)s;
+
+    return run_bin_large(b, "bin(bin_key)", duration);
+}
+
+/* this includes the time to read the collocation result file */
+static int run_bin_large_collocated(benchmark *b, const scenario *s, double *duration)
+{
+    char operations[MAX_FILENAME_LENGTH + 32];
+
+    (void)s;
+
+    sprintf(operations, "bin(\"%s\", b)", b->bin_collocation_filename);
+
+    return run_bin_large(b, operations, duration);
+}
+
+/* Equality of the values of a binning variable as defined by bin(): NaN values are equal to each other, -0.0 equals
+ * 0.0, and a NULL string is only equal to another NULL string.
+ */
+static int bin_values_equal(const harp_variable *variable, long index_a, long index_b)
+{
+    switch (variable->data_type)
+    {
+        case harp_type_int8:
+            return variable->data.int8_data[index_a] == variable->data.int8_data[index_b];
+        case harp_type_int16:
+            return variable->data.int16_data[index_a] == variable->data.int16_data[index_b];
+        case harp_type_int32:
+            return variable->data.int32_data[index_a] == variable->data.int32_data[index_b];
+        case harp_type_float:
+            if (harp_isnan(variable->data.float_data[index_a]) || harp_isnan(variable->data.float_data[index_b]))
+            {
+                return harp_isnan(variable->data.float_data[index_a]) &&
+                    harp_isnan(variable->data.float_data[index_b]);
+            }
+            return variable->data.float_data[index_a] == variable->data.float_data[index_b];
+        case harp_type_double:
+            if (harp_isnan(variable->data.double_data[index_a]) || harp_isnan(variable->data.double_data[index_b]))
+            {
+                return harp_isnan(variable->data.double_data[index_a]) &&
+                    harp_isnan(variable->data.double_data[index_b]);
+            }
+            return variable->data.double_data[index_a] == variable->data.double_data[index_b];
+        case harp_type_string:
+            if (variable->data.string_data[index_a] == NULL || variable->data.string_data[index_b] == NULL)
+            {
+                return variable->data.string_data[index_a] == NULL && variable->data.string_data[index_b] == NULL;
+            }
+            return strcmp(variable->data.string_data[index_a], variable->data.string_data[index_b]) == 0;
+    }
+
+    return 0;
+}
+
+/* Reference grouping for the bin_check_* scenarios: each sample is compared with the first sample of every existing
+ * bin, which is the O(samples x bins) approach that bin() used before it grouped samples with a hash table.
+ * index receives the index of the first sample of each bin and bin_index the bin of each sample.
+ */
+static long reference_group_samples(long num_elements, int num_variables, harp_variable **variable, long *index,
+                                    long *bin_index)
+{
+    long num_bins = 0;
+    long i, j;
+    int k;
+
+    for (i = 0; i < num_elements; i++)
+    {
+        for (j = 0; j < num_bins; j++)
+        {
+            for (k = 0; k < num_variables; k++)
+            {
+                if (!bin_values_equal(variable[k], index[j], i))
+                {
+                    break;
+                }
+            }
+            if (k == num_variables)
+            {
+                break;
+            }
+        }
+        if (j == num_bins)
+        {
+            index[num_bins] = i;
+            num_bins++;
+        }
+        bin_index[i] = j;
+    }
+
+    return num_bins;
+}
+
+/* the value of a kept variable in a bin should be identical (including the sign of zero and NaN) to the value of the
+ * first sample of the bin
+ */
+static int bin_values_identical(const harp_variable *variable, long index, const harp_variable *binned_variable,
+                                long bin)
+{
+    switch (variable->data_type)
+    {
+        case harp_type_int32:
+            return variable->data.int32_data[index] == binned_variable->data.int32_data[bin];
+        case harp_type_double:
+            return memcmp(&variable->data.double_data[index], &binned_variable->data.double_data[bin],
+                          sizeof(double)) == 0;
+        case harp_type_string:
+            if (variable->data.string_data[index] == NULL || binned_variable->data.string_data[bin] == NULL)
+            {
+                return variable->data.string_data[index] == NULL && binned_variable->data.string_data[bin] == NULL;
+            }
+            return strcmp(variable->data.string_data[index], binned_variable->data.string_data[bin]) == 0;
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+/* Run the bin() operation on a copy of the bin check product and compare the result against the reference grouping
+ * on the key variables: the binned product should have the bins in order of first occurrence, the kept variables
+ * should contain the values of the first sample of each bin, 'count' the number of samples, and 'value' the average.
+ */
+static int run_bin_check(benchmark *b, const char *operations, int num_keys, const char **key_name,
+                         int num_kept_variables, const char **kept_variable_name, double *duration)
+{
+    harp_product *product = NULL;
+    harp_variable *key[2];
+    harp_variable *value;
+    harp_variable *binned_variable;
+    double start_time;
+    double *sum = NULL;
+    long *count = NULL;
+    long *index = NULL;
+    long *bin_index = NULL;
+    long num_elements;
+    long num_bins;
+    long i;
+    int k;
+
+    num_elements = b->bin_check_product->dimension[harp_dimension_time];
+    for (k = 0; k < num_keys; k++)
+    {
+        if (harp_product_get_variable_by_name(b->bin_check_product, key_name[k], &key[k]) != 0)
+        {
+            return -1;
+        }
+    }
+    if (harp_product_get_variable_by_name(b->bin_check_product, "value", &value) != 0)
+    {
+        return -1;
+    }
+
+    index = malloc(num_elements * sizeof(long));
+    bin_index = malloc(num_elements * sizeof(long));
+    count = calloc(num_elements, sizeof(long));
+    sum = calloc(num_elements, sizeof(double));
+    if (index == NULL || bin_index == NULL || count == NULL || sum == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       num_elements * sizeof(long), __FILE__, __LINE__);
+        goto error;
+    }
+    num_bins = reference_group_samples(num_elements, num_keys, key, index, bin_index);
+    for (i = 0; i < num_elements; i++)
+    {
+        count[bin_index[i]]++;
+        sum[bin_index[i]] += value->data.double_data[i];
+    }
+
+    if (harp_product_copy(b->bin_check_product, &product) != 0)
+    {
+        goto error;
+    }
+    start_time = get_time();
+    if (harp_product_execute_operations(product, operations) != 0)
+    {
+        goto error;
+    }
+    *duration = get_time() - start_time;
+
+    if (product->dimension[harp_dimension_time] != num_bins)
+    {
+        harp_set_error(HARP_ERROR_OPERATION, "%s resulted in %ld bins (expected %ld)", operations,
+                       product->dimension[harp_dimension_time], num_bins);
+        goto error;
+    }
+    for (k = 0; k < num_kept_variables; k++)
+    {
+        harp_variable *variable;
+
+        if (harp_product_get_variable_by_name(b->bin_check_product, kept_variable_name[k], &variable) != 0 ||
+            harp_product_get_variable_by_name(product, kept_variable_name[k], &binned_variable) != 0)
+        {
+            goto error;
+        }
+        for (i = 0; i < num_bins; i++)
+        {
+            if (!bin_values_identical(variable, index[i], binned_variable, i))
+            {
+                harp_set_error(HARP_ERROR_OPERATION, "%s: '%s' of bin %ld differs from sample %ld", operations,
+                               kept_variable_name[k], i, index[i]);
+                goto error;
+            }
+        }
+    }
+    if (harp_product_get_variable_by_name(product, "count", &binned_variable) != 0)
+    {
+        goto error;
+    }
+    for (i = 0; i < num_bins; i++)
+    {
+        if (binned_variable->data.int32_data[i] != count[i])
+        {
+            harp_set_error(HARP_ERROR_OPERATION, "%s: bin %ld has %ld samples (expected %ld)", operations, i,
+                           (long)binned_variable->data.int32_data[i], count[i]);
+            goto error;
+        }
+    }
+    if (harp_product_get_variable_by_name(product, "value", &binned_variable) != 0)
+    {
+        goto error;
+    }
+    for (i = 0; i < num_bins; i++)
+    {
+        if (fabs(binned_variable->data.double_data[i] - sum[i] / count[i]) > 1.0e-6)
+        {
+            harp_set_error(HARP_ERROR_OPERATION, "%s: average value of bin %ld is %g (expected %g)", operations, i,
+                           binned_variable->data.double_data[i], sum[i] / count[i]);
+            goto error;
+        }
+    }
+
+    harp_product_delete(product);
+    free(sum);
+    free(count);
+    free(bin_index);
+    free(index);
+
+    return 0;
+
+  error:
+    if (product != NULL)
+    {
+        harp_product_delete(product);
+    }
+    free(sum);
+    free(count);
+    free(bin_index);
+    free(index);
+
+    return -1;
+}
+
+static int run_bin_check_variable(benchmark *b, const scenario *s, double *duration)
+{
+    const char *key_name[2] = { "check_double", "check_string" };
+    double key_duration;
+
+    (void)s;
+
+    if (run_bin_check(b, "bin(check_double)", 1, key_name, 1, key_name, duration) != 0)
+    {
+        return -1;
+    }
+    if (run_bin_check(b, "bin(check_string)", 1, &key_name[1], 1, &key_name[1], &key_duration) != 0)
+    {
+        return -1;
+    }
+    *duration += key_duration;
+    if (run_bin_check(b, "bin((check_double, check_string))", 2, key_name, 2, key_name, &key_duration) != 0)
+    {
+        return -1;
+    }
+    *duration += key_duration;
+
+    return 0;
+}
+
+static int run_bin_check_collocated(benchmark *b, const scenario *s, double *duration)
+{
+    const char *key_name[2] = { "check_product_b", "check_sample_b" };
+    const char *kept_variable_name = "collocation_index";
+    char operations[MAX_FILENAME_LENGTH + 32];
+
+    (void)s;
+
+    sprintf(operations, "bin(\"%s\", b)", b->bin_check_collocation_filename);
+
+    return run_bin_check(b, operations, 2, key_name, 1, &kept_variable_name, duration);
+}
+
+static const scenario scenario_list[] = {
+    {"export_netcdf", run_export_netcdf, NULL, INPUT_PRODUCT},
+    {"export_hdf5", run_export_hdf5, NULL, INPUT_PRODUCT},
+    {"import_netcdf", run_import_netcdf, NULL, INPUT_PRODUCT},
+    {"import_hdf5", run_import_hdf5, NULL, INPUT_PRODUCT},
+    {"filter_comparison", run_operations, "cloud_fraction < 0.5", INPUT_PRODUCT},
+    {"filter_string_membership", run_operations,
+     "location_name in (\"site_001\", \"site_050\", \"site_099\")", INPUT_PRODUCT},
+    {"filter_index", run_operations, "index(time) < 1000", INPUT_PRODUCT},
+    {"filter_point_distance", run_operations, "point_distance(0.0, 0.0, 2000 [km])", INPUT_PRODUCT},
+    {"filter_point_in_area", run_operations, "point_in_area((-20,-20,20,20),(-20,20,20,-20))", INPUT_PRODUCT},
+    {"filter_area_intersects_area", run_operations,
+     "area_intersects_area((-20,-20,20,20),(-20,20,20,-20))", INPUT_PRODUCT},
+    {"sort", run_operations, "sort(cloud_fraction)", INPUT_PRODUCT},
+    {"bin", run_operations, "bin(scanline_index)", INPUT_PRODUCT},
+    {"bin_large_variable", run_bin_large_variable, NULL, INPUT_BIN},
+    {"bin_large_collocation_result", run_bin_large_collocated, NULL, INPUT_BIN},
+    {"bin_check_variable", run_bin_check_variable, NULL, INPUT_BIN_CHECK},
+    {"bin_check_collocation_result", run_bin_check_collocated, NULL, INPUT_BIN_CHECK},
+    {"bin_spatial", run_operations, "bin_spatial(19, -90, 10, 37, -180, 10)", INPUT_PRODUCT},
+    {"regrid", run_operations, "regrid(vertical, altitude [km], 20, 0.5, 2.0)", INPUT_PRODUCT},
+    {"derive_number_density", run_operations, "derive(O3_number_density {time,vertical} [molec/cm3])", INPUT_PRODUCT},
+    {"derive_column", run_operations, "derive(O3_column_number_density {time} [molec/cm2])", INPUT_PRODUCT},
+    {"smooth", run_smooth, NULL, INPUT_PRODUCT | INPUT_COLLOCATED},
+    {"append", run_append, NULL, INPUT_GRANULES},
+    {"matchup", run_matchup, NULL, INPUT_PRODUCT | INPUT_STATIONS}
+};
+
+#define NUM_SCENARIOS ((int)(sizeof(scenario_list) / sizeof(scenario_list[0])))
+
+static const char *startup_result_name[] = {
+    "startup_harp_init",
+    "startup_first_import_netcdf",
+    "startup_first_ingestion"
+};
+
+#define NUM_STARTUP_RESULTS ((int)(sizeof(startup_result_name) / sizeof(startup_result_name[0])))
+
+static int has_prefix(const char *name, const char *prefix)
+{
+    return strncmp(name, prefix, strlen(prefix)) == 0;
+}
+
+/* returns whether the scenario (or startup result) with the given name should be run */
+static int is_selected(const benchmark *b, const char *name)
+{
+    int i;
+
+    if (b->num_selections == 0)
+    {
+        return 1;
+    }
+    for (i = 0; i < b->num_selections; i++)
+    {
+        if (has_prefix(name, b->selection[i]))
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* returns whether the given prefix matches at least one scenario or startup result */
+static int matches_any(const char *prefix)
+{
+    int i;
+
+    for (i = 0; i < NUM_SCENARIOS; i++)
+    {
+        if (has_prefix(scenario_list[i].name, prefix))
+        {
+            return 1;
+        }
+    }
+    for (i = 0; i < NUM_STARTUP_RESULTS; i++)
+    {
+        if (has_prefix(startup_result_name[i], prefix))
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static void write_json_string(FILE *f, const char *str)
+{
+    fputc('"', f);
+    while (*str != '\0')
+    {
+        unsigned char c = (unsigned char)*str;
+
+        if (c == '"' || c == '\\')
+        {
+            fprintf(f, "\\%c", c);
+        }
+        else if (c < 0x20)
+        {
+            fprintf(f, "\\u%04x", c);
+        }
+        else
+        {
+            fputc(c, f);
+        }
+        str++;
+    }
+    fputc('"', f);
+}
+
+/* write the result of a scenario as a JSON object; 'duration' contains the times of the successful runs */
+static void write_result(FILE *f, const char *name, int num_runs, const double *duration, const char *error)
+{
+    double min_duration = 0;
+    double total_duration = 0;
+    int i;
+
+    fprintf(f, "    {\"name\": ");
+    write_json_string(f, name);
+    if (error != NULL)
+    {
+        fprintf(f, ", \"status\": \"error\", \"error\": ");
+        write_json_string(f, error);
+        fprintf(f, "}");
+        return;
+    }
+
+    for (i = 0; i < num_runs; i++)
+    {
+        if (i == 0 || duration[i] < min_duration)
+        {
+            min_duration = duration[i];
+        }
+        total_duration += duration[i];
+    }
+    fprintf(f, ", \"status\": \"ok\", \"repeats\": %d, \"min\": %.6f, \"mean\": %.6f, \"times\": [", num_runs,
+            min_duration, total_duration / num_runs);
+    for (i = 0; i < num_runs; i++)
+    {
+        fprintf(f, "%s%.6f", i == 0 ? "" : ", ", duration[i]);
+    }
+    fprintf(f, "]}");
+}
+
+static void report_progress(const char *name, int num_runs, const double *duration, const char *error)
+{
+    double min_duration;
+    int i;
+
+    if (error != NULL)
+    {
+        fprintf(stderr, "%-28s ERROR: %s\n", name, error);
+        return;
+    }
+
+    min_duration = duration[0];
+    for (i = 1; i < num_runs; i++)
+    {
+        if (duration[i] < min_duration)
+        {
+            min_duration = duration[i];
+        }
+    }
+    fprintf(stderr, "%-28s %10.6f s (best of %d)\n", name, min_duration, num_runs);
+}
+
+static int run_scenarios(benchmark *b, FILE *f, double init_duration, double first_import_duration,
+                         const char *first_import_error, double first_ingestion_duration,
+                         const char *first_ingestion_error)
+{
+    double *duration;
+    int num_results = 0;
+    int i;
+    int k;
+
+    duration = malloc(b->num_repeats * sizeof(double));
+    if (duration == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       b->num_repeats * sizeof(double), __FILE__, __LINE__);
+        return -1;
+    }
+
+    fprintf(f, "{\n  \"harp_version\": ");
+    write_json_string(f, libharp_version);
+    fprintf(f, ",\n  \"settings\": {\"time\": %ld, \"vertical\": %ld, \"spectral\": %ld, \"bin_samples\": %ld, "
+            "\"bins\": %ld, \"repeats\": %d, \"num_threads\": %d},\n", b->num_time, b->num_vertical, b->num_spectral,
+            b->num_bin_samples, b->num_bins, b->num_repeats, harp_get_option_num_threads());
+    fprintf(f, "  \"results\": [\n");
+
+    /* startup: harp_init(), the first import, and the first ingestion in a session are only measured once */
+    if (is_selected(b, "startup_harp_init"))
+    {
+        write_result(f, "startup_harp_init", 1, &init_duration, NULL);
+        report_progress("startup_harp_init", 1, &init_duration, NULL);
+        num_results++;
+    }
+    if (is_selected(b, "startup_first_import_netcdf"))
+    {
+        fprintf(f, "%s", num_results > 0 ? ",\n" : "");
+        write_result(f, "startup_first_import_netcdf", 1, &first_import_duration, first_import_error);
+        report_progress("startup_first_import_netcdf", 1, &first_import_duration, first_import_error);
+        num_results++;
+    }
+    if (is_selected(b, "startup_first_ingestion"))
+    {
+        fprintf(f, "%s", num_results > 0 ? ",\n" : "");
+        write_result(f, "startup_first_ingestion", 1, &first_ingestion_duration, first_ingestion_error);
+        report_progress("startup_first_ingestion", 1, &first_ingestion_duration, first_ingestion_error);
+        num_results++;
+    }
+
+    for (i = 0; i < NUM_SCENARIOS; i++)
+    {
+        const scenario *s = &scenario_list[i];
+        const char *error = NULL;
+
+        if (!is_selected(b, s->name))
+        {
+            continue;
+        }
+        for (k = 0; k < b->num_repeats; k++)
+        {
+            if (s->run(b, s, &duration[k]) != 0)
+            {
+                error = harp_errno_to_string(harp_errno);
+                break;
+            }
+        }
+        fprintf(f, "%s", num_results > 0 ? ",\n" : "");
+        write_result(f, s->name, b->num_repeats, duration, error);
+        report_progress(s->name, b->num_repeats, duration, error);
+        num_results++;
+    }
+
+    fprintf(f, "\n  ]\n}\n");
+
+    free(duration);
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    benchmark b;
+    const char *output_filename = NULL;
+    const char *first_import_error = NULL;
+    const char *first_ingestion_error = NULL;
+    char first_import_error_message[1024];
+    char first_ingestion_error_message[1024];
+    double init_duration;
+    double first_import_duration = 0;
+    double first_ingestion_duration = 0;
+    double start_time;
+    FILE *f = stdout;
+    int inputs;
+    int result;
+    int i;
+
+    memset(&b, 0, sizeof(benchmark));
+    b.num_time = 10000;
+    b.num_vertical = 40;
+    b.num_spectral = 100;
+    b.num_bin_samples = 10000000;
+    b.num_bins = 100000;
+    b.num_repeats = 5;
+    b.work_dir = ".";
+
+    for (i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0)
+        {
+            print_help();
+            exit(0);
+        }
+        else if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--version") == 0)
+        {
+            print_version();
+            exit(0);
+        }
+        else if ((strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--time") == 0) && i + 1 < argc)
+        {
+            b.num_time = atol(argv[i + 1]);
+            i++;
+        }
+        else if ((strcmp(argv[i], "-z") == 0 || strcmp(argv[i], "--vertical") == 0) && i + 1 < argc)
+        {
+            b.num_vertical = atol(argv[i + 1]);
+            i++;
+        }
+        else if ((strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--spectral") == 0) && i + 1 < argc)
+        {
+            b.num_spectral = atol(argv[i + 1]);
+            i++;
+        }
+        else if ((strcmp(argv[i], "-n") == 0 || strcmp(argv[i], "--bin-samples") == 0) && i + 1 < argc)
+        {
+            b.num_bin_samples = atol(argv[i + 1]);
+            i++;
+        }
+        else if ((strcmp(argv[i], "-k") == 0 || strcmp(argv[i], "--bins") == 0) && i + 1 < argc)
+        {
+            b.num_bins = atol(argv[i + 1]);
+            i++;
+        }
+        else if ((strcmp(argv[i], "-S") == 0 || strcmp(argv[i], "--scenario") == 0) && i + 1 < argc)
+        {
+            if (b.selection == NULL)
+            {
+                /* there can never be more selections than arguments */
+                b.selection = malloc(argc * sizeof(const char *));
+                if (b.selection == NULL)
+                {
+                    fprintf(stderr, "ERROR: out of memory\n");
+                    exit(1);
+                }
+            }
+            b.selection[b.num_selections] = argv[i + 1];
+            b.num_selections++;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--repeat") == 0) && i + 1 < argc)
+        {
+            b.num_repeats = atoi(argv[i + 1]);
+            i++;
+        }
+        else if ((strcmp(argv[i], "-d") == 0 || strcmp(argv[i], "--work-dir") == 0) && i + 1 < argc)
+        {
+            b.work_dir = argv[i + 1];
+            i++;
+        }
+        else if ((strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--output") == 0) && i + 1 < argc)
+        {
+            output_filename = argv[i + 1];
+            i++;
+        }
+        else
+        {
+            fprintf(stderr, "ERROR: invalid argument: '%s'\n", argv[i]);
+            print_help();
+            exit(1);
+        }
+    }
+    if (b.num_time <= 0 || b.num_vertical < 0 || b.num_spectral < 0 || b.num_bin_samples <= 0 || b.num_bins <= 0 ||
+        b.num_repeats <= 0)
+    {
+        fprintf(stderr, "ERROR: dimension lengths and number of repeats should be positive\n");
+        exit(1);
+    }
+    if (strlen(b.work_dir) > MAX_FILENAME_LENGTH - 64)
+    {
+        fprintf(stderr, "ERROR: work directory path is too long\n");
+        exit(1);
+    }
+
+    if (harp_set_coda_definition_path_conditional(argv[0], NULL, "../share/coda/definitions") != 0)
+    {
+        fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
+        exit(1);
+    }
+    if (harp_set_udunits2_xml_path_conditional(argv[0], NULL, "../share/harp/udunits2.xml") != 0)
+    {
+        fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
+        exit(1);
+    }
+
+    for (i = 0; i < b.num_selections; i++)
+    {
+        if (!matches_any(b.selection[i]))
+        {
+            fprintf(stderr, "ERROR: no benchmark scenario matches '%s'\n", b.selection[i]);
+            free(b.selection);
+            exit(1);
+        }
+    }
+
+    inputs = 0;
+    if (is_selected(&b, "startup_first_import_netcdf"))
+    {
+        inputs |= INPUT_PRODUCT;
+    }
+    for (i = 0; i < NUM_SCENARIOS; i++)
+    {
+        if (is_selected(&b, scenario_list[i].name))
+        {
+            inputs |= scenario_list[i].inputs;
+        }
+    }
+
+    start_time = get_time();
+    if (harp_init() != 0)
+    {
+        fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
+        exit(1);
+    }
+    init_duration = get_time() - start_time;
+
+    fprintf(stderr, "generating products (time=%ld, vertical=%ld, spectral=%ld, bin samples=%ld, bins=%ld)\n",
+            b.num_time, b.num_vertical, b.num_spectral, b.num_bin_samples, b.num_bins);
+    if (benchmark_init(&b, inputs) != 0)
+    {
+        fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
+        benchmark_done(&b);
+        harp_done();
+        exit(1);
+    }
+
+    /* the first import in the session is timed separately */
+    if (is_selected(&b, "startup_first_import_netcdf") && run_import(b.netcdf_filename, &first_import_duration) != 0)
+    {
+        strncpy(first_import_error_message, harp_errno_to_string(harp_errno), sizeof(first_import_error_message) - 1);
+        first_import_error_message[sizeof(first_import_error_message) - 1] = '\0';
+        first_import_error = first_import_error_message;
+    }
+    /* the import of a HARP product does not use the ingestion modules, so the first ingestion is timed separately */
+    if (is_selected(&b, "startup_first_ingestion") && run_ingestion_unsupported(&b, &first_ingestion_duration) != 0)
+    {
+        strncpy(first_ingestion_error_message, harp_errno_to_string(harp_errno),
+                sizeof(first_ingestion_error_message) - 1);
+        first_ingestion_error_message[sizeof(first_ingestion_error_message) - 1] = '\0';
+        first_ingestion_error = first_ingestion_error_message;
+    }
+
+    if (output_filename != NULL)
+    {
+        f = fopen(output_filename, "w");
+        if (f == NULL)
+        {
+            fprintf(stderr, "ERROR: could not create %s\n", output_filename);
+            benchmark_done(&b);
+            harp_done();
+            exit(1);
+        }
+    }
+
+    result = run_scenarios(&b, f, init_duration, first_import_duration, first_import_error, first_ingestion_duration,
+                           first_ingestion_error);
+
+    if (output_filename != NULL)
+    {
+        if (fclose(f) != 0)
+        {
+            fprintf(stderr, "ERROR: could not write %s\n", output_filename);
+            result = -1;
+        }
+    }
+    if (result != 0)
+    {
+        fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
+    }
+
+    benchmark_done(&b);
+    harp_done();
+
+    return result == 0 ? 0 : 1;
+}
@@ -1261,8 +1261,7 @@ static IDL_VPTR harp_idl_import(int argc, IDL_VPTR *argv)
     {
         return harp_idl_get_error_struct(HARP_IDL_ERR_EXPECTED_STRING);
     }
-    if (((argv[0]->flags & IDL_V_ARR) != 0) || (argc > 1 && ((argv[1]->flags & IDL_V_ARR) != 0)) ||
-        (argc > 2 && ((argv[2]->flags & IDL_V_ARR) != 0)))
+    if ((argc > 1 && ((argv[1]->flags & IDL_V_ARR) != 0)) || (argc > 2 && ((argv[2]->flags & IDL_V_ARR) != 0)))
     {
         return harp_idl_get_error_struct(HARP_IDL_ERR_EXPECTED_SINGLE_ELM);
     }
@@ -1272,7 +1271,9 @@ static IDL_VPTR harp_idl_import(int argc, IDL_VPTR *argv)
         return harp_idl_get_error_struct(harp_errno);
     }
 
-    /* First argument = filename, second (optional) argument is operations, third (optional) argument is options. */
+    /* First argument = filename (or array of filenames), second (optional) argument is operations, third (optional)
+     * argument is options.
+     */
     operations = NULL;
     if (argc > 1)
     {
@@ -1284,7 +1285,39 @@ static IDL_VPTR harp_idl_import(int argc, IDL_VPTR *argv)
         options = IDL_STRING_STR(&argv[2]->value.str);
     }
 
-    if (harp_import(IDL_STRING_STR(&argv[0]->value.str), operations, options, &product) != 0)
+    if ((argv[0]->flags & IDL_V_ARR) != 0)
+    {
+        IDL_STRING *idl_filename = (IDL_STRING *)argv[0]->value.arr->data;
+        const char **filename;
+        int num_files;
+        int result;
+        int i;
+
+        num_files = (int)argv[0]->value.arr->n_elts;
+        if (num_files == 0)
+        {
+            return harp_idl_get_error_struct(HARP_IDL_ERR_EMPTY_ARRAY);
+        }
+        filename = (const char **)malloc(num_files * sizeof(const char *));
+        if (filename == NULL)
+        {
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                           num_files * sizeof(const char *), __FILE__, __LINE__);
+            return harp_idl_get_error_struct(harp_errno);
+        }
+        for (i = 0; i < num_files; i++)
+        {
+            filename[i] = IDL_STRING_STR(&idl_filename[i]);
+        }
+        /* import and merge all files, parsing the operations and options only once */
+        result = harp_import_multiple(num_files, filename, operations, options, NULL, &product);
+        free(filename);
+        if (result != 0)
+        {
+            return harp_idl_get_error_struct(harp_errno);
+        }
+    }
+    else if (harp_import(IDL_STRING_STR(&argv[0]->value.str), operations, options, &product) != 0)
     {
         return harp_idl_get_error_struct(harp_errno);
     }
@@ -30,6 +30,7 @@
  */
 
 #include "harp-area-mask.h"
+#include "harp-csv.h"
 
 #include <ctype.h>
 #include <stdlib.h>
@@ -37,7 +38,6 @@
 #include <string.h>
 
 #define AREA_MASK_BLOCK_SIZE 1024
-#define AREA_MASK_MAX_LINE_SIZE 1024
 
 int harp_area_mask_new(harp_area_mask **new_area_mask)
 {
@@ -223,6 +223,7 @@ static int parse_polygon(const char *str, harp_spherical_polygon **polygon)
     {
         harp_spherical_point point;
         const char *mark;
+        char *end;
         int length;
 
         while (*str != '\0' && isspace(*str))
@@ -242,7 +243,8 @@ static int parse_polygon(const char *str, harp_spherical_polygon **polygon)
         }
 
         length = (int)(str - mark);
-        if (harp_parse_double(mark, length, &point.lat, 0) != length || !harp_isfinite(point.lat))
+        point.lat = strtod(mark, &end);
+        if (length == 0 || end != &mark[length] || !harp_isfinite(point.lat))
         {
             harp_set_error(HARP_ERROR_INVALID_FORMAT, "invalid latitude '%.*s' (%s:%u)", length, mark, __FILE__,
                            __LINE__);
@@ -276,7 +278,8 @@ static int parse_polygon(const char *str, harp_spherical_polygon **polygon)
         }
 
         length = (int)(str - mark);
-        if (harp_parse_double(mark, length, &point.lon, 0) != length || !harp_isfinite(point.lon))
+        point.lon = strtod(mark, &end);
+        if (length == 0 || end != &mark[length] || !harp_isfinite(point.lon))
         {
             harp_set_error(HARP_ERROR_INVALID_FORMAT, "invalid longitude '%.*s' (%s:%u)", length, mark, __FILE__,
                            __LINE__);
@@ -341,28 +344,26 @@ static int parse_polygon(const char *str, harp_spherical_polygon **polygon)
     return 0;
 }
 
-static int read_area_mask(FILE *stream, harp_area_mask **new_area_mask)
+static int read_area_mask(harp_csv_reader *reader, harp_area_mask **new_area_mask)
 {
     harp_area_mask *area_mask;
-    char line[AREA_MASK_MAX_LINE_SIZE];
+    char *line;
     int read_header;
-    long i;
+    int result;
 
     if (harp_area_mask_new(&area_mask) != 0)
     {
         return -1;
     }
 
-    i = 1;
     read_header = 0;
-    while (fgets(line, AREA_MASK_MAX_LINE_SIZE, stream) != NULL)
+    while ((result = harp_csv_reader_read_line(reader, &line, NULL)) == 0)
     {
         harp_spherical_polygon *polygon;
 
         /* Skip blank lines. */
         if (is_blank_line(line))
         {
-            i++;
             continue;
         }
 
@@ -370,13 +371,12 @@ static int read_area_mask(FILE *stream, harp_area_mask **new_area_mask)
         if (!read_header)
         {
             read_header = 1;
-            i++;
             continue;
         }
 
         if (parse_polygon(line, &polygon) != 0)
         {
-            harp_add_error_message(" (line %lu)", i);
+            harp_add_error_message(" (line %ld)", harp_csv_reader_get_line_number(reader));
             harp_area_mask_delete(area_mask);
             return -1;
         }
@@ -387,13 +387,9 @@ static int read_area_mask(FILE *stream, harp_area_mask **new_area_mask)
             harp_area_mask_delete(area_mask);
             return -1;
         }
-
-        i++;
     }
-
-    if (ferror(stream) || !feof(stream))
+    if (result < 0)
     {
-        harp_set_error(HARP_ERROR_FILE_READ, "read error");
         harp_area_mask_delete(area_mask);
         return -1;
     }
@@ -404,7 +400,7 @@ static int read_area_mask(FILE *stream, harp_area_mask **new_area_mask)
 
 int harp_area_mask_read(const char *filename, harp_area_mask **new_area_mask)
 {
-    FILE *stream;
+    harp_csv_reader *reader;
     harp_area_mask *area_mask;
 
     if (filename == NULL)
@@ -413,21 +409,20 @@ int harp_area_mask_read(const char *filename, harp_area_mask **new_area_mask)
         return -1;
     }
 
-    stream = fopen(filename, "r");
-    if (stream == NULL)
+    if (harp_csv_reader_open(filename, &reader) != 0)
     {
         harp_set_error(HARP_ERROR_FILE_OPEN, "cannot open area mask file '%s'", filename);
         return -1;
     }
 
-    if (read_area_mask(stream, &area_mask) != 0)
+    if (read_area_mask(reader, &area_mask) != 0)
     {
         harp_add_error_message(" (while reading area mask file '%s')", filename);
-        fclose(stream);
+        harp_csv_reader_close(reader);
         return -1;
     }
 
-    fclose(stream);
+    harp_csv_reader_close(reader);
 
     *new_area_mask = area_mask;
     return 0;
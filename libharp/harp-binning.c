@@ -40,6 +40,7 @@
 
 #define MAX_NAME_LENGTH 128
 #define LATLON_BLOCK_SIZE 1024
+#define BIN_HASH_TABLE_INITIAL_SIZE 1024
 
 typedef enum binning_type_enum
 {
@@ -2752,6 +2753,288 @@ int harp_product_bin_full(harp_product *product)
     return 0;
 }
 
+/* Hash/equality callbacks used by group_samples() to compare the binning keys of two samples */
+typedef uint64_t (*sample_hash_function) (void *user_data, long index);
+typedef int (*sample_equal_function) (void *user_data, long index_a, long index_b);
+
+/* the finalizer of MurmurHash3 (spreads the entropy of a key over all bits) */
+static uint64_t hash_mix(uint64_t hash)
+{
+    hash ^= hash >> 33;
+    hash *= (uint64_t)0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= (uint64_t)0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+static uint64_t hash_combine(uint64_t hash, uint64_t value)
+{
+    return hash_mix(hash ^ (value + (uint64_t)0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2)));
+}
+
+/* values that compare equal should hash equal, so all NaN values hash the same and -0.0 hashes as 0.0 */
+static uint64_t hash_double(double value)
+{
+    uint64_t bits;
+
+    if (harp_isnan(value))
+    {
+        return (uint64_t)0x7ff8000000000000ULL;
+    }
+    if (value == 0)
+    {
+        return 0;
+    }
+    memcpy(&bits, &value, sizeof(bits));
+
+    return bits;
+}
+
+/* FNV-1a hash of a string (NULL strings get their own hash value) */
+static uint64_t hash_string(const char *value)
+{
+    uint64_t hash = (uint64_t)0xcbf29ce484222325ULL;
+
+    if (value == NULL)
+    {
+        return 1;
+    }
+    while (*value != '\0')
+    {
+        hash ^= (unsigned char)*value;
+        hash *= (uint64_t)0x100000001b3ULL;
+        value++;
+    }
+
+    return hash;
+}
+
+typedef struct variable_key_struct
+{
+    int num_variables;
+    harp_variable **variable;
+} variable_key;
+
+static uint64_t variable_key_hash(void *user_data, long index)
+{
+    variable_key *key = (variable_key *)user_data;
+    uint64_t hash = 0;
+    int k;
+
+    for (k = 0; k < key->num_variables; k++)
+    {
+        harp_variable *variable = key->variable[k];
+        uint64_t value_hash = 0;
+
+        switch (variable->data_type)
+        {
+            case harp_type_int8:
+                value_hash = (uint64_t)variable->data.int8_data[index];
+                break;
+            case harp_type_int16:
+                value_hash = (uint64_t)variable->data.int16_data[index];
+                break;
+            case harp_type_int32:
+                value_hash = (uint64_t)variable->data.int32_data[index];
+                break;
+            case harp_type_float:
+                value_hash = hash_double(variable->data.float_data[index]);
+                break;
+            case harp_type_double:
+                value_hash = hash_double(variable->data.double_data[index]);
+                break;
+            case harp_type_string:
+                value_hash = hash_string(variable->data.string_data[index]);
+                break;
+        }
+        hash = hash_combine(hash, value_hash);
+    }
+
+    return hash;
+}
+
+/* NaN values are considered equal to each other and a NULL string is only equal to another NULL string */
+static int variable_key_equal(void *user_data, long index_a, long index_b)
+{
+    variable_key *key = (variable_key *)user_data;
+    int k;
+
+    for (k = 0; k < key->num_variables; k++)
+    {
+        harp_variable *variable = key->variable[k];
+        int equal = 1;
+
+        switch (variable->data_type)
+        {
+            case harp_type_int8:
+                equal = variable->data.int8_data[index_a] == variable->data.int8_data[index_b];
+                break;
+            case harp_type_int16:
+                equal = variable->data.int16_data[index_a] == variable->data.int16_data[index_b];
+                break;
+            case harp_type_int32:
+                equal = variable->data.int32_data[index_a] == variable->data.int32_data[index_b];
+                break;
+            case harp_type_float:
+                if (harp_isnan(variable->data.float_data[index_b]))
+                {
+                    equal = harp_isnan(variable->data.float_data[index_a]);
+                }
+                else
+                {
+                    equal = variable->data.float_data[index_a] == variable->data.float_data[index_b];
+                }
+                break;
+            case harp_type_double:
+                if (harp_isnan(variable->data.double_data[index_b]))
+                {
+                    equal = harp_isnan(variable->data.double_data[index_a]);
+                }
+                else
+                {
+                    equal = variable->data.double_data[index_a] == variable->data.double_data[index_b];
+                }
+                break;
+            case harp_type_string:
+                if (variable->data.string_data[index_b] == NULL)
+                {
+                    equal = variable->data.string_data[index_a] == NULL;
+                }
+                else if (variable->data.string_data[index_a] == NULL)
+                {
+                    equal = 0;
+                }
+                else
+                {
+                    equal = strcmp(variable->data.string_data[index_a], variable->data.string_data[index_b]) == 0;
+                }
+                break;
+        }
+        if (!equal)
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+static uint64_t collocated_sample_hash(void *user_data, long index)
+{
+    harp_collocation_result *collocation_result = (harp_collocation_result *)user_data;
+
+    return hash_combine(hash_combine(0, (uint64_t)collocation_result->pair_data->product_index_b[index]),
+                        (uint64_t)collocation_result->pair_data->sample_index_b[index]);
+}
+
+static int collocated_sample_equal(void *user_data, long index_a, long index_b)
+{
+    harp_collocation_result *collocation_result = (harp_collocation_result *)user_data;
+
+    const harp_collocation_pair_data *pair_data = collocation_result->pair_data;
+
+    return pair_data->product_index_b[index_a] == pair_data->product_index_b[index_b] &&
+        pair_data->sample_index_b[index_a] == pair_data->sample_index_b[index_b];
+}
+
+/* Insert bin into an open addressing (linear probing) hash table of the given size (a power of two) */
+static void bin_hash_table_insert(long *table, long size, uint64_t hash, long bin)
+{
+    long position = (long)(hash & (uint64_t)(size - 1));
+
+    while (table[position] >= 0)
+    {
+        position = (position + 1) & (size - 1);
+    }
+    table[position] = bin;
+}
+
+/* Assign samples to bins such that all samples with an equal key end up in the same bin.
+ * Bins are numbered in order of first occurrence and index will receive the index of the first sample of each bin.
+ * Both index and bin_index should be able to hold num_elements values.
+ * A hash table (keyed on the hash of the key of the first sample of each bin) is used to find the bin of a sample, so
+ * the performance does not depend on the number of bins.
+ */
+static int group_samples(long num_elements, sample_hash_function hash_function, sample_equal_function equal_function,
+                         void *user_data, long *index, long *bin_index, long *num_bins)
+{
+    long *table;
+    long size = BIN_HASH_TABLE_INITIAL_SIZE;
+    long num_groups = 0;
+    long i, j;
+
+    table = malloc(size * sizeof(long));
+    if (table == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       size * sizeof(long), __FILE__, __LINE__);
+        return -1;
+    }
+    for (j = 0; j < size; j++)
+    {
+        table[j] = -1;
+    }
+
+    for (i = 0; i < num_elements; i++)
+    {
+        uint64_t hash = hash_function(user_data, i);
+        long position = (long)(hash & (uint64_t)(size - 1));
+
+        while (table[position] >= 0)
+        {
+            if (equal_function(user_data, index[table[position]], i))
+            {
+                break;
+            }
+            position = (position + 1) & (size - 1);
+        }
+        if (table[position] >= 0)
+        {
+            bin_index[i] = table[position];
+            continue;
+        }
+
+        /* add new bin */
+        index[num_groups] = i;
+        bin_index[i] = num_groups;
+        table[position] = num_groups;
+        num_groups++;
+
+        /* keep the load factor of the hash table below 1/2 */
+        if (2 * num_groups > size)
+        {
+            long *new_table;
+
+            new_table = malloc(2 * size * sizeof(long));
+            if (new_table == NULL)
+            {
+                harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                               2 * size * sizeof(long), __FILE__, __LINE__);
+                free(table);
+                return -1;
+            }
+            free(table);
+            table = new_table;
+            size *= 2;
+            for (j = 0; j < size; j++)
+            {
+                table[j] = -1;
+            }
+            for (j = 0; j < num_groups; j++)
+            {
+                bin_hash_table_insert(table, size, hash_function(user_data, index[j]), j);
+            }
+        }
+    }
+
+    free(table);
+
+    *num_bins = num_groups;
+    return 0;
+}
+
 /** Bin the product's variables (from dataset a in the collocation result) such that all pairs that have the same
  * item in dataset b are averaged together.
  *
@@ -2769,7 +3052,6 @@ int harp_product_bin_with_collocated_dataset(harp_product *product, harp_colloca
     long *index;        /* contains index of first sample for each bin */
     long *bin_index;
     long num_bins;
-    long i, j;
 
     /* Get the source product's collocation index variable */
     if (harp_product_get_variable_by_name(product, "collocation_index", &collocation_index) != 0)
@@ -2816,26 +3098,13 @@ int harp_product_bin_with_collocated_dataset(harp_product *product, harp_colloca
         return -1;
     }
 
-    num_bins = 0;
-    for (i = 0; i < collocation_index->num_elements; i++)
+    if (group_samples(collocation_index->num_elements, collocated_sample_hash, collocated_sample_equal,
+                      filtered_collocation_result, index, bin_index, &num_bins) != 0)
     {
-        for (j = 0; j < num_bins; j++)
-        {
-            if (filtered_collocation_result->pair[index[j]]->product_index_b ==
-                filtered_collocation_result->pair[i]->product_index_b &&
-                filtered_collocation_result->pair[index[j]]->sample_index_b ==
-                filtered_collocation_result->pair[i]->sample_index_b)
-            {
-                break;
-            }
-        }
-        if (j == num_bins)
-        {
-            /* add new value to bin */
-            index[num_bins] = i;
-            num_bins++;
-        }
-        bin_index[i] = j;
+        harp_collocation_result_shallow_delete(filtered_collocation_result);
+        free(bin_index);
+        free(index);
+        return -1;
     }
 
     if (harp_product_detach_variable(product, collocation_index) != 0)
@@ -2893,12 +3162,12 @@ int harp_product_bin_with_variable(harp_product *product, int num_variables, con
 {
     harp_variable **variable = NULL;
     harp_variable **variable_copy = NULL;
-    int *check_nan = NULL;
+    variable_key key;
     long *index = NULL; /* contains index of first sample for each bin */
     long *bin_index = NULL;
     long num_elements;
     long num_bins;
-    long i, j, k;
+    long k;
 
     if (num_variables < 1)
     {
@@ -2957,105 +3226,13 @@ int harp_product_bin_with_variable(harp_product *product, int num_variables, con
         goto error;
     }
 
-    check_nan = malloc(num_variables * sizeof(int));
-    if (check_nan == NULL)
+    key.num_variables = num_variables;
+    key.variable = variable;
+    if (group_samples(num_elements, variable_key_hash, variable_key_equal, &key, index, bin_index, &num_bins) != 0)
     {
-        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
-                       num_variables * sizeof(int), __FILE__, __LINE__);
         goto error;
     }
 
-    num_bins = 0;
-    for (i = 0; i < num_elements; i++)
-    {
-        for (k = 0; k < num_variables; k++)
-        {
-            check_nan[k] = 0;
-            if (variable[k]->data_type == harp_type_float)
-            {
-                check_nan[k] = harp_isnan(variable[k]->data.float_data[i]);
-            }
-            else if (variable[k]->data_type == harp_type_double)
-            {
-                check_nan[k] = harp_isnan(variable[k]->data.double_data[i]);
-            }
-        }
-        for (j = 0; j < num_bins; j++)
-        {
-            for (k = 0; k < num_variables; k++)
-            {
-                int equal = 1;
-
-                switch (variable[k]->data_type)
-                {
-                    case harp_type_int8:
-                        equal = variable[k]->data.int8_data[index[j]] == variable[k]->data.int8_data[i];
-                        break;
-                    case harp_type_int16:
-                        equal = variable[k]->data.int16_data[index[j]] == variable[k]->data.int16_data[i];
-                        break;
-                    case harp_type_int32:
-                        equal = variable[k]->data.int32_data[index[j]] == variable[k]->data.int32_data[i];
-                        break;
-                    case harp_type_float:
-                        if (check_nan)
-                        {
-                            equal = harp_isnan(variable[k]->data.float_data[index[j]]);
-                        }
-                        else
-                        {
-                            equal = variable[k]->data.float_data[index[j]] == variable[k]->data.float_data[i];
-                        }
-                        break;
-                    case harp_type_double:
-                        if (check_nan)
-                        {
-                            equal = harp_isnan(variable[k]->data.double_data[index[j]]);
-                        }
-                        else
-                        {
-                            equal = variable[k]->data.double_data[index[j]] == variable[k]->data.double_data[i];
-                        }
-                        break;
-                    case harp_type_string:
-                        if (variable[k]->data.string_data[i] == NULL)
-                        {
-                            equal = variable[k]->data.string_data[index[j]] == NULL;
-                        }
-                        else if (variable[k]->data.string_data[index[j]] == NULL)
-                        {
-                            equal = 0;
-                        }
-                        else
-                        {
-                            equal = strcmp(variable[k]->data.string_data[index[j]],
-                                           variable[k]->data.string_data[i]) == 0;
-                        }
-                        break;
-                }
-                if (!equal)
-                {
-                    break;
-                }
-            }
-            if (k == num_variables)
-            {
-                /* equal bin */
-                break;
-            }
-        }
-        if (j == num_bins)
-        {
-            /* add new value to bin */
-            index[num_bins] = i;
-            num_bins++;
-        }
-        bin_index[i] = j;
-    }
-
-    free(check_nan);
-    check_nan = NULL;
-
     for (k = 0; k < num_variables; k++)
     {
         if (get_binning_type(variable[k]) == binning_remove)
@@ -3099,10 +3276,6 @@ int harp_product_bin_with_variable(harp_product *product, int num_variables, con
     return 0;
 
   error:
-    if (check_nan != NULL)
-    {
-        free(check_nan);
-    }
     if (index != NULL)
     {
         free(index);
@@ -49,71 +49,376 @@
  * Collocation results can be written to and read from a csv file.
  */
 
-static void collocation_pair_swap_datasets(harp_collocation_pair *pair)
+static int pair_data_new(harp_collocation_pair_data **new_pair_data)
 {
-    long index_a = pair->product_index_a;
-    long sample_a = pair->sample_index_a;
+    harp_collocation_pair_data *pair_data;
 
-    pair->product_index_a = pair->product_index_b;
-    pair->sample_index_a = pair->sample_index_b;
-    pair->product_index_b = index_a;
-    pair->sample_index_b = sample_a;
+    pair_data = (harp_collocation_pair_data *)malloc(sizeof(harp_collocation_pair_data));
+    if (pair_data == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       sizeof(harp_collocation_pair_data), __FILE__, __LINE__);
+        return -1;
+    }
+    pair_data->collocation_index = NULL;
+    pair_data->product_index_a = NULL;
+    pair_data->sample_index_a = NULL;
+    pair_data->product_index_b = NULL;
+    pair_data->sample_index_b = NULL;
+    pair_data->difference = NULL;
+
+    *new_pair_data = pair_data;
+
+    return 0;
 }
 
-static void collocation_pair_delete(harp_collocation_pair *pair)
+static void pair_data_delete(harp_collocation_pair_data *pair_data)
 {
-    if (pair != NULL)
+    if (pair_data->collocation_index != NULL)
+    {
+        free(pair_data->collocation_index);
+    }
+    if (pair_data->product_index_a != NULL)
+    {
+        free(pair_data->product_index_a);
+    }
+    if (pair_data->sample_index_a != NULL)
+    {
+        free(pair_data->sample_index_a);
+    }
+    if (pair_data->product_index_b != NULL)
+    {
+        free(pair_data->product_index_b);
+    }
+    if (pair_data->sample_index_b != NULL)
+    {
+        free(pair_data->sample_index_b);
+    }
+    if (pair_data->difference != NULL)
+    {
+        free(pair_data->difference);
+    }
+    free(pair_data);
+}
+
+/* The pair arrays of a collocation result are allocated in blocks of COLLOCATION_RESULT_BLOCK_SIZE pairs and the
+ * number of blocks is doubled each time the arrays are full. Since the arrays never shrink, the allocated size is
+ * always at least get_pair_capacity(num_pairs).
+ */
+static long get_pair_capacity(long num_pairs)
+{
+    long capacity = COLLOCATION_RESULT_BLOCK_SIZE;
+
+    while (capacity < num_pairs)
+    {
+        capacity *= 2;
+    }
+
+    return capacity;
+}
+
+static int resize_long_array(long **array, long num_elements)
+{
+    long *new_array;
+
+    new_array = realloc(*array, num_elements * sizeof(long));
+    if (new_array == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       num_elements * sizeof(long), __FILE__, __LINE__);
+        return -1;
+    }
+    *array = new_array;
+
+    return 0;
+}
+
+static int resize_pair_arrays(harp_collocation_result *collocation_result, long capacity)
+{
+    if (resize_long_array(&collocation_result->pair_data->collocation_index, capacity) != 0)
+    {
+        return -1;
+    }
+    if (resize_long_array(&collocation_result->pair_data->product_index_a, capacity) != 0)
+    {
+        return -1;
+    }
+    if (resize_long_array(&collocation_result->pair_data->sample_index_a, capacity) != 0)
+    {
+        return -1;
+    }
+    if (resize_long_array(&collocation_result->pair_data->product_index_b, capacity) != 0)
+    {
+        return -1;
+    }
+    if (resize_long_array(&collocation_result->pair_data->sample_index_b, capacity) != 0)
+    {
+        return -1;
+    }
+    if (collocation_result->num_differences > 0)
     {
-        if (pair->difference != NULL)
+        double *new_difference;
+
+        new_difference = realloc(collocation_result->pair_data->difference,
+                                 capacity * collocation_result->num_differences * sizeof(double));
+        if (new_difference == NULL)
         {
-            free(pair->difference);
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                           capacity * collocation_result->num_differences * sizeof(double), __FILE__, __LINE__);
+            return -1;
         }
+        collocation_result->pair_data->difference = new_difference;
+    }
 
-        free(pair);
+    return 0;
+}
+
+static void copy_pair(harp_collocation_result *collocation_result, long target_index, long source_index)
+{
+    harp_collocation_pair_data *pair_data = collocation_result->pair_data;
+    int num_differences = collocation_result->num_differences;
+
+    pair_data->collocation_index[target_index] = pair_data->collocation_index[source_index];
+    pair_data->product_index_a[target_index] = pair_data->product_index_a[source_index];
+    pair_data->sample_index_a[target_index] = pair_data->sample_index_a[source_index];
+    pair_data->product_index_b[target_index] = pair_data->product_index_b[source_index];
+    pair_data->sample_index_b[target_index] = pair_data->sample_index_b[source_index];
+    if (num_differences > 0)
+    {
+        memmove(&pair_data->difference[target_index * num_differences],
+                &pair_data->difference[source_index * num_differences], num_differences * sizeof(double));
     }
 }
 
-static int collocation_pair_new(long collocation_index, long product_index_a, long sample_index_a, long product_index_b,
-                                long sample_index_b, int num_differences, const double *difference,
-                                harp_collocation_pair **new_pair)
+static void gather_long_array(long *array, long num_elements, const long *permutation, long *buffer)
 {
-    harp_collocation_pair *pair;
-    int i;
+    long i;
 
-    pair = (harp_collocation_pair *)malloc(sizeof(harp_collocation_pair));
-    if (pair == NULL)
+    for (i = 0; i < num_elements; i++)
+    {
+        buffer[i] = array[permutation[i]];
+    }
+    memcpy(array, buffer, num_elements * sizeof(long));
+}
+
+/* Reorder the pairs such that the pair at index i becomes the pair that was at index permutation[i].
+ * Only the first num_pairs pairs are retained (num_pairs should not exceed the current number of pairs and the
+ * permutation should not contain duplicates).
+ */
+static int apply_permutation(harp_collocation_result *collocation_result, long num_pairs, const long *permutation)
+{
+    int num_differences = collocation_result->num_differences;
+    double *difference = NULL;
+    long *buffer;
+    long i;
+
+    if (num_pairs == 0)
+    {
+        collocation_result->num_pairs = 0;
+        return 0;
+    }
+
+    buffer = malloc(num_pairs * sizeof(long));
+    if (buffer == NULL)
     {
         harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
-                       sizeof(harp_collocation_pair), __FILE__, __LINE__);
+                       num_pairs * sizeof(long), __FILE__, __LINE__);
         return -1;
     }
+    if (num_differences > 0)
+    {
+        difference = malloc(num_pairs * num_differences * sizeof(double));
+        if (difference == NULL)
+        {
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                           num_pairs * num_differences * sizeof(double), __FILE__, __LINE__);
+            free(buffer);
+            return -1;
+        }
+    }
+
+    gather_long_array(collocation_result->pair_data->collocation_index, num_pairs, permutation, buffer);
+    gather_long_array(collocation_result->pair_data->product_index_a, num_pairs, permutation, buffer);
+    gather_long_array(collocation_result->pair_data->sample_index_a, num_pairs, permutation, buffer);
+    gather_long_array(collocation_result->pair_data->product_index_b, num_pairs, permutation, buffer);
+    gather_long_array(collocation_result->pair_data->sample_index_b, num_pairs, permutation, buffer);
+    free(buffer);
+
+    if (difference != NULL)
+    {
+        for (i = 0; i < num_pairs; i++)
+        {
+            memcpy(&difference[i * num_differences],
+                   &collocation_result->pair_data->difference[permutation[i] * num_differences],
+                   num_differences * sizeof(double));
+        }
+        memcpy(collocation_result->pair_data->difference, difference, num_pairs * num_differences * sizeof(double));
+        free(difference);
+    }
 
-    pair->collocation_index = collocation_index;
+    collocation_result->num_pairs = num_pairs;
 
-    pair->product_index_a = product_index_a;
-    pair->sample_index_a = sample_index_a;
+    return 0;
+}
 
-    pair->product_index_b = product_index_b;
-    pair->sample_index_b = sample_index_b;
+/* Stable LSD radix sort (8 bits per pass) of the permutation such that key[permutation[i]] becomes non-decreasing.
+ * Only as many passes are performed as are needed to cover the range of the key values.
+ * The buffer should be able to hold num_elements values.
+ */
+static void radix_sort_permutation(long num_elements, const long *key, long *permutation, long *buffer)
+{
+    long *source = permutation;
+    long *target = buffer;
+    unsigned long range;
+    long min_key;
+    long max_key;
+    long count[256];
+    int shift;
+    long i;
 
-    pair->num_differences = num_differences;
-    pair->difference = NULL;
+    if (num_elements < 2)
+    {
+        return;
+    }
+
+    min_key = key[0];
+    max_key = key[0];
+    for (i = 1; i < num_elements; i++)
+    {
+        if (key[i] < min_key)
+        {
+            min_key = key[i];
+        }
+        else if (key[i] > max_key)
+        {
+            max_key = key[i];
+        }
+    }
+    range = (unsigned long)max_key - (unsigned long)min_key;
+
+    for (shift = 0; shift < (int)(8 * sizeof(long)) && (range >> shift) != 0; shift += 8)
+    {
+        long offset = 0;
+        long *swap;
+        int digit;
+
+        memset(count, 0, sizeof(count));
+        for (i = 0; i < num_elements; i++)
+        {
+            count[(((unsigned long)key[source[i]] - (unsigned long)min_key) >> shift) & 0xff]++;
+        }
+        for (digit = 0; digit < 256; digit++)
+        {
+            long digit_count = count[digit];
+
+            count[digit] = offset;
+            offset += digit_count;
+        }
+        for (i = 0; i < num_elements; i++)
+        {
+            target[count[(((unsigned long)key[source[i]] - (unsigned long)min_key) >> shift) & 0xff]++] = source[i];
+        }
+
+        swap = source;
+        source = target;
+        target = swap;
+    }
+
+    if (source != permutation)
+    {
+        memcpy(permutation, source, num_elements * sizeof(long));
+    }
+}
+
+/* Sort the pairs on a list of keys (ordered from most significant to least significant).
+ * Each key is an array with one value per pair.
+ */
+static int sort_pairs(harp_collocation_result *collocation_result, int num_keys, const long **key)
+{
+    long *permutation;
+    long *buffer;
+    long i;
+    int k;
+
+    if (collocation_result->num_pairs < 2)
+    {
+        return 0;
+    }
+
+    permutation = malloc(collocation_result->num_pairs * sizeof(long));
+    if (permutation == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       collocation_result->num_pairs * sizeof(long), __FILE__, __LINE__);
+        return -1;
+    }
+    buffer = malloc(collocation_result->num_pairs * sizeof(long));
+    if (buffer == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       collocation_result->num_pairs * sizeof(long), __FILE__, __LINE__);
+        free(permutation);
+        return -1;
+    }
+
+    for (i = 0; i < collocation_result->num_pairs; i++)
+    {
+        permutation[i] = i;
+    }
+    for (k = num_keys - 1; k >= 0; k--)
+    {
+        radix_sort_permutation(collocation_result->num_pairs, key[k], permutation, buffer);
+    }
+    free(buffer);
+
+    if (apply_permutation(collocation_result, collocation_result->num_pairs, permutation) != 0)
+    {
+        free(permutation);
+        return -1;
+    }
+    free(permutation);
+
+    return 0;
+}
 
-    pair->difference = malloc(num_differences * sizeof(double));
-    if (pair->difference == NULL)
+/* Determine for each pair the position of the source product name of the referenced product in the alphabetically
+ * sorted list of source products of the dataset. This allows pairs to be sorted on source product name using integer
+ * keys.
+ */
+static int get_source_product_rank(const harp_dataset *dataset, long num_pairs, const long *product_index,
+                                   long **new_rank)
+{
+    long *product_rank;
+    long *rank;
+    long i;
+
+    product_rank = malloc((dataset->num_products > 0 ? dataset->num_products : 1) * sizeof(long));
+    if (product_rank == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       dataset->num_products * sizeof(long), __FILE__, __LINE__);
+        return -1;
+    }
+    rank = malloc(num_pairs * sizeof(long));
+    if (rank == NULL)
     {
         harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
-                       sizeof(harp_collocation_pair), __FILE__, __LINE__);
-        collocation_pair_delete(pair);
+                       num_pairs * sizeof(long), __FILE__, __LINE__);
+        free(product_rank);
         return -1;
     }
 
-    for (i = 0; i < num_differences; i++)
+    for (i = 0; i < dataset->num_products; i++)
     {
-        pair->difference[i] = difference[i];
+        product_rank[dataset->sorted_index[i]] = i;
     }
+    for (i = 0; i < num_pairs; i++)
+    {
+        rank[i] = product_rank[product_index[i]];
+    }
+    free(product_rank);
 
-    *new_pair = pair;
+    *new_rank = rank;
     return 0;
 }
 
@@ -151,8 +456,13 @@ LIBHARP_API int harp_collocation_result_new(harp_collocation_result **new_colloc
     collocation_result->difference_variable_name = NULL;
     collocation_result->difference_unit = NULL;
     collocation_result->num_pairs = 0;
-    collocation_result->pair = NULL;
+    collocation_result->pair_data = NULL;
 
+    if (pair_data_new(&collocation_result->pair_data) != 0)
+    {
+        harp_collocation_result_delete(collocation_result);
+        return -1;
+    }
     if (harp_dataset_new(&collocation_result->dataset_a) != 0)
     {
         harp_collocation_result_delete(collocation_result);
@@ -272,15 +582,9 @@ LIBHARP_API void harp_collocation_result_delete(harp_collocation_result *colloca
         free(collocation_result->difference_unit);
     }
 
-    if (collocation_result->pair)
+    if (collocation_result->pair_data != NULL)
     {
-        long i;
-
-        for (i = 0; i < collocation_result->num_pairs; i++)
-        {
-            collocation_pair_delete(collocation_result->pair[i]);
-        }
-        free(collocation_result->pair);
+        pair_data_delete(collocation_result->pair_data);
     }
 
     free(collocation_result);
@@ -296,6 +600,14 @@ int harp_collocation_result_add_difference(harp_collocation_result *collocation_
     char **new_string_array;
     int index;
 
+    if (collocation_result->num_pairs > 0)
+    {
+        /* the difference array is laid out per pair, so the number of differences can not change anymore */
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "cannot add a difference to a collocation result that already "
+                       "contains pairs (%s:%u)", __FILE__, __LINE__);
+        return -1;
+    }
+
     new_string_array = realloc(collocation_result->difference_variable_name,
                                (collocation_result->num_differences + 1) * sizeof(char *));
     if (new_string_array == NULL)
@@ -339,136 +651,94 @@ int harp_collocation_result_add_difference(harp_collocation_result *collocation_
     return 0;
 }
 
-static harp_dataset *sort_dataset_a = NULL;
-static harp_dataset *sort_dataset_b = NULL;
+/** \addtogroup harp_collocation
+ * @{
+ */
 
-static int compare_by_a(const void *a, const void *b)
+/** Sort the collocation result pairs by dataset A
+ * Results will be sorted first by product index of A and then by sample index of A
+ * \param collocation_result Result set that will be sorted in place.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_collocation_result_sort_by_a(harp_collocation_result *collocation_result)
 {
-    harp_collocation_pair *pair_a = *(harp_collocation_pair **)a;
-    harp_collocation_pair *pair_b = *(harp_collocation_pair **)b;
+    const long *key[4];
+    long *rank_a;
+    long *rank_b;
+    int result;
 
-    if (pair_a->product_index_a != pair_b->product_index_a)
+    if (collocation_result->num_pairs < 2)
     {
-        return strcmp(sort_dataset_a->source_product[pair_a->product_index_a],
-                      sort_dataset_a->source_product[pair_b->product_index_a]);
+        return 0;
     }
-    if (pair_a->sample_index_a < pair_b->sample_index_a)
+    if (get_source_product_rank(collocation_result->dataset_a, collocation_result->num_pairs,
+                                collocation_result->pair_data->product_index_a, &rank_a) != 0)
     {
         return -1;
     }
-    if (pair_a->sample_index_a > pair_b->sample_index_a)
+    if (get_source_product_rank(collocation_result->dataset_b, collocation_result->num_pairs,
+                                collocation_result->pair_data->product_index_b, &rank_b) != 0)
     {
-        return 1;
+        free(rank_a);
+        return -1;
     }
 
     /* If a is equal, then further sort by b to get a fixed ordering. */
-    if (pair_a->product_index_b != pair_b->product_index_b)
-    {
-        return strcmp(sort_dataset_b->source_product[pair_a->product_index_b],
-                      sort_dataset_b->source_product[pair_b->product_index_b]);
-    }
-    if (pair_a->sample_index_b < pair_b->sample_index_b)
-    {
-        return -1;
-    }
-    if (pair_a->sample_index_b > pair_b->sample_index_b)
-    {
-        return 1;
-    }
+    key[0] = rank_a;
+    key[1] = collocation_result->pair_data->sample_index_a;
+    key[2] = rank_b;
+    key[3] = collocation_result->pair_data->sample_index_b;
+    result = sort_pairs(collocation_result, 4, key);
 
-    return 0;
+    free(rank_b);
+    free(rank_a);
+
+    return result;
 }
 
-static int compare_by_b(const void *a, const void *b)
+/** Sort the collocation result pairs by dataset B
+ * Results will be sorted first by product index of B and then by sample index of B
+ * \param collocation_result Result set that will be sorted in place.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_collocation_result_sort_by_b(harp_collocation_result *collocation_result)
 {
-    harp_collocation_pair *pair_a = *(harp_collocation_pair **)a;
-    harp_collocation_pair *pair_b = *(harp_collocation_pair **)b;
+    const long *key[4];
+    long *rank_a;
+    long *rank_b;
+    int result;
 
-    if (pair_a->product_index_b != pair_b->product_index_b)
+    if (collocation_result->num_pairs < 2)
     {
-        return strcmp(sort_dataset_b->source_product[pair_a->product_index_b],
-                      sort_dataset_b->source_product[pair_b->product_index_b]);
+        return 0;
     }
-    if (pair_a->sample_index_b < pair_b->sample_index_b)
+    if (get_source_product_rank(collocation_result->dataset_a, collocation_result->num_pairs,
+                                collocation_result->pair_data->product_index_a, &rank_a) != 0)
     {
         return -1;
     }
-    if (pair_a->sample_index_b > pair_b->sample_index_b)
-    {
-        return 1;
-    }
-
-    /* If b is equal, then further sort by a to get a fixed ordering. */
-    if (pair_a->product_index_a != pair_b->product_index_a)
-    {
-        return strcmp(sort_dataset_a->source_product[pair_a->product_index_b],
-                      sort_dataset_a->source_product[pair_b->product_index_b]);
-    }
-    if (pair_a->sample_index_a < pair_b->sample_index_a)
+    if (get_source_product_rank(collocation_result->dataset_b, collocation_result->num_pairs,
+                                collocation_result->pair_data->product_index_b, &rank_b) != 0)
     {
+        free(rank_a);
         return -1;
     }
-    if (pair_a->sample_index_a > pair_b->sample_index_a)
-    {
-        return 1;
-    }
 
-    return 0;
-}
+    /* If b is equal, then further sort by a to get a fixed ordering. */
+    key[0] = rank_b;
+    key[1] = collocation_result->pair_data->sample_index_b;
+    key[2] = rank_a;
+    key[3] = collocation_result->pair_data->sample_index_a;
+    result = sort_pairs(collocation_result, 4, key);
 
-static int compare_by_collocation_index(const void *a, const void *b)
-{
-    harp_collocation_pair *pair_a = *(harp_collocation_pair **)a;
-    harp_collocation_pair *pair_b = *(harp_collocation_pair **)b;
+    free(rank_b);
+    free(rank_a);
 
-    if (pair_a->collocation_index < pair_b->collocation_index)
-    {
-        return -1;
-    }
-    if (pair_a->collocation_index > pair_b->collocation_index)
-    {
-        return 1;
-    }
-
-    return 0;
-}
-
-/** \addtogroup harp_collocation
- * @{
- */
-
-/** Sort the collocation result pairs by dataset A
- * Results will be sorted first by product index of A and then by sample index of A
- * \param collocation_result Result set that will be sorted in place.
- * \return
- *   \arg \c 0, Success.
- *   \arg \c -1, Error occurred (check #harp_errno).
- */
-LIBHARP_API int harp_collocation_result_sort_by_a(harp_collocation_result *collocation_result)
-{
-    sort_dataset_a = collocation_result->dataset_a;
-    sort_dataset_b = collocation_result->dataset_b;
-    qsort(collocation_result->pair, collocation_result->num_pairs, sizeof(harp_collocation_pair *), compare_by_a);
-    sort_dataset_a = NULL;
-    sort_dataset_b = NULL;
-    return 0;
-}
-
-/** Sort the collocation result pairs by dataset B
- * Results will be sorted first by product index of B and then by sample index of B
- * \param collocation_result Result set that will be sorted in place.
- * \return
- *   \arg \c 0, Success.
- *   \arg \c -1, Error occurred (check #harp_errno).
- */
-LIBHARP_API int harp_collocation_result_sort_by_b(harp_collocation_result *collocation_result)
-{
-    sort_dataset_a = collocation_result->dataset_a;
-    sort_dataset_b = collocation_result->dataset_b;
-    qsort(collocation_result->pair, collocation_result->num_pairs, sizeof(harp_collocation_pair *), compare_by_b);
-    sort_dataset_a = NULL;
-    sort_dataset_b = NULL;
-    return 0;
+    return result;
 }
 
 /** Sort the collocation result pairs by collocation index
@@ -479,9 +749,25 @@ LIBHARP_API int harp_collocation_result_sort_by_b(harp_collocation_result *collo
  */
 LIBHARP_API int harp_collocation_result_sort_by_collocation_index(harp_collocation_result *collocation_result)
 {
-    qsort(collocation_result->pair, collocation_result->num_pairs, sizeof(harp_collocation_pair *),
-          compare_by_collocation_index);
-    return 0;
+    const long *key[1];
+    long i;
+
+    /* collocation results are usually already sorted by collocation index */
+    for (i = 1; i < collocation_result->num_pairs; i++)
+    {
+        if (collocation_result->pair_data->collocation_index[i] <
+            collocation_result->pair_data->collocation_index[i - 1])
+        {
+            break;
+        }
+    }
+    if (i >= collocation_result->num_pairs)
+    {
+        return 0;
+    }
+
+    key[0] = collocation_result->pair_data->collocation_index;
+    return sort_pairs(collocation_result, 1, key);
 }
 
 /** Filter collocation result set for a specific product from dataset A
@@ -496,24 +782,25 @@ LIBHARP_API int harp_collocation_result_filter_for_source_product_a(harp_colloca
                                                                     const char *source_product)
 {
     long product_index;
-    long i, j;
+    long num_pairs = 0;
+    long i;
 
     if (harp_dataset_get_index_from_source_product(collocation_result->dataset_a, source_product, &product_index) != 0)
     {
         return -1;
     }
-    for (i = collocation_result->num_pairs - 1; i >= 0; i--)
+    for (i = 0; i < collocation_result->num_pairs; i++)
     {
-        if (collocation_result->pair[i]->product_index_a != product_index)
+        if (collocation_result->pair_data->product_index_a[i] == product_index)
         {
-            collocation_pair_delete(collocation_result->pair[i]);
-            for (j = i + 1; j < collocation_result->num_pairs; j++)
+            if (num_pairs != i)
             {
-                collocation_result->pair[j - 1] = collocation_result->pair[j];
+                copy_pair(collocation_result, num_pairs, i);
             }
-            collocation_result->num_pairs--;
+            num_pairs++;
         }
     }
+    collocation_result->num_pairs = num_pairs;
     return 0;
 }
 
@@ -529,24 +816,25 @@ LIBHARP_API int harp_collocation_result_filter_for_source_product_b(harp_colloca
                                                                     const char *source_product)
 {
     long product_index;
-    long i, j;
+    long num_pairs = 0;
+    long i;
 
     if (harp_dataset_get_index_from_source_product(collocation_result->dataset_b, source_product, &product_index) != 0)
     {
         return -1;
     }
-    for (i = collocation_result->num_pairs - 1; i >= 0; i--)
+    for (i = 0; i < collocation_result->num_pairs; i++)
     {
-        if (collocation_result->pair[i]->product_index_b != product_index)
+        if (collocation_result->pair_data->product_index_b[i] == product_index)
         {
-            collocation_pair_delete(collocation_result->pair[i]);
-            for (j = i + 1; j < collocation_result->num_pairs; j++)
+            if (num_pairs != i)
             {
-                collocation_result->pair[j - 1] = collocation_result->pair[j];
+                copy_pair(collocation_result, num_pairs, i);
             }
-            collocation_result->num_pairs--;
+            num_pairs++;
         }
     }
+    collocation_result->num_pairs = num_pairs;
     return 0;
 }
 
@@ -570,14 +858,14 @@ static int find_collocation_pair_for_collocation_index(harp_collocation_result *
         long pivot_index = lower_index + ((upper_index - lower_index) / 2);
 
         /* If the pivot equals the key, terminate early. */
-        if (collocation_result->pair[pivot_index]->collocation_index == collocation_index)
+        if (collocation_result->pair_data->collocation_index[pivot_index] == collocation_index)
         {
             *index = pivot_index;
             return 0;
         }
 
         /* If the pivot is smaller than the key, search the upper sub array, otherwise search the lower sub array. */
-        if (collocation_result->pair[pivot_index]->collocation_index < collocation_index)
+        if (collocation_result->pair_data->collocation_index[pivot_index] < collocation_index)
         {
             lower_index = pivot_index + 1;
         }
@@ -587,7 +875,7 @@ static int find_collocation_pair_for_collocation_index(harp_collocation_result *
         }
     }
 
-    harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "cannot find collocation index %d in collocation results",
+    harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "cannot find collocation index %ld in collocation results",
                    collocation_index);
     return -1;
 }
@@ -609,8 +897,8 @@ static int find_collocation_pair_for_collocation_index(harp_collocation_result *
 LIBHARP_API int harp_collocation_result_filter_for_collocation_indices(harp_collocation_result *collocation_result,
                                                                        long num_indices, int32_t *collocation_index)
 {
-    harp_collocation_pair **pair = NULL;
-    long num_pairs = 0;
+    long *permutation = NULL;
+    uint8_t *used = NULL;
     long i;
 
     if (harp_collocation_result_sort_by_collocation_index(collocation_result) != 0)
@@ -618,49 +906,75 @@ LIBHARP_API int harp_collocation_result_filter_for_collocation_indices(harp_coll
         return -1;
     }
 
-    /* create a temporary array to store all pairs */
-    pair = malloc(collocation_result->num_pairs * sizeof(harp_collocation_pair *));
-    if (!pair)
+    if (num_indices > 0)
     {
-        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
-                       collocation_result->num_pairs * sizeof(harp_collocation_pair *), __FILE__, __LINE__);
-        return -1;
+        permutation = malloc(num_indices * sizeof(long));
+        if (permutation == NULL)
+        {
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                           num_indices * sizeof(long), __FILE__, __LINE__);
+            return -1;
+        }
+    }
+    if (collocation_result->num_pairs > 0)
+    {
+        /* keeps track of the pairs that have already been selected */
+        used = calloc(collocation_result->num_pairs, sizeof(uint8_t));
+        if (used == NULL)
+        {
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                           collocation_result->num_pairs * sizeof(uint8_t), __FILE__, __LINE__);
+            if (permutation != NULL)
+            {
+                free(permutation);
+            }
+            return -1;
+        }
     }
 
     for (i = 0; i < num_indices; i++)
     {
         long index;
-        long j;
 
         if (find_collocation_pair_for_collocation_index(collocation_result, collocation_index[i], &index) != 0)
         {
             goto error;
         }
-        pair[num_pairs] = collocation_result->pair[index];
-        num_pairs++;
-        for (j = index + 1; j < collocation_result->num_pairs; j++)
+        if (used[index])
         {
-            collocation_result->pair[j - 1] = collocation_result->pair[j];
+            harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "cannot find collocation index %ld in collocation results",
+                           (long)collocation_index[i]);
+            goto error;
         }
-        collocation_result->num_pairs--;
+        used[index] = 1;
+        permutation[i] = index;
     }
 
-    for (i = 0; i < collocation_result->num_pairs; i++)
+    if (apply_permutation(collocation_result, num_indices, permutation) != 0)
     {
-        collocation_pair_delete(collocation_result->pair[i]);
+        goto error;
+    }
+
+    if (used != NULL)
+    {
+        free(used);
+    }
+    if (permutation != NULL)
+    {
+        free(permutation);
     }
-    free(collocation_result->pair);
-    collocation_result->pair = pair;
-    collocation_result->num_pairs = num_pairs;
 
     return 0;
 
   error:
-    for (i = 0; i < num_pairs; i++)
+    if (used != NULL)
+    {
+        free(used);
+    }
+    if (permutation != NULL)
     {
-        collocation_pair_delete(pair[i]);
+        free(permutation);
     }
-    free(pair);
 
     return -1;
 }
@@ -685,8 +999,8 @@ LIBHARP_API int harp_collocation_result_add_pair(harp_collocation_result *colloc
                                                  const char *source_product_b, long index_b, int num_differences,
                                                  const double *difference)
 {
-    harp_collocation_pair *pair;
     long product_index_a, product_index_b;
+    long index;
 
     if (num_differences != collocation_result->num_differences)
     {
@@ -716,32 +1030,29 @@ LIBHARP_API int harp_collocation_result_add_pair(harp_collocation_result *colloc
     {
         return -1;
     }
-    if (collocation_pair_new(collocation_index, product_index_a, index_a, product_index_b, index_b, num_differences,
-                             difference, &pair) != 0)
-    {
-        return -1;
-    }
 
-    if (collocation_result->num_pairs % COLLOCATION_RESULT_BLOCK_SIZE == 0)
+    if (collocation_result->pair_data->collocation_index == NULL ||
+        collocation_result->num_pairs == get_pair_capacity(collocation_result->num_pairs))
     {
-        harp_collocation_pair **new_pair = NULL;
-
-        new_pair = realloc(collocation_result->pair, (collocation_result->num_pairs + COLLOCATION_RESULT_BLOCK_SIZE) *
-                           sizeof(harp_collocation_pair *));
-        if (new_pair == NULL)
+        if (resize_pair_arrays(collocation_result, get_pair_capacity(collocation_result->num_pairs + 1)) != 0)
         {
-            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
-                           (long)(collocation_result->num_pairs + COLLOCATION_RESULT_BLOCK_SIZE) *
-                           sizeof(harp_collocation_pair *), __FILE__, __LINE__);
-            collocation_pair_delete(pair);
             return -1;
         }
-
-        collocation_result->pair = new_pair;
     }
 
-    collocation_result->pair[collocation_result->num_pairs] = pair;
+    index = collocation_result->num_pairs;
+    collocation_result->pair_data->collocation_index[index] = collocation_index;
+    collocation_result->pair_data->product_index_a[index] = product_index_a;
+    collocation_result->pair_data->sample_index_a[index] = index_a;
+    collocation_result->pair_data->product_index_b[index] = product_index_b;
+    collocation_result->pair_data->sample_index_b[index] = index_b;
+    if (num_differences > 0)
+    {
+        memcpy(&collocation_result->pair_data->difference[index * num_differences], difference,
+               num_differences * sizeof(double));
+    }
     collocation_result->num_pairs++;
+
     return 0;
 }
 
@@ -763,42 +1074,94 @@ LIBHARP_API int harp_collocation_result_remove_pair_at_index(harp_collocation_re
         return -1;
     }
 
-    collocation_pair_delete(collocation_result->pair[index]);
     for (i = index + 1; i < collocation_result->num_pairs; i++)
     {
-        collocation_result->pair[i - 1] = collocation_result->pair[i];
+        copy_pair(collocation_result, i - 1, i);
     }
     collocation_result->num_pairs--;
 
     return 0;
 }
 
-/**
- * @}
+/** Retrieve a collocation result entry from a result set
+ * The difference array of the returned pair points into the collocation result set and remains valid only as long as
+ * the collocation result set is not modified.
+ * \param collocation_result Result set from which to retrieve the entry
+ * \param index Zero-based index in the collocation result set of the entry that should be retrieved
+ * \param pair Pointer to the C variable where the pair will be stored.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
  */
-
-static int read_header(FILE *file, harp_collocation_result *collocation_result)
+LIBHARP_API int harp_collocation_result_get_pair(const harp_collocation_result *collocation_result, long index,
+                                                 harp_collocation_pair *pair)
 {
-    char line[HARP_CSV_LINE_LENGTH];
-    char *cursor = line;
-    char *string = NULL;
-    size_t length;
+    if (index < 0 || index >= collocation_result->num_pairs)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "index (%ld) is not in the range of collocation results [0,%ld)",
+                       index, collocation_result->num_pairs);
+        return -1;
+    }
 
-    rewind(file);
+    pair->collocation_index = collocation_result->pair_data->collocation_index[index];
+    pair->product_index_a = collocation_result->pair_data->product_index_a[index];
+    pair->sample_index_a = collocation_result->pair_data->sample_index_a[index];
+    pair->product_index_b = collocation_result->pair_data->product_index_b[index];
+    pair->sample_index_b = collocation_result->pair_data->sample_index_b[index];
+    pair->num_differences = collocation_result->num_differences;
+    pair->difference = NULL;
+    if (collocation_result->num_differences > 0)
+    {
+        pair->difference = &collocation_result->pair_data->difference[index * collocation_result->num_differences];
+    }
 
-    if (fgets(line, HARP_CSV_LINE_LENGTH, file) == NULL)
+    return 0;
+}
+
+/** Set the collocation index of a collocation result entry
+ * \param collocation_result Result set containing the entry
+ * \param index Zero-based index in the collocation result set of the entry that should be updated
+ * \param collocation_index New collocation index of the entry
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_collocation_result_set_collocation_index(harp_collocation_result *collocation_result, long index,
+                                                              long collocation_index)
+{
+    if (index < 0 || index >= collocation_result->num_pairs)
     {
-        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "error reading header");
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "index (%ld) is not in the range of collocation results [0,%ld)",
+                       index, collocation_result->num_pairs);
         return -1;
     }
 
-    /* trim end-of-line */
-    length = strlen(line);
-    while (length > 0 && (line[length - 1] == '\r' || line[length - 1] == '\n'))
+    collocation_result->pair_data->collocation_index[index] = collocation_index;
+
+    return 0;
+}
+
+/**
+ * @}
+ */
+
+static int read_header(harp_csv_reader *reader, harp_collocation_result *collocation_result)
+{
+    char *line;
+    char *cursor;
+    char *string = NULL;
+    int result;
+
+    result = harp_csv_reader_read_line(reader, &line, NULL);
+    if (result != 0)
     {
-        length--;
+        if (result == 1)
+        {
+            harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "error reading header");
+        }
+        return -1;
     }
-    line[length] = '\0';
+    cursor = line;
 
     if (harp_csv_parse_string(&cursor, &string) != 0)
     {
@@ -863,33 +1226,41 @@ static int read_header(FILE *file, harp_collocation_result *collocation_result)
     return 0;
 }
 
-static int read_pair(FILE *file, long min_collocation_index, long max_collocation_index,
+/* add the line and column number to the current error message */
+static void add_error_location(harp_csv_reader *reader, int column)
+{
+    harp_add_error_message(" (line %ld, column %d)", harp_csv_reader_get_line_number(reader), column);
+}
+
+/* Read the next pair from the collocation result file.
+ * The difference buffer should be able to hold num_differences values and is reused for all pairs.
+ * Returns 1 at the end of the file.
+ */
+static int read_pair(harp_csv_reader *reader, long min_collocation_index, long max_collocation_index,
                      const char *source_product_a_filter, const char *source_product_b_filter,
-                     harp_collocation_result *collocation_result)
+                     harp_collocation_result *collocation_result, double *difference)
 {
-    char line[HARP_CSV_LINE_LENGTH];
-    char *cursor = line;
+    char *line;
+    char *cursor;
     long collocation_index;
     char *source_product_a;
     char *source_product_b;
     long index_a;
     long index_b;
-    double *difference = NULL;
+    int result;
     int i;
 
-    if (fgets(line, HARP_CSV_LINE_LENGTH, file) == NULL)
+    result = harp_csv_reader_read_line(reader, &line, NULL);
+    if (result != 0)
     {
-        if (ferror(file))
-        {
-            harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "error reading line");
-            return -1;
-        }
-        /* EOF */
-        return 1;
+        /* error or EOF */
+        return result;
     }
+    cursor = line;
 
     if (harp_csv_parse_long(&cursor, &collocation_index) != 0)
     {
+        add_error_location(reader, 1);
         return -1;
     }
 
@@ -906,6 +1277,7 @@ static int read_pair(FILE *file, long min_collocation_index, long max_collocatio
     /* read pair and add it to the collocation_result */
     if (harp_csv_parse_string(&cursor, &source_product_a) != 0)
     {
+        add_error_location(reader, 2);
         return -1;
     }
     if (source_product_a_filter != NULL)
@@ -917,10 +1289,12 @@ static int read_pair(FILE *file, long min_collocation_index, long max_collocatio
     }
     if (harp_csv_parse_long(&cursor, &index_a) != 0)
     {
+        add_error_location(reader, 3);
         return -1;
     }
     if (harp_csv_parse_string(&cursor, &source_product_b) != 0)
     {
+        add_error_location(reader, 4);
         return -1;
     }
     if (source_product_b_filter != NULL)
@@ -932,44 +1306,26 @@ static int read_pair(FILE *file, long min_collocation_index, long max_collocatio
     }
     if (harp_csv_parse_long(&cursor, &index_b) != 0)
     {
+        add_error_location(reader, 5);
         return -1;
     }
 
-    if (collocation_result->num_differences > 0)
+    for (i = 0; i < collocation_result->num_differences; i++)
     {
-        difference = malloc(collocation_result->num_differences * sizeof(double));
-        if (difference == NULL)
+        if (harp_csv_parse_double(&cursor, &difference[i]) != 0)
         {
-            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
-                           collocation_result->num_differences * sizeof(double), __FILE__, __LINE__);
+            add_error_location(reader, 6 + i);
             return -1;
         }
-        for (i = 0; i < collocation_result->num_differences; i++)
-        {
-            if (harp_csv_parse_double(&cursor, &difference[i]) != 0)
-            {
-                free(difference);
-                return -1;
-            }
-        }
     }
 
     if (harp_collocation_result_add_pair(collocation_result, collocation_index, source_product_a, index_a,
                                          source_product_b, index_b, collocation_result->num_differences, difference)
         != 0)
     {
-        if (difference != NULL)
-        {
-            free(difference);
-        }
         return -1;
     }
 
-    if (difference != NULL)
-    {
-        free(difference);
-    }
-
     return 0;
 }
 
@@ -978,7 +1334,8 @@ int harp_collocation_result_read_range(const char *collocation_result_filename,
                                        const char *source_product_b, harp_collocation_result **new_collocation_result)
 {
     harp_collocation_result *collocation_result = NULL;
-    FILE *file;
+    harp_csv_reader *reader;
+    double *difference = NULL;
     int result = 0;
 
     if (collocation_result_filename == NULL)
@@ -988,8 +1345,7 @@ int harp_collocation_result_read_range(const char *collocation_result_filename,
     }
 
     /* Open the collocation result file */
-    file = fopen(collocation_result_filename, "r");
-    if (file == NULL)
+    if (harp_csv_reader_open(collocation_result_filename, &reader) != 0)
     {
         harp_set_error(HARP_ERROR_FILE_OPEN, "error opening collocation result file '%s'", collocation_result_filename);
         return -1;
@@ -998,33 +1354,51 @@ int harp_collocation_result_read_range(const char *collocation_result_filename,
     /* Start new collocation result */
     if (harp_collocation_result_new(&collocation_result, 0, NULL, NULL) != 0)
     {
-        fclose(file);
+        harp_csv_reader_close(reader);
         return -1;
     }
 
     /* Initialize the collocation result and update the collocation differences with the information in the header */
-    if (read_header(file, collocation_result) != 0)
+    if (read_header(reader, collocation_result) != 0)
     {
         harp_collocation_result_delete(collocation_result);
-        fclose(file);
+        harp_csv_reader_close(reader);
         return -1;
     }
 
+    if (collocation_result->num_differences > 0)
+    {
+        difference = malloc(collocation_result->num_differences * sizeof(double));
+        if (difference == NULL)
+        {
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                           collocation_result->num_differences * sizeof(double), __FILE__, __LINE__);
+            harp_collocation_result_delete(collocation_result);
+            harp_csv_reader_close(reader);
+            return -1;
+        }
+    }
+
     /* Read the matching pairs */
     while (result == 0)
     {
-        result = read_pair(file, min_collocation_index, max_collocation_index, source_product_a, source_product_b,
-                           collocation_result);
+        result = read_pair(reader, min_collocation_index, max_collocation_index, source_product_a, source_product_b,
+                           collocation_result, difference);
+    }
+    if (difference != NULL)
+    {
+        free(difference);
     }
     if (result < 0)
     {
+        harp_add_error_message(" (while reading collocation result file '%s')", collocation_result_filename);
         harp_collocation_result_delete(collocation_result);
-        fclose(file);
+        harp_csv_reader_close(reader);
         return -1;
     }
 
     /* Close the collocation result file */
-    fclose(file);
+    harp_csv_reader_close(reader);
 
     *new_collocation_result = collocation_result;
     return 0;
@@ -1070,24 +1444,23 @@ static void write_header(FILE *file, const harp_collocation_result *collocation_
 
 static void write_pair(FILE *file, const harp_collocation_result *collocation_result, long index)
 {
-    harp_collocation_pair *pair;
+    const double *difference;
     int i;
 
-    assert(collocation_result->pair != NULL);
     assert(index >= 0 && index < collocation_result->num_pairs);
-    assert(collocation_result->pair[index] != NULL);
-
-    pair = collocation_result->pair[index];
 
     /* Write filenames and measurement indices */
-    fprintf(file, "%ld,%s,%ld,%s,%ld", pair->collocation_index,
-            collocation_result->dataset_a->source_product[pair->product_index_a], pair->sample_index_a,
-            collocation_result->dataset_b->source_product[pair->product_index_b], pair->sample_index_b);
+    fprintf(file, "%ld,%s,%ld,%s,%ld", collocation_result->pair_data->collocation_index[index],
+            collocation_result->dataset_a->source_product[collocation_result->pair_data->product_index_a[index]],
+            collocation_result->pair_data->sample_index_a[index],
+            collocation_result->dataset_b->source_product[collocation_result->pair_data->product_index_b[index]],
+            collocation_result->pair_data->sample_index_b[index]);
 
     /* Write differences */
-    for (i = 0; i < pair->num_differences; i++)
+    difference = &collocation_result->pair_data->difference[index * collocation_result->num_differences];
+    for (i = 0; i < collocation_result->num_differences; i++)
     {
-        fprintf(file, ",%.8g", pair->difference[i]);
+        fprintf(file, ",%.8g", difference[i]);
     }
     fprintf(file, "\n");
 }
@@ -1151,13 +1524,16 @@ LIBHARP_API int harp_collocation_result_write(const char *collocation_result_fil
  */
 LIBHARP_API void harp_collocation_result_swap_datasets(harp_collocation_result *collocation_result)
 {
-    long i;
     harp_dataset *data_a;
+    long *index_a;
 
-    for (i = 0; i < collocation_result->num_pairs; i++)
-    {
-        collocation_pair_swap_datasets(collocation_result->pair[i]);
-    }
+    index_a = collocation_result->pair_data->product_index_a;
+    collocation_result->pair_data->product_index_a = collocation_result->pair_data->product_index_b;
+    collocation_result->pair_data->product_index_b = index_a;
+
+    index_a = collocation_result->pair_data->sample_index_a;
+    collocation_result->pair_data->sample_index_a = collocation_result->pair_data->sample_index_b;
+    collocation_result->pair_data->sample_index_b = index_a;
 
     data_a = collocation_result->dataset_a;
 
@@ -1173,8 +1549,10 @@ LIBHARP_API void harp_collocation_result_swap_datasets(harp_collocation_result *
 int harp_collocation_result_shallow_copy(const harp_collocation_result *collocation_result,
                                          harp_collocation_result **new_result)
 {
+    const harp_collocation_pair_data *pair_data = collocation_result->pair_data;
     harp_collocation_result *result = NULL;
-    long i;
+    long num_pairs = collocation_result->num_pairs;
+    int num_differences = collocation_result->num_differences;
 
     /* allocate memory for the result struct */
     result = (harp_collocation_result *)malloc(sizeof(harp_collocation_result));
@@ -1186,36 +1564,37 @@ int harp_collocation_result_shallow_copy(const harp_collocation_result *collocat
     }
     result->dataset_a = collocation_result->dataset_a;
     result->dataset_b = collocation_result->dataset_b;
-    result->num_differences = collocation_result->num_differences;
+    result->num_differences = num_differences;
     result->difference_variable_name = collocation_result->difference_variable_name;
     result->difference_unit = collocation_result->difference_unit;
-    result->num_pairs = collocation_result->num_pairs;
-    result->pair = NULL;
+    result->num_pairs = 0;
+    result->pair_data = NULL;
 
-    result->pair = malloc(collocation_result->num_pairs * sizeof(harp_collocation_pair *));
-    if (result->pair == NULL)
+    if (pair_data_new(&result->pair_data) != 0)
     {
-        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
-                       collocation_result->num_pairs * sizeof(harp_collocation_pair *), __FILE__, __LINE__);
         harp_collocation_result_shallow_delete(result);
         return -1;
     }
-    for (i = 0; i < collocation_result->num_pairs; i++)
-    {
-        result->pair[i] = NULL;
-    }
 
-    for (i = 0; i < collocation_result->num_pairs; i++)
+    if (num_pairs > 0)
     {
-        harp_collocation_pair *pair = collocation_result->pair[i];
-
-        if (collocation_pair_new(pair->collocation_index, pair->product_index_a, pair->sample_index_a,
-                                 pair->product_index_b, pair->sample_index_b, pair->num_differences, pair->difference,
-                                 &result->pair[i]) != 0)
+        if (resize_pair_arrays(result, get_pair_capacity(num_pairs)) != 0)
         {
             harp_collocation_result_shallow_delete(result);
             return -1;
         }
+
+        memcpy(result->pair_data->collocation_index, pair_data->collocation_index, num_pairs * sizeof(long));
+        memcpy(result->pair_data->product_index_a, pair_data->product_index_a, num_pairs * sizeof(long));
+        memcpy(result->pair_data->sample_index_a, pair_data->sample_index_a, num_pairs * sizeof(long));
+        memcpy(result->pair_data->product_index_b, pair_data->product_index_b, num_pairs * sizeof(long));
+        memcpy(result->pair_data->sample_index_b, pair_data->sample_index_b, num_pairs * sizeof(long));
+        if (num_differences > 0)
+        {
+            memcpy(result->pair_data->difference, pair_data->difference,
+                   num_pairs * num_differences * sizeof(double));
+        }
+        result->num_pairs = num_pairs;
     }
 
     *new_result = result;
@@ -1227,16 +1606,9 @@ void harp_collocation_result_shallow_delete(harp_collocation_result *collocation
 {
     if (collocation_result != NULL)
     {
-        if (collocation_result->pair != NULL)
+        if (collocation_result->pair_data != NULL)
         {
-            long i;
-
-            for (i = 0; i < collocation_result->num_pairs; i++)
-            {
-                collocation_pair_delete(collocation_result->pair[i]);
-            }
-
-            free(collocation_result->pair);
+            pair_data_delete(collocation_result->pair_data);
         }
 
         free(collocation_result);
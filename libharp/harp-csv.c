@@ -33,51 +33,194 @@
 #include "harp-csv.h"
 
 #include <assert.h>
+#include <limits.h>
+#include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 
-int harp_csv_parse_double(char **str, double *value)
+/* initial size of the read buffer of a csv reader (the buffer grows if a line does not fit) */
+#define CSV_READER_BUFFER_SIZE (1024 * 1024)
+
+struct harp_csv_reader_struct
 {
-    char *cursor = *str;
-    int stringlength = 0;
+    FILE *file;
+    char *buffer;
+    long buffer_size;   /* allocated size of buffer */
+    long data_length;   /* number of bytes in buffer that contain data */
+    long position;      /* offset in buffer of the start of the next line */
+    int end_of_file;
+    long line_number;   /* line number of the last line that was returned */
+};
+
+int harp_csv_reader_open(const char *filename, harp_csv_reader **new_reader)
+{
+    harp_csv_reader *reader;
 
-    *value = harp_nan();
+    reader = (harp_csv_reader *)malloc(sizeof(harp_csv_reader));
+    if (reader == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       sizeof(harp_csv_reader), __FILE__, __LINE__);
+        return -1;
+    }
+    reader->file = NULL;
+    reader->buffer_size = CSV_READER_BUFFER_SIZE;
+    reader->data_length = 0;
+    reader->position = 0;
+    reader->end_of_file = 0;
+    reader->line_number = 0;
+
+    reader->buffer = (char *)malloc(reader->buffer_size);
+    if (reader->buffer == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       reader->buffer_size, __FILE__, __LINE__);
+        harp_csv_reader_close(reader);
+        return -1;
+    }
 
-    /* Skip leading white space */
-    while (*cursor == ' ')
+    reader->file = fopen(filename, "rb");
+    if (reader->file == NULL)
     {
-        cursor++;
+        harp_set_error(HARP_ERROR_FILE_OPEN, "error opening file '%s'", filename);
+        harp_csv_reader_close(reader);
+        return -1;
     }
 
-    /* Grab string */
-    while (cursor[stringlength] != ',' && cursor[stringlength] != '\0')
+    *new_reader = reader;
+    return 0;
+}
+
+void harp_csv_reader_close(harp_csv_reader *reader)
+{
+    if (reader != NULL)
     {
-        stringlength++;
+        if (reader->file != NULL)
+        {
+            fclose(reader->file);
+        }
+        if (reader->buffer != NULL)
+        {
+            free(reader->buffer);
+        }
+        free(reader);
     }
-    if (cursor[stringlength] == '\0')
+}
+
+/* Read more data into the buffer of the reader (keeping the partial line at reader->position) */
+static int csv_reader_fill_buffer(harp_csv_reader *reader)
+{
+    size_t num_bytes;
+
+    /* move the partial line to the start of the buffer */
+    if (reader->position > 0)
     {
-        *str = &cursor[stringlength];
+        reader->data_length -= reader->position;
+        memmove(reader->buffer, &reader->buffer[reader->position], reader->data_length);
+        reader->position = 0;
     }
-    else
+
+    /* grow the buffer if a single line fills it (one byte is reserved for a terminating zero) */
+    if (reader->data_length >= reader->buffer_size - 1)
     {
-        cursor[stringlength] = '\0';
-        *str = &cursor[stringlength + 1];
+        char *new_buffer;
+
+        new_buffer = (char *)realloc(reader->buffer, 2 * reader->buffer_size);
+        if (new_buffer == NULL)
+        {
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                           2 * reader->buffer_size, __FILE__, __LINE__);
+            return -1;
+        }
+        reader->buffer = new_buffer;
+        reader->buffer_size *= 2;
     }
-    if (sscanf(cursor, "%lf", value) != 1)
+
+    num_bytes = fread(&reader->buffer[reader->data_length], 1, reader->buffer_size - 1 - reader->data_length,
+                      reader->file);
+    if (num_bytes == 0)
     {
-        harp_set_error(HARP_ERROR_INVALID_FORMAT, "could not parse floating point value from csv element '%s'", cursor);
-        return -1;
+        if (ferror(reader->file))
+        {
+            harp_set_error(HARP_ERROR_FILE_READ, "read error");
+            return -1;
+        }
+        reader->end_of_file = 1;
     }
+    reader->data_length += (long)num_bytes;
 
     return 0;
 }
 
-int harp_csv_parse_long(char **str, long *value)
+/* Get the next line from the file.
+ * The line is zero terminated and does not include the end-of-line character(s). The line remains valid until the
+ * next call to harp_csv_reader_read_line() and may be modified in place by the caller.
+ * Returns 1 if the end of the file was reached, 0 if a line was read, and -1 on error.
+ */
+int harp_csv_reader_read_line(harp_csv_reader *reader, char **line, long *length)
 {
-    char *cursor = *str;
-    size_t stringlength = 0;
+    char *start;
+    long line_length;
 
-    *value = 0;
+    for (;;)
+    {
+        char *end_of_line;
+
+        start = &reader->buffer[reader->position];
+        end_of_line = memchr(start, '\n', reader->data_length - reader->position);
+        if (end_of_line != NULL)
+        {
+            line_length = (long)(end_of_line - start);
+            reader->position += line_length + 1;
+            break;
+        }
+        if (reader->end_of_file)
+        {
+            if (reader->position == reader->data_length)
+            {
+                return 1;
+            }
+            /* last line is not terminated by an end-of-line */
+            line_length = reader->data_length - reader->position;
+            reader->position = reader->data_length;
+            break;
+        }
+        if (csv_reader_fill_buffer(reader) != 0)
+        {
+            return -1;
+        }
+    }
+
+    if (line_length > 0 && start[line_length - 1] == '\r')
+    {
+        line_length--;
+    }
+    start[line_length] = '\0';
+    reader->line_number++;
+
+    *line = start;
+    if (length != NULL)
+    {
+        *length = line_length;
+    }
+
+    return 0;
+}
+
+/* Returns the (1-based) line number of the line that was last returned by harp_csv_reader_read_line() */
+long harp_csv_reader_get_line_number(const harp_csv_reader *reader)
+{
+    return reader->line_number;
+}
+
+/* Find the end of the current csv element and advance *str to the start of the next element.
+ * The element will be zero terminated with trailing white space removed; the length of the element is returned.
+ */
+static long csv_grab_element(char **str, char **element)
+{
+    char *cursor = *str;
+    char *end;
+    long length;
 
     /* Skip leading white space */
     while (*cursor == ' ')
@@ -85,25 +228,105 @@ int harp_csv_parse_long(char **str, long *value)
         cursor++;
     }
 
-    /* Grab string */
-    while (cursor[stringlength] != ',' && cursor[stringlength] != '\0')
+    end = strchr(cursor, ',');
+    if (end == NULL)
     {
-        stringlength++;
+        length = (long)strlen(cursor);
+        *str = &cursor[length];
     }
-    if (cursor[stringlength] == '\0')
+    else
     {
-        *str = &cursor[stringlength];
+        length = (long)(end - cursor);
+        *end = '\0';
+        *str = end + 1;
     }
-    else
+    while (length > 0 && cursor[length - 1] == ' ')
     {
-        cursor[stringlength] = '\0';
-        *str = &cursor[stringlength + 1];
+        length--;
+    }
+    cursor[length] = '\0';
+
+    *element = cursor;
+    return length;
+}
+
+int harp_csv_parse_double(char **str, double *value)
+{
+    char *cursor;
+    char *end;
+    long length;
+
+    *value = harp_nan();
+
+    /* the element is zero terminated, so it can be converted with strtod(), which is correctly rounded and also
+     * accepts (signed) nan and inf values
+     */
+    length = csv_grab_element(str, &cursor);
+    if (length > 0)
+    {
+        *value = strtod(cursor, &end);
+        if (end == &cursor[length])
+        {
+            return 0;
+        }
+    }
+
+    *value = harp_nan();
+    harp_set_error(HARP_ERROR_INVALID_FORMAT, "could not parse floating point value from csv element '%s'", cursor);
+    return -1;
+}
+
+int harp_csv_parse_long(char **str, long *value)
+{
+    char *cursor;
+    long length;
+    unsigned long result = 0;
+    unsigned long max_value;
+    int negative = 0;
+    long i = 0;
+
+    *value = 0;
+
+    length = csv_grab_element(str, &cursor);
+    if (length > 0 && (cursor[0] == '+' || cursor[0] == '-'))
+    {
+        negative = cursor[0] == '-';
+        i++;
     }
-    if (sscanf(cursor, "%ld", value) != 1)
+    if (i == length)
     {
         harp_set_error(HARP_ERROR_INVALID_FORMAT, "could not parse long value from csv element '%s'", cursor);
         return -1;
     }
+    /* the magnitude of the most negative value is one larger than that of the most positive value */
+    max_value = negative ? (unsigned long)LONG_MAX + 1 : (unsigned long)LONG_MAX;
+    for (; i < length; i++)
+    {
+        unsigned long digit;
+
+        if (cursor[i] < '0' || cursor[i] > '9')
+        {
+            harp_set_error(HARP_ERROR_INVALID_FORMAT, "could not parse long value from csv element '%s'", cursor);
+            return -1;
+        }
+        digit = (unsigned long)(cursor[i] - '0');
+        if (result > (max_value - digit) / 10)
+        {
+            harp_set_error(HARP_ERROR_INVALID_FORMAT, "long value in csv element '%s' is out of range", cursor);
+            return -1;
+        }
+        result = 10 * result + digit;
+    }
+
+    if (negative)
+    {
+        /* avoid overflow when negating LONG_MIN */
+        *value = result == 0 ? 0 : -(long)(result - 1) - 1;
+    }
+    else
+    {
+        *value = (long)result;
+    }
 
     return 0;
 }
@@ -234,27 +457,52 @@ int harp_csv_parse_variable_name_and_unit(char **str, char **variable_name, char
 
 int harp_csv_get_num_lines(FILE *file, const char *filename, long *new_num_lines)
 {
-    long length;
-    char LINE[HARP_CSV_LINE_LENGTH];
+    char buffer[HARP_CSV_LINE_LENGTH];
     long num_lines = 0;
+    long line_length = 0;       /* length of the current line excluding end-of-line characters */
+    size_t num_bytes;
 
-    while (fgets(LINE, HARP_CSV_LINE_LENGTH, file) != NULL)
+    /* count the lines in large blocks instead of reading the file line by line */
+    while ((num_bytes = fread(buffer, 1, HARP_CSV_LINE_LENGTH, file)) > 0)
     {
-        /* Trim the line */
-        length = (long)strlen(LINE);
-        while (length > 0 && (LINE[length - 1] == '\r' || LINE[length - 1] == '\n'))
-        {
-            length--;
-        }
-        LINE[length] = '\0';
+        char *cursor = buffer;
+        char *end = &buffer[num_bytes];
 
-        /* Do not allow empty lines */
-        if (length == 0)
+        while (cursor < end)
         {
-            harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "empty line in file '%s'", filename);
-            return -1;
-        }
+            char *end_of_line = memchr(cursor, '\n', end - cursor);
+            long length;
+
+            length = (long)((end_of_line == NULL ? end : end_of_line) - cursor);
+            if (length > 0 && cursor[length - 1] == '\r')
+            {
+                length--;
+            }
+            line_length += length;
+            if (end_of_line == NULL)
+            {
+                break;
+            }
 
+            /* Do not allow empty lines */
+            if (line_length == 0)
+            {
+                harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "empty line in file '%s'", filename);
+                return -1;
+            }
+            num_lines++;
+            line_length = 0;
+            cursor = end_of_line + 1;
+        }
+    }
+    if (ferror(file))
+    {
+        harp_set_error(HARP_ERROR_FILE_READ, "error reading file '%s'", filename);
+        return -1;
+    }
+    if (line_length > 0)
+    {
+        /* last line without end-of-line */
         num_lines++;
     }
 
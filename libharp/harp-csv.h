@@ -36,6 +36,14 @@
 
 #define HARP_CSV_LINE_LENGTH 4096
 
+/* Line reader for (large) csv files; reads the file in large chunks instead of line by line */
+typedef struct harp_csv_reader_struct harp_csv_reader;
+
+int harp_csv_reader_open(const char *filename, harp_csv_reader **new_reader);
+void harp_csv_reader_close(harp_csv_reader *reader);
+int harp_csv_reader_read_line(harp_csv_reader *reader, char **line, long *length);
+long harp_csv_reader_get_line_number(const harp_csv_reader *reader);
+
 int harp_csv_parse_double(char **str, double *value);
 int harp_csv_parse_long(char **str, long *value);
 int harp_csv_parse_string(char **str, char **value);
@@ -30,6 +30,7 @@
  */
 
 #include "harp-internal.h"
+#include "harp-csv.h"
 #include "hashtable.h"
 
 #include <sys/types.h>
@@ -86,7 +87,798 @@ static int is_directory(const char *directoryname)
     return 0;
 }
 
-static int add_path_file(harp_dataset *dataset, const char *filename, const char *options)
+/* A catalog caches the product metadata of files, together with the ingestion options that were used and the
+ * modification time and size of each file at the moment its metadata was retrieved. Entries are only reused when the
+ * options, modification time, and size still match.
+ * Catalog files are stored as csv with one header line (CATALOG_HEADER) and one line per file. String fields are
+ * always quoted (with embedded quotes doubled).
+ */
+#define CATALOG_HEADER "filename,options,modification_time,file_size,datetime_start,datetime_stop,time,latitude," \
+    "longitude,vertical,spectral,source_product"
+
+typedef struct catalog_entry_struct
+{
+    char *filename;
+    char *options;      /* ingestion options used for the metadata ("" if no options were used) */
+    long modification_time;
+    long file_size;
+    harp_product_metadata *metadata;    /* NULL for files that still need to be scanned */
+} catalog_entry;
+
+typedef struct catalog_struct
+{
+    hashtable *filename_to_index;
+    long num_entries;
+    catalog_entry *entry;
+    long num_pending;   /* number of entries that need to be (re)scanned */
+    long *pending_index;        /* indices of entries that need to be (re)scanned */
+    int modified;
+} catalog;
+
+static void catalog_delete(catalog *dataset_catalog)
+{
+    long i;
+
+    if (dataset_catalog->filename_to_index != NULL)
+    {
+        hashtable_delete(dataset_catalog->filename_to_index);
+    }
+    if (dataset_catalog->entry != NULL)
+    {
+        for (i = 0; i < dataset_catalog->num_entries; i++)
+        {
+            free(dataset_catalog->entry[i].filename);
+            if (dataset_catalog->entry[i].options != NULL)
+            {
+                free(dataset_catalog->entry[i].options);
+            }
+            if (dataset_catalog->entry[i].metadata != NULL)
+            {
+                harp_product_metadata_delete(dataset_catalog->entry[i].metadata);
+            }
+        }
+        free(dataset_catalog->entry);
+    }
+    if (dataset_catalog->pending_index != NULL)
+    {
+        free(dataset_catalog->pending_index);
+    }
+    free(dataset_catalog);
+}
+
+static int catalog_new(catalog **new_catalog)
+{
+    catalog *dataset_catalog;
+
+    dataset_catalog = (catalog *)malloc(sizeof(catalog));
+    if (dataset_catalog == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       sizeof(catalog), __FILE__, __LINE__);
+        return -1;
+    }
+    dataset_catalog->filename_to_index = NULL;
+    dataset_catalog->num_entries = 0;
+    dataset_catalog->entry = NULL;
+    dataset_catalog->num_pending = 0;
+    dataset_catalog->pending_index = NULL;
+    dataset_catalog->modified = 0;
+
+    dataset_catalog->filename_to_index = hashtable_new(1);
+    if (dataset_catalog->filename_to_index == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not create hashtable) (%s:%u)", __FILE__,
+                       __LINE__);
+        catalog_delete(dataset_catalog);
+        return -1;
+    }
+
+    *new_catalog = dataset_catalog;
+
+    return 0;
+}
+
+/* Set the catalog entry for filename (the catalog takes ownership of metadata, which may be NULL).
+ * If index is not NULL then the index of the entry will be stored there.
+ */
+static int catalog_set_entry(catalog *dataset_catalog, const char *filename, const char *options,
+                             long modification_time, long file_size, harp_product_metadata *metadata, long *index)
+{
+    catalog_entry *entry;
+    char *options_copy;
+    long entry_index;
+
+    options_copy = strdup(options == NULL ? "" : options);
+    if (options_copy == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not duplicate string) (%s:%u)", __FILE__,
+                       __LINE__);
+        harp_product_metadata_delete(metadata);
+        return -1;
+    }
+
+    entry_index = hashtable_get_index_from_name(dataset_catalog->filename_to_index, filename);
+    if (entry_index < 0)
+    {
+        if (dataset_catalog->num_entries % BLOCK_SIZE == 0)
+        {
+            catalog_entry *new_entry;
+
+            new_entry = realloc(dataset_catalog->entry,
+                                (dataset_catalog->num_entries + BLOCK_SIZE) * sizeof(catalog_entry));
+            if (new_entry == NULL)
+            {
+                harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                               (dataset_catalog->num_entries + BLOCK_SIZE) * sizeof(catalog_entry), __FILE__,
+                               __LINE__);
+                harp_product_metadata_delete(metadata);
+                free(options_copy);
+                return -1;
+            }
+            dataset_catalog->entry = new_entry;
+        }
+        entry_index = dataset_catalog->num_entries;
+        entry = &dataset_catalog->entry[entry_index];
+        entry->filename = strdup(filename);
+        if (entry->filename == NULL)
+        {
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not duplicate string) (%s:%u)", __FILE__,
+                           __LINE__);
+            harp_product_metadata_delete(metadata);
+            free(options_copy);
+            return -1;
+        }
+        entry->options = NULL;
+        entry->metadata = NULL;
+        if (hashtable_add_name(dataset_catalog->filename_to_index, entry->filename) != 0)
+        {
+            assert(0);
+            exit(1);
+        }
+        dataset_catalog->num_entries++;
+    }
+    entry = &dataset_catalog->entry[entry_index];
+    if (entry->options != NULL)
+    {
+        free(entry->options);
+    }
+    if (entry->metadata != NULL)
+    {
+        harp_product_metadata_delete(entry->metadata);
+    }
+    entry->options = options_copy;
+    entry->modification_time = modification_time;
+    entry->file_size = file_size;
+    entry->metadata = metadata;
+
+    if (index != NULL)
+    {
+        *index = entry_index;
+    }
+
+    return 0;
+}
+
+static int catalog_add_pending(catalog *dataset_catalog, const char *filename, const char *options,
+                               long modification_time, long file_size)
+{
+    long index;
+
+    if (catalog_set_entry(dataset_catalog, filename, options, modification_time, file_size, NULL, &index) != 0)
+    {
+        return -1;
+    }
+    if (dataset_catalog->num_pending % BLOCK_SIZE == 0)
+    {
+        long *new_pending_index;
+
+        new_pending_index = realloc(dataset_catalog->pending_index,
+                                    (dataset_catalog->num_pending + BLOCK_SIZE) * sizeof(long));
+        if (new_pending_index == NULL)
+        {
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                           (dataset_catalog->num_pending + BLOCK_SIZE) * sizeof(long), __FILE__, __LINE__);
+            return -1;
+        }
+        dataset_catalog->pending_index = new_pending_index;
+    }
+    dataset_catalog->pending_index[dataset_catalog->num_pending] = index;
+    dataset_catalog->num_pending++;
+
+    return 0;
+}
+
+static int get_file_stamp(const char *filename, long *modification_time, long *file_size)
+{
+    struct stat statbuf;
+
+    if (stat(filename, &statbuf) != 0)
+    {
+        if (errno == ENOENT)
+        {
+            harp_set_error(HARP_ERROR_FILE_NOT_FOUND, "could not find '%s'", filename);
+        }
+        else
+        {
+            harp_set_error(HARP_ERROR_FILE_OPEN, "could not open '%s' (%s)", filename, strerror(errno));
+        }
+        return -1;
+    }
+
+    *modification_time = (long)statbuf.st_mtime;
+    *file_size = (long)statbuf.st_size;
+
+    return 0;
+}
+
+static int metadata_copy(const harp_product_metadata *metadata, harp_product_metadata **new_metadata)
+{
+    harp_product_metadata *metadata_copy;
+    int i;
+
+    if (harp_product_metadata_new(&metadata_copy) != 0)
+    {
+        return -1;
+    }
+    metadata_copy->filename = strdup(metadata->filename);
+    if (metadata_copy->filename == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not duplicate string) (%s:%u)", __FILE__,
+                       __LINE__);
+        harp_product_metadata_delete(metadata_copy);
+        return -1;
+    }
+    metadata_copy->source_product = strdup(metadata->source_product);
+    if (metadata_copy->source_product == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not duplicate string) (%s:%u)", __FILE__,
+                       __LINE__);
+        harp_product_metadata_delete(metadata_copy);
+        return -1;
+    }
+    metadata_copy->datetime_start = metadata->datetime_start;
+    metadata_copy->datetime_stop = metadata->datetime_stop;
+    for (i = 0; i < HARP_NUM_DIM_TYPES; i++)
+    {
+        metadata_copy->dimension[i] = metadata->dimension[i];
+    }
+
+    *new_metadata = metadata_copy;
+
+    return 0;
+}
+
+/* Add a copy of the metadata of a catalog entry to the dataset */
+static int add_catalog_entry_to_dataset(harp_dataset *dataset, const catalog_entry *entry)
+{
+    harp_product_metadata *metadata;
+
+    assert(entry->metadata != NULL);
+
+    if (metadata_copy(entry->metadata, &metadata) != 0)
+    {
+        return -1;
+    }
+    if (harp_dataset_add_product(dataset, metadata->source_product, metadata) != 0)
+    {
+        harp_product_metadata_delete(metadata);
+        return -1;
+    }
+
+    return 0;
+}
+
+/* Write a string as a quoted csv field (embedded quotes are doubled) */
+static void write_catalog_string(FILE *stream, const char *str)
+{
+    fputc('"', stream);
+    while (*str != '\0')
+    {
+        if (*str == '"')
+        {
+            fputc('"', stream);
+        }
+        fputc(*str, stream);
+        str++;
+    }
+    fputc('"', stream);
+}
+
+/* Parse a (quoted) csv string field; quotes are removed and doubled quotes are unescaped in place */
+static int parse_catalog_string(char **str, char **value)
+{
+    char *cursor = *str;
+    char *target;
+
+    /* Skip leading white space */
+    while (*cursor == ' ')
+    {
+        cursor++;
+    }
+    if (*cursor != '"')
+    {
+        *str = cursor;
+        return harp_csv_parse_string(str, value);
+    }
+
+    cursor++;
+    *value = cursor;
+    target = cursor;
+    for (;;)
+    {
+        if (*cursor == '\0')
+        {
+            harp_set_error(HARP_ERROR_INVALID_FORMAT, "missing closing quote for string value in csv element");
+            return -1;
+        }
+        if (*cursor == '"')
+        {
+            if (cursor[1] != '"')
+            {
+                break;
+            }
+            cursor++;
+        }
+        *target = *cursor;
+        target++;
+        cursor++;
+    }
+    *target = '\0';
+
+    /* skip the closing quote and move to the start of the next element */
+    cursor++;
+    while (*cursor == ' ')
+    {
+        cursor++;
+    }
+    if (*cursor == ',')
+    {
+        cursor++;
+    }
+    else if (*cursor != '\0')
+    {
+        harp_set_error(HARP_ERROR_INVALID_FORMAT, "invalid characters after closing quote of string value in csv "
+                       "element");
+        return -1;
+    }
+    *str = cursor;
+
+    return 0;
+}
+
+/* Returns 1 if the entry can be stored in a catalog file; a catalog line can not contain line breaks, so entries with
+ * line breaks in one of the string fields are left out (these files are then just scanned again each time) */
+static int is_writable_catalog_entry(const catalog_entry *entry)
+{
+    return entry->metadata != NULL && strpbrk(entry->filename, "\r\n") == NULL &&
+        strpbrk(entry->options, "\r\n") == NULL && strpbrk(entry->metadata->source_product, "\r\n") == NULL;
+}
+
+static void write_catalog_entry(FILE *stream, const catalog_entry *entry)
+{
+    int i;
+
+    assert(entry->metadata != NULL);
+
+    write_catalog_string(stream, entry->filename);
+    fputc(',', stream);
+    write_catalog_string(stream, entry->options);
+    fprintf(stream, ",%ld,%ld,%.17g,%.17g", entry->modification_time, entry->file_size,
+            entry->metadata->datetime_start, entry->metadata->datetime_stop);
+    for (i = 0; i < HARP_NUM_DIM_TYPES; i++)
+    {
+        fprintf(stream, ",%ld", entry->metadata->dimension[i]);
+    }
+    fputc(',', stream);
+    write_catalog_string(stream, entry->metadata->source_product);
+    fputc('\n', stream);
+}
+
+/* Parse a catalog line; returns 1 if the line is empty, 0 on success, and -1 on error */
+static int read_catalog_entry(char *line, catalog *dataset_catalog)
+{
+    harp_product_metadata *metadata;
+    char *cursor = line;
+    char *filename;
+    char *options;
+    char *source_product;
+    long modification_time;
+    long file_size;
+    int i;
+
+    if (*line == '\0')
+    {
+        return 1;
+    }
+
+    if (parse_catalog_string(&cursor, &filename) != 0)
+    {
+        return -1;
+    }
+    if (parse_catalog_string(&cursor, &options) != 0)
+    {
+        return -1;
+    }
+    if (harp_csv_parse_long(&cursor, &modification_time) != 0)
+    {
+        return -1;
+    }
+    if (harp_csv_parse_long(&cursor, &file_size) != 0)
+    {
+        return -1;
+    }
+    if (harp_product_metadata_new(&metadata) != 0)
+    {
+        return -1;
+    }
+    if (harp_csv_parse_double(&cursor, &metadata->datetime_start) != 0)
+    {
+        harp_product_metadata_delete(metadata);
+        return -1;
+    }
+    if (harp_csv_parse_double(&cursor, &metadata->datetime_stop) != 0)
+    {
+        harp_product_metadata_delete(metadata);
+        return -1;
+    }
+    for (i = 0; i < HARP_NUM_DIM_TYPES; i++)
+    {
+        if (harp_csv_parse_long(&cursor, &metadata->dimension[i]) != 0)
+        {
+            harp_product_metadata_delete(metadata);
+            return -1;
+        }
+    }
+    if (parse_catalog_string(&cursor, &source_product) != 0)
+    {
+        harp_product_metadata_delete(metadata);
+        return -1;
+    }
+    metadata->filename = strdup(filename);
+    if (metadata->filename == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not duplicate string) (%s:%u)", __FILE__,
+                       __LINE__);
+        harp_product_metadata_delete(metadata);
+        return -1;
+    }
+    metadata->source_product = strdup(source_product);
+    if (metadata->source_product == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not duplicate string) (%s:%u)", __FILE__,
+                       __LINE__);
+        harp_product_metadata_delete(metadata);
+        return -1;
+    }
+
+    return catalog_set_entry(dataset_catalog, filename, options, modification_time, file_size, metadata, NULL);
+}
+
+/* Returns 1 if the file starts with the catalog header, 0 if it does not, and -1 on error */
+static int read_catalog_header(harp_csv_reader *reader)
+{
+    char *line;
+    int result;
+
+    result = harp_csv_reader_read_line(reader, &line, NULL);
+    if (result != 0)
+    {
+        /* an empty file is not a catalog file */
+        return result < 0 ? -1 : 0;
+    }
+
+    return strcmp(line, CATALOG_HEADER) == 0;
+}
+
+static int is_catalog_file(const char *filename)
+{
+    long length = (long)strlen(filename);
+    harp_csv_reader *reader;
+    int result;
+
+    if (length <= 4 || strcmp(&filename[length - 4], ".csv") != 0)
+    {
+        return 0;
+    }
+
+    if (harp_csv_reader_open(filename, &reader) != 0)
+    {
+        /* let the regular product import report the error */
+        return 0;
+    }
+    result = read_catalog_header(reader);
+    harp_csv_reader_close(reader);
+
+    return result;
+}
+
+/* Read entries from a catalog file (a non-existing catalog file is treated as an empty catalog) */
+static int catalog_read(catalog *dataset_catalog, const char *filename)
+{
+    harp_csv_reader *reader;
+    struct stat statbuf;
+    char *line;
+    int result;
+
+    if (stat(filename, &statbuf) != 0 && errno == ENOENT)
+    {
+        return 0;
+    }
+
+    if (harp_csv_reader_open(filename, &reader) != 0)
+    {
+        harp_add_error_message(" (catalog file '%s')", filename);
+        return -1;
+    }
+
+    result = read_catalog_header(reader);
+    if (result != 1)
+    {
+        if (result == 0)
+        {
+            harp_set_error(HARP_ERROR_INVALID_FORMAT, "invalid header");
+        }
+        harp_add_error_message(" (catalog file '%s')", filename);
+        harp_csv_reader_close(reader);
+        return -1;
+    }
+
+    while ((result = harp_csv_reader_read_line(reader, &line, NULL)) == 0)
+    {
+        if (read_catalog_entry(line, dataset_catalog) < 0)
+        {
+            harp_add_error_message(" (catalog file '%s', line %ld)", filename,
+                                   harp_csv_reader_get_line_number(reader));
+            harp_csv_reader_close(reader);
+            return -1;
+        }
+    }
+    if (result < 0)
+    {
+        harp_add_error_message(" (catalog file '%s')", filename);
+        harp_csv_reader_close(reader);
+        return -1;
+    }
+
+    harp_csv_reader_close(reader);
+
+    return 0;
+}
+
+/* Write all scanned entries of the catalog; the file is first written to a temporary file that then replaces the
+ * catalog file, so an interrupted update will never leave a truncated catalog behind.
+ */
+static int catalog_write(const catalog *dataset_catalog, const char *filename)
+{
+    char *tmp_filename;
+    FILE *stream;
+    long i;
+
+    tmp_filename = malloc(strlen(filename) + 5);
+    if (tmp_filename == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       strlen(filename) + 5, __FILE__, __LINE__);
+        return -1;
+    }
+    sprintf(tmp_filename, "%s.tmp", filename);
+
+    stream = fopen(tmp_filename, "w");
+    if (stream == NULL)
+    {
+        harp_set_error(HARP_ERROR_FILE_OPEN, "could not open '%s' for writing (%s)", tmp_filename, strerror(errno));
+        free(tmp_filename);
+        return -1;
+    }
+    fprintf(stream, "%s\n", CATALOG_HEADER);
+    for (i = 0; i < dataset_catalog->num_entries; i++)
+    {
+        if (is_writable_catalog_entry(&dataset_catalog->entry[i]))
+        {
+            write_catalog_entry(stream, &dataset_catalog->entry[i]);
+        }
+    }
+    if (fclose(stream) != 0)
+    {
+        harp_set_error(HARP_ERROR_FILE_WRITE, "could not write '%s' (%s)", tmp_filename, strerror(errno));
+        remove(tmp_filename);
+        free(tmp_filename);
+        return -1;
+    }
+
+#ifdef WIN32
+    /* rename() does not replace existing files on Windows */
+    remove(filename);
+#endif
+    if (rename(tmp_filename, filename) != 0)
+    {
+        harp_set_error(HARP_ERROR_FILE_WRITE, "could not rename '%s' to '%s' (%s)", tmp_filename, filename,
+                       strerror(errno));
+        remove(tmp_filename);
+        free(tmp_filename);
+        return -1;
+    }
+    free(tmp_filename);
+
+    return 0;
+}
+
+static int scan_pending_serial(catalog *dataset_catalog, const char *options)
+{
+    long i;
+
+    for (i = 0; i < dataset_catalog->num_pending; i++)
+    {
+        catalog_entry *entry = &dataset_catalog->entry[dataset_catalog->pending_index[i]];
+
+        if (harp_import_product_metadata(entry->filename, options, &entry->metadata) != 0)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* Retrieve the metadata for all files in the catalog that are pending and add them to the dataset */
+static int scan_pending(harp_dataset *dataset, catalog *dataset_catalog, const char *options)
+{
+    long i;
+
+    if (dataset_catalog->num_pending == 0)
+    {
+        return 0;
+    }
+
+    if (scan_pending_serial(dataset_catalog, options) != 0)
+    {
+        return -1;
+    }
+
+    for (i = 0; i < dataset_catalog->num_pending; i++)
+    {
+        if (add_catalog_entry_to_dataset(dataset, &dataset_catalog->entry[dataset_catalog->pending_index[i]]) != 0)
+        {
+            return -1;
+        }
+    }
+    dataset_catalog->num_pending = 0;
+    dataset_catalog->modified = 1;
+
+    return 0;
+}
+
+/* Returns 1 if the catalog entry was created with the given options for the file in its current state */
+static int catalog_entry_is_up_to_date(const catalog_entry *entry, const char *options, long modification_time,
+                                       long file_size)
+{
+    return entry->modification_time == modification_time && entry->file_size == file_size &&
+        strcmp(entry->options, options == NULL ? "" : options) == 0;
+}
+
+/* Import a product file; if a catalog is provided then the cached metadata is used when it is still up-to-date and
+ * otherwise the file is queued for scanning */
+static int import_product_file(harp_dataset *dataset, const char *filename, const char *options,
+                               catalog *dataset_catalog)
+{
+    harp_product_metadata *metadata = NULL;
+    long modification_time;
+    long file_size;
+    long index;
+
+    if (dataset_catalog == NULL)
+    {
+        /* Import the metadata */
+        if (harp_import_product_metadata(filename, options, &metadata) != 0)
+        {
+            return -1;
+        }
+
+        return harp_dataset_add_product(dataset, metadata->source_product, metadata);
+    }
+
+    if (get_file_stamp(filename, &modification_time, &file_size) != 0)
+    {
+        return -1;
+    }
+    index = hashtable_get_index_from_name(dataset_catalog->filename_to_index, filename);
+    if (index >= 0)
+    {
+        catalog_entry *entry = &dataset_catalog->entry[index];
+
+        if (entry->metadata != NULL && catalog_entry_is_up_to_date(entry, options, modification_time, file_size))
+        {
+            return add_catalog_entry_to_dataset(dataset, entry);
+        }
+        if (entry->metadata == NULL)
+        {
+            /* already pending */
+            return 0;
+        }
+    }
+
+    return catalog_add_pending(dataset_catalog, filename, options, modification_time, file_size);
+}
+
+/* Import all products referenced by a catalog file; entries for files that no longer exist are ignored and files
+ * that changed since the catalog was created (or that were scanned with different options) are scanned again.
+ * If a catalog is provided then the up-to-date entries are also copied to that catalog.
+ */
+static int import_catalog_file(harp_dataset *dataset, const char *filename, const char *options,
+                               catalog *dataset_catalog)
+{
+    catalog *file_catalog;
+    long i;
+
+    if (catalog_new(&file_catalog) != 0)
+    {
+        return -1;
+    }
+    if (catalog_read(file_catalog, filename) != 0)
+    {
+        catalog_delete(file_catalog);
+        return -1;
+    }
+    for (i = 0; i < file_catalog->num_entries; i++)
+    {
+        catalog_entry *entry = &file_catalog->entry[i];
+        long modification_time;
+        long file_size;
+        long index;
+
+        if (get_file_stamp(entry->filename, &modification_time, &file_size) != 0)
+        {
+            if (harp_errno == HARP_ERROR_FILE_NOT_FOUND)
+            {
+                continue;
+            }
+            catalog_delete(file_catalog);
+            return -1;
+        }
+        if (catalog_entry_is_up_to_date(entry, options, modification_time, file_size))
+        {
+            if (add_catalog_entry_to_dataset(dataset, entry) != 0)
+            {
+                catalog_delete(file_catalog);
+                return -1;
+            }
+            index = -1;
+            if (dataset_catalog != NULL)
+            {
+                index = hashtable_get_index_from_name(dataset_catalog->filename_to_index, entry->filename);
+            }
+            if (dataset_catalog != NULL && (index < 0 || dataset_catalog->entry[index].metadata != NULL))
+            {
+                harp_product_metadata *metadata;
+
+                if (metadata_copy(entry->metadata, &metadata) != 0)
+                {
+                    catalog_delete(file_catalog);
+                    return -1;
+                }
+                if (catalog_set_entry(dataset_catalog, entry->filename, entry->options, modification_time, file_size,
+                                      metadata, NULL) != 0)
+                {
+                    catalog_delete(file_catalog);
+                    return -1;
+                }
+                dataset_catalog->modified = 1;
+            }
+        }
+        else if (import_product_file(dataset, entry->filename, options, dataset_catalog) != 0)
+        {
+            catalog_delete(file_catalog);
+            return -1;
+        }
+    }
+    catalog_delete(file_catalog);
+
+    return 0;
+}
+
+static int import_path(harp_dataset *dataset, const char *path, const char *options, catalog *dataset_catalog);
+
+static int add_path_file(harp_dataset *dataset, const char *filename, const char *options, catalog *dataset_catalog)
 {
     char line[HARP_MAX_PATH_LENGTH];
     FILE *stream;
@@ -112,7 +904,7 @@ static int add_path_file(harp_dataset *dataset, const char *filename, const char
         /* skip empty lines and lines starting with '#' */
         if (length > 0 && line[0] != '#')
         {
-            if (harp_dataset_import(dataset, line, options) != 0)
+            if (import_path(dataset, line, options, dataset_catalog) != 0)
             {
                 fclose(stream);
                 return -1;
@@ -125,7 +917,7 @@ static int add_path_file(harp_dataset *dataset, const char *filename, const char
     return 0;
 }
 
-static int add_directory(harp_dataset *dataset, const char *pathname, const char *options)
+static int add_directory(harp_dataset *dataset, const char *pathname, const char *options, catalog *dataset_catalog)
 {
 #ifdef WIN32
     WIN32_FIND_DATA FileData;
@@ -171,7 +963,7 @@ static int add_directory(harp_dataset *dataset, const char *pathname, const char
                 return -1;
             }
             sprintf(filepath, "%s\\%s", pathname, FileData.cFileName);
-            if (harp_dataset_import(dataset, filepath, options) != 0)
+            if (import_path(dataset, filepath, options, dataset_catalog) != 0)
             {
                 free(filepath);
                 FindClose(hSearch);
@@ -230,7 +1022,7 @@ static int add_directory(harp_dataset *dataset, const char *pathname, const char
         }
         sprintf(filepath, "%s/%s", pathname, dp->d_name);
 
-        if (harp_dataset_import(dataset, filepath, options) != 0)
+        if (import_path(dataset, filepath, options, dataset_catalog) != 0)
         {
             free(filepath);
             closedir(dirp);
@@ -245,6 +1037,40 @@ static int add_directory(harp_dataset *dataset, const char *pathname, const char
     return 0;
 }
 
+static int import_path(harp_dataset *dataset, const char *path, const char *options, catalog *dataset_catalog)
+{
+    long length;
+    int result;
+
+    result = is_directory(path);
+    if (result == -1)
+    {
+        return -1;
+    }
+    if (result)
+    {
+        return add_directory(dataset, path, options, dataset_catalog);
+    }
+
+    length = (long)strlen(path);
+    if (length > 4 && strcmp(&path[length - 4], ".pth") == 0)
+    {
+        return add_path_file(dataset, path, options, dataset_catalog);
+    }
+
+    result = is_catalog_file(path);
+    if (result == -1)
+    {
+        return -1;
+    }
+    if (result)
+    {
+        return import_catalog_file(dataset, path, options, dataset_catalog);
+    }
+
+    return import_product_file(dataset, path, options, dataset_catalog);
+}
+
 /** \addtogroup harp_dataset
  * @{
  */
@@ -352,6 +1178,9 @@ LIBHARP_API void harp_dataset_print(harp_dataset *dataset, int (*print) (const c
  * If path is a directory then all files (recursively) from that directory are added to the dataset.
  * If path references a .pth file then the file paths from that text file (one per line) are imported.
  * These file paths can be absolute or relative and can point to files, directories, or other .pth files.
+ * If path references a catalog file (see harp_dataset_import_with_catalog()) then the metadata of all products
+ * listed in the catalog is added to the dataset. Products that no longer exist are skipped and products that were
+ * modified after the catalog was created (or that were read with different ingestion options) are read again.
  * If path references a product file then that file is added to the dataset. Trying to add a file that is not supported
  * by HARP will result in an error.
  *
@@ -369,35 +1198,179 @@ LIBHARP_API void harp_dataset_print(harp_dataset *dataset, int (*print) (const c
  */
 LIBHARP_API int harp_dataset_import(harp_dataset *dataset, const char *path, const char *options)
 {
-    int result;
+    return import_path(dataset, path, options, NULL);
+}
 
-    result = is_directory(path);
-    if (result == -1)
+/** Import metadata for products into the dataset using a persistent catalog.
+ * This function behaves the same as harp_dataset_import(), but uses a catalog file to cache the metadata of
+ * products. For each product file, the metadata from the catalog is used if the modification time and size of the
+ * file are unchanged and the metadata was read using the same ingestion options. Only files that are not in the
+ * catalog (or that were modified or read with different options) are opened. The catalog file is created if it does
+ * not exist yet and is updated with the metadata of all newly read products.
+ * Entries in the catalog for files outside \a path are kept. If \a path is itself a catalog file then its up-to-date
+ * entries are copied to the catalog, which allows catalog files to be merged.
+ *
+ * The catalog is a csv file with the columns filename, options, modification_time, file_size, datetime_start,
+ * datetime_stop (both as days since 2000-01-01), the lengths of the time, latitude, longitude, vertical, and spectral
+ * dimensions, and source_product. The string columns are quoted. A catalog file can itself be passed as path to
+ * harp_dataset_import().
+ *
+ * The metadata of files is read sequentially. Applications can use harp_dataset_get_outdated_catalog_files() to
+ * distribute the reading of metadata over multiple processes (each updating its own catalog file) and then merge the
+ * resulting catalog files.
+ *
+ * \param dataset Dataset into which to import the metadata.
+ * \param path Path to either a directory containing product files, a .pth file, a catalog file, or a single product
+ * file.
+ * \param options Ingestion module specific options (optional); should be specified as a semi-colon separated
+ * string of key=value pair; only used for product files that are not already in HARP format.
+ * \param catalog_filename Path to the catalog file.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_dataset_import_with_catalog(harp_dataset *dataset, const char *path, const char *options,
+                                                 const char *catalog_filename)
+{
+    catalog *dataset_catalog;
+
+    if (catalog_filename == NULL)
     {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "catalog_filename is NULL");
         return -1;
     }
-    if (result)
+
+    if (catalog_new(&dataset_catalog) != 0)
     {
-        return add_directory(dataset, path, options);
+        return -1;
     }
-    else
+    if (catalog_read(dataset_catalog, catalog_filename) != 0)
     {
-        harp_product_metadata *metadata = NULL;
-        long length = (long)strlen(path);
-
-        if (length > 4 && strcmp(&path[length - 4], ".pth") == 0)
+        catalog_delete(dataset_catalog);
+        return -1;
+    }
+    if (import_path(dataset, path, options, dataset_catalog) != 0)
+    {
+        catalog_delete(dataset_catalog);
+        return -1;
+    }
+    if (scan_pending(dataset, dataset_catalog, options) != 0)
+    {
+        catalog_delete(dataset_catalog);
+        return -1;
+    }
+    if (dataset_catalog->modified)
+    {
+        if (catalog_write(dataset_catalog, catalog_filename) != 0)
         {
-            return add_path_file(dataset, path, options);
+            catalog_delete(dataset_catalog);
+            return -1;
         }
+    }
+    catalog_delete(dataset_catalog);
 
-        /* Import the metadata */
-        if (harp_import_product_metadata(path, options, &metadata) != 0)
+    return 0;
+}
+
+/** Determine which product files need to be read to bring a catalog up-to-date.
+ * This returns the files in \a path for which harp_dataset_import_with_catalog() would read the metadata, because
+ * they are not in the catalog yet, or because they were modified or read with different ingestion options. Neither
+ * the files nor the catalog are modified.
+ * The returned array and each of its filenames should be freed with harp_free().
+ * \param path Path to either a directory containing product files, a .pth file, a catalog file, or a single product
+ * file.
+ * \param options Ingestion module specific options (optional); should be specified as a semi-colon separated
+ * string of key=value pair.
+ * \param catalog_filename Path to the catalog file (a catalog file that does not exist is treated as empty).
+ * \param num_files Pointer to the C variable where the number of outdated files will be stored.
+ * \param filename Pointer to the C variable where the array of outdated filenames will be stored (NULL if there are no
+ * outdated files).
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_dataset_get_outdated_catalog_files(const char *path, const char *options,
+                                                        const char *catalog_filename, long *num_files,
+                                                        char ***filename)
+{
+    catalog *dataset_catalog;
+    harp_dataset *dataset;
+    char **outdated_filename = NULL;
+    long i;
+
+    if (catalog_filename == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "catalog_filename is NULL");
+        return -1;
+    }
+    if (num_files == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "num_files is NULL");
+        return -1;
+    }
+    if (filename == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "filename is NULL");
+        return -1;
+    }
+
+    if (catalog_new(&dataset_catalog) != 0)
+    {
+        return -1;
+    }
+    if (catalog_read(dataset_catalog, catalog_filename) != 0)
+    {
+        catalog_delete(dataset_catalog);
+        return -1;
+    }
+    /* the dataset only receives the up-to-date entries, which we don't need */
+    if (harp_dataset_new(&dataset) != 0)
+    {
+        catalog_delete(dataset_catalog);
+        return -1;
+    }
+    if (import_path(dataset, path, options, dataset_catalog) != 0)
+    {
+        harp_dataset_delete(dataset);
+        catalog_delete(dataset_catalog);
+        return -1;
+    }
+    harp_dataset_delete(dataset);
+
+    if (dataset_catalog->num_pending > 0)
+    {
+        outdated_filename = (char **)malloc(dataset_catalog->num_pending * sizeof(char *));
+        if (outdated_filename == NULL)
         {
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                           dataset_catalog->num_pending * sizeof(char *), __FILE__, __LINE__);
+            catalog_delete(dataset_catalog);
             return -1;
         }
-
-        return harp_dataset_add_product(dataset, metadata->source_product, metadata);
+        for (i = 0; i < dataset_catalog->num_pending; i++)
+        {
+            outdated_filename[i] = strdup(dataset_catalog->entry[dataset_catalog->pending_index[i]].filename);
+            if (outdated_filename[i] == NULL)
+            {
+                harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not duplicate string) (%s:%u)",
+                               __FILE__, __LINE__);
+                while (i > 0)
+                {
+                    i--;
+                    free(outdated_filename[i]);
+                }
+                free(outdated_filename);
+                catalog_delete(dataset_catalog);
+                return -1;
+            }
+        }
     }
+
+    *num_files = dataset_catalog->num_pending;
+    *filename = outdated_filename;
+    catalog_delete(dataset_catalog);
+
+    return 0;
 }
 
 /** Lookup the index of source_product in the given dataset.
@@ -459,6 +1432,8 @@ LIBHARP_API int harp_dataset_add_product(harp_dataset *dataset, const char *sour
     if (!harp_dataset_has_product(dataset, source_product))
     {
         long index;
+        long lower;
+        long upper;
         long i;
 
         /* Make space for new entry */
@@ -506,13 +1481,23 @@ LIBHARP_API int harp_dataset_add_product(harp_dataset *dataset, const char *sour
             }
         }
 
-        /* add newly appended item into the list of sorted indices */
-        index = 0;
-        while (index < dataset->num_products &&
-               strcmp(source_product, dataset->source_product[dataset->sorted_index[index]]) > 0)
+        /* add newly appended item into the list of sorted indices (using a binary search for the position) */
+        lower = 0;
+        upper = dataset->num_products;
+        while (lower < upper)
         {
-            index++;
+            long middle = lower + (upper - lower) / 2;
+
+            if (strcmp(source_product, dataset->source_product[dataset->sorted_index[middle]]) > 0)
+            {
+                lower = middle + 1;
+            }
+            else
+            {
+                upper = middle;
+            }
         }
+        index = lower;
         for (i = dataset->num_products; i > index; i--)
         {
             dataset->sorted_index[i] = dataset->sorted_index[i - 1];
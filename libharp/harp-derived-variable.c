@@ -1017,6 +1017,89 @@ int harp_variable_conversion_set_source_description(harp_variable_conversion *co
     return 0;
 }
 
+/* Determine whether the variable source_variable_name can be used (directly or via intermediate derivations) when
+ * deriving the variable with the given name and dimensions. All conversions are taken into account (also the ones that
+ * are currently disabled). Returns 1 if the variable can be used or if this could not be determined, and 0 otherwise.
+ */
+int harp_derived_variable_may_use_source(const char *variable_name, int num_dimensions,
+                                         const harp_dimension_type *dimension_type, const char *source_variable_name)
+{
+    char *dimsvar_name;
+    uint8_t *visited;
+    long *stack;
+    long stack_size = 0;
+    long index;
+    int result = 0;
+
+    if (harp_derived_variable_conversions == NULL)
+    {
+        return 1;
+    }
+
+    dimsvar_name = get_dimsvar_name(variable_name, num_dimensions, dimension_type);
+    if (dimsvar_name == NULL)
+    {
+        return 1;
+    }
+    index = hashtable_get_index_from_name(harp_derived_variable_conversions->hash_data, dimsvar_name);
+    free(dimsvar_name);
+    if (index < 0)
+    {
+        /* the variable can not be derived */
+        return 0;
+    }
+
+    visited = calloc(harp_derived_variable_conversions->num_variables, sizeof(uint8_t));
+    if (visited == NULL)
+    {
+        return 1;
+    }
+    stack = malloc(harp_derived_variable_conversions->num_variables * sizeof(long));
+    if (stack == NULL)
+    {
+        free(visited);
+        return 1;
+    }
+
+    visited[index] = 1;
+    stack[stack_size++] = index;
+    while (stack_size > 0 && !result)
+    {
+        harp_variable_conversion_list *conversion_list;
+        int i;
+
+        conversion_list = harp_derived_variable_conversions->conversions_for_variable[stack[--stack_size]];
+        for (i = 0; i < conversion_list->num_conversions && !result; i++)
+        {
+            harp_variable_conversion *conversion = conversion_list->conversion[i];
+            int j;
+
+            for (j = 0; j < conversion->num_source_variables; j++)
+            {
+                harp_source_variable_definition *source_definition = &conversion->source_definition[j];
+
+                if (strcmp(source_definition->variable_name, source_variable_name) == 0)
+                {
+                    result = 1;
+                    break;
+                }
+                index = hashtable_get_index_from_name(harp_derived_variable_conversions->hash_data,
+                                                      source_definition->dimsvar_name);
+                if (index >= 0 && !visited[index])
+                {
+                    visited[index] = 1;
+                    stack[stack_size++] = index;
+                }
+            }
+        }
+    }
+
+    free(stack);
+    free(visited);
+
+    return result;
+}
+
 /** Print the full listing of available variable conversions.
  * \ingroup harp_documentation
  * If product is NULL then all possible conversions will be printed. If a product is provided then only conversions
@@ -646,3 +646,131 @@ int harp_dimension_mask_set_simplify(harp_dimension_mask_set *dimension_mask_set
 
     return 0;
 }
+
+/* Determine the runs of consecutive set entries in the mask (per row for 2-D masks). The runs only need to be computed
+ * once per mask and can then be used to filter any number of arrays using block copies.
+ */
+int harp_dimension_mask_runs_new(const harp_dimension_mask *dimension_mask, harp_dimension_mask_runs **new_runs)
+{
+    harp_dimension_mask_runs *runs;
+    const uint8_t *mask;
+    long row_length;
+    long num_runs;
+    long i, j;
+
+    assert(dimension_mask != NULL);
+    assert(dimension_mask->num_dimensions == 1 || dimension_mask->num_dimensions == 2);
+
+    runs = (harp_dimension_mask_runs *)malloc(sizeof(harp_dimension_mask_runs));
+    if (runs == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       sizeof(harp_dimension_mask_runs), __FILE__, __LINE__);
+        return -1;
+    }
+    runs->num_rows = (dimension_mask->num_dimensions == 2 ? dimension_mask->dimension[0] : 1);
+    runs->row_first_run = NULL;
+    runs->num_runs = 0;
+    runs->offset = NULL;
+    runs->length = NULL;
+
+    row_length = dimension_mask->dimension[dimension_mask->num_dimensions - 1];
+
+    /* count the number of runs */
+    num_runs = 0;
+    mask = dimension_mask->mask;
+    for (i = 0; i < runs->num_rows; i++)
+    {
+        for (j = 0; j < row_length; j++)
+        {
+            if (mask[j] && (j == 0 || !mask[j - 1]))
+            {
+                num_runs++;
+            }
+        }
+        mask += row_length;
+    }
+
+    runs->row_first_run = (long *)malloc((runs->num_rows + 1) * sizeof(long));
+    if (runs->row_first_run == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       (runs->num_rows + 1) * sizeof(long), __FILE__, __LINE__);
+        harp_dimension_mask_runs_delete(runs);
+        return -1;
+    }
+    if (num_runs > 0)
+    {
+        runs->offset = (long *)malloc(num_runs * sizeof(long));
+        if (runs->offset == NULL)
+        {
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                           num_runs * sizeof(long), __FILE__, __LINE__);
+            harp_dimension_mask_runs_delete(runs);
+            return -1;
+        }
+        runs->length = (long *)malloc(num_runs * sizeof(long));
+        if (runs->length == NULL)
+        {
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                           num_runs * sizeof(long), __FILE__, __LINE__);
+            harp_dimension_mask_runs_delete(runs);
+            return -1;
+        }
+    }
+
+    /* store the runs */
+    mask = dimension_mask->mask;
+    for (i = 0; i < runs->num_rows; i++)
+    {
+        runs->row_first_run[i] = runs->num_runs;
+        j = 0;
+        while (j < row_length)
+        {
+            long start;
+
+            while (j < row_length && !mask[j])
+            {
+                j++;
+            }
+            if (j == row_length)
+            {
+                break;
+            }
+            start = j;
+            while (j < row_length && mask[j])
+            {
+                j++;
+            }
+            runs->offset[runs->num_runs] = start;
+            runs->length[runs->num_runs] = j - start;
+            runs->num_runs++;
+        }
+        mask += row_length;
+    }
+    runs->row_first_run[runs->num_rows] = runs->num_runs;
+    assert(runs->num_runs == num_runs);
+
+    *new_runs = runs;
+    return 0;
+}
+
+void harp_dimension_mask_runs_delete(harp_dimension_mask_runs *runs)
+{
+    if (runs != NULL)
+    {
+        if (runs->row_first_run != NULL)
+        {
+            free(runs->row_first_run);
+        }
+        if (runs->offset != NULL)
+        {
+            free(runs->offset);
+        }
+        if (runs->length != NULL)
+        {
+            free(runs->length);
+        }
+        free(runs);
+    }
+}
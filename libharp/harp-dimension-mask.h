@@ -48,6 +48,18 @@ typedef struct harp_dimension_mask_struct
 
 typedef harp_dimension_mask *harp_dimension_mask_set;
 
+/* Runs of consecutive indices that are set in a dimension mask. For a 2-D mask the runs are determined per row, and run
+ * offsets are relative to the start of the row.
+ */
+typedef struct harp_dimension_mask_runs_struct
+{
+    long num_rows;
+    long *row_first_run;        /* [num_rows + 1], index of the first run of each row (the last entry is num_runs) */
+    long num_runs;
+    long *offset;       /* [num_runs] */
+    long *length;       /* [num_runs] */
+} harp_dimension_mask_runs;
+
 int harp_dimension_mask_new(int num_dimensions, const long *dimension, harp_dimension_mask **new_dimension_mask);
 void harp_dimension_mask_delete(harp_dimension_mask *dimension_mask);
 int harp_dimension_mask_copy(const harp_dimension_mask *other_dimension_mask, harp_dimension_mask **new_dimension_mask);
@@ -69,4 +81,7 @@ int harp_dimension_mask_merge(const harp_dimension_mask *dimension_mask, int dim
                               harp_dimension_mask *merged_dimension_mask);
 int harp_dimension_mask_set_simplify(harp_dimension_mask_set *dimension_mask_set);
 
+int harp_dimension_mask_runs_new(const harp_dimension_mask *dimension_mask, harp_dimension_mask_runs **new_runs);
+void harp_dimension_mask_runs_delete(harp_dimension_mask_runs *runs);
+
 #endif
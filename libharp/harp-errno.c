@@ -254,27 +254,33 @@ LIBHARP_API void harp_set_error(int err, const char *message, ...)
 {
     va_list ap;
 
-    harp_errno = err;
+    /* operations that process variables in parallel can report errors from multiple threads */
+#ifdef _OPENMP
+#pragma omp critical (harp_set_error)
+#endif
+    {
+        harp_errno = err;
 
-    va_start(ap, message);
-    set_error_message_vargs(message, ap);
-    va_end(ap);
+        va_start(ap, message);
+        set_error_message_vargs(message, ap);
+        va_end(ap);
 
 #ifdef HAVE_HDF4
-    if (err == HARP_ERROR_HDF4 && message == NULL)
-    {
-        harp_hdf4_add_error_message();
-    }
+        if (err == HARP_ERROR_HDF4 && message == NULL)
+        {
+            harp_hdf4_add_error_message();
+        }
 #endif
 #ifdef HAVE_HDF5
-    if (err == HARP_ERROR_HDF5 && message == NULL)
-    {
-        harp_hdf5_add_error_message();
-    }
+        if (err == HARP_ERROR_HDF5 && message == NULL)
+        {
+            harp_hdf5_add_error_message();
+        }
 #endif
-    if (err == HARP_ERROR_CODA && message == NULL)
-    {
-        harp_add_error_message("%s", coda_errno_to_string(coda_errno));
+        if (err == HARP_ERROR_CODA && message == NULL)
+        {
+            harp_add_error_message("%s", coda_errno_to_string(coda_errno));
+        }
     }
 }
 
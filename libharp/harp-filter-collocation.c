@@ -38,6 +38,25 @@
 
 #define COLLOCATION_MASK_BLOCK_SIZE 1024
 
+/* Products that are imported as collocated product (product b of a collocation result) are kept in a least recently
+ * used cache, such that e.g. smoothing a series of products against the same model files only imports each model file
+ * once. The maximum total (in-memory) size of the cached products is set by the collocated_product_cache_size option.
+ */
+typedef struct collocated_product_cache_entry_struct
+{
+    char *filename;
+    harp_product *product;
+    int64_t size;
+    struct collocated_product_cache_entry_struct *prev; /* more recently used entry */
+    struct collocated_product_cache_entry_struct *next; /* less recently used entry */
+} collocated_product_cache_entry;
+
+static collocated_product_cache_entry *cache_first = NULL;      /* most recently used entry */
+static collocated_product_cache_entry *cache_last = NULL;       /* least recently used entry */
+static int64_t cache_size = 0;
+static long cache_num_hits = 0;
+static long cache_num_misses = 0;
+
 static int compare_by_index(const void *a, const void *b)
 {
     harp_collocation_index_pair *pair_a = (harp_collocation_index_pair *)a;
@@ -142,9 +161,9 @@ static void collocation_mask_sort_by_collocation_index(harp_collocation_mask *ma
     qsort(mask->index_pair, mask->num_index_pairs, sizeof(harp_collocation_index_pair), compare_by_collocation_index);
 }
 
-static int collocation_mask_from_result(const harp_collocation_result *collocation_result,
-                                        harp_collocation_filter_type filter_type, const char *source_product,
-                                        harp_collocation_mask **new_mask)
+int harp_collocation_mask_from_result(const harp_collocation_result *collocation_result,
+                                      harp_collocation_filter_type filter_type, const char *source_product,
+                                      harp_collocation_mask **new_mask)
 {
     long i;
     long product_index = -1;
@@ -184,17 +203,15 @@ static int collocation_mask_from_result(const harp_collocation_result *collocati
     /* if product_index is -1, no match will be found */
     for (i = 0; i < collocation_result->num_pairs && product_index >= 0; i++)
     {
-        const harp_collocation_pair *pair;
-
-        pair = collocation_result->pair[i];
         if (filter_type == harp_collocation_left)
         {
-            if (pair->product_index_a != product_index)
+            if (collocation_result->pair_data->product_index_a[i] != product_index)
             {
                 continue;
             }
 
-            if (collocation_mask_add_index_pair(mask, pair->collocation_index, pair->sample_index_a) != 0)
+            if (collocation_mask_add_index_pair(mask, collocation_result->pair_data->collocation_index[i],
+                                                collocation_result->pair_data->sample_index_a[i]) != 0)
             {
                 harp_collocation_mask_delete(mask);
                 return -1;
@@ -202,12 +219,13 @@ static int collocation_mask_from_result(const harp_collocation_result *collocati
         }
         else
         {
-            if (pair->product_index_b != product_index)
+            if (collocation_result->pair_data->product_index_b[i] != product_index)
             {
                 continue;
             }
 
-            if (collocation_mask_add_index_pair(mask, pair->collocation_index, pair->sample_index_b) != 0)
+            if (collocation_mask_add_index_pair(mask, collocation_result->pair_data->collocation_index[i],
+                                                collocation_result->pair_data->sample_index_b[i]) != 0)
             {
                 harp_collocation_mask_delete(mask);
                 return -1;
@@ -249,7 +267,7 @@ int harp_collocation_mask_import(const char *filename, harp_collocation_filter_t
         return -1;
     }
 
-    if (collocation_mask_from_result(collocation_result, filter_type, source_product, &mask) != 0)
+    if (harp_collocation_mask_from_result(collocation_result, filter_type, source_product, &mask) != 0)
     {
         harp_collocation_result_delete(collocation_result);
         return -1;
@@ -519,13 +537,221 @@ int harp_product_apply_collocation_mask(harp_product *product, harp_collocation_
     return 0;
 }
 
+static int64_t get_max_cache_size(void)
+{
+    return (int64_t)harp_get_option_collocated_product_cache_size() * 1024 * 1024;
+}
+
+static void cache_unlink_entry(collocated_product_cache_entry *entry)
+{
+    if (entry->prev != NULL)
+    {
+        entry->prev->next = entry->next;
+    }
+    else
+    {
+        cache_first = entry->next;
+    }
+    if (entry->next != NULL)
+    {
+        entry->next->prev = entry->prev;
+    }
+    else
+    {
+        cache_last = entry->prev;
+    }
+    entry->prev = NULL;
+    entry->next = NULL;
+}
+
+static void cache_link_entry_first(collocated_product_cache_entry *entry)
+{
+    entry->prev = NULL;
+    entry->next = cache_first;
+    if (cache_first != NULL)
+    {
+        cache_first->prev = entry;
+    }
+    else
+    {
+        cache_last = entry;
+    }
+    cache_first = entry;
+}
+
+static void cache_entry_delete(collocated_product_cache_entry *entry)
+{
+    if (entry->filename != NULL)
+    {
+        free(entry->filename);
+    }
+    if (entry->product != NULL)
+    {
+        harp_product_delete(entry->product);
+    }
+    free(entry);
+}
+
+/* remove least recently used entries until the total size of the cache is at most max_size */
+static void cache_evict(int64_t max_size)
+{
+    while (cache_last != NULL && cache_size > max_size)
+    {
+        collocated_product_cache_entry *entry = cache_last;
+
+        cache_unlink_entry(entry);
+        cache_size -= entry->size;
+        cache_entry_delete(entry);
+    }
+}
+
+static collocated_product_cache_entry *cache_find(const char *filename)
+{
+    collocated_product_cache_entry *entry;
+
+    for (entry = cache_first; entry != NULL; entry = entry->next)
+    {
+        if (strcmp(entry->filename, filename) == 0)
+        {
+            /* move the entry to the front of the list */
+            if (entry != cache_first)
+            {
+                cache_unlink_entry(entry);
+                cache_link_entry_first(entry);
+            }
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+/* add a product to the cache (ownership of the product is transferred to the cache) */
+static int cache_add(const char *filename, harp_product *product, int64_t size)
+{
+    collocated_product_cache_entry *entry;
+
+    entry = (collocated_product_cache_entry *)malloc(sizeof(collocated_product_cache_entry));
+    if (entry == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       sizeof(collocated_product_cache_entry), __FILE__, __LINE__);
+        harp_product_delete(product);
+        return -1;
+    }
+    entry->product = product;
+    entry->size = size;
+    entry->prev = NULL;
+    entry->next = NULL;
+    entry->filename = strdup(filename);
+    if (entry->filename == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not duplicate string) (%s:%u)", __FILE__,
+                       __LINE__);
+        cache_entry_delete(entry);
+        return -1;
+    }
+
+    cache_evict(get_max_cache_size() - size);
+    cache_link_entry_first(entry);
+    cache_size += size;
+
+    return 0;
+}
+
+/* Reduce the collocated product cache to the current collocated_product_cache_size option value */
+void harp_collocated_product_cache_trim(void)
+{
+    cache_evict(get_max_cache_size());
+}
+
+/* Remove all products from the collocated product cache and reset the cache statistics */
+void harp_collocated_product_cache_done(void)
+{
+    cache_evict(-1);
+    cache_num_hits = 0;
+    cache_num_misses = 0;
+}
+
+/** Retrieve the usage statistics of the collocated product cache.
+ * \ingroup harp_general
+ * Products that are used as collocated product by the smoothing, regridding, and derive_smoothed_column operations
+ * that take a collocated dataset are cached in memory (see harp_set_option_collocated_product_cache_size()).
+ * This function returns how often a requested product was taken from the cache (hit) and how often a product had to
+ * be imported (miss) since harp_init().
+ * \param num_hits Pointer to the C variable where the number of cache hits will be stored (can be NULL).
+ * \param num_misses Pointer to the C variable where the number of cache misses will be stored (can be NULL).
+ */
+LIBHARP_API void harp_get_collocated_product_cache_statistics(long *num_hits, long *num_misses)
+{
+    if (num_hits != NULL)
+    {
+        *num_hits = cache_num_hits;
+    }
+    if (num_misses != NULL)
+    {
+        *num_misses = cache_num_misses;
+    }
+}
+
+/* Import a collocated product (using the collocated product cache) */
+static int import_collocated_product(const char *filename, harp_product **product)
+{
+    collocated_product_cache_entry *entry;
+    harp_product *imported_product;
+    int64_t max_size;
+    int64_t size;
+
+    entry = cache_find(filename);
+    if (entry != NULL)
+    {
+        cache_num_hits++;
+        /* the caller will filter the product, so provide a copy */
+        return harp_product_copy(entry->product, product);
+    }
+
+    cache_num_misses++;
+    if (harp_import(filename, NULL, NULL, &imported_product) != 0)
+    {
+        return -1;
+    }
+
+    max_size = get_max_cache_size();
+    if (max_size > 0)
+    {
+        if (harp_product_get_storage_size(imported_product, 0, &size) != 0)
+        {
+            harp_product_delete(imported_product);
+            return -1;
+        }
+        if (size <= max_size)
+        {
+            if (harp_product_copy(imported_product, product) != 0)
+            {
+                harp_product_delete(imported_product);
+                return -1;
+            }
+            if (cache_add(filename, imported_product, size) != 0)
+            {
+                harp_product_delete(*product);
+                return -1;
+            }
+            return 0;
+        }
+    }
+
+    *product = imported_product;
+
+    return 0;
+}
+
 static int get_collocated_product(harp_collocation_result *collocation_result, const char *source_product_b,
                                   harp_product **product)
 {
     harp_collocation_mask *mask;
     harp_product_metadata *product_metadata;
     harp_product *collocated_product;
-    harp_collocation_pair *pair;
+    long product_index;
 
     if (harp_collocation_result_filter_for_source_product_b(collocation_result, source_product_b) != 0)
     {
@@ -537,21 +763,21 @@ static int get_collocated_product(harp_collocation_result *collocation_result, c
         return 0;
     }
     /* use product b reference from first pair to find and import product */
-    pair = collocation_result->pair[0];
-    product_metadata = collocation_result->dataset_b->metadata[pair->product_index_b];
+    product_index = collocation_result->pair_data->product_index_b[0];
+    product_metadata = collocation_result->dataset_b->metadata[product_index];
     if (product_metadata == NULL)
     {
         harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "missing product metadata for product %s",
-                       collocation_result->dataset_b->source_product[pair->product_index_b]);
+                       collocation_result->dataset_b->source_product[product_index]);
         return -1;
     }
 
-    if (collocation_mask_from_result(collocation_result, harp_collocation_right, source_product_b, &mask) != 0)
+    if (harp_collocation_mask_from_result(collocation_result, harp_collocation_right, source_product_b, &mask) != 0)
     {
         return -1;
     }
 
-    if (harp_import(product_metadata->filename, NULL, NULL, &collocated_product) != 0)
+    if (import_collocated_product(product_metadata->filename, &collocated_product) != 0)
     {
         harp_set_error(HARP_ERROR_IMPORT, "could not import file %s", product_metadata->filename);
         harp_collocation_mask_delete(mask);
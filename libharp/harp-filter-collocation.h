@@ -47,6 +47,9 @@ typedef struct harp_collocation_mask_struct
 } harp_collocation_mask;
 
 void harp_collocation_mask_delete(harp_collocation_mask *mask);
+int harp_collocation_mask_from_result(const harp_collocation_result *collocation_result,
+                                      harp_collocation_filter_type filter_type, const char *source_product,
+                                      harp_collocation_mask **new_mask);
 int harp_collocation_mask_import(const char *filename, harp_collocation_filter_type filter_type,
                                  long min_collocation_index, long max_collocation_index,
                                  const char *original_filename, harp_collocation_mask **new_mask);
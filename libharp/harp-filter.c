@@ -47,203 +47,211 @@ static void free_string_data(char **first, char **last)
     }
 }
 
-static void filter_array_int8(long num_source_elements, const uint8_t *mask, const int8_t *source,
-                              long num_target_elements, int8_t *target)
+/* Move num_elements elements from source to target. The arrays may overlap as long as target <= source. For strings
+ * the ownership of the strings is moved to the target and any string that was still present at the target is freed.
+ * If owns_strings is 0 (i.e. the strings are part of a string arena) the string pointers are moved as plain data.
+ */
+static void move_elements(harp_data_type data_type, int owns_strings, long num_elements, char *source, char *target)
 {
-    const int8_t *source_end;
-    int8_t *target_end;
+    if (num_elements <= 0 || source == target)
+    {
+        return;
+    }
 
-    target_end = target + num_target_elements;
-    for (source_end = source + num_source_elements; source != source_end; source++, mask++)
+    if (data_type == harp_type_string && owns_strings)
     {
-        if (*mask)
+        char **source_string = (char **)source;
+        char **target_string = (char **)target;
+        long i;
+
+        for (i = 0; i < num_elements; i++)
         {
-            *target = *source;
-            target++;
-            num_target_elements--;
+            if (target_string[i] != NULL)
+            {
+                free(target_string[i]);
+            }
+            target_string[i] = source_string[i];
+            source_string[i] = NULL;
         }
     }
-
-    for (; target != target_end; target++)
+    else
     {
-        *target = 0;
+        memmove(target, source, num_elements * harp_get_size_for_type(data_type));
     }
 }
 
-static void filter_array_int16(long num_source_elements, const uint8_t *mask, const int16_t *source,
-                               long num_target_elements, int16_t *target)
+/* Set num_elements elements of target to the null value for the data type (strings are freed if owns_strings is set).
+ */
+static void null_elements(harp_data_type data_type, int owns_strings, long num_elements, char *target)
 {
-    const int16_t *source_end;
-    int16_t *target_end;
+    harp_array array;
+
+    if (num_elements <= 0)
+    {
+        return;
+    }
 
-    target_end = target + num_target_elements;
-    for (source_end = source + num_source_elements; source != source_end; source++, mask++)
+    if (data_type == harp_type_string)
     {
-        if (*mask)
+        if (owns_strings)
+        {
+            free_string_data((char **)target, ((char **)target) + num_elements);
+        }
+        else
         {
-            *target = *source;
-            target++;
-            num_target_elements--;
+            memset(target, 0, num_elements * sizeof(char *));
         }
     }
-
-    for (; target != target_end; target++)
+    else
     {
-        *target = 0;
+        array.ptr = target;
+        harp_array_null(data_type, num_elements, array);
     }
 }
 
-static void filter_array_int32(long num_source_elements, const uint8_t *mask, const int32_t *source,
-                               long num_target_elements, int32_t *target)
+static void filter_array(harp_data_type data_type, long num_source_elements, const uint8_t *mask, harp_array source,
+                         long num_target_elements, harp_array target)
 {
-    const int32_t *source_end;
-    int32_t *target_end;
+    long element_size = harp_get_size_for_type(data_type);
+    char *source_data = (char *)source.ptr;
+    char *target_data = (char *)target.ptr;
+    long num_copied = 0;
+    long i = 0;
 
-    target_end = target + num_target_elements;
-    for (source_end = source + num_source_elements; source != source_end; source++, mask++)
+    if (mask == NULL)
     {
-        if (*mask)
-        {
-            *target = *source;
-            target++;
-            num_target_elements--;
-        }
+        assert(num_source_elements == num_target_elements);
+        move_elements(data_type, 1, num_source_elements, source_data, target_data);
+        return;
     }
 
-    for (; target != target_end; target++)
+    /* copy each run of consecutive elements that should be kept as a single block */
+    while (i < num_source_elements)
     {
-        *target = 0;
-    }
-}
+        long start;
 
-static void filter_array_float(long num_source_elements, const uint8_t *mask, const float *source,
-                               long num_target_elements, float *target)
-{
-    const float *source_end;
-    float *target_end;
-
-    target_end = target + num_target_elements;
-    for (source_end = source + num_source_elements; source != source_end; source++, mask++)
-    {
-        if (*mask)
+        while (i < num_source_elements && !mask[i])
         {
-            *target = *source;
-            target++;
+            i++;
+        }
+        start = i;
+        while (i < num_source_elements && mask[i])
+        {
+            i++;
+        }
+        if (i > start)
+        {
+            move_elements(data_type, 1, i - start, source_data + start * element_size,
+                          target_data + num_copied * element_size);
+            num_copied += i - start;
         }
     }
+    assert(num_copied <= num_target_elements);
 
-    for (; target != target_end; target++)
-    {
-        *target = (float)harp_nan();
-    }
+    null_elements(data_type, 1, num_target_elements - num_copied, target_data + num_copied * element_size);
 }
 
-static void filter_array_double(long num_source_elements, const uint8_t *mask, const double *source,
-                                long num_target_elements, double *target)
+/* Runs of indices to keep for a single dimension (a single row in case of a 2-D mask). If offset is NULL all indices
+ * are kept.
+ */
+typedef struct filter_runs_struct
 {
-    const double *source_end;
-    double *target_end;
+    long num_runs;
+    const long *offset;
+    const long *length;
+} filter_runs;
 
-    target_end = target + num_target_elements;
-    for (source_end = source + num_source_elements; source != source_end; source++, mask++)
+static void get_filter_runs(const harp_dimension_mask_runs *runs, long row, filter_runs *row_runs)
+{
+    if (runs == NULL)
     {
-        if (*mask)
-        {
-            *target = *source;
-            target++;
-        }
+        row_runs->num_runs = 0;
+        row_runs->offset = NULL;
+        row_runs->length = NULL;
+        return;
     }
 
-    for (; target != target_end; target++)
-    {
-        *target = harp_nan();
-    }
+    row_runs->num_runs = runs->row_first_run[row + 1] - runs->row_first_run[row];
+    row_runs->offset = &runs->offset[runs->row_first_run[row]];
+    row_runs->length = &runs->length[runs->row_first_run[row]];
 }
 
-static void filter_array_string(long num_source_elements, const uint8_t *mask, char **source,
-                                long num_target_elements, char **target)
+/* Filter the source array into the target array using a list of runs of indices to keep for each dimension. Runs of
+ * the outer dimension are moved as single blocks whenever none of the inner dimensions are filtered.
+ */
+static void filter_array_with_runs(harp_data_type data_type, int owns_strings, int num_dimensions,
+                                   const long *source_dimension, const filter_runs *runs, harp_array source,
+                                   const long *target_dimension, harp_array target)
 {
-    char **source_end;
-    char **target_end;
-
-    target_end = target + num_target_elements;
-    for (source_end = source + num_source_elements; source != source_end; source++, mask++)
+    long element_size = harp_get_size_for_type(data_type);
+    char *source_data = (char *)source.ptr;
+    char *target_data = (char *)target.ptr;
+    long source_block_length = 1;
+    long target_block_length = 1;
+    long num_runs, full_offset, full_length;
+    const long *run_offset;
+    const long *run_length;
+    long num_copied = 0;
+    int inner_dimensions_filtered = 0;
+    long i, k;
+
+    for (i = 1; i < num_dimensions; i++)
     {
-        if (*mask)
+        source_block_length *= source_dimension[i];
+        target_block_length *= target_dimension[i];
+        if (runs[i].offset != NULL)
         {
-            if (target != source)
-            {
-                if (*target != NULL)
-                {
-                    free(*target);
-                }
-
-                *target = *source;
-                *source = NULL;
-            }
-
-            target++;
-            num_target_elements--;
+            inner_dimensions_filtered = 1;
         }
     }
 
-    free_string_data(target, target_end);
-}
-
-static void filter_array(harp_data_type data_type, long num_source_elements, const uint8_t *mask, harp_array source,
-                         long num_target_elements, harp_array target)
-{
-    if (mask == NULL)
+    if (runs[0].offset == NULL)
     {
-        assert(num_source_elements == num_target_elements);
+        full_offset = 0;
+        full_length = source_dimension[0];
+        num_runs = 1;
+        run_offset = &full_offset;
+        run_length = &full_length;
+    }
+    else
+    {
+        num_runs = runs[0].num_runs;
+        run_offset = runs[0].offset;
+        run_length = runs[0].length;
+    }
 
-        if (target.ptr != source.ptr)
+    if (!inner_dimensions_filtered)
+    {
+        assert(source_block_length == target_block_length);
+        for (i = 0; i < num_runs; i++)
         {
-            if (data_type == harp_type_string)
-            {
-                free_string_data(target.string_data, target.string_data + num_target_elements);
-            }
-
-            memcpy(target.ptr, source.ptr, num_target_elements * harp_get_size_for_type(data_type));
-
-            if (data_type == harp_type_string)
-            {
-                memset(source.ptr, 0, num_source_elements * harp_get_size_for_type(data_type));
-            }
+            move_elements(data_type, owns_strings, run_length[i] * source_block_length,
+                          source_data + run_offset[i] * source_block_length * element_size,
+                          target_data + num_copied * target_block_length * element_size);
+            num_copied += run_length[i];
         }
     }
     else
     {
-        switch (data_type)
-        {
-            case harp_type_int8:
-                filter_array_int8(num_source_elements, mask, source.int8_data, num_target_elements, target.int8_data);
-                break;
-            case harp_type_int16:
-                filter_array_int16(num_source_elements, mask, source.int16_data, num_target_elements,
-                                   target.int16_data);
-                break;
-            case harp_type_int32:
-                filter_array_int32(num_source_elements, mask, source.int32_data, num_target_elements,
-                                   target.int32_data);
-                break;
-            case harp_type_float:
-                filter_array_float(num_source_elements, mask, source.float_data, num_target_elements,
-                                   target.float_data);
-                break;
-            case harp_type_double:
-                filter_array_double(num_source_elements, mask, source.double_data, num_target_elements,
-                                    target.double_data);
-                break;
-            case harp_type_string:
-                filter_array_string(num_source_elements, mask, source.string_data, num_target_elements,
-                                    target.string_data);
-                break;
-            default:
-                assert(0);
-                exit(1);
+        for (i = 0; i < num_runs; i++)
+        {
+            for (k = run_offset[i]; k < run_offset[i] + run_length[i]; k++)
+            {
+                harp_array sub_source;
+                harp_array sub_target;
+
+                sub_source.ptr = source_data + k * source_block_length * element_size;
+                sub_target.ptr = target_data + num_copied * target_block_length * element_size;
+                filter_array_with_runs(data_type, owns_strings, num_dimensions - 1, &source_dimension[1], &runs[1],
+                                       sub_source, &target_dimension[1], sub_target);
+                num_copied++;
+            }
         }
     }
+    assert(num_copied <= target_dimension[0]);
+
+    null_elements(data_type, owns_strings, (target_dimension[0] - num_copied) * target_block_length,
+                  target_data + num_copied * target_block_length * element_size);
 }
 
 /**
@@ -362,77 +370,214 @@ void harp_array_filter(harp_data_type data_type, int num_dimensions, const long
     }
 }
 
-int harp_variable_filter(harp_variable *variable, const harp_dimension_mask_set *dimension_mask_set)
+/* Returns whether a variable is large enough to be filtered by multiple threads (instead of by a single thread). */
+static int is_large_variable(const harp_variable *variable)
 {
-    const uint8_t *mask[HARP_MAX_NUM_DIMS] = { 0 };
-    long new_dimension[HARP_MAX_NUM_DIMS];
-    long new_num_elements;
-    int has_masks = 0;
-    int has_2D_masks = 0;
+    return variable->num_elements * harp_get_size_for_type(variable->data_type) >= HARP_PARALLEL_MIN_VARIABLE_SIZE;
+}
+
+/* Filter a variable into a newly allocated data block by dividing the outer dimension of the result into chunks that
+ * are filtered in parallel. The result is the same as that of the (in-place) filtering in filter_variable().
+ */
+static int filter_variable_parallel(harp_variable *variable, const harp_dimension_mask_runs **runs,
+                                    const long *new_dimension, long new_num_elements)
+{
+    long element_size = harp_get_size_for_type(variable->data_type);
+    long source_block_length = variable->num_elements / variable->dimension[0];
+    long target_block_length = new_num_elements / new_dimension[0];
+    /* strings that are part of a string arena are released with the arena and can be moved as plain pointers */
+    int owns_strings = (variable->string_arena == NULL);
+    int inner_dimensions_filtered = 0;
+    int num_threads = harp_get_num_threads();
+    long chunk_length;
+    long num_chunks;
+    long *source_index;
+    char *source_data = (char *)variable->data.ptr;
+    char *target_data;
+    long c;
     int i;
 
-    if (dimension_mask_set == NULL)
+    for (i = 1; i < variable->num_dimensions; i++)
     {
-        return 0;
+        if (runs[i] != NULL)
+        {
+            inner_dimensions_filtered = 1;
+        }
     }
 
-    if (variable->num_dimensions == 0)
+    /* determine the source index of each index of the outer dimension of the result */
+    source_index = malloc(new_dimension[0] * sizeof(long));
+    if (source_index == NULL)
     {
-        /* Scalars do not depend on any dimension, and will therefore not be affected by dimension masks. */
-        return 0;
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       new_dimension[0] * sizeof(long), __FILE__, __LINE__);
+        return -1;
     }
-
-    /* Determine the dimensions of the variable after filtering. */
-    for (i = 0; i < variable->num_dimensions; i++)
+    if (runs[0] == NULL)
     {
-        harp_dimension_type dimension_type = variable->dimension_type[i];
+        for (c = 0; c < new_dimension[0]; c++)
+        {
+            source_index[c] = c;
+        }
+    }
+    else
+    {
+        long num_kept = 0;
 
-        if (dimension_type == harp_dimension_independent)
+        assert(runs[0]->num_rows == 1);
+        for (c = 0; c < runs[0]->num_runs; c++)
         {
-            new_dimension[i] = variable->dimension[i];
+            long k;
+
+            for (k = runs[0]->offset[c]; k < runs[0]->offset[c] + runs[0]->length[c]; k++)
+            {
+                source_index[num_kept] = k;
+                num_kept++;
+            }
         }
-        else
+        assert(num_kept == new_dimension[0]);
+    }
+
+    /* the target is zero initialized such that no strings are freed when elements are moved into it */
+    target_data = calloc(new_num_elements, element_size);
+    if (target_data == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       new_num_elements * element_size, __FILE__, __LINE__);
+        free(source_index);
+        return -1;
+    }
+
+    /* use a few chunks per thread to even out differences in the amount of data that is kept per chunk */
+    num_chunks = 4 * num_threads;
+    if (num_chunks > new_dimension[0])
+    {
+        num_chunks = new_dimension[0];
+    }
+    chunk_length = (new_dimension[0] + num_chunks - 1) / num_chunks;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+#endif
+    for (c = 0; c < num_chunks; c++)
+    {
+        long first = c * chunk_length;
+        long last = first + chunk_length;
+        long t;
+
+        if (last > new_dimension[0])
         {
-            const harp_dimension_mask *dimension_mask = dimension_mask_set[dimension_type];
+            last = new_dimension[0];
+        }
 
-            if (dimension_mask == NULL)
+        if (!inner_dimensions_filtered)
+        {
+            /* move blocks with consecutive source indices at once */
+            t = first;
+            while (t < last)
             {
-                new_dimension[i] = variable->dimension[i];
+                long length = 1;
+
+                while (t + length < last && source_index[t + length] == source_index[t] + length)
+                {
+                    length++;
+                }
+                move_elements(variable->data_type, owns_strings, length * source_block_length,
+                              source_data + source_index[t] * source_block_length * element_size,
+                              target_data + t * target_block_length * element_size);
+                t += length;
             }
-            else
+        }
+        else
+        {
+            filter_runs row_runs[HARP_MAX_NUM_DIMS];
+
+            for (t = first; t < last; t++)
             {
-                new_dimension[i] = dimension_mask->masked_dimension_length;
+                harp_array sub_source;
+                harp_array sub_target;
+                int k;
+
+                for (k = 1; k < variable->num_dimensions; k++)
+                {
+                    /* 2-D masks have a separate list of runs for each time index */
+                    get_filter_runs(runs[k], (runs[k] != NULL && runs[k]->num_rows > 1) ? source_index[t] : 0,
+                                    &row_runs[k]);
+                }
+                sub_source.ptr = source_data + source_index[t] * source_block_length * element_size;
+                sub_target.ptr = target_data + t * target_block_length * element_size;
+                filter_array_with_runs(variable->data_type, owns_strings, variable->num_dimensions - 1,
+                                       &variable->dimension[1], &row_runs[1], sub_source, &new_dimension[1],
+                                       sub_target);
             }
         }
     }
 
-    /* Determine the number of elements remaining after filtering. */
-    new_num_elements = harp_get_num_elements(variable->num_dimensions, new_dimension);
+    free(source_index);
+
+    /* free the strings that were not moved to the target */
+    if (variable->data_type == harp_type_string && owns_strings)
+    {
+        free_string_data(variable->data.string_data, variable->data.string_data + variable->num_elements);
+    }
+    free(variable->data.ptr);
+    variable->data.ptr = target_data;
+
+    /* Update variable attributes. */
+    variable->num_elements = new_num_elements;
+    memcpy(variable->dimension, new_dimension, variable->num_dimensions * sizeof(long));
+
+    return 0;
+}
 
-    /* Get information about the applicable dimension masks. */
+/* Filter a variable using the precomputed runs of each dimension mask in the dimension mask set. */
+static int filter_variable(harp_variable *variable, const harp_dimension_mask_set *dimension_mask_set,
+                           harp_dimension_mask_runs **dimension_mask_runs)
+{
+    const harp_dimension_mask_runs *runs[HARP_MAX_NUM_DIMS] = { 0 };
+    filter_runs row_runs[HARP_MAX_NUM_DIMS];
+    long new_dimension[HARP_MAX_NUM_DIMS];
+    long new_num_elements;
+    int owns_strings = (variable->string_arena == NULL);
+    int has_masks = 0;
+    int has_2D_masks = 0;
+    int i;
+
+    if (variable->num_dimensions == 0)
+    {
+        /* Scalars do not depend on any dimension, and will therefore not be affected by dimension masks. */
+        return 0;
+    }
+
+    /* Determine the dimensions of the variable after filtering and get the applicable runs. */
     for (i = 0; i < variable->num_dimensions; i++)
     {
         harp_dimension_type dimension_type = variable->dimension_type[i];
+        const harp_dimension_mask *dimension_mask;
 
-        if (dimension_type != harp_dimension_independent)
+        new_dimension[i] = variable->dimension[i];
+        if (dimension_type == harp_dimension_independent)
         {
-            const harp_dimension_mask *dimension_mask = dimension_mask_set[dimension_type];
+            continue;
+        }
 
-            if (dimension_mask == NULL)
-            {
-                continue;
-            }
+        dimension_mask = dimension_mask_set[dimension_type];
+        if (dimension_mask == NULL)
+        {
+            continue;
+        }
 
-            assert(dimension_mask->mask != NULL);
+        assert(dimension_mask->mask != NULL);
+        assert(dimension_mask_runs[dimension_type] != NULL);
 
-            has_masks = 1;
-            mask[i] = dimension_mask->mask;
-            if (dimension_mask->num_dimensions == 2)
-            {
-                assert(i > 0 && variable->dimension_type[0] == harp_dimension_time);
-                assert(dimension_type != harp_dimension_time);
-                has_2D_masks = 1;
-            }
+        new_dimension[i] = dimension_mask->masked_dimension_length;
+        runs[i] = dimension_mask_runs[dimension_type];
+        has_masks = 1;
+        if (dimension_mask->num_dimensions == 2)
+        {
+            assert(i > 0 && variable->dimension_type[0] == harp_dimension_time);
+            assert(dimension_type != harp_dimension_time);
+            has_2D_masks = 1;
         }
     }
 
@@ -442,18 +587,30 @@ int harp_variable_filter(harp_variable *variable, const harp_dimension_mask_set
         return 0;
     }
 
+    /* Determine the number of elements remaining after filtering. */
+    new_num_elements = harp_get_num_elements(variable->num_dimensions, new_dimension);
+
+    if (new_num_elements > 0 && new_dimension[0] > 1 && is_large_variable(variable) && harp_get_num_threads() > 1)
+    {
+        return filter_variable_parallel(variable, runs, new_dimension, new_num_elements);
+    }
+
     if (!has_2D_masks)
     {
-        harp_array_filter(variable->data_type, variable->num_dimensions, variable->dimension, mask, variable->data,
-                          new_dimension, variable->data);
+        for (i = 0; i < variable->num_dimensions; i++)
+        {
+            get_filter_runs(runs[i], 0, &row_runs[i]);
+        }
+        filter_array_with_runs(variable->data_type, owns_strings, variable->num_dimensions, variable->dimension,
+                               row_runs, variable->data, new_dimension, variable->data);
     }
     else
     {
+        const harp_dimension_mask *time_mask = dimension_mask_set[harp_dimension_time];
         harp_array source = variable->data;
         harp_array target = variable->data;
         long source_stride;
         long target_stride;
-        long mask_stride[HARP_MAX_NUM_DIMS] = { 0 };
         long j;
 
         /* Since the mask for time dimension is 1-D per definition, the fact that there are 2-D masks implies that there
@@ -465,56 +622,33 @@ int harp_variable_filter(harp_variable *variable, const harp_dimension_mask_set
         source_stride = (variable->num_elements / variable->dimension[0]) * harp_get_size_for_type(variable->data_type);
         target_stride = (new_num_elements / new_dimension[0]) * harp_get_size_for_type(variable->data_type);
 
-        for (i = 0; i < variable->num_dimensions; i++)
+        for (j = 0; j < variable->dimension[0]; j++)
         {
-            harp_dimension_type dimension_type = variable->dimension_type[i];
-
-            if (dimension_type != harp_dimension_independent)
+            if (time_mask == NULL || time_mask->mask[j])
             {
-                const harp_dimension_mask *dimension_mask = dimension_mask_set[dimension_type];
-
-                if (dimension_mask == NULL)
+                for (i = 1; i < variable->num_dimensions; i++)
                 {
-                    continue;
+                    if (runs[i] != NULL && runs[i]->num_rows > 1)
+                    {
+                        get_filter_runs(runs[i], j, &row_runs[i]);
+                    }
+                    else
+                    {
+                        get_filter_runs(runs[i], 0, &row_runs[i]);
+                    }
                 }
-
-                if (i == 0)
-                {
-                    assert(dimension_mask->num_dimensions == 1);
-                    mask_stride[i] = 1;
-                }
-                else if (dimension_mask->num_dimensions == 2)
-                {
-                    assert(dimension_type != harp_dimension_time);
-                    mask_stride[i] = dimension_mask->dimension[1];
-                }
-            }
-        }
-
-        for (j = 0; j < variable->dimension[0]; j++)
-        {
-            if (mask[0] == NULL || *mask[0])
-            {
-                harp_array_filter(variable->data_type, variable->num_dimensions - 1, &variable->dimension[1], &mask[1],
-                                  source, &new_dimension[1], target);
+                filter_array_with_runs(variable->data_type, owns_strings, variable->num_dimensions - 1,
+                                       &variable->dimension[1], &row_runs[1], source, &new_dimension[1], target);
 
                 target.ptr = (void *)(((char *)target.ptr) + target_stride);
             }
 
-            for (i = 0; i < variable->num_dimensions; i++)
-            {
-                if (mask[i] != NULL)
-                {
-                    mask[i] += mask_stride[i];
-                }
-            }
-
             source.ptr = (void *)(((char *)source.ptr) + source_stride);
         }
     }
 
     /* Free any remaining string data. */
-    if (variable->data_type == harp_type_string)
+    if (variable->data_type == harp_type_string && owns_strings)
     {
         free_string_data(variable->data.string_data + new_num_elements,
                          variable->data.string_data + variable->num_elements);
@@ -526,9 +660,9 @@ int harp_variable_filter(harp_variable *variable, const harp_dimension_mask_set
         void *new_data;
 
         new_data = realloc(variable->data.ptr, new_num_elements * harp_get_size_for_type(variable->data_type));
-        if (new_data == NULL)
+        if (new_data == NULL && new_num_elements > 0)
         {
-            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %u bytes) (%s:%u)",
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
                            new_num_elements * harp_get_size_for_type(variable->data_type), __FILE__, __LINE__);
             return -1;
         }
@@ -542,8 +676,60 @@ int harp_variable_filter(harp_variable *variable, const harp_dimension_mask_set
     return 0;
 }
 
+static void dimension_mask_runs_delete(harp_dimension_mask_runs **dimension_mask_runs)
+{
+    int i;
+
+    for (i = 0; i < HARP_NUM_DIM_TYPES; i++)
+    {
+        harp_dimension_mask_runs_delete(dimension_mask_runs[i]);
+    }
+}
+
+int harp_variable_filter(harp_variable *variable, const harp_dimension_mask_set *dimension_mask_set)
+{
+    harp_dimension_mask_runs *dimension_mask_runs[HARP_NUM_DIM_TYPES] = { 0 };
+    int i;
+
+    if (dimension_mask_set == NULL)
+    {
+        return 0;
+    }
+
+    /* Only determine the runs for the dimension masks that apply to this variable. */
+    for (i = 0; i < variable->num_dimensions; i++)
+    {
+        harp_dimension_type dimension_type = variable->dimension_type[i];
+
+        if (dimension_type == harp_dimension_independent || dimension_mask_set[dimension_type] == NULL ||
+            dimension_mask_runs[dimension_type] != NULL)
+        {
+            continue;
+        }
+        if (harp_dimension_mask_runs_new(dimension_mask_set[dimension_type], &dimension_mask_runs[dimension_type]) !=
+            0)
+        {
+            dimension_mask_runs_delete(dimension_mask_runs);
+            return -1;
+        }
+    }
+
+    if (filter_variable(variable, dimension_mask_set, dimension_mask_runs) != 0)
+    {
+        dimension_mask_runs_delete(dimension_mask_runs);
+        return -1;
+    }
+
+    dimension_mask_runs_delete(dimension_mask_runs);
+
+    return 0;
+}
+
 int harp_product_filter(harp_product *product, const harp_dimension_mask_set *dimension_mask_set)
 {
+    harp_dimension_mask_runs *dimension_mask_runs[HARP_NUM_DIM_TYPES] = { 0 };
+    long small_variables_size = 0;
+    int result = 0;
     int i;
 
     if (dimension_mask_set == NULL)
@@ -563,7 +749,19 @@ int harp_product_filter(harp_product *product, const harp_dimension_mask_set *di
         }
     }
 
-    /* Filter all variables in the product. */
+    /* Determine the runs of each dimension mask once; they are shared by all variables. */
+    for (i = 0; i < HARP_NUM_DIM_TYPES; i++)
+    {
+        if (dimension_mask_set[i] != NULL)
+        {
+            if (harp_dimension_mask_runs_new(dimension_mask_set[i], &dimension_mask_runs[i]) != 0)
+            {
+                dimension_mask_runs_delete(dimension_mask_runs);
+                return -1;
+            }
+        }
+    }
+
     for (i = 0; i < product->num_variables; i++)
     {
         harp_variable *variable = product->variable[i];
@@ -595,17 +793,52 @@ int harp_product_filter(harp_product *product, const harp_dimension_mask_set *di
                 if (harp_variable_add_dimension(variable, 0, harp_dimension_time,
                                                 product->dimension[harp_dimension_time]) != 0)
                 {
+                    dimension_mask_runs_delete(dimension_mask_runs);
                     return -1;
                 }
             }
         }
 
-        if (harp_variable_filter(variable, dimension_mask_set) != 0)
+        if (!is_large_variable(variable))
         {
-            return -1;
+            small_variables_size += variable->num_elements * harp_get_size_for_type(variable->data_type);
         }
     }
 
+    /* Filter all variables in the product. The variables are independent, so small variables are filtered in parallel
+     * (each by a single thread). Large variables are filtered one after the other, each using multiple threads.
+     */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(harp_get_num_threads()) \
+    if (small_variables_size >= HARP_PARALLEL_MIN_PRODUCT_SIZE)
+#endif
+    for (i = 0; i < product->num_variables; i++)
+    {
+        if (!is_large_variable(product->variable[i]))
+        {
+            if (filter_variable(product->variable[i], dimension_mask_set, dimension_mask_runs) != 0)
+            {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                result = -1;
+            }
+        }
+    }
+    for (i = 0; i < product->num_variables && result == 0; i++)
+    {
+        if (is_large_variable(product->variable[i]))
+        {
+            result = filter_variable(product->variable[i], dimension_mask_set, dimension_mask_runs);
+        }
+    }
+
+    dimension_mask_runs_delete(dimension_mask_runs);
+    if (result != 0)
+    {
+        return -1;
+    }
+
     /* Update product dimensions. */
     for (i = 0; i < HARP_NUM_DIM_TYPES; i++)
     {
@@ -221,6 +221,103 @@ double harp_spherical_point_distance(const harp_spherical_point *pointp, const h
     }
 }
 
+/* Calculate the angle between two unit vectors
+ * This uses atan2 of the norm of the cross product and the dot product, which (unlike acos of the dot product) is
+ * well conditioned for all angles.
+ */
+static double unit_vector_angle(double ax, double ay, double az, double bx, double by, double bz)
+{
+    double cx = ay * bz - az * by;
+    double cy = az * bx - ax * bz;
+    double cz = ax * by - ay * bx;
+    double angle;
+
+    angle = atan2(sqrt(cx * cx + cy * cy + cz * cz), ax * bx + ay * by + az * bz);
+    if (HARP_GEOMETRY_FPzero(angle))
+    {
+        return 0.0;
+    }
+
+    return angle;
+}
+
+/* Convert arrays of latitude [degree_north] and longitude [degree_east] values to unit vectors (x,y,z) in Cartesian
+ * coordinates. The result is stored as separate x, y, and z arrays (each of length num_points).
+ * Each input point is converted only once so that subsequent distance tests only need a dot product per point.
+ */
+void harp_vector3d_array_from_latlon(long num_points, const double *latitude, const double *longitude, double *x,
+                                     double *y, double *z)
+{
+    long i;
+
+    for (i = 0; i < num_points; i++)
+    {
+        double lat = latitude[i] * (double)(CONST_DEG2RAD);
+        double lon = longitude[i] * (double)(CONST_DEG2RAD);
+        double coslat = cos(lat);
+
+        x[i] = coslat * cos(lon);
+        y[i] = coslat * sin(lon);
+        z[i] = sin(lat);
+    }
+}
+
+/* Update a mask for all points (given as arrays of unit vectors) that are within the given angular distance [rad]
+ * of the point given by 'vector'. Points that are further away will get their mask value set to 0; mask values of
+ * points within the distance are left as is.
+ *
+ * Details:
+ *   A point p is within distance d of point q if dot(p, q) >= cos(d).
+ *   The first pass only compares dot products against the precomputed threshold (using a branch-free loop that
+ *   compilers can vectorize). Only points whose dot product is so close to the threshold that rounding could
+ *   matter get an exact distance check in the second pass.
+ */
+void harp_vector3d_array_within_distance(const harp_vector3d *vector, double distance, long num_points,
+                                         const double *x, const double *y, const double *z, uint8_t *mask)
+{
+    double vx = vector->x;
+    double vy = vector->y;
+    double vz = vector->z;
+    double cos_lower;
+    double cos_upper;
+    long i;
+
+    if (!(distance >= 0))
+    {
+        /* negative (or NaN) distance -> no point will match */
+        for (i = 0; i < num_points; i++)
+        {
+            mask[i] = 0;
+        }
+        return;
+    }
+    if (distance >= M_PI)
+    {
+        /* all points on the sphere are within the given distance (assuming valid coordinates) */
+        for (i = 0; i < num_points; i++)
+        {
+            mask[i] &= (x[i] == x[i] && y[i] == y[i] && z[i] == z[i]);
+        }
+        return;
+    }
+
+    cos_lower = cos(distance) - HARP_GEOMETRY_DOT_EPSILON;
+    cos_upper = cos(distance) + HARP_GEOMETRY_DOT_EPSILON;
+
+    /* a NaN coordinate results in a NaN dot product, for which the comparison below is false */
+    for (i = 0; i < num_points; i++)
+    {
+        mask[i] &= (vx * x[i] + vy * y[i] + vz * z[i] >= cos_lower);
+    }
+
+    for (i = 0; i < num_points; i++)
+    {
+        if (mask[i] && vx * x[i] + vy * y[i] + vz * z[i] < cos_upper)
+        {
+            mask[i] = (unit_vector_angle(vx, vy, vz, x[i], y[i], z[i]) <= distance);
+        }
+    }
+}
 
 /** Calculate the distance between two points on the surface of the Earth in meters
  * \ingroup harp_geometry
@@ -251,3 +348,90 @@ LIBHARP_API int harp_geometry_get_point_distance(double latitude_a, double longi
 
     return 0;
 }
+
+/** Convert arrays of latitude and longitude values to unit vectors in Cartesian coordinates
+ * \ingroup harp_geometry
+ * The unit vectors can be passed to harp_geometry_get_point_distance_mask() to efficiently test many points against
+ * a distance criterion. The vectors are stored as a 'structure of arrays': the first \a num_points elements of
+ * \a unit_vector will contain all x components, the next \a num_points elements all y components, and the last
+ * \a num_points elements all z components.
+ * \param num_points Number of points.
+ * \param latitude Array with latitude values [degree_north] (of length \a num_points).
+ * \param longitude Array with longitude values [degree_east] (of length \a num_points).
+ * \param unit_vector Array of length 3 * \a num_points in which the unit vectors will be stored.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_geometry_get_point_unit_vectors(long num_points, const double *latitude, const double *longitude,
+                                                     double *unit_vector)
+{
+    if (num_points < 0)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "invalid number of points (%ld) (%s:%u)", num_points, __FILE__,
+                       __LINE__);
+        return -1;
+    }
+    if (num_points == 0)
+    {
+        return 0;
+    }
+    if (latitude == NULL || longitude == NULL || unit_vector == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "invalid argument (NULL pointer) (%s:%u)", __FILE__, __LINE__);
+        return -1;
+    }
+
+    harp_vector3d_array_from_latlon(num_points, latitude, longitude, unit_vector, &unit_vector[num_points],
+                                    &unit_vector[2 * num_points]);
+
+    return 0;
+}
+
+/** Determine which points lie within a given distance of a reference point on the surface of the Earth
+ * \ingroup harp_geometry
+ * This function assumes a spherical earth (using the same radius as harp_geometry_get_point_distance()).
+ * The points to test should be provided as unit vectors, as created by harp_geometry_get_point_unit_vectors().
+ * \param latitude Latitude of the reference point [degree_north]
+ * \param longitude Longitude of the reference point [degree_east]
+ * \param distance Maximum surface distance [m] between the reference point and a point.
+ * \param num_points Number of points.
+ * \param unit_vector Array of length 3 * \a num_points with the unit vectors of the points.
+ * \param mask Array of length \a num_points; elements will be set to 1 for points that are within \a distance of the
+ * reference point and to 0 otherwise.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_geometry_get_point_distance_mask(double latitude, double longitude, double distance,
+                                                      long num_points, const double *unit_vector, uint8_t *mask)
+{
+    harp_vector3d vector;
+    long i;
+
+    if (num_points < 0)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "invalid number of points (%ld) (%s:%u)", num_points, __FILE__,
+                       __LINE__);
+        return -1;
+    }
+    if (num_points == 0)
+    {
+        return 0;
+    }
+    if (unit_vector == NULL || mask == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "invalid argument (NULL pointer) (%s:%u)", __FILE__, __LINE__);
+        return -1;
+    }
+
+    harp_vector3d_array_from_latlon(1, &latitude, &longitude, &vector.x, &vector.y, &vector.z);
+    for (i = 0; i < num_points; i++)
+    {
+        mask[i] = 1;
+    }
+    harp_vector3d_array_within_distance(&vector, distance / CONST_EARTH_RADIUS_WGS84_SPHERE, num_points, unit_vector,
+                                        &unit_vector[num_points], &unit_vector[2 * num_points], mask);
+
+    return 0;
+}
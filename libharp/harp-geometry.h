@@ -61,6 +61,9 @@
 #define HARP_GEOMETRY_FPgt(A, B) ((A) - (B) > HARP_GEOMETRY_EPSILON)
 #define HARP_GEOMETRY_FPge(A, B) ((B) - (A) <= HARP_GEOMETRY_EPSILON)
 
+/* tolerance on dot products of unit vectors below which an exact distance calculation is used */
+#define HARP_GEOMETRY_DOT_EPSILON (1.0E-12)
+
 #define HARP_GEOMETRY_NUM_PLANE_COEFFICIENTS 4
 #define HARP_GEOMETRY_NUM_MATRIX_3X3_ELEMENTS 9
 
@@ -169,6 +172,10 @@ void harp_spherical_point_from_vector3d(harp_spherical_point *point, const harp_
 void harp_spherical_point_rad_from_deg(harp_spherical_point *point);
 void harp_spherical_point_deg_from_rad(harp_spherical_point *point);
 double harp_spherical_point_distance(const harp_spherical_point *pointp, const harp_spherical_point *pointq);
+void harp_vector3d_array_from_latlon(long num_points, const double *latitude, const double *longitude, double *x,
+                                     double *y, double *z);
+void harp_vector3d_array_within_distance(const harp_vector3d *vector, double distance, long num_points,
+                                         const double *x, const double *y, const double *z, uint8_t *mask);
 
 /* Spherical line functions */
 void harp_spherical_line_begin(harp_spherical_point *point, const harp_spherical_line *line);
@@ -57,6 +57,9 @@
  */
 #define NC_DIMID_ATT_NAME "_Netcdf4Dimid"
 
+/* Number of elements per chunk for datasets that are extendable along the time dimension */
+#define HDF5_APPEND_CHUNK_NUM_ELEMENTS 65536
+
 /* List of shared dimensions. */
 typedef struct hdf5_dimensions_struct
 {
@@ -371,14 +374,18 @@ static int get_link_iteration_index_type(hid_t group_id, H5_index_t * index_type
     return 0;
 }
 
-static int set_compression(hid_t plist_id, harp_variable *variable)
+/* Set the chunking and compression properties of a dataset.
+ * Chunking is needed to enable compression and for datasets that are extendable along the time dimension.
+ */
+static int set_compression(hid_t plist_id, harp_variable *variable, int extendable)
 {
     int level = harp_get_option_hdf5_compression();
 
-    if (level > 0 && variable->num_dimensions > 0)
+    if ((level > 0 || extendable) && variable->num_dimensions > 0)
     {
         long max_length = 4294967295;
         hsize_t dimension[HARP_MAX_NUM_DIMS];
+        long num_elements;
         int i;
 
         /* set chunk configuration (we need chunking to enable compression) */
@@ -387,9 +394,25 @@ static int set_compression(hid_t plist_id, harp_variable *variable)
         {
             dimension[i] = variable->dimension[i];
         }
-        if (variable->num_elements > max_length)
+        num_elements = variable->num_elements;
+        if (extendable)
+        {
+            long sample_num_elements = 1;
+
+            /* the final length of the time dimension is not known, so use a fixed number of elements per chunk */
+            for (i = 1; i < variable->num_dimensions; i++)
+            {
+                sample_num_elements *= variable->dimension[i];
+            }
+            dimension[0] = sample_num_elements > 0 ? HDF5_APPEND_CHUNK_NUM_ELEMENTS / sample_num_elements : 1;
+            if (dimension[0] < 1)
+            {
+                dimension[0] = 1;
+            }
+            num_elements = (long)dimension[0] * sample_num_elements;
+        }
+        if (num_elements > max_length)
         {
-            long num_elements = variable->num_elements;
             int i = 0;
 
             while (i < variable->num_dimensions - 1)
@@ -414,10 +437,13 @@ static int set_compression(hid_t plist_id, harp_variable *variable)
             harp_set_error(HARP_ERROR_HDF5, NULL);
             return -1;
         }
-        if (H5Pset_deflate(plist_id, level) < 0)
+        if (level > 0)
         {
-            harp_set_error(HARP_ERROR_HDF5, NULL);
-            return -1;
+            if (H5Pset_deflate(plist_id, level) < 0)
+            {
+                harp_set_error(HARP_ERROR_HDF5, NULL);
+                return -1;
+            }
         }
     }
     return 0;
@@ -1699,9 +1725,13 @@ static int write_numeric_attribute(hid_t obj_id, const char *name, harp_data_typ
     return 0;
 }
 
-static int write_variable(hid_t group_id, const char *name, harp_variable *variable)
+/* Write a variable as a new dataset. If extendable is set, the dataset will be created such that it can be extended
+ * along the time dimension (which should then be the first dimension of the variable).
+ */
+static int write_variable(hid_t group_id, const char *name, harp_variable *variable, int extendable)
 {
     hsize_t dimension[HARP_MAX_NUM_DIMS];
+    hsize_t max_dimension[HARP_MAX_NUM_DIMS];
     hid_t space_id;
     hid_t dcpl_id;
     hid_t dataset_id;
@@ -1710,6 +1740,12 @@ static int write_variable(hid_t group_id, const char *name, harp_variable *varia
     for (i = 0; i < variable->num_dimensions; i++)
     {
         dimension[i] = (hsize_t)variable->dimension[i];
+        max_dimension[i] = (hsize_t)variable->dimension[i];
+    }
+    if (extendable)
+    {
+        assert(variable->num_dimensions > 0 && variable->dimension_type[0] == harp_dimension_time);
+        max_dimension[0] = H5S_UNLIMITED;
     }
 
     if (variable->data_type == harp_type_string)
@@ -1748,7 +1784,7 @@ static int write_variable(hid_t group_id, const char *name, harp_variable *varia
             return -1;
         }
 
-        space_id = H5Screate_simple(variable->num_dimensions, dimension, NULL);
+        space_id = H5Screate_simple(variable->num_dimensions, dimension, max_dimension);
         if (space_id < 0)
         {
             harp_set_error(HARP_ERROR_HDF5, NULL);
@@ -1778,7 +1814,7 @@ static int write_variable(hid_t group_id, const char *name, harp_variable *varia
             return -1;
         }
 
-        if (set_compression(dcpl_id, variable) != 0)
+        if (set_compression(dcpl_id, variable, extendable) != 0)
         {
             H5Pclose(dcpl_id);
             H5Sclose(space_id);
@@ -1815,7 +1851,7 @@ static int write_variable(hid_t group_id, const char *name, harp_variable *varia
     }
     else
     {
-        space_id = H5Screate_simple(variable->num_dimensions, dimension, NULL);
+        space_id = H5Screate_simple(variable->num_dimensions, dimension, max_dimension);
         if (space_id < 0)
         {
             harp_set_error(HARP_ERROR_HDF5, NULL);
@@ -1839,7 +1875,7 @@ static int write_variable(hid_t group_id, const char *name, harp_variable *varia
             return -1;
         }
 
-        if (set_compression(dcpl_id, variable) != 0)
+        if (set_compression(dcpl_id, variable, extendable) != 0)
         {
             H5Pclose(dcpl_id);
             H5Sclose(space_id);
@@ -1939,16 +1975,19 @@ static int write_variable(hid_t group_id, const char *name, harp_variable *varia
     return 0;
 }
 
-static int write_dimension(hid_t group_id, harp_dimension_type dimension_type, long length, hid_t *dimensions_id)
+static int write_dimension(hid_t group_id, harp_dimension_type dimension_type, long length, int extendable,
+                           hid_t *dimensions_id)
 {
     hid_t space_id;
     hid_t dcpl_id;
     hid_t dataset_id;
     hsize_t dimension[1];
+    hsize_t max_dimension[1];
 
     dimension[0] = length;
+    max_dimension[0] = extendable ? H5S_UNLIMITED : (hsize_t)length;
 
-    space_id = H5Screate_simple(1, dimension, NULL);
+    space_id = H5Screate_simple(1, dimension, max_dimension);
     if (space_id < 0)
     {
         harp_set_error(HARP_ERROR_HDF5, NULL);
@@ -1972,6 +2011,18 @@ static int write_dimension(hid_t group_id, harp_dimension_type dimension_type, l
         return -1;
     }
 
+    if (extendable)
+    {
+        dimension[0] = HDF5_APPEND_CHUNK_NUM_ELEMENTS;
+        if (H5Pset_chunk(dcpl_id, 1, dimension) < 0)
+        {
+            harp_set_error(HARP_ERROR_HDF5, NULL);
+            H5Pclose(dcpl_id);
+            H5Sclose(space_id);
+            return -1;
+        }
+    }
+
     if (dimension_type == harp_dimension_independent)
     {
         char dataset_name[64];
@@ -2015,7 +2066,7 @@ static int write_dimension(hid_t group_id, harp_dimension_type dimension_type, l
     return 0;
 }
 
-static int write_dimensions(hid_t group_id, const harp_product *product, hdf5_dimensions *dimensions)
+static int write_dimensions(hid_t group_id, const harp_product *product, hdf5_dimensions *dimensions, int extendable)
 {
     harp_scalar netcdf4_dimension_id;
     int i;
@@ -2054,7 +2105,8 @@ static int write_dimensions(hid_t group_id, const harp_product *product, hdf5_di
         }
 
         /* Write a dimension scale without a coordinate variable attached to it. */
-        if (write_dimension(group_id, dimension_type, product->dimension[i], &dataset_id) != 0)
+        if (write_dimension(group_id, dimension_type, product->dimension[i],
+                            extendable && dimension_type == harp_dimension_time, &dataset_id) != 0)
         {
             H5Dclose(dataset_id);
             return -1;
@@ -2096,7 +2148,7 @@ static int write_dimensions(hid_t group_id, const harp_product *product, hdf5_di
             }
 
             /* Write a dimension scale without a coordinate variable attached to it. */
-            if (write_dimension(group_id, harp_dimension_independent, variable->dimension[j], &dataset_id) != 0)
+            if (write_dimension(group_id, harp_dimension_independent, variable->dimension[j], 0, &dataset_id) != 0)
             {
                 H5Dclose(dataset_id);
                 return -1;
@@ -2305,7 +2357,7 @@ static int write_attributes(hid_t group_id, const harp_product *product)
     return 0;
 }
 
-static int write_product(hid_t file_id, const harp_product *product)
+static int write_product(hid_t file_id, const harp_product *product, int extendable)
 {
     hid_t root_id;
     hdf5_dimensions dimensions;
@@ -2342,7 +2394,7 @@ static int write_product(hid_t file_id, const harp_product *product)
     /* Write dimensions and variables. */
     dimensions_init(&dimensions);
 
-    if (write_dimensions(root_id, product, &dimensions) != 0)
+    if (write_dimensions(root_id, product, &dimensions, extendable) != 0)
     {
         dimensions_done(&dimensions);
         H5Gclose(root_id);
@@ -2358,7 +2410,7 @@ static int write_product(hid_t file_id, const harp_product *product)
         {
             return -1;
         }
-        if (write_variable(root_id, name, product->variable[i]) != 0)
+        if (write_variable(root_id, name, product->variable[i], extendable) != 0)
         {
             free(name);
             dimensions_done(&dimensions);
@@ -2388,23 +2440,11 @@ static int write_product(hid_t file_id, const harp_product *product)
     return 0;
 }
 
-int harp_export_hdf5(const char *filename, const harp_product *product)
+static hid_t create_file(const char *filename)
 {
     hid_t file_id;
     hid_t fcpl_id;
 
-    if (filename == NULL)
-    {
-        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "filename is NULL");
-        return -1;
-    }
-
-    if (product == NULL)
-    {
-        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "product is NULL");
-        return -1;
-    }
-
     /* Setup file creation property list to enable link and attribute creation
      * order tracking and indexing.
      */
@@ -2440,7 +2480,32 @@ int harp_export_hdf5(const char *filename, const harp_product *product)
 
     H5Pclose(fcpl_id);
 
-    if (write_product(file_id, product) != 0)
+    return file_id;
+}
+
+int harp_export_hdf5(const char *filename, const harp_product *product)
+{
+    hid_t file_id;
+
+    if (filename == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "filename is NULL");
+        return -1;
+    }
+
+    if (product == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "product is NULL");
+        return -1;
+    }
+
+    file_id = create_file(filename);
+    if (file_id < 0)
+    {
+        return -1;
+    }
+
+    if (write_product(file_id, product, 0) != 0)
     {
         harp_add_error_message(" (%s)", filename);
         H5Fclose(file_id);
@@ -2457,6 +2522,325 @@ int harp_export_hdf5(const char *filename, const harp_product *product)
     return 0;
 }
 
+struct harp_hdf5_writer_struct
+{
+    char *filename;
+    hid_t file_id;
+    long num_time_elements;
+};
+
+static void hdf5_writer_delete(harp_hdf5_writer *writer)
+{
+    if (writer->filename != NULL)
+    {
+        free(writer->filename);
+    }
+    free(writer);
+}
+
+/* Extend the dataset along the time dimension and write the data of the variable at the given time offset. */
+static int append_variable(hid_t dataset_id, const harp_variable *variable, long time_offset)
+{
+    hsize_t dimension[HARP_MAX_NUM_DIMS];
+    hsize_t start[HARP_MAX_NUM_DIMS];
+    hid_t data_type_id;
+    hid_t file_space_id;
+    hid_t mem_space_id;
+    char *buffer = NULL;
+    const void *data;
+    int i;
+
+    assert(variable->num_dimensions > 0 && variable->dimension_type[0] == harp_dimension_time);
+
+    for (i = 0; i < variable->num_dimensions; i++)
+    {
+        dimension[i] = (hsize_t)variable->dimension[i];
+        start[i] = 0;
+    }
+    start[0] = (hsize_t)time_offset;
+
+    data_type_id = H5Dget_type(dataset_id);
+    if (data_type_id < 0)
+    {
+        harp_set_error(HARP_ERROR_HDF5, NULL);
+        return -1;
+    }
+    if (variable->data_type == harp_type_string)
+    {
+        size_t string_length;
+        long length;
+
+        /* use the fixed string length as it was defined in the file */
+        string_length = H5Tget_size(data_type_id);
+        if (harp_get_char_array_from_string_array(variable->num_elements, variable->data.string_data,
+                                                  (long)string_length, &length, &buffer) != 0)
+        {
+            H5Tclose(data_type_id);
+            return -1;
+        }
+        if (length > (long)string_length)
+        {
+            harp_set_error(HARP_ERROR_EXPORT, "string length (%ld) of variable '%s' exceeds string length of "
+                           "variable in file (%ld)", length, variable->name, (long)string_length);
+            H5Tclose(data_type_id);
+            free(buffer);
+            return -1;
+        }
+        data = buffer;
+    }
+    else
+    {
+        H5Tclose(data_type_id);
+        data_type_id = H5Tcopy(get_hdf5_type(variable->data_type));
+        if (data_type_id < 0)
+        {
+            harp_set_error(HARP_ERROR_HDF5, NULL);
+            return -1;
+        }
+        data = variable->data.ptr;
+    }
+
+    /* extend the dataset */
+    dimension[0] = (hsize_t)(time_offset + variable->dimension[0]);
+    if (H5Dset_extent(dataset_id, dimension) < 0)
+    {
+        harp_set_error(HARP_ERROR_HDF5, NULL);
+        H5Tclose(data_type_id);
+        if (buffer != NULL)
+        {
+            free(buffer);
+        }
+        return -1;
+    }
+    dimension[0] = (hsize_t)variable->dimension[0];
+
+    file_space_id = H5Dget_space(dataset_id);
+    if (file_space_id < 0)
+    {
+        harp_set_error(HARP_ERROR_HDF5, NULL);
+        H5Tclose(data_type_id);
+        if (buffer != NULL)
+        {
+            free(buffer);
+        }
+        return -1;
+    }
+    if (H5Sselect_hyperslab(file_space_id, H5S_SELECT_SET, start, NULL, dimension, NULL) < 0)
+    {
+        harp_set_error(HARP_ERROR_HDF5, NULL);
+        H5Sclose(file_space_id);
+        H5Tclose(data_type_id);
+        if (buffer != NULL)
+        {
+            free(buffer);
+        }
+        return -1;
+    }
+
+    mem_space_id = H5Screate_simple(variable->num_dimensions, dimension, NULL);
+    if (mem_space_id < 0)
+    {
+        harp_set_error(HARP_ERROR_HDF5, NULL);
+        H5Sclose(file_space_id);
+        H5Tclose(data_type_id);
+        if (buffer != NULL)
+        {
+            free(buffer);
+        }
+        return -1;
+    }
+
+    if (H5Dwrite(dataset_id, data_type_id, mem_space_id, file_space_id, H5P_DEFAULT, data) < 0)
+    {
+        harp_set_error(HARP_ERROR_HDF5, NULL);
+        H5Sclose(mem_space_id);
+        H5Sclose(file_space_id);
+        H5Tclose(data_type_id);
+        if (buffer != NULL)
+        {
+            free(buffer);
+        }
+        return -1;
+    }
+
+    H5Sclose(mem_space_id);
+    H5Sclose(file_space_id);
+    H5Tclose(data_type_id);
+    if (buffer != NULL)
+    {
+        free(buffer);
+    }
+
+    return 0;
+}
+
+/* Create a new HDF5 file in which all datasets can be extended along the time dimension and write \a product as the
+ * first block of data. All variables of \a product should have the time dimension as first dimension.
+ */
+int harp_hdf5_writer_new(const char *filename, const harp_product *product, harp_hdf5_writer **new_writer)
+{
+    harp_hdf5_writer *writer;
+
+    writer = (harp_hdf5_writer *)malloc(sizeof(harp_hdf5_writer));
+    if (writer == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       sizeof(harp_hdf5_writer), __FILE__, __LINE__);
+        return -1;
+    }
+    writer->file_id = -1;
+    writer->num_time_elements = 0;
+    writer->filename = strdup(filename);
+    if (writer->filename == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not duplicate string) (%s:%u)", __FILE__,
+                       __LINE__);
+        hdf5_writer_delete(writer);
+        return -1;
+    }
+
+    writer->file_id = create_file(filename);
+    if (writer->file_id < 0)
+    {
+        hdf5_writer_delete(writer);
+        return -1;
+    }
+
+    if (write_product(writer->file_id, product, 1) != 0)
+    {
+        harp_add_error_message(" (%s)", filename);
+        H5Fclose(writer->file_id);
+        hdf5_writer_delete(writer);
+        return -1;
+    }
+
+    writer->num_time_elements = product->dimension[harp_dimension_time];
+
+    *new_writer = writer;
+    return 0;
+}
+
+/* Append the data of \a product to the file along the time dimension.
+ * The product should have the same variables (with the same dimensions, except for the length of the time dimension)
+ * as the product that was used to create the writer.
+ */
+int harp_hdf5_writer_append(harp_hdf5_writer *writer, const harp_product *product)
+{
+    hsize_t dimension[1];
+    hid_t dataset_id;
+    int i;
+
+    for (i = 0; i < product->num_variables; i++)
+    {
+        char *name;
+
+        name = get_hdf5_variable_name(product, product->variable[i]);
+        if (name == NULL)
+        {
+            return -1;
+        }
+        dataset_id = H5Dopen(writer->file_id, name);
+        free(name);
+        if (dataset_id < 0)
+        {
+            harp_set_error(HARP_ERROR_HDF5, NULL);
+            harp_add_error_message(" (variable '%s') (%s)", product->variable[i]->name, writer->filename);
+            return -1;
+        }
+        if (append_variable(dataset_id, product->variable[i], writer->num_time_elements) != 0)
+        {
+            harp_add_error_message(" (%s)", writer->filename);
+            H5Dclose(dataset_id);
+            return -1;
+        }
+        H5Dclose(dataset_id);
+    }
+
+    writer->num_time_elements += product->dimension[harp_dimension_time];
+
+    /* also extend the time dimension scale (this is a no-op if it is an axis variable that was already extended) */
+    dataset_id = H5Dopen(writer->file_id, harp_get_dimension_type_name(harp_dimension_time));
+    if (dataset_id < 0)
+    {
+        harp_set_error(HARP_ERROR_HDF5, NULL);
+        harp_add_error_message(" (%s)", writer->filename);
+        return -1;
+    }
+    dimension[0] = (hsize_t)writer->num_time_elements;
+    if (H5Dset_extent(dataset_id, dimension) < 0)
+    {
+        harp_set_error(HARP_ERROR_HDF5, NULL);
+        harp_add_error_message(" (%s)", writer->filename);
+        H5Dclose(dataset_id);
+        return -1;
+    }
+    H5Dclose(dataset_id);
+
+    return 0;
+}
+
+/* Finalize and close the file. The datetime_start/datetime_stop attributes are updated if \a datetime_range is not
+ * NULL (it should then contain the start and stop value, in days since 2000-01-01, of the full appended range).
+ * The writer is always deleted, also when an error occurs.
+ */
+int harp_hdf5_writer_close(harp_hdf5_writer *writer, const double *datetime_range)
+{
+    if (datetime_range != NULL)
+    {
+        const char *attribute_name[2] = { "datetime_start", "datetime_stop" };
+        hid_t root_id;
+        int i;
+
+        root_id = H5Gopen(writer->file_id, "/");
+        if (root_id < 0)
+        {
+            harp_set_error(HARP_ERROR_HDF5, NULL);
+            harp_add_error_message(" (%s)", writer->filename);
+            H5Fclose(writer->file_id);
+            hdf5_writer_delete(writer);
+            return -1;
+        }
+        for (i = 0; i < 2; i++)
+        {
+            harp_scalar value;
+            htri_t exists;
+
+            value.double_data = datetime_range[i];
+            exists = H5Aexists(root_id, attribute_name[i]);
+            if (exists < 0 || (exists > 0 && H5Adelete(root_id, attribute_name[i]) < 0))
+            {
+                harp_set_error(HARP_ERROR_HDF5, NULL);
+                harp_add_error_message(" (%s)", writer->filename);
+                H5Gclose(root_id);
+                H5Fclose(writer->file_id);
+                hdf5_writer_delete(writer);
+                return -1;
+            }
+            if (write_numeric_attribute(root_id, attribute_name[i], harp_type_double, value) != 0)
+            {
+                harp_add_error_message(" (%s)", writer->filename);
+                H5Gclose(root_id);
+                H5Fclose(writer->file_id);
+                hdf5_writer_delete(writer);
+                return -1;
+            }
+        }
+        H5Gclose(root_id);
+    }
+
+    if (H5Fclose(writer->file_id) < 0)
+    {
+        harp_set_error(HARP_ERROR_HDF5, NULL);
+        harp_add_error_message(" (%s)", writer->filename);
+        hdf5_writer_delete(writer);
+        return -1;
+    }
+
+    hdf5_writer_delete(writer);
+
+    return 0;
+}
+
 static herr_t add_error_message(int n, H5E_error_t *err_desc, void *client_data)
 {
     (void)client_data;
@@ -255,6 +255,8 @@ typedef struct ingest_info_struct
      * GRIB2 grid_data_parameter_ref = ((2 * 256 + discipline) * 256 + parameterCategory) * 256 + parameterNumber */
     long *grid_data_parameter_ref;      /* [num_grid_data] */
     coda_cursor *parameter_cursor;      /* [num_grid_data], array of cursors to /[]/data([])/values for each param */
+    float **grid_data;  /* [num_grid_data], decoded [num_latitudes, num_longitudes] values (NULL if not decoded) */
+    grib_parameter grid_data_parameter; /* parameter of the grids in grid_data (grib_param_unknown if none) */
     double *level;      /* [num_grid_data] */
 
     double datetime;
@@ -860,61 +862,167 @@ static grib_parameter get_grib_parameter(int parameter_ref)
     return get_grib2_parameter(parameter_ref & 0xffffff);
 }
 
-static int read_grid_data(ingest_info *info, long grid_data_index, long latitude_index, harp_array data)
+/* Decode all values of a grid (i.e. a GRIB message) at once and keep them until the grids of a different parameter
+ * are needed (see select_grid_data_parameter()). Reading the grid per latitude row would unpack the (packed) GRIB data
+ * again for each row. Grids are decoded one at a time since CODA cursor reads are not thread-safe.
+ */
+static int get_grid_data(ingest_info *info, long grid_data_index, float **grid_data)
 {
-    /* flip latitude dimension, so it becomes ascending */
-    latitude_index = info->num_latitudes - latitude_index - 1;
+    if (info->grid_data[grid_data_index] == NULL)
+    {
+        coda_cursor *cursor = &info->parameter_cursor[grid_data_index];
+        long num_elements;
+        float *data;
+
+        if (coda_cursor_get_num_elements(cursor, &num_elements) != 0)
+        {
+            harp_set_error(HARP_ERROR_CODA, NULL);
+            return -1;
+        }
+        if (num_elements != info->num_latitudes * info->num_longitudes)
+        {
+            harp_set_error(HARP_ERROR_INGESTION, "number of grid values (%ld) does not match grid size (%ld x %ld)",
+                           num_elements, info->num_latitudes, info->num_longitudes);
+            return -1;
+        }
+        data = malloc(num_elements * sizeof(float));
+        if (data == NULL)
+        {
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                           num_elements * sizeof(float), __FILE__, __LINE__);
+            return -1;
+        }
+        if (coda_cursor_read_float_array(cursor, data, coda_array_ordering_c) != 0)
+        {
+            harp_set_error(HARP_ERROR_CODA, NULL);
+            free(data);
+            return -1;
+        }
+        info->grid_data[grid_data_index] = data;
+    }
+
+    *grid_data = info->grid_data[grid_data_index];
+
+    return 0;
+}
+
+/* Release the decoded grids of the previously read parameter if the grids of a different parameter are requested.
+ * Variables are read one at a time and a variable only uses the grids of a single parameter, so this keeps the grids of
+ * at most one parameter in memory, independent of which latitude rows get read.
+ */
+static void select_grid_data_parameter(ingest_info *info, grib_parameter parameter)
+{
+    long i;
+
+    if (info->grid_data_parameter == parameter)
+    {
+        return;
+    }
+    if (info->grid_data_parameter != grib_param_unknown)
+    {
+        for (i = 0; i < info->num_levels; i++)
+        {
+            long grid_data_index = info->grid_data_index[info->grid_data_parameter * info->num_levels + i];
+
+            if (grid_data_index >= 0 && info->grid_data[grid_data_index] != NULL)
+            {
+                free(info->grid_data[grid_data_index]);
+                info->grid_data[grid_data_index] = NULL;
+            }
+        }
+    }
+    info->grid_data_parameter = parameter;
+}
+
+/* Get the values of a latitude row of a grid (or NULL if the grid data is not available) */
+static int get_grid_data_row(ingest_info *info, long grid_data_index, long latitude_index, float **row)
+{
+    float *grid_data;
 
     if (grid_data_index < 0)
+    {
+        /* this specific grid data (e.g. height level or specific wavelength) is not available */
+        *row = NULL;
+        return 0;
+    }
+    if (get_grid_data(info, grid_data_index, &grid_data) != 0)
+    {
+        return -1;
+    }
+
+    /* flip latitude dimension, so it becomes ascending */
+    *row = &grid_data[(info->num_latitudes - latitude_index - 1) * info->num_longitudes];
+
+    return 0;
+}
+
+static int read_grid_data(ingest_info *info, long grid_data_index, long latitude_index, harp_array data)
+{
+    float *row;
+
+    if (get_grid_data_row(info, grid_data_index, latitude_index, &row) != 0)
+    {
+        return -1;
+    }
+    if (row == NULL)
     {
         float missing_value = (float)harp_nan();
-        int i;
+        long i;
 
-        /* this specific grid data (e.g. height level or specific wavelength) is not available */
         for (i = 0; i < info->num_longitudes; i++)
         {
             data.float_data[i] = missing_value;
         }
-        return 0;
     }
-    return coda_cursor_read_float_partial_array(&info->parameter_cursor[grid_data_index],
-                                                latitude_index * info->num_longitudes, info->num_longitudes,
-                                                data.float_data);
+    else
+    {
+        memcpy(data.float_data, row, info->num_longitudes * sizeof(float));
+    }
+
+    return 0;
 }
 
 static int read_2d_grid_data(ingest_info *info, grib_parameter parameter, long index, harp_array data)
 {
     assert(info->has_parameter[parameter]);
+    select_grid_data_parameter(info, parameter);
     return read_grid_data(info, info->grid_data_index[parameter * info->num_levels], index, data);
 }
 
 static int read_3d_grid_data(ingest_info *info, grib_parameter parameter, long index, harp_array data)
 {
-    long dimension_transpose[2];
-    long i;
+    float missing_value = (float)harp_nan();
+    long num_levels = info->num_levels;
+    long i, k;
 
     assert(info->has_parameter[parameter]);
+    select_grid_data_parameter(info, parameter);
 
-    dimension_transpose[0] = info->num_levels;
-    dimension_transpose[1] = info->num_longitudes;
-
-    /* we read the data as [vertical,longitude] */
-    for (i = 0; i < info->num_levels; i++)
+    /* write the rows of each level directly into the [longitude,vertical] output */
+    for (i = 0; i < num_levels; i++)
     {
-        harp_array subgrid;
-
-        subgrid.float_data = &data.float_data[i * info->num_longitudes];
         /* invert the loop because level 0 = TOA */
-        if (read_grid_data(info, info->grid_data_index[(parameter + 1) * info->num_levels - 1 - i], index, subgrid) !=
-            0)
+        long grid_data_index = info->grid_data_index[(parameter + 1) * num_levels - 1 - i];
+        float *row;
+
+        if (get_grid_data_row(info, grid_data_index, index, &row) != 0)
         {
             return -1;
         }
-    }
-    /* and then reorder dimensions from [vertical,longitude] to [longitude,vertical] */
-    if (harp_array_transpose(harp_type_float, 2, dimension_transpose, NULL, data) != 0)
-    {
-        return -1;
+        if (row == NULL)
+        {
+            for (k = 0; k < info->num_longitudes; k++)
+            {
+                data.float_data[k * num_levels + i] = missing_value;
+            }
+        }
+        else
+        {
+            for (k = 0; k < info->num_longitudes; k++)
+            {
+                data.float_data[k * num_levels + i] = row[k];
+            }
+        }
     }
 
     return 0;
@@ -2144,6 +2252,17 @@ static int init_cursors_and_grid(ingest_info *info)
                        info->num_grid_data * sizeof(coda_cursor), __FILE__, __LINE__);
         return -1;
     }
+    info->grid_data = malloc(info->num_grid_data * sizeof(float *));
+    if (info->grid_data == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       info->num_grid_data * sizeof(float *), __FILE__, __LINE__);
+        return -1;
+    }
+    for (i = 0; i < info->num_grid_data; i++)
+    {
+        info->grid_data[i] = NULL;
+    }
     info->level = malloc(info->num_grid_data * sizeof(double));
     if (info->level == NULL)
     {
@@ -2704,6 +2823,19 @@ static void ingest_info_delete(ingest_info *info)
         {
             free(info->parameter_cursor);
         }
+        if (info->grid_data != NULL)
+        {
+            long i;
+
+            for (i = 0; i < info->num_grid_data; i++)
+            {
+                if (info->grid_data[i] != NULL)
+                {
+                    free(info->grid_data[i]);
+                }
+            }
+            free(info->grid_data);
+        }
         if (info->level != NULL)
         {
             free(info->level);
@@ -2746,6 +2878,8 @@ static int ingest_info_new(coda_product *product, ingest_info **new_info)
     info->num_grid_data = 0;
     info->grid_data_parameter_ref = NULL;
     info->parameter_cursor = NULL;
+    info->grid_data = NULL;
+    info->grid_data_parameter = grib_param_unknown;
     info->level = NULL;
     info->datetime = 0;
     info->reference_datetime = 0;
@@ -48,6 +48,7 @@
 #define MAX_NR_BANDS                  6
 #define MAX_READOUTS_PER_MDR_RECORD  32
 #define MAX_PIXELS                 4096
+#define MDR_RECORDS_PER_RANGE        16
 
 #define CHECKED_MALLOC(v, s) v = malloc(s); if (v == NULL) { harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)", s, __FILE__, __LINE__); return -1;}
 
@@ -73,6 +74,8 @@ typedef struct ingest_info_struct
     long num_pixels[MAX_NR_BANDS];
     long offset_of_band[MAX_NR_BANDS];
     long total_num_pixels_all_bands;
+    long spectral_offset;       /* First index in the spectral dimension that needs to be read */
+    long spectral_length;       /* Number of indices in the spectral dimension that need to be read */
     int band_nr;        /* Which band (0-5) to ingest, -1 means all bands */
 
     /* Data about the MDR-records */
@@ -82,6 +85,7 @@ typedef struct ingest_info_struct
     int *band_nr_fastest_band;
     int *index_of_fastest_timer_in_list_of_timers;
     short *readout_offset;      /* First valid readout in MDR record: 1 (if first readout is skipped) or 0 (default) */
+    long *time_offset;  /* [num_mdr_records + 1], index in the time dimension of the first readout of each MDR record */
 
     /* Data about the VIADR_SMR-records */
     long num_viadr_smr_records;
@@ -134,6 +138,10 @@ static void ingestion_done(void *user_data)
     {
         free(info->readout_offset);
     }
+    if (info->time_offset != NULL)
+    {
+        free(info->time_offset);
+    }
     free(info);
 }
 
@@ -170,14 +178,15 @@ static void copy_double_data_to_following_rows(long num_rows_with_data, long num
     }
 }
 
-static int get_main_datetime_data(ingest_info *info, double *double_data_array)
+static int get_main_datetime_data(ingest_info *info, long first_mdr_record, long num_mdr_records,
+                                  double *double_data_array)
 {
     coda_cursor cursor;
     double *double_data, time_from_record;
     long i, j;
 
     double_data = double_data_array;
-    for (i = 0; i < info->num_mdr_records; i++)
+    for (i = first_mdr_record; i < first_mdr_record + num_mdr_records; i++)
     {
         cursor = info->mdr_lightsource_cursors[i];
 
@@ -408,15 +417,15 @@ static int get_main_geo_earth_actual_data_old_version(ingest_info *info, long md
     return 0;
 }
 
-static int get_main_geo_earth_actual_data(ingest_info *info, const char *dataset_name, const char *fieldname,
-                                          long start_data_index, long end_data_index, long data_dim_size,
-                                          double *double_data_array)
+static int get_main_geo_earth_actual_data(ingest_info *info, long first_mdr_record, long num_mdr_records,
+                                          const char *dataset_name, const char *fieldname, long start_data_index,
+                                          long end_data_index, long data_dim_size, double *double_data_array)
 {
     double *double_data, *save_double_data, nan;
     long i, j, k;
 
     double_data = double_data_array;
-    for (i = 0; i < info->num_mdr_records; i++)
+    for (i = first_mdr_record; i < first_mdr_record + num_mdr_records; i++)
     {
         save_double_data = double_data;
         /* set all values to NaN */
@@ -506,9 +515,10 @@ static int get_main_cloud_data(ingest_info *info, long mdr_record, int fit_numbe
     return 0;
 }
 
+/* Only the pixels first_pixel <= j < end_pixel of the band are read, the other pixels are left unchanged */
 static int get_spectral_data_per_band(coda_cursor cursor_start_of_band, ingest_info *info, const char *fieldname,
                                       spectral_variable_type var_type, long mdr_record, int band_nr,
-                                      double *data_startposition)
+                                      long first_pixel, long end_pixel, double *data_startposition)
 {
     const double undefined_int32_vsf_value = -2147483648.0E128;
     coda_cursor cursor, start_of_band_array_element;
@@ -553,37 +563,40 @@ static int get_spectral_data_per_band(coda_cursor cursor_start_of_band, ingest_i
                 double_data = data_startposition + (info->total_num_pixels_all_bands * double_data_row);
                 for (j = 0; j < info->num_pixels[band_nr]; j++)
                 {
-                    start_of_band_array_element = cursor;
-                    if (coda_cursor_goto_record_field_by_name(&cursor, fieldname) != 0)
-                    {
-                        harp_set_error(HARP_ERROR_CODA, NULL);
-                        return -1;
-                    }
                     if (i >= info->readout_offset[mdr_record])
                     {
-                        if (coda_cursor_read_double(&cursor, &rad) != 0)
-                        {
-                            harp_set_error(HARP_ERROR_CODA, NULL);
-                            return -1;
-                        }
-                        /* We do a compare on the difference because absolute
-                         * comparison of rad against undefined_int32_vsf_value
-                         * may sometimes incorrectly return false due to
-                         * rounding issues.
-                         */
-                        if (fabs(rad - undefined_int32_vsf_value) > fabs(undefined_int32_vsf_value * 1E-12))
+                        if (j >= first_pixel && j < end_pixel)
                         {
-                            *double_data = rad;
+                            start_of_band_array_element = cursor;
+                            if (coda_cursor_goto_record_field_by_name(&cursor, fieldname) != 0)
+                            {
+                                harp_set_error(HARP_ERROR_CODA, NULL);
+                                return -1;
+                            }
+                            if (coda_cursor_read_double(&cursor, &rad) != 0)
+                            {
+                                harp_set_error(HARP_ERROR_CODA, NULL);
+                                return -1;
+                            }
+                            /* We do a compare on the difference because absolute
+                             * comparison of rad against undefined_int32_vsf_value
+                             * may sometimes incorrectly return false due to
+                             * rounding issues.
+                             */
+                            if (fabs(rad - undefined_int32_vsf_value) > fabs(undefined_int32_vsf_value * 1E-12))
+                            {
+                                *double_data = rad;
+                            }
+                            else
+                            {
+                                *double_data = nan;
+                            }
+                            copy_double_data_to_following_rows(num_recs_of_band, info->total_num_pixels_all_bands,
+                                                               double_data);
+                            cursor = start_of_band_array_element;
                         }
-                        else
-                        {
-                            *double_data = nan;
-                        }
-                        copy_double_data_to_following_rows(num_recs_of_band, info->total_num_pixels_all_bands,
-                                                           double_data);
                         double_data++;
                     }
-                    cursor = start_of_band_array_element;
                     if ((j < (info->num_pixels[band_nr] - 1)) || (i < (num_recs_of_band - 1)))
                     {
                         if (coda_cursor_goto_next_array_element(&cursor) != 0)
@@ -618,17 +631,20 @@ static int get_spectral_data_per_band(coda_cursor cursor_start_of_band, ingest_i
             double_data = data_startposition;
             for (j = 0; j < info->num_pixels[band_nr]; j++)
             {
-                if (coda_cursor_read_double(&cursor, double_data) != 0)
+                if (j >= first_pixel && j < end_pixel)
                 {
-                    harp_set_error(HARP_ERROR_CODA, NULL);
-                    return -1;
-                }
-                /* Copy the wavelength value to the rows below it */
-                dest_data = double_data + info->total_num_pixels_all_bands;
-                for (k = 1; k <= (31 - info->readout_offset[mdr_record]); k++)
-                {
-                    *dest_data = *double_data;
-                    dest_data += info->total_num_pixels_all_bands;
+                    if (coda_cursor_read_double(&cursor, double_data) != 0)
+                    {
+                        harp_set_error(HARP_ERROR_CODA, NULL);
+                        return -1;
+                    }
+                    /* Copy the wavelength value to the rows below it */
+                    dest_data = double_data + info->total_num_pixels_all_bands;
+                    for (k = 1; k <= (31 - info->readout_offset[mdr_record]); k++)
+                    {
+                        *dest_data = *double_data;
+                        dest_data += info->total_num_pixels_all_bands;
+                    }
                 }
                 double_data++;
                 if (j < (info->num_pixels[band_nr] - 1))
@@ -675,18 +691,36 @@ static int get_spectral_data_per_band(coda_cursor cursor_start_of_band, ingest_i
     return 0;
 }
 
-static int get_spectral_data(ingest_info *info, const char *fieldname, spectral_variable_type var_type,
-                             double *double_data_array)
+static int get_spectral_data(ingest_info *info, long first_mdr_record, long num_mdr_records, const char *fieldname,
+                             spectral_variable_type var_type, double *double_data_array)
 {
     coda_cursor cursor;
     double *double_data, nan;
+    long first_pixel[MAX_NR_BANDS], end_pixel[MAX_NR_BANDS];
+    long band_offset;
     long i, j;
     int band_nr;
 
+    /* determine for each band which of its pixels are within the part of the spectral dimension that is read */
+    for (band_nr = 0; band_nr < MAX_NR_BANDS; band_nr++)
+    {
+        band_offset = info->band_nr < 0 ? info->offset_of_band[band_nr] : 0;
+        first_pixel[band_nr] = info->spectral_offset - band_offset;
+        if (first_pixel[band_nr] < 0)
+        {
+            first_pixel[band_nr] = 0;
+        }
+        end_pixel[band_nr] = info->spectral_offset + info->spectral_length - band_offset;
+        if (end_pixel[band_nr] > info->num_pixels[band_nr])
+        {
+            end_pixel[band_nr] = info->num_pixels[band_nr];
+        }
+    }
+
     /* set all values to NaN */
     nan = coda_NaN();
     double_data = double_data_array;
-    for (i = 0; i < info->num_mdr_records; i++)
+    for (i = first_mdr_record; i < first_mdr_record + num_mdr_records; i++)
     {
         for (j = (info->readout_offset[i] * info->total_num_pixels_all_bands);
              j < (MAX_READOUTS_PER_MDR_RECORD * info->total_num_pixels_all_bands); j++)
@@ -697,7 +731,7 @@ static int get_spectral_data(ingest_info *info, const char *fieldname, spectral_
     }
 
     double_data = double_data_array;
-    for (i = 0; i < info->num_mdr_records; i++)
+    for (i = first_mdr_record; i < first_mdr_record + num_mdr_records; i++)
     {
         cursor = info->mdr_lightsource_cursors[i];
         if (info->band_nr < 0)
@@ -705,8 +739,13 @@ static int get_spectral_data(ingest_info *info, const char *fieldname, spectral_
             /* Ingest all bands */
             for (band_nr = 0; band_nr < MAX_NR_BANDS; band_nr++)
             {
-                if (get_spectral_data_per_band
-                    (cursor, info, fieldname, var_type, i, band_nr, double_data + info->offset_of_band[band_nr]) != 0)
+                if (first_pixel[band_nr] >= end_pixel[band_nr])
+                {
+                    /* no pixels of this band are needed */
+                    continue;
+                }
+                if (get_spectral_data_per_band(cursor, info, fieldname, var_type, i, band_nr, first_pixel[band_nr],
+                                               end_pixel[band_nr], double_data + info->offset_of_band[band_nr]) != 0)
                 {
                     return -1;
                 }
@@ -715,7 +754,8 @@ static int get_spectral_data(ingest_info *info, const char *fieldname, spectral_
         else
         {
             /* Ingest only this band */
-            if (get_spectral_data_per_band(cursor, info, fieldname, var_type, i, info->band_nr, double_data) != 0)
+            if (get_spectral_data_per_band(cursor, info, fieldname, var_type, i, info->band_nr,
+                                           first_pixel[info->band_nr], end_pixel[info->band_nr], double_data) != 0)
             {
                 return -1;
             }
@@ -725,9 +765,157 @@ static int get_spectral_data(ingest_info *info, const char *fieldname, spectral_
     return 0;
 }
 
-static int read_datetime(void *user_data, harp_array data)
+static int set_dimension_range_hint(void *user_data, harp_dimension_type dimension_type, long index_offset,
+                                    long index_length)
 {
-    return get_main_datetime_data((ingest_info *)user_data, data.double_data);
+    ingest_info *info = (ingest_info *)user_data;
+
+    if (dimension_type == harp_dimension_spectral)
+    {
+        info->spectral_offset = index_offset;
+        info->spectral_length = index_length;
+    }
+
+    return 0;
+}
+
+/* Find the MDR record that contains the given index in the time dimension */
+static long find_mdr_record(ingest_info *info, long index)
+{
+    long lower = 0;
+    long upper = info->num_mdr_records - 1;
+
+    while (lower < upper)
+    {
+        long middle = lower + (upper - lower + 1) / 2;
+
+        if (info->time_offset[middle] <= index)
+        {
+            lower = middle;
+        }
+        else
+        {
+            upper = middle - 1;
+        }
+    }
+
+    return lower;
+}
+
+static long get_optimal_range_length(void *user_data)
+{
+    (void)user_data;
+
+    return MDR_RECORDS_PER_RANGE * MAX_READOUTS_PER_MDR_RECORD;
+}
+
+/* Read the readouts [index_offset, index_offset + index_length) of the time dimension using a function that reads
+ * full MDR records. Only the MDR records that overlap with the range are read. If the range does not start and end at
+ * an MDR record boundary, the records are read into a temporary buffer first.
+ */
+static int read_mdr_range(ingest_info *info, long index_offset, long index_length, long num_values_per_readout,
+                          int (*read_mdr_records) (ingest_info *info, long first_mdr_record, long num_mdr_records,
+                                                   double *double_data_array), harp_array data)
+{
+    long first_mdr_record, last_mdr_record;
+    long num_readouts, readout_offset;
+    double *buffer;
+
+    if (index_length <= 0)
+    {
+        return 0;
+    }
+
+    first_mdr_record = find_mdr_record(info, index_offset);
+    last_mdr_record = find_mdr_record(info, index_offset + index_length - 1);
+    readout_offset = index_offset - info->time_offset[first_mdr_record];
+    num_readouts = info->time_offset[last_mdr_record + 1] - info->time_offset[first_mdr_record];
+
+    if (readout_offset == 0 && num_readouts == index_length)
+    {
+        return read_mdr_records(info, first_mdr_record, last_mdr_record - first_mdr_record + 1, data.double_data);
+    }
+
+    CHECKED_MALLOC(buffer, num_readouts * num_values_per_readout * sizeof(double));
+    if (read_mdr_records(info, first_mdr_record, last_mdr_record - first_mdr_record + 1, buffer) != 0)
+    {
+        free(buffer);
+        return -1;
+    }
+    memcpy(data.double_data, &buffer[readout_offset * num_values_per_readout],
+           index_length * num_values_per_readout * sizeof(double));
+    free(buffer);
+
+    return 0;
+}
+
+/* Rearrange the corners ABCD as BDCA */
+static void rearrange_corners(long num_readouts, double *double_data)
+{
+    double a, b, c, d;
+    long i;
+
+    for (i = 0; i < num_readouts; i++)
+    {
+        a = *double_data;
+        b = *(double_data + 1);
+        c = *(double_data + 2);
+        d = *(double_data + 3);
+        *double_data = b;
+        *(double_data + 1) = d;
+        *(double_data + 2) = c;
+        *(double_data + 3) = a;
+        double_data += 4;
+    }
+}
+
+static int read_datetime_records(ingest_info *info, long first_mdr_record, long num_mdr_records, double *data)
+{
+    return get_main_datetime_data(info, first_mdr_record, num_mdr_records, data);
+}
+
+static int read_latitude_records(ingest_info *info, long first_mdr_record, long num_mdr_records, double *data)
+{
+    return get_main_geo_earth_actual_data(info, first_mdr_record, num_mdr_records, "CENTRE_ACTUAL", "latitude", 0, 0, 1,
+                                          data);
+}
+
+static int read_longitude_records(ingest_info *info, long first_mdr_record, long num_mdr_records, double *data)
+{
+    return get_main_geo_earth_actual_data(info, first_mdr_record, num_mdr_records, "CENTRE_ACTUAL", "longitude", 0, 0,
+                                          1, data);
+}
+
+static int read_latitude_bounds_records(ingest_info *info, long first_mdr_record, long num_mdr_records, double *data)
+{
+    return get_main_geo_earth_actual_data(info, first_mdr_record, num_mdr_records, "CORNER_ACTUAL", "latitude", 0, 3, 4,
+                                          data);
+}
+
+static int read_longitude_bounds_records(ingest_info *info, long first_mdr_record, long num_mdr_records, double *data)
+{
+    return get_main_geo_earth_actual_data(info, first_mdr_record, num_mdr_records, "CORNER_ACTUAL", "longitude", 0, 3,
+                                          4, data);
+}
+
+static int read_radiance_records(ingest_info *info, long first_mdr_record, long num_mdr_records, double *data)
+{
+    return get_spectral_data(info, first_mdr_record, num_mdr_records, "RAD", RADIANCE, data);
+}
+
+static int read_wavelength_records(ingest_info *info, long first_mdr_record, long num_mdr_records, double *data)
+{
+    return get_spectral_data(info, first_mdr_record, num_mdr_records, NULL, WAVELENGTH, data);
+}
+
+static int read_integration_time_records(ingest_info *info, long first_mdr_record, long num_mdr_records, double *data)
+{
+    return get_spectral_data(info, first_mdr_record, num_mdr_records, NULL, INTEGRATION_TIME, data);
+}
+
+static int read_datetime(void *user_data, long index_offset, long index_length, harp_array data)
+{
+    return read_mdr_range((ingest_info *)user_data, index_offset, index_length, 1, read_datetime_records, data);
 }
 
 static int read_orbit_index(void *user_data, harp_array data)
@@ -755,108 +943,88 @@ static int read_orbit_index(void *user_data, harp_array data)
     return 0;
 }
 
-static int read_latitude(void *user_data, harp_array data)
+static int read_latitude(void *user_data, long index_offset, long index_length, harp_array data)
 {
-    return get_main_geo_earth_actual_data((ingest_info *)user_data, "CENTRE_ACTUAL", "latitude", 0, 0, 1,
-                                          data.double_data);
+    return read_mdr_range((ingest_info *)user_data, index_offset, index_length, 1, read_latitude_records, data);
 }
 
-static int read_longitude(void *user_data, harp_array data)
+static int read_longitude(void *user_data, long index_offset, long index_length, harp_array data)
 {
-    return get_main_geo_earth_actual_data((ingest_info *)user_data, "CENTRE_ACTUAL", "longitude", 0, 0, 1,
-                                          data.double_data);
+    return read_mdr_range((ingest_info *)user_data, index_offset, index_length, 1, read_longitude_records, data);
 }
 
-static int read_latitude_bounds(void *user_data, harp_array data)
+static int read_latitude_bounds(void *user_data, long index_offset, long index_length, harp_array data)
 {
-    ingest_info *info = (ingest_info *)user_data;
-    double *double_data, a, b, c, d;
-    long i, j;
-
-    if (get_main_geo_earth_actual_data(info, "CORNER_ACTUAL", "latitude", 0, 3, 4, data.double_data) != 0)
+    if (read_mdr_range((ingest_info *)user_data, index_offset, index_length, 4, read_latitude_bounds_records, data) !=
+        0)
     {
         return -1;
     }
+    rearrange_corners(index_length, data.double_data);
 
-    /* Rearrange the corners ABCD as BDCA */
-    double_data = data.double_data;
-    for (i = 0; i < info->num_mdr_records; i++)
-    {
-        for (j = 0; j < (MAX_READOUTS_PER_MDR_RECORD - info->readout_offset[i]); j++)
-        {
-            a = *double_data;
-            b = *(double_data + 1);
-            c = *(double_data + 2);
-            d = *(double_data + 3);
-            *double_data = b;
-            *(double_data + 1) = d;
-            *(double_data + 2) = c;
-            *(double_data + 3) = a;
-            double_data += 4;
-        }
-    }
     return 0;
 }
 
-static int read_longitude_bounds(void *user_data, harp_array data)
+static int read_longitude_bounds(void *user_data, long index_offset, long index_length, harp_array data)
 {
-    ingest_info *info = (ingest_info *)user_data;
-    double *double_data, a, b, c, d;
-    long i, j;
-
-    if (get_main_geo_earth_actual_data(info, "CORNER_ACTUAL", "longitude", 0, 3, 4, data.double_data) != 0)
+    if (read_mdr_range((ingest_info *)user_data, index_offset, index_length, 4, read_longitude_bounds_records, data) !=
+        0)
     {
         return -1;
     }
+    rearrange_corners(index_length, data.double_data);
 
-    /* Rearrange the corners ABCD as BDCA */
-    double_data = data.double_data;
-    for (i = 0; i < info->num_mdr_records; i++)
-    {
-        for (j = 0; j < (MAX_READOUTS_PER_MDR_RECORD - info->readout_offset[i]); j++)
-        {
-            a = *double_data;
-            b = *(double_data + 1);
-            c = *(double_data + 2);
-            d = *(double_data + 3);
-            *double_data = b;
-            *(double_data + 1) = d;
-            *(double_data + 2) = c;
-            *(double_data + 3) = a;
-            double_data += 4;
-        }
-    }
     return 0;
 }
 
-static int read_wavelength_photon_radiance(void *user_data, harp_array data)
+static int read_wavelength_photon_radiance(void *user_data, long index_offset, long index_length, harp_array data)
 {
-    return get_spectral_data((ingest_info *)user_data, "RAD", RADIANCE, data.double_data);
+    ingest_info *info = (ingest_info *)user_data;
+
+    return read_mdr_range(info, index_offset, index_length, info->total_num_pixels_all_bands, read_radiance_records,
+                          data);
 }
 
-static int read_transmittance(void *user_data, harp_array data)
+static int read_transmittance(void *user_data, long index_offset, long index_length, harp_array data)
 {
-    return get_spectral_data((ingest_info *)user_data, "RAD", RADIANCE, data.double_data);
+    ingest_info *info = (ingest_info *)user_data;
+
+    return read_mdr_range(info, index_offset, index_length, info->total_num_pixels_all_bands, read_radiance_records,
+                          data);
 }
 
-static int read_sun_wavelength_photon_irradiance(void *user_data, harp_array data)
+static int read_sun_wavelength_photon_irradiance(void *user_data, long index_offset, long index_length,
+                                                 harp_array data)
 {
-    return get_spectral_data((ingest_info *)user_data, "RAD", RADIANCE, data.double_data);
+    ingest_info *info = (ingest_info *)user_data;
+
+    return read_mdr_range(info, index_offset, index_length, info->total_num_pixels_all_bands, read_radiance_records,
+                          data);
 }
 
-static int read_moon_wavelength_photon_irradiance(void *user_data, harp_array data)
+static int read_moon_wavelength_photon_irradiance(void *user_data, long index_offset, long index_length,
+                                                  harp_array data)
 {
-    return get_spectral_data((ingest_info *)user_data, "RAD", RADIANCE, data.double_data);
+    ingest_info *info = (ingest_info *)user_data;
+
+    return read_mdr_range(info, index_offset, index_length, info->total_num_pixels_all_bands, read_radiance_records,
+                          data);
 }
 
-static int read_wavelength(void *user_data, harp_array data)
+static int read_wavelength(void *user_data, long index_offset, long index_length, harp_array data)
 {
-    return get_spectral_data((ingest_info *)user_data, NULL, WAVELENGTH, data.double_data);
+    ingest_info *info = (ingest_info *)user_data;
+
+    return read_mdr_range(info, index_offset, index_length, info->total_num_pixels_all_bands, read_wavelength_records,
+                          data);
 }
 
-static int read_integration_time(void *user_data, harp_array data)
+static int read_integration_time(void *user_data, long index_offset, long index_length, harp_array data)
 {
-    return get_spectral_data((ingest_info *)user_data, NULL, INTEGRATION_TIME, data.double_data);
+    ingest_info *info = (ingest_info *)user_data;
+
+    return read_mdr_range(info, index_offset, index_length, info->total_num_pixels_all_bands,
+                          read_integration_time_records, data);
 }
 
 static int read_scan_subindex(void *user_data, harp_array data)
@@ -886,24 +1054,22 @@ static int read_scan_subindex(void *user_data, harp_array data)
 static int read_scan_direction_type(void *user_data, long index, harp_array data)
 {
     ingest_info *info;
-    long i, subindex, index_plus_readout_offset;
+    long mdr_record, readout, subindex;
 
     info = (ingest_info *)user_data;
 
-    index_plus_readout_offset = index;
-    for (i = 0; i < index; i += 32)
-    {
-        index_plus_readout_offset += info->readout_offset[i / 32];
-    }
+    /* determine the readout (0..31) within the MDR record */
+    mdr_record = find_mdr_record(info, index);
+    readout = index - info->time_offset[mdr_record] + info->readout_offset[mdr_record];
 
-    if (index_plus_readout_offset == 0L)
+    if (readout == 0)
     {
         /* First readout is from previous scan so index within scan = 15 */
         subindex = 15;
     }
     else
     {
-        subindex = (((index_plus_readout_offset - 1) % 32) / 2);
+        subindex = (readout - 1) / 2;
     }
     if (subindex < 12)
     {
@@ -917,16 +1083,16 @@ static int read_scan_direction_type(void *user_data, long index, harp_array data
     return 0;
 }
 
-static int read_cloud_top_pressure(void *user_data, harp_array data)
+static int read_cloud_top_pressure_records(ingest_info *info, long first_mdr_record, long num_mdr_records,
+                                       double *double_data_array)
 {
-    ingest_info *info = (ingest_info *)user_data;
     double *double_data, *start_mdr_record;
     double fit_data[MAX_READOUTS_PER_MDR_RECORD], total;
     long i, j, k, combined_rows;
     int retval;
 
-    double_data = data.double_data;
-    for (i = 0; i < info->num_mdr_records; i++)
+    double_data = double_data_array;
+    for (i = first_mdr_record; i < first_mdr_record + num_mdr_records; i++)
     {
         retval = get_main_cloud_data(info, i, 1, fit_data);
         if (retval < 0)
@@ -986,16 +1152,16 @@ static int read_cloud_top_pressure(void *user_data, harp_array data)
     return 0;
 }
 
-static int read_cloud_fraction(void *user_data, harp_array data)
+static int read_cloud_fraction_records(ingest_info *info, long first_mdr_record, long num_mdr_records,
+                                       double *double_data_array)
 {
-    ingest_info *info = (ingest_info *)user_data;
     double *double_data, *start_mdr_record;
     double fit_data[MAX_READOUTS_PER_MDR_RECORD], total;
     long i, j, k, combined_rows;
     int retval;
 
-    double_data = data.double_data;
-    for (i = 0; i < info->num_mdr_records; i++)
+    double_data = double_data_array;
+    for (i = first_mdr_record; i < first_mdr_record + num_mdr_records; i++)
     {
         retval = get_main_cloud_data(info, i, 2, fit_data);
         if (retval < 0)
@@ -1051,28 +1217,67 @@ static int read_cloud_fraction(void *user_data, harp_array data)
     return 0;
 }
 
-static int read_solar_zenith_angle(void *user_data, harp_array data)
+static int read_cloud_top_pressure(void *user_data, long index_offset, long index_length, harp_array data)
+{
+    return read_mdr_range((ingest_info *)user_data, index_offset, index_length, 1, read_cloud_top_pressure_records,
+                          data);
+}
+
+static int read_cloud_fraction(void *user_data, long index_offset, long index_length, harp_array data)
+{
+    return read_mdr_range((ingest_info *)user_data, index_offset, index_length, 1, read_cloud_fraction_records, data);
+}
+
+static int read_solar_zenith_angle_records(ingest_info *info, long first_mdr_record, long num_mdr_records,
+                                           double *data)
+{
+    return get_main_geo_earth_actual_data(info, first_mdr_record, num_mdr_records, "SOLAR_ZENITH_ACTUAL", NULL, 1, 1, 3,
+                                          data);
+}
+
+static int read_solar_azimuth_angle_records(ingest_info *info, long first_mdr_record, long num_mdr_records,
+                                            double *data)
 {
-    return get_main_geo_earth_actual_data((ingest_info *)user_data, "SOLAR_ZENITH_ACTUAL", NULL, 1, 1, 3,
-                                          data.double_data);
+    return get_main_geo_earth_actual_data(info, first_mdr_record, num_mdr_records, "SOLAR_AZIMUTH_ACTUAL", NULL, 1, 1,
+                                          3, data);
 }
 
-static int read_solar_azimuth_angle(void *user_data, harp_array data)
+static int read_viewing_zenith_angle_records(ingest_info *info, long first_mdr_record, long num_mdr_records,
+                                             double *data)
 {
-    return get_main_geo_earth_actual_data((ingest_info *)user_data, "SOLAR_AZIMUTH_ACTUAL", NULL, 1, 1, 3,
-                                          data.double_data);
+    return get_main_geo_earth_actual_data(info, first_mdr_record, num_mdr_records, "SAT_ZENITH_ACTUAL", NULL, 1, 1, 3,
+                                          data);
 }
 
-static int read_viewing_zenith_angle(void *user_data, harp_array data)
+static int read_viewing_azimuth_angle_records(ingest_info *info, long first_mdr_record, long num_mdr_records,
+                                              double *data)
 {
-    return get_main_geo_earth_actual_data((ingest_info *)user_data, "SAT_ZENITH_ACTUAL", NULL, 1, 1, 3,
-                                          data.double_data);
+    return get_main_geo_earth_actual_data(info, first_mdr_record, num_mdr_records, "SAT_AZIMUTH_ACTUAL", NULL, 1, 1, 3,
+                                          data);
 }
 
-static int read_viewing_azimuth_angle(void *user_data, harp_array data)
+static int read_solar_zenith_angle(void *user_data, long index_offset, long index_length, harp_array data)
 {
-    return get_main_geo_earth_actual_data((ingest_info *)user_data, "SAT_AZIMUTH_ACTUAL", NULL, 1, 1, 3,
-                                          data.double_data);
+    return read_mdr_range((ingest_info *)user_data, index_offset, index_length, 1, read_solar_zenith_angle_records,
+                          data);
+}
+
+static int read_solar_azimuth_angle(void *user_data, long index_offset, long index_length, harp_array data)
+{
+    return read_mdr_range((ingest_info *)user_data, index_offset, index_length, 1, read_solar_azimuth_angle_records,
+                          data);
+}
+
+static int read_viewing_zenith_angle(void *user_data, long index_offset, long index_length, harp_array data)
+{
+    return read_mdr_range((ingest_info *)user_data, index_offset, index_length, 1, read_viewing_zenith_angle_records,
+                          data);
+}
+
+static int read_viewing_azimuth_angle(void *user_data, long index_offset, long index_length, harp_array data)
+{
+    return read_mdr_range((ingest_info *)user_data, index_offset, index_length, 1, read_viewing_azimuth_angle_records,
+                          data);
 }
 
 static int mdr_record_is_valid(ingest_info *info, coda_cursor *cursor)
@@ -1210,6 +1415,7 @@ static int init_measurements_dimensions(ingest_info *info)
     double time_of_mdr_record, time_of_prev_mdr_record;
     long num_all_mdr_records, mdr_record, valid_mdr_record;
     long band_nr, offset, dim[CODA_MAX_NUM_DIMS];
+    long i;
     int num_dims, prev_mdr_record_was_valid;
     uint16_t previous_num_recs_of_band[MAX_NR_BANDS];
 
@@ -1360,6 +1566,14 @@ static int init_measurements_dimensions(ingest_info *info)
     }
     info->num_mdr_records = valid_mdr_record;
 
+    /* Create the index of the first readout of each MDR record within the time dimension */
+    CHECKED_MALLOC(info->time_offset, (info->num_mdr_records + 1) * sizeof(long));
+    info->time_offset[0] = 0;
+    for (i = 0; i < info->num_mdr_records; i++)
+    {
+        info->time_offset[i + 1] = info->time_offset[i] + MAX_READOUTS_PER_MDR_RECORD - info->readout_offset[i];
+    }
+
     coda_cursor_goto_root(&cursor);
 
     offset = 0L;
@@ -1376,6 +1590,8 @@ static int init_measurements_dimensions(ingest_info *info)
     {
         info->total_num_pixels_all_bands = MAX_PIXELS;
     }
+    info->spectral_offset = 0;
+    info->spectral_length = info->total_num_pixels_all_bands;
     return 0;
 }
 
@@ -1412,8 +1628,9 @@ static void register_variables_radiance_transmittance_fields(harp_product_defini
     /* time_of_the_measurement */
     description = "time of the measurement at the end of the integration time";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "datetime", harp_type_double, 1, dimension_type,
-                                                   NULL, description, "seconds since 2000-01-01", NULL, read_datetime);
+        harp_ingestion_register_variable_range_read(product_definition, "datetime", harp_type_double, 1, dimension_type,
+                                                    NULL, description, "seconds since 2000-01-01", NULL,
+                                                    get_optimal_range_length, read_datetime);
     description = "The record start time is the start time of the scan and thus the start time of the second readout "
         "in the MDR. The start time for readout i (0..31) is thus RECORD_START_TIME + (i - 1) * 0.1875 and the time "
         "at end of integration time (which is the time that is returned) is RECORD_START_TIME + i * 0.1875";
@@ -1430,8 +1647,9 @@ static void register_variables_radiance_transmittance_fields(harp_product_defini
     /* latitude_of_the_measurement */
     description = "center latitude of the measurement";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "latitude", harp_type_double, 1, dimension_type,
-                                                   NULL, description, "degree_north", NULL, read_latitude);
+        harp_ingestion_register_variable_range_read(product_definition, "latitude", harp_type_double, 1, dimension_type,
+                                                    NULL, description, "degree_north", NULL, get_optimal_range_length,
+                                                    read_latitude);
     harp_variable_definition_set_valid_range_double(variable_definition, -90.0, 90.0);
     path = "/MDR[]/Earthshine/GEO_EARTH_ACTUAL/CENTRE_ACTUAL[INT_INDEX[band_id],]/latitude";
     description = "The integration time index INT_INDEX[band_id] is the index of the band with the minimum integration "
@@ -1445,8 +1663,9 @@ static void register_variables_radiance_transmittance_fields(harp_product_defini
     /* longitude_of_the_measurement */
     description = "center longitude of the measurement";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "longitude", harp_type_double, 1, dimension_type,
-                                                   NULL, description, "degree_east", NULL, read_longitude);
+        harp_ingestion_register_variable_range_read(product_definition, "longitude", harp_type_double, 1,
+                                                    dimension_type, NULL, description, "degree_east", NULL,
+                                                    get_optimal_range_length, read_longitude);
     harp_variable_definition_set_valid_range_double(variable_definition, -180.0, 180.0);
     path = "/MDR[]/Earthshine/GEO_EARTH_ACTUAL/CENTRE_ACTUAL[INT_INDEX[band_id],]/longitude";
     description =
@@ -1460,9 +1679,10 @@ static void register_variables_radiance_transmittance_fields(harp_product_defini
     /* latitude_bounds */
     description = "corner latitudes for the ground pixel of the measurement";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "latitude_bounds", harp_type_double, 2,
-                                                   bounds_dimension_type, bounds_dimension, description, "degree_north",
-                                                   NULL, read_latitude_bounds);
+        harp_ingestion_register_variable_range_read(product_definition, "latitude_bounds", harp_type_double, 2,
+                                                    bounds_dimension_type, bounds_dimension, description,
+                                                    "degree_north", NULL, get_optimal_range_length,
+                                                    read_latitude_bounds);
     harp_variable_definition_set_valid_range_double(variable_definition, -90.0, 90.0);
     path = "/MDR[]/Earthshine/GEO_EARTH_ACTUAL/CORNER_ACTUAL[INT_INDEX[band_id],,]/latitude";
     description =
@@ -1476,9 +1696,9 @@ static void register_variables_radiance_transmittance_fields(harp_product_defini
     /* longitude_bounds */
     description = "corner longitudes for the ground pixel of the measurement";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "longitude_bounds", harp_type_double, 2,
-                                                   bounds_dimension_type, bounds_dimension, description, "degree_east",
-                                                   NULL, read_longitude_bounds);
+        harp_ingestion_register_variable_range_read(product_definition, "longitude_bounds", harp_type_double, 2,
+                                                    bounds_dimension_type, bounds_dimension, description, "degree_east",
+                                                    NULL, get_optimal_range_length, read_longitude_bounds);
     harp_variable_definition_set_valid_range_double(variable_definition, -180.0, 180.0);
     path = "/MDR[]/Earthshine/GEO_EARTH_ACTUAL/CORNER_ACTUAL[INT_INDEX[band_id],,]/longitude";
     description =
@@ -1494,18 +1714,19 @@ static void register_variables_radiance_transmittance_fields(harp_product_defini
         /* wavelength_photon_radiance */
         description = "measured radiances";
         variable_definition =
-            harp_ingestion_register_variable_full_read(product_definition, "wavelength_photon_radiance",
-                                                       harp_type_double, 2, dimension_type, NULL, description,
-                                                       "count/s/cm2/sr/nm", NULL, read_wavelength_photon_radiance);
+            harp_ingestion_register_variable_range_read(product_definition, "wavelength_photon_radiance",
+                                                        harp_type_double, 2, dimension_type, NULL, description,
+                                                        "count/s/cm2/sr/nm", NULL, get_optimal_range_length,
+                                                        read_wavelength_photon_radiance);
     }
     else
     {
         /* transmittance */
         description = "transmittance";
         variable_definition =
-            harp_ingestion_register_variable_full_read(product_definition, "transmittance", harp_type_double, 2,
-                                                       dimension_type, NULL, description, HARP_UNIT_DIMENSIONLESS, NULL,
-                                                       read_transmittance);
+            harp_ingestion_register_variable_range_read(product_definition, "transmittance", harp_type_double, 2,
+                                                        dimension_type, NULL, description, HARP_UNIT_DIMENSIONLESS,
+                                                        NULL, get_optimal_range_length, read_transmittance);
     }
     path = "/MDR[]/Earthshine/BAND_1A[,]/RAD, /MDR[]/Earthshine/BAND_1B[,]/RAD, /MDR[]/Earthshine/BAND_2A[,]/RAD, "
         "/MDR[]/Earthshine/BAND_2B[,]/RAD, /MDR[]/Earthshine/BAND_3[,]/RAD, /MDR[]/Earthshine/BAND_4[,]/RAD";
@@ -1514,8 +1735,9 @@ static void register_variables_radiance_transmittance_fields(harp_product_defini
     /* wavelength */
     description = "nominal wavelength assignment for each of the detector pixels";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "wavelength", harp_type_double, 2,
-                                                   dimension_type, NULL, description, "nm", NULL, read_wavelength);
+        harp_ingestion_register_variable_range_read(product_definition, "wavelength", harp_type_double, 2,
+                                                    dimension_type, NULL, description, "nm", NULL,
+                                                    get_optimal_range_length, read_wavelength);
     path = "/MDR[]/Earthshine/WAVELENGTH_1A[], /MDR[]/Earthshine/WAVELENGTH_1B[], /MDR[]/Earthshine/WAVELENGTH_2A[], "
         "/MDR/Earthshine[]/WAVELENGTH_2B[], /MDR[]/Earthshine/WAVELENGTH_3[], /MDR[]/Earthshine/WAVELENGTH_4[]";
     harp_variable_definition_add_mapping(variable_definition, NULL, NULL, path, NULL);
@@ -1523,8 +1745,9 @@ static void register_variables_radiance_transmittance_fields(harp_product_defini
     /* integration_time */
     description = "integration time for each pixel";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "integration_time", harp_type_double, 2,
-                                                   dimension_type, NULL, description, "s", NULL, read_integration_time);
+        harp_ingestion_register_variable_range_read(product_definition, "integration_time", harp_type_double, 2,
+                                                    dimension_type, NULL, description, "s", NULL,
+                                                    get_optimal_range_length, read_integration_time);
     path = "/MDR[]/Earthshine/INTEGRATION_TIMES[]";
     harp_variable_definition_add_mapping(variable_definition, NULL, NULL, path, NULL);
 
@@ -1550,9 +1773,9 @@ static void register_variables_radiance_transmittance_fields(harp_product_defini
     /* cloud_top_pressure */
     description = "cloud top pressure";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "cloud_top_pressure", harp_type_double, 1,
-                                                   dimension_type, NULL, description, "hPa", NULL,
-                                                   read_cloud_top_pressure);
+        harp_ingestion_register_variable_range_read(product_definition, "cloud_top_pressure", harp_type_double, 1,
+                                                    dimension_type, NULL, description, "hPa", NULL,
+                                                    get_optimal_range_length, read_cloud_top_pressure);
     path = "/MDR[]/Earthshine/CLOUD/FIT_1[]";
     description = "If the minimum ingested integration time > 187.5ms then the corresponding cloud top pressures will "
         "be combined using logarithmic averaging. The cloud top pressure will be set to NaN if FIT_MODE in the CLOUD "
@@ -1563,9 +1786,9 @@ static void register_variables_radiance_transmittance_fields(harp_product_defini
     /* cloud_fraction */
     description = "cloud fraction";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "cloud_fraction", harp_type_double, 1,
-                                                   dimension_type, NULL, description, HARP_UNIT_DIMENSIONLESS, NULL,
-                                                   read_cloud_fraction);
+        harp_ingestion_register_variable_range_read(product_definition, "cloud_fraction", harp_type_double, 1,
+                                                    dimension_type, NULL, description, HARP_UNIT_DIMENSIONLESS, NULL,
+                                                    get_optimal_range_length, read_cloud_fraction);
     path = "/MDR[]/Earthshine/CLOUD/FIT_2[]";
     description = "If the minimum ingested integration time > 187.5ms then the corresponding cloud fractions will be "
         "combined using averaging. The cloud fraction will be set to NaN if FIT_MODE in the CLOUD structure is not "
@@ -1575,9 +1798,9 @@ static void register_variables_radiance_transmittance_fields(harp_product_defini
     /* solar_zenith_angle */
     description = "solar zenith angle at top of atmosphere";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "solar_zenith_angle_toa", harp_type_double, 1,
-                                                   dimension_type, NULL, description, "degree", NULL,
-                                                   read_solar_zenith_angle);
+        harp_ingestion_register_variable_range_read(product_definition, "solar_zenith_angle_toa", harp_type_double, 1,
+                                                    dimension_type, NULL, description, "degree", NULL,
+                                                    get_optimal_range_length, read_solar_zenith_angle);
     path = "/MDR[]/Earthshine/GEO_EARTH_ACTUAL/SOLAR_ZENITH_ACTUAL[INT_INDEX[band_id],1,]";
     description = "The integration time index INT_INDEX[band_id] is the index of the band with the minimum "
         "integration time (limited to those bands that are ingested).";
@@ -1590,9 +1813,9 @@ static void register_variables_radiance_transmittance_fields(harp_product_defini
     /* solar_azimuth_angle */
     description = "solar azimuth angle at top of atmosphere";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "solar_azimuth_angle_toa", harp_type_double, 1,
-                                                   dimension_type, NULL, description, "degree", NULL,
-                                                   read_solar_azimuth_angle);
+        harp_ingestion_register_variable_range_read(product_definition, "solar_azimuth_angle_toa", harp_type_double, 1,
+                                                    dimension_type, NULL, description, "degree", NULL,
+                                                    get_optimal_range_length, read_solar_azimuth_angle);
     path = "/MDR[]/Earthshine/GEO_EARTH_ACTUAL/SOLAR_AZIMUTH_ACTUAL[INT_INDEX[band_id],1,]";
     description = "The integration time index INT_INDEX[band_id] is the index of the band with the minimum "
         "integration time (limited to those bands that are ingested).";
@@ -1605,9 +1828,9 @@ static void register_variables_radiance_transmittance_fields(harp_product_defini
     /* viewing_zenith_angle */
     description = "viewing zenith angle at top of atmosphere";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "viewing_zenith_angle_toa", harp_type_double, 1,
-                                                   dimension_type, NULL, description, "degree", NULL,
-                                                   read_viewing_zenith_angle);
+        harp_ingestion_register_variable_range_read(product_definition, "viewing_zenith_angle_toa", harp_type_double, 1,
+                                                    dimension_type, NULL, description, "degree", NULL,
+                                                    get_optimal_range_length, read_viewing_zenith_angle);
     path = "/MDR[]/Earthshine/GEO_EARTH_ACTUAL/SAT_ZENITH_ACTUAL[INT_INDEX[band_id],1,]";
     description = "The integration time index INT_INDEX[band_id] is the index of the band with the minimum "
         "integration time (limited to those bands that are ingested).";
@@ -1620,9 +1843,9 @@ static void register_variables_radiance_transmittance_fields(harp_product_defini
     /* viewing_azimuth_angle */
     description = "viewing azimuth angle at top of atmosphere";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "viewing_azimuth_angle_toa", harp_type_double, 1,
-                                                   dimension_type, NULL, description, "degree", NULL,
-                                                   read_viewing_azimuth_angle);
+        harp_ingestion_register_variable_range_read(product_definition, "viewing_azimuth_angle_toa", harp_type_double,
+                                                    1, dimension_type, NULL, description, "degree", NULL,
+                                                    get_optimal_range_length, read_viewing_azimuth_angle);
     path = "/MDR[]/Earthshine/GEO_EARTH_ACTUAL/SAT_AZIMUTH_ACTUAL[INT_INDEX[band_id],1,]";
     description = "The integration time index INT_INDEX[band_id] is the index of the band with the minimum "
         "integration time (limited to those bands that are ingested).";
@@ -1646,8 +1869,9 @@ static void register_variables_irradiance_fields(harp_product_definition *produc
     /* time_of_the_measurement */
     description = "time of the measurement at the end of the integration time";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "datetime", harp_type_double, 1, dimension_type,
-                                                   NULL, description, "seconds since 2000-01-01", NULL, read_datetime);
+        harp_ingestion_register_variable_range_read(product_definition, "datetime", harp_type_double, 1, dimension_type,
+                                                    NULL, description, "seconds since 2000-01-01", NULL,
+                                                    get_optimal_range_length, read_datetime);
     description = "The record start time is the start time of the scan and thus the start time of the second readout "
         "in the MDR. The start time for readout i (0..31) is thus RECORD_START_TIME + (i - 1) * 0.1875 and the time "
         "at end of integration time (which is the time that is returned) is RECORD_START_TIME + i * 0.1875";
@@ -1666,10 +1890,10 @@ static void register_variables_irradiance_fields(harp_product_definition *produc
     /* wavelength_photon_irradiance of the sun */
     description = "measured sun irradiances";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "wavelength_photon_irradiance_sun",
-                                                   harp_type_double, 2, dimension_type, NULL, description,
-                                                   "count/s/cm2/nm", include_when_sun,
-                                                   read_sun_wavelength_photon_irradiance);
+        harp_ingestion_register_variable_range_read(product_definition, "wavelength_photon_irradiance_sun",
+                                                    harp_type_double, 2, dimension_type, NULL, description,
+                                                    "count/s/cm2/nm", include_when_sun, get_optimal_range_length,
+                                                    read_sun_wavelength_photon_irradiance);
     path = "/MDR[]/Sun/BAND_1A[,]/RAD, /MDR[]/Sun/BAND_1B[,]/RAD, /MDR[]/Sun/BAND_2A[,]/RAD, "
         "/MDR[]/Sun/BAND_2B[,]/RAD, /MDR[]/Sun/BAND_3[,]/RAD, /MDR[]/Sun/BAND_4[,]/RAD";
     harp_variable_definition_add_mapping(variable_definition, "data=sun", NULL, path, NULL);
@@ -1677,10 +1901,10 @@ static void register_variables_irradiance_fields(harp_product_definition *produc
     /* wavelength_photon_irradiance of the moon */
     description = "measured moon irradiances";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "wavelength_photon_irradiance_moon",
-                                                   harp_type_double, 2, dimension_type, NULL, description,
-                                                   "count/s/cm2/nm", include_when_moon,
-                                                   read_moon_wavelength_photon_irradiance);
+        harp_ingestion_register_variable_range_read(product_definition, "wavelength_photon_irradiance_moon",
+                                                    harp_type_double, 2, dimension_type, NULL, description,
+                                                    "count/s/cm2/nm", include_when_moon, get_optimal_range_length,
+                                                    read_moon_wavelength_photon_irradiance);
     path = "/MDR[]/Moon/BAND_1A[,]/RAD, /MDR[]/Moon/BAND_1B[,]/RAD, /MDR[]/Moon/BAND_2A[,]/RAD, "
         "/MDR[]/Moon/BAND_2B[,]/RAD, /MDR[]/Moon/BAND_3[,]/RAD, /MDR[]/Moon/BAND_4[,]/RAD";
     harp_variable_definition_add_mapping(variable_definition, "data=moon", NULL, path, NULL);
@@ -1688,8 +1912,9 @@ static void register_variables_irradiance_fields(harp_product_definition *produc
     /* wavelength */
     description = "nominal wavelength assignment for each of the detector pixels";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "wavelength", harp_type_double, 2,
-                                                   dimension_type, NULL, description, "nm", NULL, read_wavelength);
+        harp_ingestion_register_variable_range_read(product_definition, "wavelength", harp_type_double, 2,
+                                                    dimension_type, NULL, description, "nm", NULL,
+                                                    get_optimal_range_length, read_wavelength);
     path = "/MDR[]/Sun/WAVELENGTH_1A[], /MDR[]/Sun/WAVELENGTH_1B[], /MDR[]/Sun/WAVELENGTH_2A[], "
         "/MDR[]/Sun/WAVELENGTH_2B[], /MDR[]/Sun/WAVELENGTH_3[], /MDR[]/Sun/WAVELENGTH_4[]";
     harp_variable_definition_add_mapping(variable_definition, "data=sun", NULL, path, NULL);
@@ -1700,8 +1925,9 @@ static void register_variables_irradiance_fields(harp_product_definition *produc
     /* integration_time */
     description = "integration time for each pixel";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "integration_time", harp_type_double, 2,
-                                                   dimension_type, NULL, description, "s", NULL, read_integration_time);
+        harp_ingestion_register_variable_range_read(product_definition, "integration_time", harp_type_double, 2,
+                                                    dimension_type, NULL, description, "s", NULL,
+                                                    get_optimal_range_length, read_integration_time);
     path = "/MDR[]/Sun/INTEGRATION_TIMES[]";
     harp_variable_definition_add_mapping(variable_definition, "data=sun", NULL, path, NULL);
     path = "/MDR[]/Moon/INTEGRATION_TIMES[]";
@@ -1711,15 +1937,8 @@ static void register_variables_irradiance_fields(harp_product_definition *produc
 static int read_dimensions_measurements_fields(void *user_data, long dimension[HARP_NUM_DIM_TYPES])
 {
     ingest_info *info = (ingest_info *)user_data;
-    long i, total_skipped_readouts;
-
-    total_skipped_readouts = 0;
-    for (i = 0; i < info->num_mdr_records; i++)
-    {
-        total_skipped_readouts += info->readout_offset[i];
-    }
 
-    dimension[harp_dimension_time] = (info->num_mdr_records * MAX_READOUTS_PER_MDR_RECORD) - total_skipped_readouts;
+    dimension[harp_dimension_time] = info->time_offset[info->num_mdr_records];
     dimension[harp_dimension_spectral] = info->total_num_pixels_all_bands;
     return 0;
 }
@@ -1927,6 +2146,8 @@ static int init_sun_reference_dimensions(ingest_info *info)
     {
         info->total_num_pixels_all_bands = MAX_PIXELS;
     }
+    info->spectral_offset = 0;
+    info->spectral_length = info->total_num_pixels_all_bands;
     return 0;
 }
 
@@ -2110,6 +2331,7 @@ static harp_product_definition *register_measurement_product(harp_ingestion_modu
 
     product_definition = harp_ingestion_register_product(module, product_name, product_description,
                                                          read_dimensions_measurements_fields);
+    harp_ingestion_register_dimension_range_hint(product_definition, set_dimension_range_hint);
     description = "The GOME2 spectral data in the GOME2 L1b product is stored inside MDRs. There are separate MDRs for "
         "Earthshine, Calibration, Sun, and Moon measurements. In addition there are also 'Dummy Records' (DMDR) that "
         "can be present when there is lost data in the product. With HARP only Earthshine, Sun, and Moon "
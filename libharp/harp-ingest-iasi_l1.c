@@ -49,6 +49,7 @@ typedef enum main_data_variable_enum
 #define SCANS_PER_SCANLINE     30
 #define SPECTRA_PER_SCAN        4
 #define SPECTRA_PER_SCANLINE   (SPECTRA_PER_SCAN * SCANS_PER_SCANLINE)
+#define SCANLINES_PER_RANGE    16
 
 typedef struct ingest_info_struct
 {
@@ -59,14 +60,16 @@ typedef struct ingest_info_struct
     coda_cursor *mdr_cursors;
     long num_main;      /* Number spectral measurements in the file (number scanlines * 30 * 4) */
     long num_pixels;    /* Number of pixels in 1 scan (will usually be 8700) */
+    long spectral_offset;       /* First index in the spectral dimension that needs to be read */
+    long spectral_length;       /* Number of indices in the spectral dimension that need to be read */
     int16_t nr_scale_factors;
     int16_t *scale_factors;
     int16_t *channel_first;
     int16_t *channel_last;
 } ingest_info;
 
-static int get_main_data(ingest_info *info, const char *fieldname, main_data_variable var_type,
-                         double *double_data_array)
+static int get_main_data(ingest_info *info, long first_scanline, long num_scanlines, const char *fieldname,
+                         main_data_variable var_type, double *double_data_array)
 {
     coda_cursor cursor;
     double *double_data;
@@ -74,7 +77,7 @@ static int get_main_data(ingest_info *info, const char *fieldname, main_data_var
     long mdr_nr, i, offset;
 
     double_data = double_data_array;
-    for (mdr_nr = 0; mdr_nr < info->valid_scanlines; mdr_nr++)
+    for (mdr_nr = first_scanline; mdr_nr < first_scanline + num_scanlines; mdr_nr++)
     {
         cursor = info->mdr_cursors[mdr_nr];
         if (coda_cursor_goto(&cursor, fieldname) != 0)
@@ -127,13 +130,12 @@ static int get_spectra_sample_data(ingest_info *info, long row, float *float_dat
 {
     int32_t first_channel;
     int16_t measured_spectrum_data[8700];
-    int16_t *spectrum_data;
     coda_cursor cursor;
-    float *float_data;
-    int16_t scale_nr, channel_nr;
-    int16_t *start_of_this_spectrum;
+    double scale;
+    long first_pixel, last_pixel, pixel_offset;
+    long index, first_index, last_index, i;
+    int16_t scale_nr;
 
-    float_data = float_data_array;
     cursor = info->mdr_cursors[row / SPECTRA_PER_SCANLINE];
     if (coda_cursor_goto_record_field_by_name(&cursor, "IDefNsfirst1b") != 0)
     {
@@ -157,28 +159,60 @@ static int get_spectra_sample_data(ingest_info *info, long row, float *float_dat
         return -1;
     }
 
-    if (coda_cursor_read_int16_partial_array(&cursor, (row % SPECTRA_PER_SCANLINE) * info->num_pixels,
-                                             info->num_pixels, measured_spectrum_data) != 0)
+    /* Determine which pixels of the measured spectrum are needed for the requested part of the spectral dimension.
+     * Each scale factor covers a consecutive range of channels, which end up consecutively in the spectral dimension.
+     */
+    first_pixel = info->num_pixels;
+    last_pixel = -1;
+    index = 0;
+    for (scale_nr = 0; scale_nr < info->nr_scale_factors; scale_nr++)
+    {
+        pixel_offset = info->channel_first[scale_nr] - first_channel - index;
+        first_index = index > info->spectral_offset ? index : info->spectral_offset;
+        index += info->channel_last[scale_nr] - info->channel_first[scale_nr] + 1;
+        last_index = index < info->spectral_offset + info->spectral_length ? index :
+            info->spectral_offset + info->spectral_length;
+        if (first_index < last_index)
+        {
+            if (first_index + pixel_offset < first_pixel)
+            {
+                first_pixel = first_index + pixel_offset;
+            }
+            if (last_index - 1 + pixel_offset > last_pixel)
+            {
+                last_pixel = last_index - 1 + pixel_offset;
+            }
+        }
+    }
+    if (last_pixel < first_pixel)
+    {
+        return 0;
+    }
+
+    if (coda_cursor_read_int16_partial_array(&cursor, (row % SPECTRA_PER_SCANLINE) * info->num_pixels + first_pixel,
+                                             last_pixel - first_pixel + 1, &measured_spectrum_data[first_pixel]) != 0)
     {
         harp_set_error(HARP_ERROR_CODA, NULL);
         return -1;
     }
-    spectrum_data = measured_spectrum_data;
 
-    start_of_this_spectrum = spectrum_data;
+    index = 0;
     for (scale_nr = 0; scale_nr < info->nr_scale_factors; scale_nr++)
     {
-        spectrum_data = start_of_this_spectrum + info->channel_first[scale_nr] - first_channel;
-        for (channel_nr = info->channel_first[scale_nr]; channel_nr <= info->channel_last[scale_nr]; channel_nr++)
+        pixel_offset = info->channel_first[scale_nr] - first_channel - index;
+        first_index = index > info->spectral_offset ? index : info->spectral_offset;
+        index += info->channel_last[scale_nr] - info->channel_first[scale_nr] + 1;
+        last_index = index < info->spectral_offset + info->spectral_length ? index :
+            info->spectral_offset + info->spectral_length;
+
+        /* Because this data has limited precision (it was stored in */
+        /* an int16), we store the radiance in a float.              */
+        scale = pow(10.0, -(info->scale_factors[scale_nr]));
+        for (i = first_index; i < last_index; i++)
         {
-            /* Because this data has limited precision (it was stored in */
-            /* an int16), we store the radiance in a float.              */
-            *float_data = (float)((*spectrum_data) * pow(10.0, -(info->scale_factors[scale_nr])));
-            float_data++;
-            spectrum_data++;
+            float_data_array[i] = (float)(measured_spectrum_data[i + pixel_offset] * scale);
         }
     }
-    spectrum_data = start_of_this_spectrum + info->num_pixels;
 
     return 0;
 }
@@ -263,6 +297,10 @@ static void ingestion_done(void *user_data)
     {
         free(info->channel_last);
     }
+    if (info->mdr_cursors != NULL)
+    {
+        free(info->mdr_cursors);
+    }
 
     free(info);
 }
@@ -274,18 +312,21 @@ static int read_dimensions(void *user_data, long dimension[HARP_NUM_DIM_TYPES])
     return 0;
 }
 
-static int read_datetime(void *user_data, harp_array data)
+static int get_datetime_data(ingest_info *info, long first_scanline, long num_scanlines, double *double_data_array)
 {
     double *mdr_times, *double_data;
     double scantime;
-    ingest_info *info = (ingest_info *)user_data;
     long i, j, k;
-    int retval;
 
-    CHECKED_MALLOC(mdr_times, sizeof(double) * info->valid_scanlines);
-    retval = get_main_data(info, "RECORD_HEADER/RECORD_START_TIME", DATETIME, mdr_times);
-    double_data = data.double_data;
-    for (i = 0; i < info->valid_scanlines; i++)
+    CHECKED_MALLOC(mdr_times, sizeof(double) * num_scanlines);
+    if (get_main_data(info, first_scanline, num_scanlines, "RECORD_HEADER/RECORD_START_TIME", DATETIME, mdr_times) !=
+        0)
+    {
+        free(mdr_times);
+        return -1;
+    }
+    double_data = double_data_array;
+    for (i = 0; i < num_scanlines; i++)
     {
         for (j = 0; j < SCANS_PER_SCANLINE; j++)
         {
@@ -300,9 +341,71 @@ static int read_datetime(void *user_data, harp_array data)
         }
     }
     free(mdr_times);
+    return 0;
+}
+
+/* Read the spectra [index_offset, index_offset + index_length) of the time dimension. Only the scanlines that overlap
+ * with the range are read. If the range does not start and end at a scanline boundary, the scanlines are read into a
+ * temporary buffer first.
+ */
+static int get_main_data_range(ingest_info *info, long index_offset, long index_length, main_data_variable var_type,
+                               double *double_data)
+{
+    long first_scanline, num_scanlines;
+    double *buffer;
+    int retval;
+
+    if (index_length <= 0)
+    {
+        return 0;
+    }
+
+    first_scanline = index_offset / SPECTRA_PER_SCANLINE;
+    num_scanlines = (index_offset + index_length - 1) / SPECTRA_PER_SCANLINE - first_scanline + 1;
+    assert(first_scanline + num_scanlines <= info->valid_scanlines);
+
+    if (index_offset % SPECTRA_PER_SCANLINE == 0 && index_length == num_scanlines * SPECTRA_PER_SCANLINE)
+    {
+        buffer = double_data;
+    }
+    else
+    {
+        CHECKED_MALLOC(buffer, num_scanlines * SPECTRA_PER_SCANLINE * sizeof(double));
+    }
+
+    if (var_type == DATETIME)
+    {
+        retval = get_datetime_data(info, first_scanline, num_scanlines, buffer);
+    }
+    else
+    {
+        retval = get_main_data(info, first_scanline, num_scanlines, "GGeoSondLoc", var_type, buffer);
+    }
+
+    if (buffer != double_data)
+    {
+        if (retval == 0)
+        {
+            memcpy(double_data, &buffer[index_offset % SPECTRA_PER_SCANLINE], index_length * sizeof(double));
+        }
+        free(buffer);
+    }
+
     return retval;
 }
 
+static long get_optimal_range_length(void *user_data)
+{
+    (void)user_data;
+
+    return SCANLINES_PER_RANGE * SPECTRA_PER_SCANLINE;
+}
+
+static int read_datetime(void *user_data, long index_offset, long index_length, harp_array data)
+{
+    return get_main_data_range((ingest_info *)user_data, index_offset, index_length, DATETIME, data.double_data);
+}
+
 static int read_orbit_index(void *user_data, harp_array data)
 {
     ingest_info *info = (ingest_info *)user_data;
@@ -328,14 +431,28 @@ static int read_orbit_index(void *user_data, harp_array data)
     return 0;
 }
 
-static int read_latitude(void *user_data, harp_array data)
+static int read_latitude(void *user_data, long index_offset, long index_length, harp_array data)
+{
+    return get_main_data_range((ingest_info *)user_data, index_offset, index_length, LATITUDE, data.double_data);
+}
+
+static int read_longitude(void *user_data, long index_offset, long index_length, harp_array data)
 {
-    return get_main_data((ingest_info *)user_data, "GGeoSondLoc", LATITUDE, data.double_data);
+    return get_main_data_range((ingest_info *)user_data, index_offset, index_length, LONGITUDE, data.double_data);
 }
 
-static int read_longitude(void *user_data, harp_array data)
+static int set_dimension_range_hint(void *user_data, harp_dimension_type dimension_type, long index_offset,
+                                    long index_length)
 {
-    return get_main_data((ingest_info *)user_data, "GGeoSondLoc", LONGITUDE, data.double_data);
+    ingest_info *info = (ingest_info *)user_data;
+
+    if (dimension_type == harp_dimension_spectral)
+    {
+        info->spectral_offset = index_offset;
+        info->spectral_length = index_length;
+    }
+
+    return 0;
 }
 
 static int read_spectral_radiance_sample(void *user_data, long index, harp_array data)
@@ -554,6 +671,8 @@ static int ingestion_init(const harp_ingestion_module *module, coda_product *pro
         ingestion_done(info);
         return -1;
     }
+    info->spectral_offset = 0;
+    info->spectral_length = info->num_pixels;
 
     *definition = *module->product_definition;
     *user_data = info;
@@ -577,6 +696,7 @@ int harp_ingestion_module_iasi_l1_init(void)
 
     description = "IASI Level 1 product";
     product_definition = harp_ingestion_register_product(module, "IASI_L1", description, read_dimensions);
+    harp_ingestion_register_dimension_range_hint(product_definition, set_dimension_range_hint);
     description = "IASI Level 1 products contain a number of scanlines, each scanline contains 30 scans, each scan "
         "contains 4 spectra and each spectrum contains 8700 measurements";
     harp_product_definition_add_mapping(product_definition, description, NULL);
@@ -587,8 +707,9 @@ int harp_ingestion_module_iasi_l1_init(void)
     /* datetime */
     description = "time of the measurement";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "datetime", harp_type_double, 1, dimension_type,
-                                                   NULL, description, "seconds since 2000-01-01", NULL, read_datetime);
+        harp_ingestion_register_variable_range_read(product_definition, "datetime", harp_type_double, 1, dimension_type,
+                                                    NULL, description, "seconds since 2000-01-01", NULL,
+                                                    get_optimal_range_length, read_datetime);
     path = "/MDR[]/MDR/RECORD_HEADER/RECORD_START_TIME";
     harp_variable_definition_add_mapping(variable_definition, NULL, NULL, path, "");
 
@@ -602,8 +723,9 @@ int harp_ingestion_module_iasi_l1_init(void)
     /* latitude */
     description = "center latitude of the measurement";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "latitude", harp_type_double, 1, dimension_type,
-                                                   NULL, description, "degree_north", NULL, read_latitude);
+        harp_ingestion_register_variable_range_read(product_definition, "latitude", harp_type_double, 1, dimension_type,
+                                                    NULL, description, "degree_north", NULL, get_optimal_range_length,
+                                                    read_latitude);
     harp_variable_definition_set_valid_range_double(variable_definition, -90.0, 90.0);
     path = "/MDR[]/MDR/GGeoSondLoc[,,1]";
     harp_variable_definition_add_mapping(variable_definition, NULL, NULL, path, NULL);
@@ -611,8 +733,9 @@ int harp_ingestion_module_iasi_l1_init(void)
     /* longitude */
     description = "center longitude of the measurement";
     variable_definition =
-        harp_ingestion_register_variable_full_read(product_definition, "longitude", harp_type_double, 1, dimension_type,
-                                                   NULL, description, "degree_east", NULL, read_longitude);
+        harp_ingestion_register_variable_range_read(product_definition, "longitude", harp_type_double, 1,
+                                                    dimension_type, NULL, description, "degree_east", NULL,
+                                                    get_optimal_range_length, read_longitude);
     harp_variable_definition_set_valid_range_double(variable_definition, -180.0, 180.0);
     path = "/MDR[]/MDR/GGeoSondLoc[,,0]";
     harp_variable_definition_add_mapping(variable_definition, NULL, NULL, path, NULL);
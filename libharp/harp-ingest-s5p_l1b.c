@@ -59,6 +59,10 @@ typedef struct ingest_info_struct
     long num_pixels;
     long num_channels;
 
+    /* range of channels that needs to be read */
+    long channel_offset;
+    long num_channels_to_read;
+
     coda_cursor sensor_mode_cursor;
     coda_cursor geo_data_cursor;
     coda_cursor observation_cursor;
@@ -207,6 +211,20 @@ static int read_partial_dataset(const coda_cursor *cursor, long offset, long len
     return 0;
 }
 
+/* Read the channels [channel_offset, channel_offset + num_channels_to_read) of the spectrum that starts at the given
+ * offset into the dataset. The values of the other channels are left unset.
+ */
+static int read_partial_spectrum(ingest_info *info, const coda_cursor *cursor, long offset, harp_array data,
+                                 harp_scalar fill_value)
+{
+    harp_array channel_data;
+
+    channel_data.float_data = &data.float_data[info->channel_offset];
+
+    return read_partial_dataset(cursor, offset + info->channel_offset, info->num_channels_to_read, channel_data,
+                                fill_value);
+}
+
 static int init_cursors(ingest_info *info, const char *product_group_name)
 {
     coda_cursor cursor;
@@ -407,6 +425,8 @@ static int ingestion_init_s5p_l1b_ir(const harp_ingestion_module *module, coda_p
         ingestion_done(info);
         return -1;
     }
+    info->channel_offset = 0;
+    info->num_channels_to_read = info->num_channels;
 
     /* Initialize cursors and fill values for datasets which will be read using partial reads. */
     if (init_dataset
@@ -467,6 +487,8 @@ static int ingestion_init_s5p_l1b_ra(const harp_ingestion_module *module, coda_p
         ingestion_done(info);
         return -1;
     }
+    info->channel_offset = 0;
+    info->num_channels_to_read = info->num_channels;
 
     /* Initialize cursors and fill values for datasets which will be read using partial reads. */
     if (init_dataset
@@ -501,6 +523,20 @@ static int read_dimensions(void *user_data, long dimension[HARP_NUM_DIM_TYPES])
     return 0;
 }
 
+static int set_dimension_range_hint(void *user_data, harp_dimension_type dimension_type, long index_offset,
+                                    long index_length)
+{
+    ingest_info *info = (ingest_info *)user_data;
+
+    if (dimension_type == harp_dimension_spectral)
+    {
+        info->channel_offset = index_offset;
+        info->num_channels_to_read = index_length;
+    }
+
+    return 0;
+}
+
 static int read_scan_subindex(void *user_data, long index, harp_array data)
 {
     ingest_info *info = (ingest_info *)user_data;
@@ -754,16 +790,15 @@ static int read_wavelength(void *user_data, long index, harp_array data)
      */
     offset = (index - (index / info->num_pixels) * info->num_pixels) * info->num_channels;
 
-    return read_partial_dataset(&info->wavelength_cursor, offset, info->num_channels, data,
-                                info->wavelength_fill_value);
+    return read_partial_spectrum(info, &info->wavelength_cursor, offset, data, info->wavelength_fill_value);
 }
 
 static int read_observable(void *user_data, long index, harp_array data)
 {
     ingest_info *info = (ingest_info *)user_data;
 
-    return read_partial_dataset(&info->observable_cursor, index * info->num_channels, info->num_channels, data,
-                                info->observable_fill_value);
+    return read_partial_spectrum(info, &info->observable_cursor, index * info->num_channels, data,
+                                 info->observable_fill_value);
 }
 
 static void register_irradiance_product_variables(harp_product_definition *product_definition,
@@ -774,6 +809,8 @@ static void register_irradiance_product_variables(harp_product_definition *produ
     const char *description;
     char path[MAX_PATH_LENGTH];
 
+    harp_ingestion_register_dimension_range_hint(product_definition, set_dimension_range_hint);
+
     description = "zero-based index of the pixel within the scanline";
     variable_definition =
         harp_ingestion_register_variable_block_read(product_definition, "scan_subindex", harp_type_int16, 1,
@@ -829,6 +866,8 @@ static void register_radiance_product_variables(harp_product_definition *product
     const char *description;
     char path[MAX_PATH_LENGTH];
 
+    harp_ingestion_register_dimension_range_hint(product_definition, set_dimension_range_hint);
+
     description = "zero-based index of the pixel within the scanline";
     variable_definition =
         harp_ingestion_register_variable_block_read(product_definition, "scan_subindex", harp_type_int16, 1,
@@ -72,6 +72,8 @@ typedef struct ingest_info_struct
     /* Data about the whole ingested file */
     long total_num_observations;
     uint16_t total_num_wavelengths;
+    long spectral_offset;       /* First index in the spectral dimension that needs to be read */
+    long spectral_length;       /* Number of indices in the spectral dimension that need to be read */
     long num_states_current_datasource;
     int8_t *cluster_filter;
 
@@ -421,6 +423,7 @@ static int get_spectral_data(ingest_info *info, double *double_data_array)
     coda_cursor cursor;
     double *double_data, *double_data_start_state, *double_data_start_cluster;
     long i, j, k, l, num_wavelengths, num_obs, num_copies, dim[CODA_MAX_NUM_DIMS];
+    long cluster_offset, first_wavelength, end_wavelength;
     int num_dims;
     int8_t rad_units_flag;
 
@@ -480,11 +483,25 @@ static int get_spectral_data(ingest_info *info, double *double_data_array)
             num_wavelengths = dim[1];
             num_obs = dim[0];
             num_copies = info->max_num_obs_per_state[i] / num_obs;
-            double_data = double_data_start_cluster;
-            for (k = 0; k < num_obs; k++)
+
+            /* only read the wavelengths of this cluster that are within the requested part of the spectrum */
+            cluster_offset = (long)(double_data_start_cluster - double_data_start_state);
+            first_wavelength = info->spectral_offset - cluster_offset;
+            if (first_wavelength < 0)
+            {
+                first_wavelength = 0;
+            }
+            end_wavelength = info->spectral_offset + info->spectral_length - cluster_offset;
+            if (end_wavelength > num_wavelengths)
+            {
+                end_wavelength = num_wavelengths;
+            }
+
+            double_data = double_data_start_cluster + first_wavelength;
+            for (k = 0; k < num_obs && first_wavelength < end_wavelength; k++)
             {
-                if (coda_cursor_read_double_partial_array(&cursor, k * num_wavelengths, num_wavelengths, double_data) !=
-                    0)
+                if (coda_cursor_read_double_partial_array(&cursor, k * num_wavelengths + first_wavelength,
+                                                          end_wavelength - first_wavelength, double_data) != 0)
                 {
                     harp_set_error(HARP_ERROR_CODA, NULL);
                     return -1;
@@ -492,7 +509,7 @@ static int get_spectral_data(ingest_info *info, double *double_data_array)
                 for (l = 1; l < num_copies; l++)
                 {
                     memcpy(double_data + (l * info->total_num_wavelengths), double_data,
-                           num_wavelengths * sizeof(double));
+                           (end_wavelength - first_wavelength) * sizeof(double));
                 }
                 double_data += info->total_num_wavelengths * num_copies;
             }
@@ -513,6 +530,20 @@ static int get_spectral_data(ingest_info *info, double *double_data_array)
     return 0;
 }
 
+static int set_dimension_range_hint(void *user_data, harp_dimension_type dimension_type, long index_offset,
+                                    long index_length)
+{
+    ingest_info *info = (ingest_info *)user_data;
+
+    if (dimension_type == harp_dimension_spectral)
+    {
+        info->spectral_offset = index_offset;
+        info->spectral_length = index_length;
+    }
+
+    return 0;
+}
+
 static int get_wavelength_data(ingest_info *info, double *double_data_array)
 {
     coda_cursor cursor;
@@ -1289,6 +1320,8 @@ static int init_nadir_limb_occultation_dimensions(ingest_info *info)
         }
     }
     CHECKED_MALLOC(info->wavelengths, info->total_num_wavelengths * sizeof(double));
+    info->spectral_offset = 0;
+    info->spectral_length = info->total_num_wavelengths;
     return 0;
 }
 
@@ -1305,6 +1338,7 @@ static void register_nadir_limb_occultation_product(harp_ingestion_module *modul
 
     product_definition = harp_ingestion_register_product(module, "SCIAMACHY_L1c", "SCIAMACHY Level 1c",
                                                          read_dimensions);
+    harp_ingestion_register_dimension_range_hint(product_definition, set_dimension_range_hint);
     harp_product_definition_add_mapping(product_definition, NULL, "data=nadir or data=limb or data=occultation");
 
     dimension_type[0] = harp_dimension_time;
@@ -799,7 +799,10 @@ LIBHARP_API int harp_doc_export_ingestion_definitions(const char *path)
     }
 
     module_register = harp_ingestion_get_module_register();
-    assert(module_register != NULL);
+    if (module_register == NULL)
+    {
+        return -1;
+    }
 
     filename = (char *)malloc(scprintf("%s/index.rst", path) + 1);
     if (filename == NULL)
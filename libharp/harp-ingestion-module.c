@@ -101,72 +101,87 @@ int harp_ingestion_module_smr_l2_init(void);
 int harp_ingestion_module_temis_init(void);
 int harp_ingestion_module_tes_l2_init(void);
 
-/* Module initialization functions. */
+/* Module initialization functions.
+ * Each initialization function registers the ingestion modules for products of a single CODA product class.
+ * Modules are only initialized once a product of their product class is encountered (or when the full list of modules
+ * is needed), which keeps harp_init() cheap.
+ * Initialization functions of custom modules (that identify products using verify_product_type() instead of CODA)
+ * should be listed with a NULL product class; these are initialized when CODA can not identify a product.
+ */
 typedef int (module_init_func_t) (void);
 
-static module_init_func_t *module_init_func[] = {
-    harp_ingestion_module_ace_fts_l2_init,
-    harp_ingestion_module_actris_clouds_l2_aerosol_init,
-    harp_ingestion_module_aeolus_l1b_init,
-    harp_ingestion_module_aeolus_l2a_init,
-    harp_ingestion_module_aeolus_l2b_init,
-    harp_ingestion_module_calipso_l2_init,
-    harp_ingestion_module_cci_l2_aerosol_init,
-    harp_ingestion_module_cci_l2_ghg_init,
-    harp_ingestion_module_cci_l2_o3_lp_init,
-    harp_ingestion_module_cci_l2_o3_np_init,
-    harp_ingestion_module_cci_l2_o3_tc_init,
-    harp_ingestion_module_cci_l3_aerosol_init,
-    harp_ingestion_module_cci_l3_cloud_init,
-    harp_ingestion_module_cci_l3_ghg_init,
-    harp_ingestion_module_cci_l3_o3_lntoc_init,
-    harp_ingestion_module_cci_l3_o3_lp_init,
-    harp_ingestion_module_cci_l3_o3_np_init,
-    harp_ingestion_module_cci_l3_o3_tc_init,
-    harp_ingestion_module_cci_l3_o3_ttoc_init,
-    harp_ingestion_module_cci_l4_o3_np_init,
-    harp_ingestion_module_earlinet_l2_aerosol_init,
-    harp_ingestion_module_ecmwf_grib_init,
-    harp_ingestion_module_geoms_ftir_init,
-    harp_ingestion_module_geoms_mwr_init,
-    harp_ingestion_module_geoms_lidar_init,
-    harp_ingestion_module_geoms_pandora_init,
-    harp_ingestion_module_geoms_sonde_init,
-    harp_ingestion_module_geoms_tccon_init,
-    harp_ingestion_module_geoms_uvvis_doas_init,
-    harp_ingestion_module_geoms_uvvis_dobson_init,
-    harp_ingestion_module_gome_l1_init,
-    harp_ingestion_module_gome_l2_init,
-    harp_ingestion_module_gome2_l1_init,
-    harp_ingestion_module_gome2_l2_init,
-    harp_ingestion_module_gomos_l1_init,
-    harp_ingestion_module_gomos_l2_init,
-    harp_ingestion_module_gosat_fts_l1b_init,
-    harp_ingestion_module_gosat_fts_l2_init,
-    harp_ingestion_module_hirdls_l2_init,
-    harp_ingestion_module_iasi_l1_init,
-    harp_ingestion_module_iasi_l2_init,
-    harp_ingestion_module_mipas_l1_init,
-    harp_ingestion_module_mipas_l2_init,
-    harp_ingestion_module_mls_l2_init,
-    harp_ingestion_module_npp_suomi_crimss_l2_init,
-    harp_ingestion_module_npp_suomi_omps_profiles_l2_init,
-    harp_ingestion_module_npp_suomi_omps_totals_l2_init,
-    harp_ingestion_module_npp_suomi_viirs_l2_init,
-    harp_ingestion_module_omi_l2_init,
-    harp_ingestion_module_omi_l3_init,
-    harp_ingestion_module_osiris_l2_init,
-    harp_ingestion_module_qa4ecv_init,
-    harp_ingestion_module_sciamachy_l1_init,
-    harp_ingestion_module_sciamachy_l2_init,
-    harp_ingestion_module_s5p_l1b_init,
-    harp_ingestion_module_s5p_l2_init,
-    harp_ingestion_module_smr_l2_init,
-    harp_ingestion_module_temis_init,
-    harp_ingestion_module_tes_l2_init
+typedef struct module_init_entry_struct
+{
+    const char *product_class;
+    module_init_func_t *init_func;
+} module_init_entry;
+
+static module_init_entry module_init[] = {
+    {"ACE_FTS", harp_ingestion_module_ace_fts_l2_init},
+    {"CLOUDNET", harp_ingestion_module_actris_clouds_l2_aerosol_init},
+    {"AEOLUS", harp_ingestion_module_aeolus_l1b_init},
+    {"AEOLUS", harp_ingestion_module_aeolus_l2a_init},
+    {"AEOLUS", harp_ingestion_module_aeolus_l2b_init},
+    {"CALIPSO", harp_ingestion_module_calipso_l2_init},
+    {"ESACCI_AEROSOL", harp_ingestion_module_cci_l2_aerosol_init},
+    {"ESACCI_GHG", harp_ingestion_module_cci_l2_ghg_init},
+    {"ESACCI_OZONE", harp_ingestion_module_cci_l2_o3_lp_init},
+    {"ESACCI_OZONE", harp_ingestion_module_cci_l2_o3_np_init},
+    {"ESACCI_OZONE", harp_ingestion_module_cci_l2_o3_tc_init},
+    {"ESACCI_AEROSOL", harp_ingestion_module_cci_l3_aerosol_init},
+    {"ESACCI_CLOUD", harp_ingestion_module_cci_l3_cloud_init},
+    {"ESACCI_GHG", harp_ingestion_module_cci_l3_ghg_init},
+    {"ESACCI_OZONE", harp_ingestion_module_cci_l3_o3_lntoc_init},
+    {"ESACCI_OZONE", harp_ingestion_module_cci_l3_o3_lp_init},
+    {"ESACCI_OZONE", harp_ingestion_module_cci_l3_o3_np_init},
+    {"ESACCI_OZONE", harp_ingestion_module_cci_l3_o3_tc_init},
+    {"ESACCI_OZONE", harp_ingestion_module_cci_l3_o3_ttoc_init},
+    {"ESACCI_OZONE", harp_ingestion_module_cci_l4_o3_np_init},
+    {"EARLINET", harp_ingestion_module_earlinet_l2_aerosol_init},
+    {"ECMWF", harp_ingestion_module_ecmwf_grib_init},
+    {"GEOMS", harp_ingestion_module_geoms_ftir_init},
+    {"GEOMS", harp_ingestion_module_geoms_mwr_init},
+    {"GEOMS", harp_ingestion_module_geoms_lidar_init},
+    {"GEOMS", harp_ingestion_module_geoms_pandora_init},
+    {"GEOMS", harp_ingestion_module_geoms_sonde_init},
+    {"GEOMS", harp_ingestion_module_geoms_tccon_init},
+    {"GEOMS", harp_ingestion_module_geoms_uvvis_doas_init},
+    {"GEOMS", harp_ingestion_module_geoms_uvvis_dobson_init},
+    {"ERS_GOME", harp_ingestion_module_gome_l1_init},
+    {"ERS_GOME", harp_ingestion_module_gome_l2_init},
+    {"EPS", harp_ingestion_module_gome2_l1_init},
+    {"ACSAF", harp_ingestion_module_gome2_l2_init},
+    {"ENVISAT_GOMOS", harp_ingestion_module_gomos_l1_init},
+    {"ENVISAT_GOMOS", harp_ingestion_module_gomos_l2_init},
+    {"GOSAT", harp_ingestion_module_gosat_fts_l1b_init},
+    {"GOSAT", harp_ingestion_module_gosat_fts_l2_init},
+    {"AURA_HIRDLS", harp_ingestion_module_hirdls_l2_init},
+    {"EPS", harp_ingestion_module_iasi_l1_init},
+    {"EPS", harp_ingestion_module_iasi_l2_init},
+    {"ENVISAT_MIPAS", harp_ingestion_module_mipas_l1_init},
+    {"ENVISAT_MIPAS", harp_ingestion_module_mipas_l2_init},
+    {"AURA_MLS", harp_ingestion_module_mls_l2_init},
+    {"NPP_SUOMI", harp_ingestion_module_npp_suomi_crimss_l2_init},
+    {"NPP_SUOMI", harp_ingestion_module_npp_suomi_omps_profiles_l2_init},
+    {"NPP_SUOMI", harp_ingestion_module_npp_suomi_omps_totals_l2_init},
+    {"NPP_SUOMI", harp_ingestion_module_npp_suomi_viirs_l2_init},
+    {"AURA_OMI", harp_ingestion_module_omi_l2_init},
+    {"AURA_OMI", harp_ingestion_module_omi_l3_init},
+    {"ODIN_OSIRIS", harp_ingestion_module_osiris_l2_init},
+    {"QA4ECV", harp_ingestion_module_qa4ecv_init},
+    {"ENVISAT_SCIAMACHY", harp_ingestion_module_sciamachy_l1_init},
+    {"ENVISAT_SCIAMACHY", harp_ingestion_module_sciamachy_l2_init},
+    {"Sentinel5P", harp_ingestion_module_s5p_l1b_init},
+    {"Sentinel5P", harp_ingestion_module_s5p_l2_init},
+    {"ODIN_SMR", harp_ingestion_module_smr_l2_init},
+    {"TEMIS", harp_ingestion_module_temis_init},
+    {"AURA_TES", harp_ingestion_module_tes_l2_init}
 };
 
-#define NUM_INGESTION_MODULES ((long)(sizeof(module_init_func)/sizeof(module_init_func[0])))
+#define NUM_INGESTION_MODULES ((long)(sizeof(module_init)/sizeof(module_init[0])))
+
+/* Initialization state of each entry in module_init[]. */
+static int module_initialized[NUM_INGESTION_MODULES];
 
 /* Forward declarations. */
 static void ingestion_option_definition_delete(harp_ingestion_option_definition *ingestion_option_definition);
@@ -396,6 +411,7 @@ static int product_definition_new(const char *name, const char *description,
     product_definition->variable_definition_hash_data = NULL;
     product_definition->read_dimensions = read_dimensions;
     product_definition->read_datetime_range = NULL;
+    product_definition->set_dimension_range_hint = NULL;
     product_definition->ingestion_option = NULL;
     product_definition->mapping_description = NULL;
 
@@ -887,6 +903,16 @@ void harp_ingestion_register_datetime_range_read(harp_product_definition *produc
     product_definition->read_datetime_range = read_datetime_range;
 }
 
+void harp_ingestion_register_dimension_range_hint(harp_product_definition *product_definition,
+                                                  int (*set_dimension_range_hint) (void *user_data,
+                                                                                   harp_dimension_type dimension_type,
+                                                                                   long index_offset,
+                                                                                   long index_length))
+{
+    assert(product_definition->set_dimension_range_hint == NULL);
+    product_definition->set_dimension_range_hint = set_dimension_range_hint;
+}
+
 harp_variable_definition *harp_ingestion_register_variable_full_read
     (harp_product_definition *product_definition, const char *name, harp_data_type data_type, int num_dimensions,
      const harp_dimension_type *dimension_type, const long *dimension, const char *description, const char *unit,
@@ -1223,6 +1249,96 @@ int harp_ingestion_module_validate_options(harp_ingestion_module *module, const
     return 0;
 }
 
+/* Run the initialization function of a single entry of module_init[] */
+static int init_module_entry(long index)
+{
+    int first_module_index;
+    int j;
+
+    /* Make sure that udunits gets initialized as well (so we can use asserts in the module initialization) */
+    if (!harp_unit_is_valid(""))
+    {
+        return -1;
+    }
+
+    first_module_index = module_register->num_ingestion_modules;
+    if (module_init[index].init_func() != 0)
+    {
+        return -1;
+    }
+    module_initialized[index] = 1;
+
+    /* Add the variable index {time} to all product definitions of the new modules of which at least one variable
+     * depends on the time dimension.
+     */
+    for (j = first_module_index; j < module_register->num_ingestion_modules; j++)
+    {
+        harp_ingestion_module *module = module_register->ingestion_module[j];
+        int k;
+
+        for (k = 0; k < module->num_product_definitions; k++)
+        {
+            harp_product_definition *product_definition = module->product_definition[k];
+
+            if (harp_product_definition_has_dimension_type(product_definition, harp_dimension_time))
+            {
+                harp_dimension_type dimension_type[1] = { harp_dimension_time };
+                harp_ingestion_register_variable_block_read(product_definition, "index", harp_type_int32, 1,
+                                                            dimension_type, NULL, "zero-based index of the sample "
+                                                            "within the source product", NULL, NULL, read_index);
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* Run the initialization functions that have not been run yet for the given product class (or for all product classes
+ * if product_class is NULL).
+ */
+static int init_modules(const char *product_class)
+{
+    long i;
+
+    for (i = 0; i < NUM_INGESTION_MODULES; i++)
+    {
+        if (module_initialized[i])
+        {
+            continue;
+        }
+        if (product_class != NULL &&
+            (module_init[i].product_class == NULL || strcmp(module_init[i].product_class, product_class) != 0))
+        {
+            continue;
+        }
+        if (init_module_entry(i) != 0)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* Run the initialization functions that have not been run yet for modules without a CODA product class */
+static int init_custom_modules(void)
+{
+    long i;
+
+    for (i = 0; i < NUM_INGESTION_MODULES; i++)
+    {
+        if (!module_initialized[i] && module_init[i].product_class == NULL)
+        {
+            if (init_module_entry(i) != 0)
+            {
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
 int harp_ingestion_find_module(const char *filename, harp_ingestion_module **module, coda_product **cproduct)
 {
     coda_product *product;
@@ -1266,6 +1382,11 @@ int harp_ingestion_find_module(const char *filename, harp_ingestion_module **mod
         /* Look for a compatible ingestion module by comparing product_class and product_type. */
         if (product_class != NULL && product_type != NULL)
         {
+            if (init_modules(product_class) != 0)
+            {
+                coda_close(product);
+                return -1;
+            }
             for (i = 0; i < module_register->num_ingestion_modules; i++)
             {
                 harp_ingestion_module *ingestion_module;
@@ -1307,7 +1428,14 @@ int harp_ingestion_find_module(const char *filename, harp_ingestion_module **mod
             return -1;
         }
 
-        /* Could not identify product using CODA => try verify_product_type() for custom modules */
+        /* Could not identify product using CODA => try verify_product_type() for custom modules.
+         * Only the modules without a CODA product class need to be initialized for this; if there are no such modules
+         * then the product is not supported.
+         */
+        if (init_custom_modules() != 0)
+        {
+            return -1;
+        }
         for (i = 0; i < module_register->num_ingestion_modules; i++)
         {
             harp_ingestion_module *ingestion_module;
@@ -1333,7 +1461,7 @@ int harp_ingestion_find_module(const char *filename, harp_ingestion_module **mod
 
 int harp_ingestion_init(void)
 {
-    int i;
+    long i;
 
     if (module_register != NULL)
     {
@@ -1356,42 +1484,12 @@ int harp_ingestion_init(void)
     }
     module_register->num_ingestion_modules = 0;
     module_register->ingestion_module = NULL;
-
-    /* Make sure that udunits gets initialized as well (so we can use asserts later on) */
-    if (!harp_unit_is_valid(""))
-    {
-        return -1;
-    }
-
     for (i = 0; i < NUM_INGESTION_MODULES; i++)
     {
-        if (module_init_func[i] () != 0)
-        {
-            return -1;
-        }
+        module_initialized[i] = 0;
     }
 
-    /* Add the variable index {time} to all product definitions of which at least one variable depends on the time
-     * dimension.
-     */
-    for (i = 0; i < module_register->num_ingestion_modules; i++)
-    {
-        harp_ingestion_module *module = module_register->ingestion_module[i];
-        int j;
-
-        for (j = 0; j < module->num_product_definitions; j++)
-        {
-            harp_product_definition *product_definition = module->product_definition[j];
-
-            if (harp_product_definition_has_dimension_type(product_definition, harp_dimension_time))
-            {
-                harp_dimension_type dimension_type[1] = { harp_dimension_time };
-                harp_ingestion_register_variable_block_read(product_definition, "index", harp_type_int32, 1,
-                                                            dimension_type, NULL, "zero-based index of the sample "
-                                                            "within the source product", NULL, NULL, read_index);
-            }
-        }
-    }
+    /* the modules themselves are initialized on first use (see init_modules()) */
 
     return 0;
 }
@@ -1419,7 +1517,18 @@ void harp_ingestion_done(void)
     }
 }
 
+/* Returns the register with all ingestion modules initialized (or NULL on error) */
 harp_ingestion_module_register *harp_ingestion_get_module_register(void)
 {
+    if (module_register == NULL)
+    {
+        harp_set_error(HARP_ERROR_INGESTION, "ingestion module register unavailable (%s:%u)", __FILE__, __LINE__);
+        return NULL;
+    }
+    if (init_modules(NULL) != 0)
+    {
+        return NULL;
+    }
+
     return module_register;
 }
@@ -1301,6 +1301,7 @@ static int execute_point_filter(ingest_info *info, harp_program *program)
     harp_variable *latitude;
     harp_variable *longitude;
     uint8_t *mask;
+    double *vector = NULL;
     int num_operations = 1;
     long num_points;
     long i;
@@ -1400,39 +1401,75 @@ static int execute_point_filter(ingest_info *info, harp_program *program)
 
     mask = info->dimension_mask_set[harp_dimension_time]->mask;
 
-    for (i = 0; i < num_points; i++)
+    for (k = 0; k < num_operations; k++)
     {
-        if (mask[i])
-        {
-            harp_spherical_point point;
+        harp_operation *operation = program->operation[program->current_index + k];
 
-            point.lat = latitude->data.double_data[i];
-            point.lon = longitude->data.double_data[i];
-            harp_spherical_point_rad_from_deg(&point);
-            harp_spherical_point_check(&point);
+        if (operation->type == operation_point_distance_filter)
+        {
+            harp_operation_point_distance_filter *distance_operation;
 
-            for (k = 0; k < num_operations; k++)
+            /* convert all points to unit vectors once and test them in bulk using dot products */
+            if (vector == NULL)
             {
-                if (mask[i])
+                vector = (double *)malloc(3 * num_points * sizeof(double));
+                if (vector == NULL)
                 {
-                    harp_operation_point_filter *operation;
-                    int result;
+                    harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                                   3 * num_points * sizeof(double), __FILE__, __LINE__);
+                    harp_variable_delete(latitude);
+                    harp_variable_delete(longitude);
+                    return -1;
+                }
+                harp_vector3d_array_from_latlon(num_points, latitude->data.double_data, longitude->data.double_data,
+                                                vector, &vector[num_points], &vector[2 * num_points]);
+            }
+            distance_operation = (harp_operation_point_distance_filter *)operation;
+            harp_vector3d_array_within_distance(&distance_operation->vector, distance_operation->angular_distance,
+                                                num_points, vector, &vector[num_points], &vector[2 * num_points],
+                                                mask);
+            continue;
+        }
 
-                    operation = (harp_operation_point_filter *)program->operation[program->current_index + k];
-                    result = operation->eval(operation, &point);
-                    if (result < 0)
+        for (i = 0; i < num_points; i++)
+        {
+            if (mask[i])
+            {
+                harp_operation_point_filter *point_operation = (harp_operation_point_filter *)operation;
+                harp_spherical_point point;
+                int result;
+
+                point.lat = latitude->data.double_data[i];
+                point.lon = longitude->data.double_data[i];
+                harp_spherical_point_rad_from_deg(&point);
+                harp_spherical_point_check(&point);
+
+                result = point_operation->eval(point_operation, &point);
+                if (result < 0)
+                {
+                    harp_variable_delete(latitude);
+                    harp_variable_delete(longitude);
+                    if (vector != NULL)
                     {
-                        harp_variable_delete(latitude);
-                        harp_variable_delete(longitude);
-                        return -1;
+                        free(vector);
                     }
-                    mask[i] = result;
+                    return -1;
                 }
+                mask[i] = result;
             }
-            if (!mask[i])
-            {
-                info->dimension_mask_set[harp_dimension_time]->masked_dimension_length--;
-            }
+        }
+    }
+    if (vector != NULL)
+    {
+        free(vector);
+    }
+
+    info->dimension_mask_set[harp_dimension_time]->masked_dimension_length = 0;
+    for (i = 0; i < num_points; i++)
+    {
+        if (mask[i])
+        {
+            info->dimension_mask_set[harp_dimension_time]->masked_dimension_length++;
         }
     }
 
@@ -1813,10 +1850,99 @@ static int evaluate_ingestion_mask(ingest_info *info, harp_program *program)
     return 0;
 }
 
+/* Pass the range of indices that will be kept for each filtered dimension (except time) to the ingestion module, so
+ * that it can skip reading data that would be masked out anyway (e.g. channels outside a wavelength window).
+ */
+static int set_dimension_range_hints(ingest_info *info)
+{
+    int i;
+
+    if (info->product_definition->set_dimension_range_hint == NULL)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < HARP_NUM_DIM_TYPES; i++)
+    {
+        const harp_dimension_mask *dimension_mask = info->dimension_mask_set[i];
+        long dimension_length;
+        long first, last;
+        long j;
+
+        if (i == harp_dimension_time || dimension_mask == NULL || dimension_mask->masked_dimension_length == 0)
+        {
+            continue;
+        }
+
+        /* for a 2D mask the range covers the selected indices of all samples */
+        dimension_length = dimension_mask->dimension[dimension_mask->num_dimensions - 1];
+        first = dimension_length;
+        last = -1;
+        for (j = 0; j < dimension_mask->num_elements; j++)
+        {
+            if (dimension_mask->mask[j])
+            {
+                long index = j % dimension_length;
+
+                if (index < first)
+                {
+                    first = index;
+                }
+                if (index > last)
+                {
+                    last = index;
+                }
+            }
+        }
+        if (last < first || (first == 0 && last == dimension_length - 1))
+        {
+            continue;
+        }
+
+        if (info->product_definition->set_dimension_range_hint(info->user_data, (harp_dimension_type)i, first,
+                                                               last - first + 1) != 0)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* record the selectivity of the ingestion mask (number of indices that are kept for each masked dimension) */
+static void trace_ingestion_mask(const harp_trace_span *span, const ingest_info *info)
+{
+    char details[512];
+    char *str = details;
+    int i;
+
+    *str = '\0';
+    if (info->product_mask == 0)
+    {
+        strcpy(details, "product excluded");
+    }
+    else
+    {
+        for (i = 0; i < HARP_NUM_DIM_TYPES; i++)
+        {
+            if (info->dimension_mask_set[i] != NULL && info->dimension[i] > 0)
+            {
+                str += sprintf(str, "%s%s kept %ld of %ld (%.1f%%)", str == details ? "" : ", ",
+                               harp_get_dimension_type_name(i), info->dimension_mask_set[i]->masked_dimension_length,
+                               info->dimension[i],
+                               100.0 * info->dimension_mask_set[i]->masked_dimension_length / info->dimension[i]);
+            }
+        }
+    }
+    harp_trace_end(span, "ingestion", "evaluate ingestion mask", NULL, str == details ? NULL : details);
+}
+
 /* Ingest a product while taking into account filter operations at the head of program.
  */
 static int get_product(ingest_info *info, harp_program *program)
 {
+    harp_trace_span span;
+    int num_variables_read = 0;
     int i;
 
     if (harp_product_new(&info->product) != 0)
@@ -1832,6 +1958,10 @@ static int get_product(ingest_info *info, harp_program *program)
         return -1;
     }
 
+    if (harp_option_trace)
+    {
+        harp_trace_begin(&span, NULL);
+    }
     if (init_product_dimensions(info) != 0)
     {
         return -1;
@@ -1840,6 +1970,22 @@ static int get_product(ingest_info *info, harp_program *program)
     {
         return -1;
     }
+    if (harp_option_trace)
+    {
+        char details[256];
+        char *str = details;
+
+        *str = '\0';
+        for (i = 0; i < HARP_NUM_DIM_TYPES; i++)
+        {
+            if (info->dimension[i] > 0)
+            {
+                str += sprintf(str, "%s%s %ld", str == details ? "" : ", ", harp_get_dimension_type_name(i),
+                               info->dimension[i]);
+            }
+        }
+        harp_trace_end(&span, "ingestion", "read dimensions", NULL, str == details ? NULL : details);
+    }
 
     if (product_has_empty_dimensions(info))
     {
@@ -1855,16 +2001,34 @@ static int get_product(ingest_info *info, harp_program *program)
         return 0;
     }
 
+    if (harp_option_trace)
+    {
+        harp_trace_begin(&span, NULL);
+    }
     if (evaluate_ingestion_mask(info, program))
     {
         return -1;
     }
+    if (harp_option_trace)
+    {
+        trace_ingestion_mask(&span, info);
+    }
 
     if (info->product_mask == 0)
     {
         return 0;
     }
 
+    if (set_dimension_range_hints(info) != 0)
+    {
+        return -1;
+    }
+
+    if (harp_option_trace)
+    {
+        harp_trace_begin(&span, info->product);
+    }
+
     /* read all variables, applying dimension masks on the fly */
     for (i = 0; i < info->product_definition->num_variable_definitions; i++)
     {
@@ -1886,6 +2050,15 @@ static int get_product(ingest_info *info, harp_program *program)
             harp_variable_delete(variable);
             return -1;
         }
+        num_variables_read++;
+    }
+
+    if (harp_option_trace)
+    {
+        char details[64];
+
+        sprintf(details, "%d variables read", num_variables_read);
+        harp_trace_end(&span, "ingestion", "read variables", info->product, details);
     }
 
     /* verify ingested product */
@@ -1895,7 +2068,7 @@ static int get_product(ingest_info *info, harp_program *program)
     }
 
     /* perform remaining operations */
-    if (harp_product_execute_program(info->product, program) != 0)
+    if (harp_product_continue_program(info->product, program) != 0)
     {
         return -1;
     }
@@ -1907,7 +2080,12 @@ static int ingest(const char *filename, harp_program *program, const harp_ingest
                   harp_product **product)
 {
     ingest_info *info;
+    harp_trace_span span;
 
+    if (harp_option_trace)
+    {
+        harp_trace_begin(&span, NULL);
+    }
     if (ingestion_init(&info) != 0)
     {
         return -1;
@@ -1945,6 +2123,11 @@ static int ingest(const char *filename, harp_program *program, const harp_ingest
 
     info->basename = harp_basename(filename);
 
+    if (harp_option_trace)
+    {
+        harp_trace_end(&span, "ingestion", "initialize", NULL, info->product_definition->name);
+    }
+
     /* ingest the product */
     if (get_product(info, program) != 0)
     {
@@ -1960,12 +2143,54 @@ static int ingest(const char *filename, harp_program *program, const harp_ingest
     return 0;
 }
 
+/* Ingest a product using an already parsed program and option list.
+ * The program should be positioned at its first operation (see harp_program_reset()).
+ */
+int harp_ingest_with_program(const char *filename, harp_program *program, const harp_ingestion_options *option_list,
+                             harp_product **product)
+{
+    harp_trace_span span;
+    int perform_conversions;
+    int perform_boundary_checks;
+    int status;
+
+    if (harp_ingestion_init() != 0)
+    {
+        return -1;
+    }
+
+    /* all ingestion routines that use CODA are build on the assumption that 'perform conversions' is enabled, so we
+     * explicitly enable it here just in case it was disabled somewhere else */
+    perform_conversions = coda_get_option_perform_conversions();
+    coda_set_option_perform_conversions(1);
+
+    /* we also disable the boundary checks of libcoda for increased ingestion performance */
+    perform_boundary_checks = coda_get_option_perform_boundary_checks();
+    coda_set_option_perform_boundary_checks(0);
+
+    if (harp_option_trace)
+    {
+        harp_trace_begin(&span, NULL);
+    }
+
+    status = ingest(filename, program, option_list, product);
+
+    if (harp_option_trace && status == 0)
+    {
+        harp_trace_end(&span, "ingestion", "ingest", *product, harp_basename(filename));
+    }
+
+    /* set the libcoda options back to their original values */
+    coda_set_option_perform_boundary_checks(perform_boundary_checks);
+    coda_set_option_perform_conversions(perform_conversions);
+
+    return status;
+}
+
 int harp_ingest(const char *filename, const char *operations, const char *options, harp_product **product)
 {
     harp_program *program;
     harp_ingestion_options *option_list;
-    int perform_conversions;
-    int perform_boundary_checks;
     int status;
 
     if (filename == NULL)
@@ -1980,11 +2205,6 @@ int harp_ingest(const char *filename, const char *operations, const char *option
         return -1;
     }
 
-    if (harp_ingestion_init() != 0)
-    {
-        return -1;
-    }
-
     if (operations == NULL)
     {
         if (harp_program_new(&program) != 0)
@@ -2017,20 +2237,7 @@ int harp_ingest(const char *filename, const char *operations, const char *option
         }
     }
 
-    /* all ingestion routines that use CODA are build on the assumption that 'perform conversions' is enabled, so we
-     * explicitly enable it here just in case it was disabled somewhere else */
-    perform_conversions = coda_get_option_perform_conversions();
-    coda_set_option_perform_conversions(1);
-
-    /* we also disable the boundary checks of libcoda for increased ingestion performance */
-    perform_boundary_checks = coda_get_option_perform_boundary_checks();
-    coda_set_option_perform_boundary_checks(0);
-
-    status = ingest(filename, program, option_list, product);
-
-    /* set the libcoda options back to their original values */
-    coda_set_option_perform_boundary_checks(perform_boundary_checks);
-    coda_set_option_perform_conversions(perform_conversions);
+    status = harp_ingest_with_program(filename, program, option_list, product);
 
     harp_ingestion_options_delete(option_list);
     harp_program_delete(program);
@@ -33,6 +33,7 @@
 #define HARP_INGESTION_H
 
 #include "harp-internal.h"
+#include "harp-program.h"
 #include "coda.h"
 
 typedef struct harp_ingestion_option_struct
@@ -100,6 +101,8 @@ typedef struct harp_product_definition_struct
 
     int (*read_dimensions) (void *user_data, long dimension[HARP_NUM_DIM_TYPES]);
     int (*read_datetime_range) (void *user_data, double *datetime_start, double *datetime_stop);
+    int (*set_dimension_range_hint) (void *user_data, harp_dimension_type dimension_type, long index_offset,
+                                     long index_length);
 
     char *ingestion_option;
     char *mapping_description;
@@ -216,6 +219,16 @@ harp_product_definition *harp_ingestion_register_product(harp_ingestion_module *
 void harp_ingestion_register_datetime_range_read(harp_product_definition *product_definition,
                                                  int (*read_datetime_range) (void *user_data, double *datetime_start,
                                                                              double *datetime_stop));
+/* set_dimension_range_hint() is called after all filters that are applied during ingestion have been evaluated and
+ * before the variables are read. It receives, for each dimension (other than time) that is filtered, the range of
+ * indices that contains all indices that will be kept. Read functions are then allowed to leave the elements outside
+ * this range uninitialized.
+ */
+void harp_ingestion_register_dimension_range_hint(harp_product_definition *product_definition,
+                                                  int (*set_dimension_range_hint) (void *user_data,
+                                                                                   harp_dimension_type dimension_type,
+                                                                                   long index_offset,
+                                                                                   long index_length));
 harp_variable_definition *harp_ingestion_register_variable_full_read(harp_product_definition *product_definition,
                                                                      const char *name, harp_data_type data_type,
                                                                      int num_dimensions,
@@ -250,4 +263,8 @@ harp_variable_definition *harp_ingestion_register_variable_block_read(harp_produ
 /* Initialization and clean-up. */
 int harp_ingestion_init(void);
 
+/* Ingestion */
+int harp_ingest_with_program(const char *filename, harp_program *program, const harp_ingestion_options *option_list,
+                             harp_product **product);
+
 #endif
@@ -68,6 +68,33 @@
 extern int harp_option_enable_aux_afgl86;
 extern int harp_option_enable_aux_usstd76;
 
+/* number of threads to use for a parallel region */
+int harp_get_num_threads(void);
+
+/* minimum size (in bytes) of a variable before an operation on that variable is spread over multiple threads */
+#define HARP_PARALLEL_MIN_VARIABLE_SIZE (8 * 1024 * 1024)
+
+/* minimum total size (in bytes) of the variables of a product before they are processed in parallel */
+#define HARP_PARALLEL_MIN_PRODUCT_SIZE (1024 * 1024)
+
+/* store the strings of newly created string variables in a single string arena (see harp_set_option_string_arena()) */
+extern int harp_option_string_arena;
+
+/* tracing of operations and ingestion phases (only call the trace functions if harp_option_trace is set) */
+extern int harp_option_trace;
+
+typedef struct harp_trace_span_struct
+{
+    double start_time;
+    long dimension[HARP_NUM_DIM_TYPES];
+    int64_t storage_size;
+    int num_variables;
+} harp_trace_span;
+
+void harp_trace_begin(harp_trace_span *span, const harp_product *product);
+void harp_trace_end(const harp_trace_span *span, const char *category, const char *name, const harp_product *product,
+                    const char *details);
+
 typedef int (*harp_conversion_function) (harp_variable *variable, const harp_variable **source_variable);
 typedef int (*harp_conversion_enabled_function) (void);
 
@@ -77,6 +104,19 @@ typedef enum harp_collocation_filter_type_enum
     harp_collocation_right
 } harp_collocation_filter_type;
 
+/* storage of the pairs of a collocation result as a set of parallel arrays of length num_pairs
+ * the differences of pair i are stored at difference[i * num_differences + j], for j = 0 .. num_differences - 1
+ */
+typedef struct harp_collocation_pair_data_struct
+{
+    long *collocation_index;
+    long *product_index_a;      /* index into dataset_a */
+    long *sample_index_a;
+    long *product_index_b;      /* index into dataset_b */
+    long *sample_index_b;
+    double *difference;         /* [num_pairs, num_differences] */
+} harp_collocation_pair_data;
+
 /* dimsvar_name is the variable name prefixed with HARP_MAX_NUM_DIMS characters defining the dimension types
  * dimsvar_name is thus the unique name for the combination of variable name + dimension types
  * the character code for a dimension type is: '0' + dimension_type, which gives:
@@ -162,6 +202,8 @@ int harp_variable_get_flag_meanings_string(const harp_variable *variable, char *
 int harp_variable_set_enumeration_values_using_flag_meanings(harp_variable *variable, const char *flag_meanings);
 int harp_variable_add_dimension(harp_variable *variable, int dim_index, harp_dimension_type dimension_type,
                                 long length);
+int harp_variable_check_appendable(const harp_variable *variable, const harp_variable *other_variable);
+int harp_variable_append_move(harp_variable *variable, harp_variable *other_variable);
 int harp_variable_rearrange_dimension(harp_variable *variable, int dim_index, long num_dim_elements,
                                       const long *dim_element_ids);
 int harp_variable_filter_dimension(harp_variable *variable, int dim_index, const uint8_t *mask);
@@ -172,6 +214,8 @@ int harp_variable_squash_dimension(harp_variable *variable, int dim_index);
 /* Products */
 int harp_product_rearrange_dimension(harp_product *product, harp_dimension_type dimension_type, long num_dim_elements,
                                      const long *dim_element_ids);
+int harp_product_resize_dimension(harp_product *product, harp_dimension_type dimension_type, long length);
+int harp_product_append_move(harp_product *product, harp_product *other_product);
 int harp_product_filter_by_index(harp_product *product, const char *index_variable, long num_elements, int32_t *index);
 int harp_product_filter_dimension(harp_product *product, harp_dimension_type dimension_type, const uint8_t *mask);
 int harp_product_remove_dimension(harp_product *product, harp_dimension_type dimension_type);
@@ -205,6 +249,18 @@ int harp_export_hdf5(const char *filename, const harp_product *product);
 #endif
 int harp_export_netcdf(const char *filename, const harp_product *product);
 
+/* Incremental export (appending along the time dimension) */
+#ifdef HAVE_HDF5
+typedef struct harp_hdf5_writer_struct harp_hdf5_writer;
+int harp_hdf5_writer_new(const char *filename, const harp_product *product, harp_hdf5_writer **new_writer);
+int harp_hdf5_writer_append(harp_hdf5_writer *writer, const harp_product *product);
+int harp_hdf5_writer_close(harp_hdf5_writer *writer, const double *datetime_range);
+#endif
+typedef struct harp_netcdf_writer_struct harp_netcdf_writer;
+int harp_netcdf_writer_new(const char *filename, const harp_product *product, harp_netcdf_writer **new_writer);
+int harp_netcdf_writer_append(harp_netcdf_writer *writer, const harp_product *product);
+int harp_netcdf_writer_close(harp_netcdf_writer *writer, const double *datetime_range);
+
 #ifdef HAVE_HDF4
 int harp_import_global_attributes_hdf4(const char *filename, double *datetime_start, double *datetime_stop,
                                        long dimension[], char **source_product);
@@ -224,6 +280,10 @@ int harp_ingest_global_attributes(const char *filename, const char *options, dou
                                   double *datetime_stop, long dimension[], char **source_product);
 void harp_ingestion_done(void);
 
+/* Collocated product cache */
+void harp_collocated_product_cache_trim(void);
+void harp_collocated_product_cache_done(void);
+
 /* Units */
 typedef struct harp_unit_converter_struct harp_unit_converter;
 int harp_unit_converter_new(const char *from_unit, const char *to_unit, harp_unit_converter **new_unit_converter);
@@ -250,6 +310,8 @@ void harp_variable_conversion_delete(harp_variable_conversion *conversion);
 int harp_derived_variable_list_init(void);
 int harp_derived_variable_list_add_conversion(harp_variable_conversion *conversion);
 void harp_derived_variable_list_done(void);
+int harp_derived_variable_may_use_source(const char *variable_name, int num_dimensions,
+                                         const harp_dimension_type *dimension_type, const char *source_variable_name);
 
 /* Analysis functions */
 double harp_fraction_of_day_from_datetime(double datetime);
@@ -49,6 +49,9 @@ typedef enum netcdf_dimension_type_enum
     netcdf_dimension_string
 } netcdf_dimension_type;
 
+/* number of bytes of free space to keep in the header of files that are written incrementally */
+#define NETCDF_WRITER_HEADER_FREE_SPACE 512
+
 typedef struct netcdf_dimensions_struct
 {
     int num_dimensions;
@@ -530,18 +533,38 @@ static int read_variable(harp_product *product, int ncid, int varid, netcdf_dime
             return -1;
         }
 
-        for (i = 0; i < variable->num_elements; i++)
+        if (harp_option_string_arena)
         {
-            char *str;
-
-            str = malloc((length + 1) * sizeof(char));
-            if (str == NULL)
+            /* store all strings in a single string arena */
+            variable->string_arena = malloc(variable->num_elements * (length + 1) * sizeof(char));
+            if (variable->string_arena == NULL)
             {
                 harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
-                               (length + 1) * sizeof(char), __FILE__, __LINE__);
+                               variable->num_elements * (length + 1) * sizeof(char), __FILE__, __LINE__);
                 free(buffer);
                 return -1;
             }
+        }
+
+        for (i = 0; i < variable->num_elements; i++)
+        {
+            char *str;
+
+            if (variable->string_arena != NULL)
+            {
+                str = &variable->string_arena[i * (length + 1)];
+            }
+            else
+            {
+                str = malloc((length + 1) * sizeof(char));
+                if (str == NULL)
+                {
+                    harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                                   (length + 1) * sizeof(char), __FILE__, __LINE__);
+                    free(buffer);
+                    return -1;
+                }
+            }
 
             memcpy(str, &buffer[i * length], length);
             str[length] = '\0';
@@ -1036,7 +1059,7 @@ int harp_import_global_attributes_netcdf(const char *filename, double *datetime_
     return 0;
 }
 
-static int write_dimensions(int ncid, const netcdf_dimensions *dimensions)
+static int write_dimensions(int ncid, const netcdf_dimensions *dimensions, int unlimited_time)
 {
     int result;
     int i;
@@ -1059,6 +1082,11 @@ static int write_dimensions(int ncid, const netcdf_dimensions *dimensions)
             sprintf(name, "string_%ld", dimensions->length[i]);
             result = nc_def_dim(ncid, name, dimensions->length[i], &dim_id);
         }
+        else if (dimensions->type[i] == netcdf_dimension_time && unlimited_time)
+        {
+            /* the time dimension is the record dimension, so records can be appended after the file is defined */
+            result = nc_def_dim(ncid, get_dimension_type_name(dimensions->type[i]), NC_UNLIMITED, &dim_id);
+        }
         else
         {
             result = nc_def_dim(ncid, get_dimension_type_name(dimensions->type[i]), dimensions->length[i], &dim_id);
@@ -1241,38 +1269,78 @@ static int write_variable_definition(int ncid, const harp_variable *variable, ne
     return 0;
 }
 
-static int write_variable(int ncid, int varid, const harp_variable *variable)
+/* Write the data of a variable. If time_offset > 0 the data is written starting at the given record of the (unlimited)
+ * time dimension.
+ */
+static int write_variable(int ncid, int varid, const harp_variable *variable, long time_offset)
 {
+    size_t start[NC_MAX_VAR_DIMS];
+    size_t count[NC_MAX_VAR_DIMS];
     int result = NC_NOERR;
+    int i;
+
+    for (i = 0; i < variable->num_dimensions; i++)
+    {
+        start[i] = 0;
+        count[i] = (size_t)variable->dimension[i];
+    }
+    if (time_offset > 0)
+    {
+        assert(variable->num_dimensions > 0 && variable->dimension_type[0] == harp_dimension_time);
+        start[0] = (size_t)time_offset;
+    }
 
     switch (variable->data_type)
     {
         case harp_type_int8:
-            result = nc_put_var_schar(ncid, varid, variable->data.ptr);
+            result = nc_put_vara_schar(ncid, varid, start, count, variable->data.ptr);
             break;
         case harp_type_int16:
-            result = nc_put_var_short(ncid, varid, variable->data.ptr);
+            result = nc_put_vara_short(ncid, varid, start, count, variable->data.ptr);
             break;
         case harp_type_int32:
-            result = nc_put_var_int(ncid, varid, variable->data.ptr);
+            result = nc_put_vara_int(ncid, varid, start, count, variable->data.ptr);
             break;
         case harp_type_float:
-            result = nc_put_var_float(ncid, varid, variable->data.ptr);
+            result = nc_put_vara_float(ncid, varid, start, count, variable->data.ptr);
             break;
         case harp_type_double:
-            result = nc_put_var_double(ncid, varid, variable->data.ptr);
+            result = nc_put_vara_double(ncid, varid, start, count, variable->data.ptr);
             break;
         case harp_type_string:
             {
+                int dim_id[NC_MAX_VAR_DIMS];
+                size_t string_length;
+                long length;
                 char *buffer;
 
-                if (harp_get_char_array_from_string_array(variable->num_elements, variable->data.string_data, 1, NULL,
-                                                          &buffer) != 0)
+                /* use the length of the string dimension as it was defined in the file */
+                result = nc_inq_vardimid(ncid, varid, dim_id);
+                if (result == NC_NOERR)
+                {
+                    result = nc_inq_dimlen(ncid, dim_id[variable->num_dimensions], &string_length);
+                }
+                if (result != NC_NOERR)
+                {
+                    break;
+                }
+
+                if (harp_get_char_array_from_string_array(variable->num_elements, variable->data.string_data,
+                                                          (long)string_length, &length, &buffer) != 0)
+                {
+                    return -1;
+                }
+                if (length > (long)string_length)
                 {
+                    harp_set_error(HARP_ERROR_EXPORT, "string length (%ld) of variable '%s' exceeds string length of "
+                                   "variable in file (%ld)", length, variable->name, (long)string_length);
+                    free(buffer);
                     return -1;
                 }
 
-                result = nc_put_var_text(ncid, varid, buffer);
+                start[variable->num_dimensions] = 0;
+                count[variable->num_dimensions] = string_length;
+                result = nc_put_vara_text(ncid, varid, start, count, buffer);
                 free(buffer);
             }
             break;
@@ -1287,7 +1355,7 @@ static int write_variable(int ncid, int varid, const harp_variable *variable)
     return 0;
 }
 
-static int write_product(int ncid, const harp_product *product, netcdf_dimensions *dimensions)
+static int write_product(int ncid, const harp_product *product, netcdf_dimensions *dimensions, int unlimited_time)
 {
     harp_scalar datetime_start;
     harp_scalar datetime_stop;
@@ -1367,7 +1435,7 @@ static int write_product(int ncid, const harp_product *product, netcdf_dimension
     }
 
     /* write dimensions */
-    if (write_dimensions(ncid, dimensions) != 0)
+    if (write_dimensions(ncid, dimensions, unlimited_time) != 0)
     {
         return -1;
     }
@@ -1384,7 +1452,15 @@ static int write_product(int ncid, const harp_product *product, netcdf_dimension
         assert(varid == i);
     }
 
-    result = nc_enddef(ncid);
+    if (unlimited_time)
+    {
+        /* reserve header space such that the datetime range attributes can be updated without moving the data */
+        result = nc__enddef(ncid, NETCDF_WRITER_HEADER_FREE_SPACE, 4, 0, 4);
+    }
+    else
+    {
+        result = nc_enddef(ncid);
+    }
     if (result != NC_NOERR)
     {
         harp_set_error(HARP_ERROR_NETCDF, "%s", nc_strerror(result));
@@ -1394,7 +1470,7 @@ static int write_product(int ncid, const harp_product *product, netcdf_dimension
     /* write variable data */
     for (i = 0; i < product->num_variables; i++)
     {
-        if (write_variable(ncid, i, product->variable[i]) != 0)
+        if (write_variable(ncid, i, product->variable[i], 0) != 0)
         {
             return -1;
         }
@@ -1442,7 +1518,7 @@ int harp_export_netcdf(const char *filename, const harp_product *product)
 
     dimensions_init(&dimensions);
 
-    if (write_product(ncid, product, &dimensions) != 0)
+    if (write_product(ncid, product, &dimensions, 0) != 0)
     {
         harp_add_error_message(" (%s)", filename);
         nc_close(ncid);
@@ -1462,3 +1538,164 @@ int harp_export_netcdf(const char *filename, const harp_product *product)
 
     return 0;
 }
+
+struct harp_netcdf_writer_struct
+{
+    char *filename;
+    int ncid;
+    long num_time_elements;
+};
+
+static void netcdf_writer_delete(harp_netcdf_writer *writer)
+{
+    if (writer->filename != NULL)
+    {
+        free(writer->filename);
+    }
+    free(writer);
+}
+
+/* Create a new netCDF file with an unlimited time dimension and write \a product as the first block of data.
+ * All variables of \a product should have the time dimension as first dimension.
+ */
+int harp_netcdf_writer_new(const char *filename, const harp_product *product, harp_netcdf_writer **new_writer)
+{
+    harp_netcdf_writer *writer;
+    netcdf_dimensions dimensions;
+    int result;
+
+    writer = (harp_netcdf_writer *)malloc(sizeof(harp_netcdf_writer));
+    if (writer == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       sizeof(harp_netcdf_writer), __FILE__, __LINE__);
+        return -1;
+    }
+    writer->ncid = -1;
+    writer->num_time_elements = 0;
+    writer->filename = strdup(filename);
+    if (writer->filename == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not duplicate string) (%s:%u)", __FILE__,
+                       __LINE__);
+        netcdf_writer_delete(writer);
+        return -1;
+    }
+
+    /* the final size is not known in advance, so always use 64-bit offsets */
+    result = nc_create(filename, NC_64BIT_OFFSET, &writer->ncid);
+    if (result != NC_NOERR)
+    {
+        harp_set_error(HARP_ERROR_NETCDF, "%s", nc_strerror(result));
+        harp_add_error_message(" (%s)", filename);
+        netcdf_writer_delete(writer);
+        return -1;
+    }
+
+    dimensions_init(&dimensions);
+    if (write_product(writer->ncid, product, &dimensions, 1) != 0)
+    {
+        harp_add_error_message(" (%s)", filename);
+        dimensions_done(&dimensions);
+        nc_close(writer->ncid);
+        netcdf_writer_delete(writer);
+        return -1;
+    }
+    dimensions_done(&dimensions);
+
+    writer->num_time_elements = product->dimension[harp_dimension_time];
+
+    *new_writer = writer;
+    return 0;
+}
+
+/* Append the data of \a product to the file along the time dimension.
+ * The product should have the same variables (with the same dimensions, except for the length of the time dimension)
+ * as the product that was used to create the writer.
+ */
+int harp_netcdf_writer_append(harp_netcdf_writer *writer, const harp_product *product)
+{
+    int i;
+
+    for (i = 0; i < product->num_variables; i++)
+    {
+        const harp_variable *variable = product->variable[i];
+        int result;
+        int varid;
+
+        result = nc_inq_varid(writer->ncid, variable->name, &varid);
+        if (result != NC_NOERR)
+        {
+            harp_set_error(HARP_ERROR_NETCDF, "%s", nc_strerror(result));
+            harp_add_error_message(" (variable '%s') (%s)", variable->name, writer->filename);
+            return -1;
+        }
+        if (write_variable(writer->ncid, varid, variable, writer->num_time_elements) != 0)
+        {
+            harp_add_error_message(" (%s)", writer->filename);
+            return -1;
+        }
+    }
+
+    writer->num_time_elements += product->dimension[harp_dimension_time];
+
+    return 0;
+}
+
+/* Finalize and close the file. The datetime_start/datetime_stop attributes are updated if \a datetime_range is not
+ * NULL (it should then contain the start and stop value, in days since 2000-01-01, of the full appended range).
+ * The writer is always deleted, also when an error occurs.
+ */
+int harp_netcdf_writer_close(harp_netcdf_writer *writer, const double *datetime_range)
+{
+    int result;
+
+    if (datetime_range != NULL)
+    {
+        harp_scalar datetime_start;
+        harp_scalar datetime_stop;
+
+        datetime_start.double_data = datetime_range[0];
+        datetime_stop.double_data = datetime_range[1];
+
+        result = nc_redef(writer->ncid);
+        if (result != NC_NOERR)
+        {
+            harp_set_error(HARP_ERROR_NETCDF, "%s", nc_strerror(result));
+            harp_add_error_message(" (%s)", writer->filename);
+            nc_close(writer->ncid);
+            netcdf_writer_delete(writer);
+            return -1;
+        }
+        if (write_numeric_attribute(writer->ncid, NC_GLOBAL, "datetime_start", harp_type_double, datetime_start) != 0 ||
+            write_numeric_attribute(writer->ncid, NC_GLOBAL, "datetime_stop", harp_type_double, datetime_stop) != 0)
+        {
+            harp_add_error_message(" (%s)", writer->filename);
+            nc_close(writer->ncid);
+            netcdf_writer_delete(writer);
+            return -1;
+        }
+        result = nc_enddef(writer->ncid);
+        if (result != NC_NOERR)
+        {
+            harp_set_error(HARP_ERROR_NETCDF, "%s", nc_strerror(result));
+            harp_add_error_message(" (%s)", writer->filename);
+            nc_close(writer->ncid);
+            netcdf_writer_delete(writer);
+            return -1;
+        }
+    }
+
+    result = nc_close(writer->ncid);
+    if (result != NC_NOERR)
+    {
+        harp_set_error(HARP_ERROR_NETCDF, "%s", nc_strerror(result));
+        harp_add_error_message(" (%s)", writer->filename);
+        netcdf_writer_delete(writer);
+        return -1;
+    }
+
+    netcdf_writer_delete(writer);
+
+    return 0;
+}
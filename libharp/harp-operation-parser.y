@@ -1663,6 +1663,7 @@ int harp_program_from_string(const char *str, harp_program **program)
         return -1;
     }
     harp_operation_parser__delete_buffer(bufstate);
+    harp_program_optimize(parsed_program);
     *program = parsed_program;
 
     return 0;
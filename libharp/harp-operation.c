@@ -404,8 +404,14 @@ static int eval_index_membership(harp_operation_index_membership_filter *operati
 
 static int eval_point_distance(harp_operation_point_distance_filter *operation, harp_spherical_point *point)
 {
-    return (harp_spherical_point_distance(&operation->point, point) * CONST_EARTH_RADIUS_WGS84_SPHERE <=
-            operation->distance);
+    harp_vector3d vector;
+    uint8_t mask = 1;
+
+    harp_vector3d_from_spherical_point(&vector, point);
+    harp_vector3d_array_within_distance(&operation->vector, operation->angular_distance, 1, &vector.x, &vector.y,
+                                        &vector.z, &mask);
+
+    return mask;
 }
 
 static int eval_point_in_area(harp_operation_point_in_area_filter *operation, harp_spherical_point *point)
@@ -634,6 +640,10 @@ static void bin_collocated_delete(harp_operation_bin_collocated *operation)
         {
             free(operation->collocation_result);
         }
+        if (operation->cached_collocation_result != NULL)
+        {
+            harp_collocation_result_delete(operation->cached_collocation_result);
+        }
 
         free(operation);
     }
@@ -728,6 +738,10 @@ static void collocation_filter_delete(harp_operation_collocation_filter *operati
         {
             harp_collocation_mask_delete(operation->collocation_mask);
         }
+        if (operation->cached_collocation_result != NULL)
+        {
+            harp_collocation_result_delete(operation->cached_collocation_result);
+        }
         if (operation->value != NULL)
         {
             free(operation->value);
@@ -804,6 +818,10 @@ static void derive_smoothed_column_collocated_dataset_delete
         {
             free(operation->dataset_dir);
         }
+        if (operation->cached_collocation_result != NULL)
+        {
+            harp_collocation_result_delete(operation->cached_collocation_result);
+        }
 
         free(operation);
     }
@@ -1014,6 +1032,10 @@ static void regrid_collocated_dataset_delete(harp_operation_regrid_collocated_da
         {
             free(operation->dataset_dir);
         }
+        if (operation->cached_collocation_result != NULL)
+        {
+            harp_collocation_result_delete(operation->cached_collocation_result);
+        }
 
         free(operation);
     }
@@ -1107,6 +1129,10 @@ static void smooth_collocated_dataset_delete(harp_operation_smooth_collocated_da
         {
             free(operation->dataset_dir);
         }
+        if (operation->cached_collocation_result != NULL)
+        {
+            harp_collocation_result_delete(operation->cached_collocation_result);
+        }
 
         free(operation);
     }
@@ -1671,6 +1697,7 @@ int harp_operation_bin_collocated_new(const char *collocation_result, const char
     operation->type = operation_bin_collocated;
     operation->collocation_result = NULL;
     operation->target_dataset = target_dataset;
+    operation->cached_collocation_result = NULL;
 
     operation->collocation_result = strdup(collocation_result);
     if (operation->collocation_result == NULL)
@@ -1895,6 +1922,7 @@ int harp_operation_collocation_filter_new(const char *filename, harp_collocation
     operation->min_collocation_index = min_collocation_index;
     operation->max_collocation_index = max_collocation_index;
     operation->collocation_mask = NULL;
+    operation->cached_collocation_result = NULL;
     operation->num_values = 0;
     operation->value = NULL;
 
@@ -2062,6 +2090,7 @@ int harp_operation_derive_smoothed_column_collocated_dataset_new(const char *var
     operation->collocation_result = NULL;
     operation->target_dataset = target_dataset;
     operation->dataset_dir = NULL;
+    operation->cached_collocation_result = NULL;
 
     operation->variable_name = strdup(variable_name);
     if (operation->variable_name == NULL)
@@ -2545,6 +2574,8 @@ int harp_operation_point_distance_filter_new(double latitude, const char *latitu
 
     harp_spherical_point_rad_from_deg(&operation->point);
     harp_spherical_point_check(&operation->point);
+    harp_vector3d_from_spherical_point(&operation->vector, &operation->point);
+    operation->angular_distance = operation->distance / CONST_EARTH_RADIUS_WGS84_SPHERE;
 
     *new_operation = (harp_operation *)operation;
     return 0;
@@ -2748,6 +2779,7 @@ int harp_operation_regrid_collocated_dataset_new(harp_dimension_type dimension_t
     operation->collocation_result = NULL;
     operation->target_dataset = target_dataset;
     operation->dataset_dir = NULL;
+    operation->cached_collocation_result = NULL;
 
     operation->axis_variable_name = strdup(axis_variable_name);
     if (operation->axis_variable_name == NULL)
@@ -2946,6 +2978,7 @@ int harp_operation_smooth_collocated_dataset_new(int num_variables, const char *
     operation->collocation_result = NULL;
     operation->target_dataset = target_dataset;
     operation->dataset_dir = NULL;
+    operation->cached_collocation_result = NULL;
 
     operation->axis_variable_name = strdup(axis_variable_name);
     if (operation->axis_variable_name == NULL)
@@ -3491,10 +3524,20 @@ int harp_operation_prepare_collocation_filter(harp_operation *operation, const c
     collocation_operation->num_values = 0;
     collocation_operation->value = NULL;
 
-    if (harp_collocation_mask_import(collocation_operation->filename, collocation_operation->filter_type,
-                                     collocation_operation->min_collocation_index,
-                                     collocation_operation->max_collocation_index,
-                                     source_product, &collocation_mask) != 0)
+    if (collocation_operation->cached_collocation_result != NULL)
+    {
+        /* compiled programs have already read the collocation result */
+        if (harp_collocation_mask_from_result(collocation_operation->cached_collocation_result,
+                                              collocation_operation->filter_type, source_product,
+                                              &collocation_mask) != 0)
+        {
+            return -1;
+        }
+    }
+    else if (harp_collocation_mask_import(collocation_operation->filename, collocation_operation->filter_type,
+                                          collocation_operation->min_collocation_index,
+                                          collocation_operation->max_collocation_index,
+                                          source_product, &collocation_mask) != 0)
     {
         return -1;
     }
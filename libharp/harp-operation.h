@@ -230,6 +230,8 @@ typedef struct harp_operation_bin_collocated_struct
     /* parameters */
     char *collocation_result;
     char target_dataset;
+    /* extra (only set for compiled programs) */
+    harp_collocation_result *cached_collocation_result;
 } harp_operation_bin_collocated;
 
 typedef struct harp_operation_bin_spatial_struct
@@ -281,6 +283,8 @@ typedef struct harp_operation_collocation_filter_struct
     long max_collocation_index;
     /* extra */
     harp_collocation_mask *collocation_mask;
+    /* extra (only set for compiled programs) */
+    harp_collocation_result *cached_collocation_result;
     /* extra (for membership filter that is only used for the ingestion phase) */
     int num_values;
     int32_t *value;
@@ -325,6 +329,8 @@ typedef struct harp_operation_derive_smoothed_column_collocated_dataset_struct
     char *collocation_result;
     char target_dataset;
     char *dataset_dir;
+    /* extra (only set for compiled programs) */
+    harp_collocation_result *cached_collocation_result;
 } harp_operation_derive_smoothed_column_collocated_dataset;
 
 typedef struct harp_operation_derive_smoothed_column_collocated_product_struct
@@ -416,6 +422,9 @@ typedef struct harp_operation_point_distance_filter_struct
     /* parameters */
     harp_spherical_point point;
     double distance;
+    /* extra */
+    harp_vector3d vector;       /* unit vector of point */
+    double angular_distance;    /* distance [rad] on the unit sphere */
 } harp_operation_point_distance_filter;
 
 typedef struct harp_operation_point_in_area_filter_struct
@@ -446,6 +455,8 @@ typedef struct harp_operation_regrid_collocated_dataset_struct
     char *collocation_result;
     char target_dataset;
     char *dataset_dir;
+    /* extra (only set for compiled programs) */
+    harp_collocation_result *cached_collocation_result;
 } harp_operation_regrid_collocated_dataset;
 
 typedef struct harp_operation_regrid_collocated_product_struct
@@ -486,6 +497,8 @@ typedef struct harp_operation_smooth_collocated_dataset_struct
     char *collocation_result;
     char target_dataset;
     char *dataset_dir;
+    /* extra (only set for compiled programs) */
+    harp_collocation_result *cached_collocation_result;
 } harp_operation_smooth_collocated_dataset;
 
 typedef struct harp_operation_smooth_collocated_product_struct
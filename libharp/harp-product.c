@@ -124,90 +124,442 @@ static int get_arguments(int argc, char *argv[], char **new_arguments)
     return 0;
 }
 
-#define MAX_NUM_COMPARISON_VARIABLES 8
-static int num_comparison_variables;
-static harp_variable *comparison_variable[MAX_NUM_COMPARISON_VARIABLES];
+/* Hash index on the names of the variables of a product. The index keeps its own copy of the name of each variable (in
+ * the same order as the variables of the product), such that the index stays safe to use if a variable that is part of
+ * a product is renamed directly (instead of via harp_product_detach_variable() and harp_product_add_variable()).
+ */
+struct harp_variable_name_index_struct
+{
+    hashtable *name_to_index;
+    char **name;
+};
+
+static void variable_name_index_delete(struct harp_variable_name_index_struct *index, int num_names)
+{
+    if (index != NULL)
+    {
+        if (index->name != NULL)
+        {
+            int i;
+
+            for (i = 0; i < num_names; i++)
+            {
+                free(index->name[i]);
+            }
+            free(index->name);
+        }
+        hashtable_delete(index->name_to_index);
+        free(index);
+    }
+}
+
+/* Add the name of the variable that will be appended to the product to the index of the product. */
+static int variable_name_index_add(harp_product *product, const char *name)
+{
+    struct harp_variable_name_index_struct *index = product->variable_name_index;
+    char *name_copy;
+
+    if (index == NULL)
+    {
+        index = malloc(sizeof(struct harp_variable_name_index_struct));
+        if (index == NULL)
+        {
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                           sizeof(struct harp_variable_name_index_struct), __FILE__, __LINE__);
+            return -1;
+        }
+        index->name = NULL;
+        index->name_to_index = hashtable_new(1);
+        if (index->name_to_index == NULL)
+        {
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not create hashtable) (%s:%u)", __FILE__,
+                           __LINE__);
+            free(index);
+            return -1;
+        }
+        assert(product->num_variables == 0);
+        product->variable_name_index = index;
+    }
+
+    if (product->num_variables % BLOCK_SIZE == 0)
+    {
+        char **name_array;
+
+        name_array = realloc(index->name, (product->num_variables + BLOCK_SIZE) * sizeof(char *));
+        if (name_array == NULL)
+        {
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                           (product->num_variables + BLOCK_SIZE) * sizeof(char *), __FILE__, __LINE__);
+            return -1;
+        }
+        index->name = name_array;
+    }
 
-static int compare_variable_elements(const void *a, const void *b)
+    name_copy = strdup(name);
+    if (name_copy == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not duplicate string) (%s:%u)", __FILE__,
+                       __LINE__);
+        return -1;
+    }
+    if (hashtable_add_name(index->name_to_index, name_copy) != 0)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "variable '%s' exists (%s:%u)", name, __FILE__, __LINE__);
+        free(name_copy);
+        return -1;
+    }
+    index->name[product->num_variables] = name_copy;
+
+    return 0;
+}
+
+/* Remove the name of the variable at position variable_index from the index of the product. Since the hash table does
+ * not support removal of names, the hash table is recreated from the remaining names.
+ */
+static int variable_name_index_remove(harp_product *product, int variable_index)
 {
-    long index_a = *(long *)a;
-    long index_b = *(long *)b;
+    struct harp_variable_name_index_struct *index = product->variable_name_index;
+    hashtable *name_to_index;
     int i;
 
-    assert(num_comparison_variables <= MAX_NUM_COMPARISON_VARIABLES);
-    for (i = 0; i < num_comparison_variables; i++)
+    if (index == NULL)
+    {
+        return 0;
+    }
+
+    name_to_index = hashtable_new(1);
+    if (name_to_index == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not create hashtable) (%s:%u)", __FILE__,
+                       __LINE__);
+        return -1;
+    }
+    for (i = 0; i < product->num_variables; i++)
     {
-        switch (comparison_variable[i]->data_type)
+        if (i != variable_index)
         {
-            case harp_type_int8:
-                if (comparison_variable[i]->data.int8_data[index_a] < comparison_variable[i]->data.int8_data[index_b])
-                {
-                    return -1;
-                }
-                else if (comparison_variable[i]->data.int8_data[index_a] >
-                         comparison_variable[i]->data.int8_data[index_b])
-                {
-                    return 1;
-                }
-                break;
-            case harp_type_int16:
-                if (comparison_variable[i]->data.int16_data[index_a] < comparison_variable[i]->data.int16_data[index_b])
-                {
-                    return -1;
-                }
-                else if (comparison_variable[i]->data.int16_data[index_a] >
-                         comparison_variable[i]->data.int16_data[index_b])
-                {
-                    return 1;
-                }
-                break;
-            case harp_type_int32:
-                if (comparison_variable[i]->data.int32_data[index_a] < comparison_variable[i]->data.int32_data[index_b])
-                {
-                    return -1;
-                }
-                else if (comparison_variable[i]->data.int32_data[index_a] >
-                         comparison_variable[i]->data.int32_data[index_b])
-                {
-                    return 1;
-                }
-                break;
-            case harp_type_float:
-                if (comparison_variable[i]->data.float_data[index_a] < comparison_variable[i]->data.float_data[index_b])
+            hashtable_add_name(name_to_index, index->name[i]);
+        }
+    }
+    hashtable_delete(index->name_to_index);
+    index->name_to_index = name_to_index;
+
+    free(index->name[variable_index]);
+    for (i = variable_index + 1; i < product->num_variables; i++)
+    {
+        index->name[i - 1] = index->name[i];
+    }
+
+    return 0;
+}
+
+/* Returns the index of the variable with the given name, or -1 if the product has no such variable. */
+static int find_variable_index(const harp_product *product, const char *name)
+{
+    int i;
+
+    if (product->variable_name_index != NULL)
+    {
+        long index;
+
+        index = hashtable_get_index_from_name(product->variable_name_index->name_to_index, name);
+        if (index < 0)
+        {
+            return -1;
+        }
+        if (index < product->num_variables && strcmp(product->variable[index]->name, name) == 0)
+        {
+            return (int)index;
+        }
+    }
+
+    /* the index is out of date (a variable was renamed directly), so search the variables themselves */
+    for (i = 0; i < product->num_variables; i++)
+    {
+        if (strcmp(product->variable[i]->name, name) == 0)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/* Sorting uses a stable least-significant-digit radix sort on unsigned 64-bit keys, 11 bits per pass (the histograms
+ * of 2048 entries still fit in the L1/L2 cache).
+ */
+#define SORT_RADIX_BITS 11
+#define SORT_RADIX_SIZE (1 << SORT_RADIX_BITS)
+#define SORT_NUM_PASSES ((64 + SORT_RADIX_BITS - 1) / SORT_RADIX_BITS)
+
+typedef struct string_rank_struct
+{
+    const char *str;
+    long index;
+} string_rank;
+
+static int compare_string_rank(const void *a, const void *b)
+{
+    const char *str_a = ((const string_rank *)a)->str;
+    const char *str_b = ((const string_rank *)b)->str;
+
+    /* NULL strings end up before all other strings */
+    if (str_a == NULL)
+    {
+        return str_b == NULL ? 0 : -1;
+    }
+    if (str_b == NULL)
+    {
+        return 1;
+    }
+    return strcmp(str_a, str_b);
+}
+
+/* Map an integer to a key such that the order of the keys equals the order of the values. */
+static uint64_t integer_sort_key(int32_t value)
+{
+    return ((uint64_t)(int64_t)value) ^ ((uint64_t)1 << 63);
+}
+
+/* Map a floating point value to a key such that the order of the keys equals the order of the values.
+ * -0 and +0 get the same key, and NaN values get the largest key (i.e. they end up last).
+ */
+static uint64_t floating_point_sort_key(double value)
+{
+    uint64_t bits;
+
+    if (harp_isnan(value))
+    {
+        return ~(uint64_t)0;
+    }
+    if (value == 0)
+    {
+        value = 0;
+    }
+    memcpy(&bits, &value, sizeof(bits));
+    if (bits & ((uint64_t)1 << 63))
+    {
+        return ~bits;
+    }
+    return bits | ((uint64_t)1 << 63);
+}
+
+/* Determine the sort key for element index[i] of the variable for each i.
+ * For strings the key is the rank of the string among all strings of the variable; rank_buffer is used to store these
+ * ranks and should have room for variable->num_elements keys.
+ */
+static int get_sort_keys(const harp_variable *variable, long num_elements, const long *index, uint64_t *key,
+                         uint64_t *rank_buffer)
+{
+    long i;
+
+    switch (variable->data_type)
+    {
+        case harp_type_int8:
+            for (i = 0; i < num_elements; i++)
+            {
+                key[i] = integer_sort_key(variable->data.int8_data[index[i]]);
+            }
+            break;
+        case harp_type_int16:
+            for (i = 0; i < num_elements; i++)
+            {
+                key[i] = integer_sort_key(variable->data.int16_data[index[i]]);
+            }
+            break;
+        case harp_type_int32:
+            for (i = 0; i < num_elements; i++)
+            {
+                key[i] = integer_sort_key(variable->data.int32_data[index[i]]);
+            }
+            break;
+        case harp_type_float:
+            for (i = 0; i < num_elements; i++)
+            {
+                key[i] = floating_point_sort_key(variable->data.float_data[index[i]]);
+            }
+            break;
+        case harp_type_double:
+            for (i = 0; i < num_elements; i++)
+            {
+                key[i] = floating_point_sort_key(variable->data.double_data[index[i]]);
+            }
+            break;
+        case harp_type_string:
+            {
+                string_rank *string;
+                uint64_t rank = 0;
+
+                string = malloc(num_elements * sizeof(string_rank));
+                if (string == NULL)
                 {
+                    harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                                   num_elements * sizeof(string_rank), __FILE__, __LINE__);
                     return -1;
                 }
-                else if (comparison_variable[i]->data.float_data[index_a] >
-                         comparison_variable[i]->data.float_data[index_b])
+                for (i = 0; i < num_elements; i++)
                 {
-                    return 1;
+                    string[i].str = variable->data.string_data[i];
+                    string[i].index = i;
                 }
-                break;
-            case harp_type_double:
-                if (comparison_variable[i]->data.double_data[index_a] <
-                    comparison_variable[i]->data.double_data[index_b])
+                qsort(string, num_elements, sizeof(string_rank), compare_string_rank);
+                for (i = 0; i < num_elements; i++)
                 {
-                    return -1;
+                    if (i > 0 && compare_string_rank(&string[i - 1], &string[i]) != 0)
+                    {
+                        rank++;
+                    }
+                    rank_buffer[string[i].index] = rank;
                 }
-                else if (comparison_variable[i]->data.double_data[index_a] >
-                         comparison_variable[i]->data.double_data[index_b])
+                free(string);
+                for (i = 0; i < num_elements; i++)
                 {
-                    return 1;
+                    key[i] = rank_buffer[index[i]];
                 }
-                break;
-            case harp_type_string:
-                {
-                    int result;
+            }
+            break;
+    }
 
-                    result = strcmp(comparison_variable[i]->data.string_data[index_a],
-                                    comparison_variable[i]->data.string_data[index_b]);
-                    if (result != 0)
-                    {
-                        return result;
-                    }
-                }
+    return 0;
+}
+
+/* Stably sort the (key, index) pairs on key. The tmp_key and tmp_index buffers are used as scratch space. */
+static void radix_sort(long num_elements, uint64_t *key, long *index, uint64_t *tmp_key, long *tmp_index)
+{
+    long count[SORT_NUM_PASSES][SORT_RADIX_SIZE];
+    uint64_t *source_key = key;
+    long *source_index = index;
+    int pass;
+    long i;
+
+    /* nothing needs to be done if the keys are already in order */
+    for (i = 1; i < num_elements; i++)
+    {
+        if (key[i] < key[i - 1])
+        {
+            break;
         }
     }
+    if (i >= num_elements)
+    {
+        return;
+    }
+
+    /* determine the histograms for all passes at once */
+    memset(count, 0, sizeof(count));
+    for (i = 0; i < num_elements; i++)
+    {
+        uint64_t value = key[i];
+
+        for (pass = 0; pass < SORT_NUM_PASSES; pass++)
+        {
+            count[pass][value & (SORT_RADIX_SIZE - 1)]++;
+            value >>= SORT_RADIX_BITS;
+        }
+    }
+
+    for (pass = 0; pass < SORT_NUM_PASSES; pass++)
+    {
+        int shift = pass * SORT_RADIX_BITS;
+        long offset = 0;
+        uint64_t *swap_key;
+        long *swap_index;
+        int digit;
+
+        /* skip passes in which all keys have the same digit */
+        if (count[pass][(source_key[0] >> shift) & (SORT_RADIX_SIZE - 1)] == num_elements)
+        {
+            continue;
+        }
+
+        for (digit = 0; digit < SORT_RADIX_SIZE; digit++)
+        {
+            long digit_count = count[pass][digit];
+
+            count[pass][digit] = offset;
+            offset += digit_count;
+        }
+        for (i = 0; i < num_elements; i++)
+        {
+            long target = count[pass][(source_key[i] >> shift) & (SORT_RADIX_SIZE - 1)]++;
+
+            tmp_key[target] = source_key[i];
+            tmp_index[target] = source_index[i];
+        }
+
+        swap_key = source_key;
+        source_key = tmp_key;
+        tmp_key = swap_key;
+        swap_index = source_index;
+        source_index = tmp_index;
+        tmp_index = swap_index;
+    }
+
+    if (source_index != index)
+    {
+        memcpy(key, source_key, num_elements * sizeof(uint64_t));
+        memcpy(index, source_index, num_elements * sizeof(long));
+    }
+}
+
+/* Determine the permutation that sorts the elements of the given variables. The first variable is the primary sort key,
+ * the second variable the secondary sort key, etc. Elements with equal keys keep their original order.
+ */
+static int get_sort_order(int num_variables, harp_variable **variable, long num_elements, long *index)
+{
+    uint64_t *key;
+    uint64_t *tmp_key;
+    long *tmp_index;
+    long i;
+    int k;
+
+    for (i = 0; i < num_elements; i++)
+    {
+        index[i] = i;
+    }
+
+    key = malloc(num_elements * sizeof(uint64_t));
+    if (key == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       num_elements * sizeof(uint64_t), __FILE__, __LINE__);
+        return -1;
+    }
+    tmp_key = malloc(num_elements * sizeof(uint64_t));
+    if (tmp_key == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       num_elements * sizeof(uint64_t), __FILE__, __LINE__);
+        free(key);
+        return -1;
+    }
+    tmp_index = malloc(num_elements * sizeof(long));
+    if (tmp_index == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       num_elements * sizeof(long), __FILE__, __LINE__);
+        free(tmp_key);
+        free(key);
+        return -1;
+    }
+
+    /* since the sort is stable, sorting on the least significant key first results in a lexicographic order */
+    for (k = num_variables - 1; k >= 0; k--)
+    {
+        if (get_sort_keys(variable[k], num_elements, index, key, tmp_key) != 0)
+        {
+            free(tmp_index);
+            free(tmp_key);
+            free(key);
+            return -1;
+        }
+        radix_sort(num_elements, key, index, tmp_key, tmp_index);
+    }
+
+    free(tmp_index);
+    free(tmp_key);
+    free(key);
+
     return 0;
 }
 
@@ -342,9 +694,40 @@ int harp_product_make_time_dependent(harp_product *product)
     return 0;
 }
 
+/* Rearrange all dimensions of the given type of a variable. */
+static int rearrange_variable_dimension(harp_variable *variable, harp_dimension_type dimension_type,
+                                        long num_dim_elements, const long *dim_element_ids)
+{
+    int j;
+
+    for (j = 0; j < variable->num_dimensions; j++)
+    {
+        if (variable->dimension_type[j] != dimension_type)
+        {
+            continue;
+        }
+
+        if (harp_variable_rearrange_dimension(variable, j, num_dim_elements, dim_element_ids) != 0)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* Returns whether a variable is large enough to be rearranged by multiple threads (instead of by a single thread). */
+static int is_large_variable(const harp_variable *variable)
+{
+    return variable->num_elements * harp_get_size_for_type(variable->data_type) >= HARP_PARALLEL_MIN_VARIABLE_SIZE;
+}
+
 int harp_product_rearrange_dimension(harp_product *product, harp_dimension_type dimension_type, long num_dim_elements,
                                      const long *dim_element_ids)
 {
+    long small_variables_size = 0;
+    uint8_t *large_variable;
+    int result = 0;
     int i;
 
     if (dimension_type == harp_dimension_independent)
@@ -374,24 +757,66 @@ int harp_product_rearrange_dimension(harp_product *product, harp_dimension_type
         return 0;
     }
 
-    for (i = 0; i < product->num_variables; i++)
+    if (product->num_variables == 0)
     {
-        harp_variable *variable = product->variable[i];
-        int j;
+        product->dimension[dimension_type] = num_dim_elements;
+        return 0;
+    }
 
-        for (j = 0; j < variable->num_dimensions; j++)
+    /* Classify the variables before rearranging any of them, since rearranging can change the size of a variable (a
+     * dimension element can be selected more than once).
+     */
+    large_variable = malloc(product->num_variables * sizeof(uint8_t));
+    if (large_variable == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       product->num_variables * sizeof(uint8_t), __FILE__, __LINE__);
+        return -1;
+    }
+    for (i = 0; i < product->num_variables; i++)
+    {
+        large_variable[i] = (uint8_t)is_large_variable(product->variable[i]);
+        if (!large_variable[i])
         {
-            if (variable->dimension_type[j] != dimension_type)
-            {
-                continue;
-            }
+            small_variables_size += product->variable[i]->num_elements *
+                harp_get_size_for_type(product->variable[i]->data_type);
+        }
+    }
 
-            if (harp_variable_rearrange_dimension(variable, j, num_dim_elements, dim_element_ids) != 0)
+    /* The variables are independent, so small variables are rearranged in parallel (each by a single thread). Large
+     * variables are rearranged one after the other, each using multiple threads.
+     */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(harp_get_num_threads()) \
+    if (small_variables_size >= HARP_PARALLEL_MIN_PRODUCT_SIZE)
+#endif
+    for (i = 0; i < product->num_variables; i++)
+    {
+        if (!large_variable[i])
+        {
+            if (rearrange_variable_dimension(product->variable[i], dimension_type, num_dim_elements,
+                                             dim_element_ids) != 0)
             {
-                return -1;
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                result = -1;
             }
         }
     }
+    for (i = 0; i < product->num_variables && result == 0; i++)
+    {
+        if (large_variable[i])
+        {
+            result = rearrange_variable_dimension(product->variable[i], dimension_type, num_dim_elements,
+                                                  dim_element_ids);
+        }
+    }
+    free(large_variable);
+    if (result != 0)
+    {
+        return -1;
+    }
 
     product->dimension[dimension_type] = num_dim_elements;
 
@@ -607,10 +1032,12 @@ void harp_product_remove_all_variables(harp_product *product)
 
         free(product->variable);
     }
+    variable_name_index_delete(product->variable_name_index, product->num_variables);
 
     memset(product->dimension, 0, HARP_NUM_DIM_TYPES * sizeof(long));
     product->num_variables = 0;
     product->variable = NULL;
+    product->variable_name_index = NULL;
 }
 
 /**
@@ -812,6 +1239,7 @@ LIBHARP_API int harp_product_new(harp_product **new_product)
     product->variable = NULL;
     product->source_product = NULL;
     product->history = NULL;
+    product->variable_name_index = NULL;
 
     *new_product = product;
     return 0;
@@ -836,6 +1264,7 @@ LIBHARP_API void harp_product_delete(harp_product *product)
 
             free(product->variable);
         }
+        variable_name_index_delete(product->variable_name_index, product->num_variables);
 
         if (product->source_product != NULL)
         {
@@ -1055,25 +1484,7 @@ static int add_missing_count_and_weight_variables(harp_product *product, harp_pr
     return 0;
 }
 
-/** \addtogroup harp_product
- * @{
- */
-
-/** Append one product to another.
- * The 'index' variable, if present, will be removed.
- * All variables in both products will have a 'time' dimension introduced as first dimension.
- * Both products will have all non-time dimensions extended to the maximum of either product.
- * Any 'source_product' attribute for the first product will be removed.
- *
- * If you pass NULL for 'other_product', then 'product' will be updated as if it was the result of a merge
- * (i.e. remove 'index', add 'time' dimension, and remove 'source_product' attribute).
- * \param product Product to which data should be appended.
- * \param other_product (optional) Product that should be appended.
- * \return
- *   \arg \c 0, Success.
- *   \arg \c -1, Error occurred (check #harp_errno).
- */
-LIBHARP_API int harp_product_append(harp_product *product, harp_product *other_product)
+static int append_product(harp_product *product, harp_product *other_product, int move_strings)
 {
     harp_variable *variable;
     harp_variable *other_variable;
@@ -1179,7 +1590,14 @@ LIBHARP_API int harp_product_append(harp_product *product, harp_product *other_p
             assert(0);
             exit(1);
         }
-        if (harp_variable_append(variable, other_variable) != 0)
+        if (move_strings)
+        {
+            if (harp_variable_append_move(variable, other_variable) != 0)
+            {
+                return -1;
+            }
+        }
+        else if (harp_variable_append(variable, other_variable) != 0)
         {
             return -1;
         }
@@ -1189,6 +1607,38 @@ LIBHARP_API int harp_product_append(harp_product *product, harp_product *other_p
     return 0;
 }
 
+/* Append one product to another and take over the string data of the other product.
+ * This is the same as harp_product_append(), except that string elements of other_product are moved instead of
+ * duplicated. It should only be used if other_product is deleted afterwards.
+ */
+int harp_product_append_move(harp_product *product, harp_product *other_product)
+{
+    return append_product(product, other_product, 1);
+}
+
+/** \addtogroup harp_product
+ * @{
+ */
+
+/** Append one product to another.
+ * The 'index' variable, if present, will be removed.
+ * All variables in both products will have a 'time' dimension introduced as first dimension.
+ * Both products will have all non-time dimensions extended to the maximum of either product.
+ * Any 'source_product' attribute for the first product will be removed.
+ *
+ * If you pass NULL for 'other_product', then 'product' will be updated as if it was the result of a merge
+ * (i.e. remove 'index', add 'time' dimension, and remove 'source_product' attribute).
+ * \param product Product to which data should be appended.
+ * \param other_product (optional) Product that should be appended.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_product_append(harp_product *product, harp_product *other_product)
+{
+    return append_product(product, other_product, 0);
+}
+
 /** Set the source product attribute of the specified product.
  * Stores the base name of \a product_path as the value of the source product attribute of the specified product.
  * The previous value (if any) will be freed.
@@ -1317,6 +1767,10 @@ LIBHARP_API int harp_product_add_variable(harp_product *product, harp_variable *
 
         product->variable = variable;
     }
+    if (variable_name_index_add(product, variable->name) != 0)
+    {
+        return -1;
+    }
     product->variable[product->num_variables] = variable;
     product->num_variables++;
 
@@ -1350,6 +1804,11 @@ LIBHARP_API int harp_product_detach_variable(harp_product *product, const harp_v
     {
         if (product->variable[i] == variable)
         {
+            if (variable_name_index_remove(product, i) != 0)
+            {
+                return -1;
+            }
+
             /* Update product dimensions. */
             sync_product_dimensions_on_variable_remove(product, variable);
 
@@ -1492,22 +1951,12 @@ LIBHARP_API int harp_product_replace_variable(harp_product *product, harp_variab
  */
 LIBHARP_API int harp_product_has_variable(const harp_product *product, const char *name)
 {
-    int i;
-
     if (name == NULL)
     {
         return 0;
     }
 
-    for (i = 0; i < product->num_variables; i++)
-    {
-        if (strcmp(product->variable[i]->name, name) == 0)
-        {
-            return 1;
-        }
-    }
-
-    return 0;
+    return find_variable_index(product, name) >= 0;
 }
 
 /** Find variable with a given name for a product.
@@ -1536,17 +1985,15 @@ LIBHARP_API int harp_product_get_variable_by_name(const harp_product *product, c
         return -1;
     }
 
-    for (i = 0; i < product->num_variables; i++)
+    i = find_variable_index(product, name);
+    if (i < 0)
     {
-        if (strcmp(product->variable[i]->name, name) == 0)
-        {
-            *variable = product->variable[i];
-            return 0;
-        }
+        harp_set_error(HARP_ERROR_VARIABLE_NOT_FOUND, "variable '%s' does not exist", name);
+        return -1;
     }
+    *variable = product->variable[i];
 
-    harp_set_error(HARP_ERROR_VARIABLE_NOT_FOUND, "variable '%s' does not exist", name);
-    return -1;
+    return 0;
 }
 
 /** Find index of variable with a given name for a product.
@@ -1574,17 +2021,15 @@ LIBHARP_API int harp_product_get_variable_index_by_name(const harp_product *prod
         return -1;
     }
 
-    for (i = 0; i < product->num_variables; i++)
+    i = find_variable_index(product, name);
+    if (i < 0)
     {
-        if (strcmp(product->variable[i]->name, name) == 0)
-        {
-            *index = i;
-            return 0;
-        }
+        harp_set_error(HARP_ERROR_VARIABLE_NOT_FOUND, "variable '%s' does not exist", name);
+        return -1;
     }
+    *index = i;
 
-    harp_set_error(HARP_ERROR_VARIABLE_NOT_FOUND, "variable '%s' does not exist", name);
-    return -1;
+    return 0;
 }
 
 /** Determine whether all variables in a product have at least one element.
@@ -2063,10 +2508,12 @@ LIBHARP_API int harp_product_flatten_dimension(harp_product *product, harp_dimen
  * variables, all using the same dimension. The dimension that will be reordered is this single dimension of the
  * referenced variables.
  *
- * Only up to eight variables can be used for sorting.
+ * The first variable is the primary sort key, the second variable is used to order elements for which the first
+ * variable has equal values, etc. The sort is stable: elements for which all variables have equal values keep their
+ * relative order. NaN values are sorted after all other values.
  *
  * \param product HARP product
- * \param num_variables Number of variables to use for sorting (1 <= num_variables <= 8)
+ * \param num_variables Number of variables to use for sorting (>= 1)
  * \param variable_name Names of the variables to use for sorting
  * \return
  *   \arg \c 0, Success.
@@ -2074,43 +2521,55 @@ LIBHARP_API int harp_product_flatten_dimension(harp_product *product, harp_dimen
  */
 LIBHARP_API int harp_product_sort(harp_product *product, int num_variables, const char **variable_name)
 {
-    long num_elements;
+    harp_variable **sort_variable;
+    long num_elements = 0;
     long *dim_element_ids;
     long i;
 
-    if (num_variables < 1 || num_comparison_variables > MAX_NUM_COMPARISON_VARIABLES)
+    if (num_variables < 1)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "invalid number of variables for sorting (%d) (%s:%u)",
+                       num_variables, __FILE__, __LINE__);
+        return -1;
+    }
+
+    sort_variable = malloc(num_variables * sizeof(harp_variable *));
+    if (sort_variable == NULL)
     {
-        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "invalid number of variables for sorting (%d not in range [1,%d])",
-                       num_variables, MAX_NUM_COMPARISON_VARIABLES);
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       num_variables * sizeof(harp_variable *), __FILE__, __LINE__);
         return -1;
     }
 
-    num_comparison_variables = num_variables;
     for (i = 0; i < num_variables; i++)
     {
-        if (harp_product_get_variable_by_name(product, variable_name[i], &comparison_variable[i]) != 0)
+        if (harp_product_get_variable_by_name(product, variable_name[i], &sort_variable[i]) != 0)
         {
+            free(sort_variable);
             return -1;
         }
-        if (comparison_variable[i]->num_dimensions != 1)
+        if (sort_variable[i]->num_dimensions != 1)
         {
             harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "variable for sorting should be a one dimensional array");
+            free(sort_variable);
             return -1;
         }
-        if (comparison_variable[i]->dimension_type[0] == harp_dimension_independent)
+        if (sort_variable[i]->dimension_type[0] == harp_dimension_independent)
         {
             harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "cannot sort independent dimension");
+            free(sort_variable);
             return -1;
         }
         if (i == 0)
         {
-            num_elements = comparison_variable[i]->num_elements;
+            num_elements = sort_variable[i]->num_elements;
         }
         else
         {
-            if (comparison_variable[i]->dimension_type[0] != comparison_variable[0]->dimension_type[0])
+            if (sort_variable[i]->dimension_type[0] != sort_variable[0]->dimension_type[0])
             {
                 harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "sort variables do not all have the same dimension");
+                free(sort_variable);
                 return -1;
             }
         }
@@ -2121,23 +2580,27 @@ LIBHARP_API int harp_product_sort(harp_product *product, int num_variables, cons
     {
         harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
                        num_elements * sizeof(long), __FILE__, __LINE__);
+        free(sort_variable);
         return -1;
     }
-    for (i = 0; i < num_elements; i++)
+
+    if (get_sort_order(num_variables, sort_variable, num_elements, dim_element_ids) != 0)
     {
-        dim_element_ids[i] = i;
+        free(dim_element_ids);
+        free(sort_variable);
+        return -1;
     }
 
-    qsort(dim_element_ids, num_elements, sizeof(long), compare_variable_elements);
-
-    if (harp_product_rearrange_dimension(product, comparison_variable[0]->dimension_type[0], num_elements,
+    if (harp_product_rearrange_dimension(product, sort_variable[0]->dimension_type[0], num_elements,
                                          dim_element_ids) != 0)
     {
         free(dim_element_ids);
+        free(sort_variable);
         return -1;
     }
 
     free(dim_element_ids);
+    free(sort_variable);
 
     return 0;
 }
@@ -37,6 +37,7 @@
 #include "harp-vertical-profiles.h"
 
 #include <assert.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -59,6 +60,7 @@ int harp_program_new(harp_program **new_program)
     program->option_enable_aux_afgl86 = harp_get_option_enable_aux_afgl86();
     program->option_enable_aux_usstd76 = harp_get_option_enable_aux_usstd76();
     program->option_regrid_out_of_bounds = harp_get_option_regrid_out_of_bounds();
+    program->restore_options = 1;
 
     /* we only explicitly set the regrid_out_of_bounds option */
     harp_set_option_regrid_out_of_bounds(0);
@@ -67,14 +69,21 @@ int harp_program_new(harp_program **new_program)
     return 0;
 }
 
-void harp_program_delete(harp_program *program)
+/** Remove a program and all its operations.
+ * \ingroup harp_product
+ * \param program Pointer to the program to remove.
+ */
+LIBHARP_API void harp_program_delete(harp_program *program)
 {
     if (program != NULL)
     {
-        /* reset global HARP options to initial values */
-        harp_set_option_enable_aux_afgl86(program->option_enable_aux_afgl86);
-        harp_set_option_enable_aux_usstd76(program->option_enable_aux_usstd76);
-        harp_set_option_regrid_out_of_bounds(program->option_regrid_out_of_bounds);
+        if (program->restore_options)
+        {
+            /* reset global HARP options to initial values */
+            harp_set_option_enable_aux_afgl86(program->option_enable_aux_afgl86);
+            harp_set_option_enable_aux_usstd76(program->option_enable_aux_usstd76);
+            harp_set_option_regrid_out_of_bounds(program->option_regrid_out_of_bounds);
+        }
 
         if (program->operation != NULL)
         {
@@ -92,6 +101,39 @@ void harp_program_delete(harp_program *program)
     }
 }
 
+/* Prepare a program for another execution.
+ * This resets the execution state and restores the global HARP options to the values they had when the program was
+ * created, such that a single parsed program can be executed on multiple products.
+ */
+void harp_program_reset(harp_program *program)
+{
+    program->current_index = 0;
+
+    harp_set_option_enable_aux_afgl86(program->option_enable_aux_afgl86);
+    harp_set_option_enable_aux_usstd76(program->option_enable_aux_usstd76);
+    harp_set_option_regrid_out_of_bounds(0);
+}
+
+/* Start an execution of a compiled program.
+ * The current global HARP options are stored in the program such that 'set' operations of the program only have an
+ * effect during this execution. The options are restored again by harp_program_end_execution().
+ */
+void harp_program_begin_execution(harp_program *program)
+{
+    program->option_enable_aux_afgl86 = harp_get_option_enable_aux_afgl86();
+    program->option_enable_aux_usstd76 = harp_get_option_enable_aux_usstd76();
+    program->option_regrid_out_of_bounds = harp_get_option_regrid_out_of_bounds();
+
+    harp_program_reset(program);
+}
+
+void harp_program_end_execution(harp_program *program)
+{
+    harp_set_option_enable_aux_afgl86(program->option_enable_aux_afgl86);
+    harp_set_option_enable_aux_usstd76(program->option_enable_aux_usstd76);
+    harp_set_option_regrid_out_of_bounds(program->option_regrid_out_of_bounds);
+}
+
 int harp_program_add_operation(harp_program *program, harp_operation *operation)
 {
     if (program->num_operations % BLOCK_SIZE == 0)
@@ -116,85 +158,416 @@ int harp_program_add_operation(harp_program *program, harp_operation *operation)
     return 0;
 }
 
-static int execute_value_filter(harp_product *product, harp_program *program)
+/* Determine whether a derive() operation leaves the dimensions of a product unchanged and only computes values that
+ * depend on the corresponding elements of the time dimension. Filtering the time dimension before such an operation
+ * gives the same result as filtering it afterwards.
+ */
+static int derive_is_elementwise_in_time(const harp_operation_derive_variable *operation)
 {
-    harp_dimension_mask_set *dimension_mask_set = NULL;
-    harp_variable *variable;
+    if (!operation->has_dimensions)
+    {
+        /* only a unit and/or data type conversion of an existing variable */
+        return 1;
+    }
+    if (operation->num_dimensions != 1 || operation->dimension_type[0] != harp_dimension_time)
+    {
+        return 0;
+    }
+
+    /* the value of 'index' depends on the position of a sample in the time dimension */
+    return strcmp(operation->variable_name, "index") != 0;
+}
+
+/* Determine whether executing a point or polygon filter before the given operation gives the same result as executing
+ * it after. These filters always filter the time dimension using the (derived) latitude/longitude (bounds) variables.
+ */
+static int location_filter_commutes_with(const harp_operation *operation)
+{
+    switch (operation->type)
+    {
+        case operation_derive_variable:
+            {
+                const harp_operation_derive_variable *derive_operation;
+
+                derive_operation = (const harp_operation_derive_variable *)operation;
+                if (strcmp(derive_operation->variable_name, "latitude") == 0 ||
+                    strcmp(derive_operation->variable_name, "longitude") == 0 ||
+                    strcmp(derive_operation->variable_name, "latitude_bounds") == 0 ||
+                    strcmp(derive_operation->variable_name, "longitude_bounds") == 0)
+                {
+                    return 0;
+                }
+                return derive_is_elementwise_in_time(derive_operation);
+            }
+        case operation_set:
+            return 1;
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+/* Determine whether the operations in front of position end_index guarantee that the given variable only depends on
+ * the time dimension. This is the case if the variable is derived with a {time} dimension and none of the operations
+ * after that derivation can change the dimensions of the variable.
+ */
+static int variable_is_time_only_before(const harp_program *program, int end_index, const char *variable_name)
+{
+    int i, k;
+
+    for (k = end_index - 1; k >= 0; k--)
+    {
+        const harp_operation *operation = program->operation[k];
+
+        switch (operation->type)
+        {
+            case operation_derive_variable:
+                {
+                    const harp_operation_derive_variable *derive_operation;
+
+                    derive_operation = (const harp_operation_derive_variable *)operation;
+                    if (derive_operation->has_dimensions && strcmp(derive_operation->variable_name, variable_name) == 0)
+                    {
+                        return derive_operation->num_dimensions == 1 &&
+                            derive_operation->dimension_type[0] == harp_dimension_time;
+                    }
+                    /* other derivations and unit/type conversions do not change the dimensions of the variable */
+                }
+                break;
+            case operation_keep_variable:
+                {
+                    const harp_operation_keep_variable *keep_operation;
+
+                    keep_operation = (const harp_operation_keep_variable *)operation;
+                    for (i = 0; i < keep_operation->num_variables; i++)
+                    {
+                        if (strcmp(keep_operation->variable_name[i], variable_name) == 0)
+                        {
+                            break;
+                        }
+                    }
+                    if (i == keep_operation->num_variables)
+                    {
+                        return 0;
+                    }
+                }
+                break;
+            case operation_exclude_variable:
+                {
+                    const harp_operation_exclude_variable *exclude_operation;
+
+                    exclude_operation = (const harp_operation_exclude_variable *)operation;
+                    for (i = 0; i < exclude_operation->num_variables; i++)
+                    {
+                        if (strcmp(exclude_operation->variable_name[i], variable_name) == 0)
+                        {
+                            return 0;
+                        }
+                    }
+                }
+                break;
+            case operation_rename:
+                {
+                    const harp_operation_rename *rename_operation = (const harp_operation_rename *)operation;
+
+                    if (strcmp(rename_operation->variable_name, variable_name) == 0 ||
+                        strcmp(rename_operation->new_variable_name, variable_name) == 0)
+                    {
+                        return 0;
+                    }
+                }
+                break;
+            case operation_set:
+                break;
+            default:
+                /* filters only remove elements of a dimension */
+                if (!harp_operation_is_value_filter(operation) && !harp_operation_is_point_filter(operation) &&
+                    !harp_operation_is_polygon_filter(operation))
+                {
+                    return 0;
+                }
+                break;
+        }
+    }
+
+    return 0;
+}
+
+/* Determine whether executing a value filter before the operation at position index gives the same result as executing
+ * it after. Only the operations in front of position index are used to determine the dimensions of the filter variable.
+ */
+static int value_filter_commutes_with(const harp_operation *filter, const harp_program *program, int index)
+{
+    const harp_operation *operation = program->operation[index];
     const char *variable_name;
-    int num_operations = 1;
-    int data_type_size;
-    long i, j;
-    int k;
+    int i;
+
+    if (harp_operation_get_variable_name(filter, &variable_name) != 0)
+    {
+        return 0;
+    }
+
+    switch (operation->type)
+    {
+        case operation_derive_variable:
+            {
+                const harp_operation_derive_variable *derive_operation;
+
+                /* the filter variable should not be (re)computed by the derivation */
+                derive_operation = (const harp_operation_derive_variable *)operation;
+                if (strcmp(derive_operation->variable_name, variable_name) == 0)
+                {
+                    return 0;
+                }
+                if (!derive_operation->has_dimensions)
+                {
+                    /* a unit and/or data type conversion of another variable is performed per element */
+                    return 1;
+                }
+                /* the filter should only remove samples of the time dimension (i.e. the filter variable should only
+                 * depend on the time dimension) and the filter variable should not be an input of the derivation
+                 */
+                if (!derive_is_elementwise_in_time(derive_operation) ||
+                    !variable_is_time_only_before(program, index, variable_name))
+                {
+                    return 0;
+                }
+                return !harp_derived_variable_may_use_source(derive_operation->variable_name,
+                                                             derive_operation->num_dimensions,
+                                                             derive_operation->dimension_type, variable_name);
+            }
+        case operation_keep_variable:
+            {
+                const harp_operation_keep_variable *keep_operation = (const harp_operation_keep_variable *)operation;
+
+                /* the filter variable needs to remain available */
+                for (i = 0; i < keep_operation->num_variables; i++)
+                {
+                    if (strcmp(keep_operation->variable_name[i], variable_name) == 0)
+                    {
+                        return 1;
+                    }
+                }
+            }
+            return 0;
+        case operation_exclude_variable:
+            {
+                const harp_operation_exclude_variable *exclude_operation;
+
+                exclude_operation = (const harp_operation_exclude_variable *)operation;
+                for (i = 0; i < exclude_operation->num_variables; i++)
+                {
+                    if (strcmp(exclude_operation->variable_name[i], variable_name) == 0)
+                    {
+                        return 0;
+                    }
+                }
+            }
+            return 1;
+        case operation_rename:
+            {
+                const harp_operation_rename *rename_operation = (const harp_operation_rename *)operation;
+
+                if (strcmp(rename_operation->variable_name, variable_name) == 0 ||
+                    strcmp(rename_operation->new_variable_name, variable_name) == 0)
+                {
+                    return 0;
+                }
+            }
+            return 1;
+        case operation_set:
+            /* none of the options influence the result of a value filter */
+            return 1;
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+/* Optimize the execution order of the operations in a program.
+ * Value filters are moved in front of directly preceding keep(), exclude(), rename(), set(), and derive() operations
+ * that do not affect the filtered variable. Point and polygon filters are moved in front of directly preceding set()
+ * and derive() operations that do not affect the location variables. A derive() is only passed if it does not add or
+ * change a dimension (i.e. it is either a unit/type conversion or a derivation of a variable with only the time
+ * dimension). A value filter is only moved in front of the derivation of a {time} variable if the filter variable is
+ * known to only depend on the time dimension (it was derived as such earlier in the program) and if the filter
+ * variable can not be an input of the derivation. This brings filters closer to the start of the program, where they can be performed as part of the
+ * ingestion, and places them directly after other filters, such that consecutive filters on the same dimension can
+ * be evaluated together. The relative order of the filters themselves is never changed.
+ */
+void harp_program_optimize(harp_program *program)
+{
+    int i;
 
-    if (harp_operation_get_variable_name(program->operation[program->current_index], &variable_name) != 0)
+    for (i = 1; i < program->num_operations; i++)
+    {
+        harp_operation *operation = program->operation[i];
+        int j = i;
+
+        if (harp_operation_is_value_filter(operation))
+        {
+            while (j > 0 && value_filter_commutes_with(operation, program, j - 1))
+            {
+                program->operation[j] = program->operation[j - 1];
+                j--;
+            }
+        }
+        else if (harp_operation_is_point_filter(operation) || harp_operation_is_polygon_filter(operation))
+        {
+            while (j > 0 && location_filter_commutes_with(program->operation[j - 1]))
+            {
+                program->operation[j] = program->operation[j - 1];
+                j--;
+            }
+        }
+        program->operation[j] = operation;
+    }
+}
+
+/* Determine the number of consecutive value filter operations, starting at start_index, that are on the same variable */
+static int get_value_filter_group(harp_program *program, int start_index, const char **variable_name,
+                                  int *num_operations)
+{
+    int count = 1;
+
+    if (harp_operation_get_variable_name(program->operation[start_index], variable_name) != 0)
     {
         return -1;
     }
 
     /* if the next operations are also value filters on the same variable then include them */
-    while (program->current_index + num_operations < program->num_operations)
+    while (start_index + count < program->num_operations)
     {
         const char *next_variable_name;
 
-        if (!harp_operation_is_value_filter(program->operation[program->current_index + num_operations]))
+        if (!harp_operation_is_value_filter(program->operation[start_index + count]))
         {
             break;
         }
-        if (harp_operation_get_variable_name(program->operation[program->current_index + num_operations],
-                                             &next_variable_name) != 0)
+        if (harp_operation_get_variable_name(program->operation[start_index + count], &next_variable_name) != 0)
         {
             return -1;
         }
-        if (strcmp(variable_name, next_variable_name) != 0)
+        if (strcmp(*variable_name, next_variable_name) != 0)
         {
             break;
         }
-        num_operations++;
+        count++;
     }
 
-    if (harp_product_get_variable_by_name(product, variable_name, &variable) != 0)
-    {
-        return -1;
-    }
-    data_type_size = harp_get_size_for_type(variable->data_type);
+    *num_operations = count;
+
+    return 0;
+}
+
+/* Set the valid range and unit of the value filter operations to those of the variable that will be filtered */
+static int prepare_value_filter_group(harp_program *program, int start_index, int num_operations,
+                                      const harp_variable *variable)
+{
+    int k;
 
     for (k = 0; k < num_operations; k++)
     {
-        if (harp_operation_set_valid_range(program->operation[program->current_index + k], variable->data_type,
+        if (harp_operation_set_valid_range(program->operation[start_index + k], variable->data_type,
                                            variable->valid_min, variable->valid_max) != 0)
         {
             return -1;
         }
         if (variable->unit != NULL)
         {
-            if (harp_operation_set_value_unit(program->operation[program->current_index + k], variable->unit) != 0)
+            if (harp_operation_set_value_unit(program->operation[start_index + k], variable->unit) != 0)
             {
                 return -1;
             }
         }
     }
 
-    if (variable->num_dimensions == 0)
+    return 0;
+}
+
+/* Evaluate a value filter operation for a single element of a variable */
+static int evaluate_value_filter(harp_operation *operation, const harp_variable *variable, long index)
+{
+    int data_type_size = harp_get_size_for_type(variable->data_type);
+
+    if (harp_operation_is_string_value_filter(operation))
+    {
+        harp_operation_string_value_filter *string_operation;
+
+        string_operation = (harp_operation_string_value_filter *)operation;
+        return string_operation->eval(string_operation, variable->num_enum_values, variable->enum_name,
+                                      variable->data_type, &variable->data.int8_data[index * data_type_size]);
+    }
+    else
+    {
+        harp_operation_numeric_value_filter *numeric_operation;
+
+        numeric_operation = (harp_operation_numeric_value_filter *)operation;
+        return numeric_operation->eval(numeric_operation, variable->data_type,
+                                       &variable->data.int8_data[index * data_type_size]);
+    }
+}
+
+/* Evaluate a group of value filter operations on a one dimensional variable and update the mask accordingly */
+static int evaluate_value_filter_group_1d(harp_program *program, int start_index, int num_operations,
+                                          const harp_variable *variable, harp_dimension_mask *dimension_mask)
+{
+    long i;
+    int k;
+
+    for (i = 0; i < variable->num_elements; i++)
     {
         for (k = 0; k < num_operations; k++)
         {
-            int result;
-
-            if (harp_operation_is_string_value_filter(program->operation[program->current_index + k]))
+            if (dimension_mask->mask[i])
             {
-                harp_operation_string_value_filter *operation;
+                int result;
 
-                operation = (harp_operation_string_value_filter *)program->operation[program->current_index + k];
-                result = operation->eval(operation, variable->num_enum_values, variable->enum_name,
-                                         variable->data_type, variable->data.ptr);
+                result = evaluate_value_filter(program->operation[start_index + k], variable, i);
+                if (result < 0)
+                {
+                    return -1;
+                }
+                dimension_mask->mask[i] = result;
             }
-            else
-            {
-                harp_operation_numeric_value_filter *operation;
+        }
+    }
 
-                operation = (harp_operation_numeric_value_filter *)program->operation[program->current_index + k];
-                result = operation->eval(operation, variable->data_type, variable->data.ptr);
-            }
+    return 0;
+}
+
+static int execute_value_filter(harp_product *product, harp_program *program)
+{
+    harp_dimension_mask_set *dimension_mask_set = NULL;
+    harp_variable *variable;
+    const char *variable_name;
+    int num_operations;
+    long i, j;
+    int k;
+
+    if (get_value_filter_group(program, program->current_index, &variable_name, &num_operations) != 0)
+    {
+        return -1;
+    }
+
+    if (harp_product_get_variable_by_name(product, variable_name, &variable) != 0)
+    {
+        return -1;
+    }
+    if (prepare_value_filter_group(program, program->current_index, num_operations, variable) != 0)
+    {
+        return -1;
+    }
+
+    if (variable->num_dimensions == 0)
+    {
+        for (k = 0; k < num_operations; k++)
+        {
+            int result;
+
+            result = evaluate_value_filter(program->operation[program->current_index + k], variable, 0);
             if (result < 0)
             {
                 return -1;
@@ -223,41 +596,59 @@ static int execute_value_filter(harp_product *product, harp_program *program)
         }
         dimension_mask_set[variable->dimension_type[0]] = dimension_mask;
 
-        for (i = 0; i < variable->num_elements; i++)
+        if (evaluate_value_filter_group_1d(program, program->current_index, num_operations, variable, dimension_mask)
+            != 0)
         {
-            for (k = 0; k < num_operations; k++)
-            {
-                if (dimension_mask->mask[i])
-                {
-                    harp_operation *operation;
-                    int result;
-
-                    operation = program->operation[program->current_index + k];
-                    if (harp_operation_is_string_value_filter(operation))
-                    {
-                        harp_operation_string_value_filter *string_operation;
+            harp_dimension_mask_set_delete(dimension_mask_set);
+            return -1;
+        }
 
-                        string_operation = (harp_operation_string_value_filter *)operation;
-                        result = string_operation->eval(string_operation, variable->num_enum_values,
-                                                        variable->enum_name, variable->data_type,
-                                                        &variable->data.int8_data[i * data_type_size]);
-                    }
-                    else
-                    {
-                        harp_operation_numeric_value_filter *numeric_operation;
+        /* directly following value filters on other one dimensional variables with the same dimension are evaluated
+         * on the same mask, such that only a single filter pass over the product is needed for all of them */
+        while (program->current_index + num_operations < program->num_operations &&
+               harp_operation_is_value_filter(program->operation[program->current_index + num_operations]))
+        {
+            harp_variable *next_variable;
+            const char *next_variable_name;
+            int next_num_operations;
 
-                        numeric_operation = (harp_operation_numeric_value_filter *)operation;
-                        result = numeric_operation->eval(numeric_operation, variable->data_type,
-                                                         &variable->data.int8_data[i * data_type_size]);
-                    }
-                    if (result < 0)
-                    {
-                        harp_dimension_mask_set_delete(dimension_mask_set);
-                        return -1;
-                    }
-                    dimension_mask->mask[i] = result;
-                }
+            if (get_value_filter_group(program, program->current_index + num_operations, &next_variable_name,
+                                       &next_num_operations) != 0)
+            {
+                harp_dimension_mask_set_delete(dimension_mask_set);
+                return -1;
+            }
+            if (!harp_product_has_variable(product, next_variable_name))
+            {
+                /* leave the error handling to the regular execution of the operation */
+                break;
+            }
+            if (harp_product_get_variable_by_name(product, next_variable_name, &next_variable) != 0)
+            {
+                harp_dimension_mask_set_delete(dimension_mask_set);
+                return -1;
+            }
+            if (next_variable->num_dimensions != 1 || next_variable->dimension_type[0] != variable->dimension_type[0])
+            {
+                break;
+            }
+            if (prepare_value_filter_group(program, program->current_index + num_operations, next_num_operations,
+                                           next_variable) != 0)
+            {
+                harp_dimension_mask_set_delete(dimension_mask_set);
+                return -1;
             }
+            if (evaluate_value_filter_group_1d(program, program->current_index + num_operations, next_num_operations,
+                                               next_variable, dimension_mask) != 0)
+            {
+                harp_dimension_mask_set_delete(dimension_mask_set);
+                return -1;
+            }
+            num_operations += next_num_operations;
+        }
+
+        for (i = 0; i < variable->num_elements; i++)
+        {
             if (!dimension_mask->mask[i])
             {
                 dimension_mask->masked_dimension_length--;
@@ -312,27 +703,10 @@ static int execute_value_filter(harp_product *product, harp_program *program)
                 {
                     if (dimension_mask->mask[index])
                     {
-                        harp_operation *operation;
                         int result;
 
-                        operation = program->operation[program->current_index + k];
-                        if (harp_operation_is_string_value_filter(operation))
-                        {
-                            harp_operation_string_value_filter *string_operation;
-
-                            string_operation = (harp_operation_string_value_filter *)operation;
-                            result = string_operation->eval(string_operation, variable->num_enum_values,
-                                                            variable->enum_name, variable->data_type,
-                                                            &variable->data.int8_data[index * data_type_size]);
-                        }
-                        else
-                        {
-                            harp_operation_numeric_value_filter *numeric_operation;
-
-                            numeric_operation = (harp_operation_numeric_value_filter *)operation;
-                            result = numeric_operation->eval(numeric_operation, variable->data_type,
-                                                             &variable->data.int8_data[index * data_type_size]);
-                        }
+                        result = evaluate_value_filter(program->operation[program->current_index + k], variable,
+                                                       index);
                         if (result < 0)
                         {
                             harp_dimension_mask_set_delete(dimension_mask_set);
@@ -444,6 +818,7 @@ static int execute_point_filter(harp_product *product, harp_program *program)
     harp_variable *latitude;
     harp_variable *longitude;
     uint8_t *mask;
+    double *vector = NULL;
     int num_operations = 1;
     long num_points;
     long i;
@@ -478,32 +853,68 @@ static int execute_point_filter(harp_product *product, harp_program *program)
     {
         harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
                        num_points * sizeof(uint8_t), __FILE__, __LINE__);
+        harp_variable_delete(latitude);
+        harp_variable_delete(longitude);
         return -1;
     }
-
     for (i = 0; i < num_points; i++)
     {
-        harp_spherical_point point;
+        mask[i] = 1;
+    }
+
+    for (k = 0; k < num_operations; k++)
+    {
+        harp_operation *operation = program->operation[program->current_index + k];
+
+        if (operation->type == operation_point_distance_filter)
+        {
+            harp_operation_point_distance_filter *distance_operation;
 
-        point.lat = latitude->data.double_data[i];
-        point.lon = longitude->data.double_data[i];
-        harp_spherical_point_rad_from_deg(&point);
-        harp_spherical_point_check(&point);
+            /* convert all points to unit vectors once and test them in bulk using dot products */
+            if (vector == NULL)
+            {
+                vector = (double *)malloc(3 * num_points * sizeof(double));
+                if (vector == NULL)
+                {
+                    harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                                   3 * num_points * sizeof(double), __FILE__, __LINE__);
+                    harp_variable_delete(latitude);
+                    harp_variable_delete(longitude);
+                    free(mask);
+                    return -1;
+                }
+                harp_vector3d_array_from_latlon(num_points, latitude->data.double_data, longitude->data.double_data,
+                                                vector, &vector[num_points], &vector[2 * num_points]);
+            }
+            distance_operation = (harp_operation_point_distance_filter *)operation;
+            harp_vector3d_array_within_distance(&distance_operation->vector, distance_operation->angular_distance,
+                                                num_points, vector, &vector[num_points], &vector[2 * num_points],
+                                                mask);
+            continue;
+        }
 
-        mask[i] = 1;
-        for (k = 0; k < num_operations; k++)
+        for (i = 0; i < num_points; i++)
         {
             if (mask[i])
             {
-                harp_operation_point_filter *operation;
+                harp_operation_point_filter *point_operation = (harp_operation_point_filter *)operation;
+                harp_spherical_point point;
                 int result;
 
-                operation = (harp_operation_point_filter *)program->operation[program->current_index + k];
-                result = operation->eval(operation, &point);
+                point.lat = latitude->data.double_data[i];
+                point.lon = longitude->data.double_data[i];
+                harp_spherical_point_rad_from_deg(&point);
+                harp_spherical_point_check(&point);
+
+                result = point_operation->eval(point_operation, &point);
                 if (result < 0)
                 {
                     harp_variable_delete(latitude);
                     harp_variable_delete(longitude);
+                    if (vector != NULL)
+                    {
+                        free(vector);
+                    }
                     free(mask);
                     return -1;
                 }
@@ -514,6 +925,10 @@ static int execute_point_filter(harp_product *product, harp_program *program)
 
     harp_variable_delete(latitude);
     harp_variable_delete(longitude);
+    if (vector != NULL)
+    {
+        free(vector);
+    }
 
     if (harp_product_filter_dimension(product, harp_dimension_time, mask) != 0)
     {
@@ -680,28 +1095,59 @@ static int execute_collocation_filter(harp_product *product, harp_operation_coll
     return harp_product_apply_collocation_mask(product, operation->collocation_mask);
 }
 
-static int execute_bin_collocated(harp_product *product, harp_operation_bin_collocated *operation)
+/* Read the collocation result for one of the collocated dataset operations.
+ * If target_dataset is 'a' then the datasets of the collocation result will be swapped.
+ * If dataset_dir is not NULL, the metadata of the products in dataset_dir will be added to the target dataset.
+ */
+static int read_collocated_dataset(const char *filename, char target_dataset, const char *dataset_dir,
+                                   harp_collocation_result **collocation_result)
 {
-    harp_collocation_result *collocation_result = NULL;
+    harp_collocation_result *result = NULL;
 
-    if (harp_collocation_result_read(operation->collocation_result, &collocation_result) != 0)
+    if (harp_collocation_result_read(filename, &result) != 0)
     {
         return -1;
     }
 
-    if (operation->target_dataset == 'a')
+    if (target_dataset == 'a')
+    {
+        harp_collocation_result_swap_datasets(result);
+    }
+    if (dataset_dir != NULL)
     {
-        harp_collocation_result_swap_datasets(collocation_result);
+        if (harp_dataset_import(result->dataset_b, dataset_dir, NULL) != 0)
+        {
+            harp_collocation_result_delete(result);
+            return -1;
+        }
     }
 
-    if (harp_product_bin_with_collocated_dataset(product, collocation_result) != 0)
+    *collocation_result = result;
+    return 0;
+}
+
+static int execute_bin_collocated(harp_product *product, harp_operation_bin_collocated *operation)
+{
+    harp_collocation_result *collocation_result = operation->cached_collocation_result;
+    int result;
+
+    if (collocation_result == NULL)
     {
-        harp_collocation_result_delete(collocation_result);
-        return -1;
+        if (read_collocated_dataset(operation->collocation_result, operation->target_dataset, NULL,
+                                    &collocation_result) != 0)
+        {
+            return -1;
+        }
     }
 
+    result = harp_product_bin_with_collocated_dataset(product, collocation_result);
 
-    return 0;
+    if (operation->cached_collocation_result == NULL)
+    {
+        harp_collocation_result_delete(collocation_result);
+    }
+
+    return result;
 }
 
 static int execute_bin_spatial(harp_product *product, harp_operation_bin_spatial *operation)
@@ -774,34 +1220,34 @@ static int execute_derive_variable(harp_product *product, harp_operation_derive_
 static int execute_derive_smoothed_column_collocated_dataset
     (harp_product *product, harp_operation_derive_smoothed_column_collocated_dataset *operation)
 {
-    harp_collocation_result *collocation_result = NULL;
+    harp_collocation_result *collocation_result = operation->cached_collocation_result;
     harp_variable *variable;
+    int result;
 
-    if (harp_collocation_result_read(operation->collocation_result, &collocation_result) != 0)
+    if (collocation_result == NULL)
     {
-        return -1;
+        if (read_collocated_dataset(operation->collocation_result, operation->target_dataset, operation->dataset_dir,
+                                    &collocation_result) != 0)
+        {
+            return -1;
+        }
     }
 
-    if (operation->target_dataset == 'a')
-    {
-        harp_collocation_result_swap_datasets(collocation_result);
-    }
-    if (harp_dataset_import(collocation_result->dataset_b, operation->dataset_dir, NULL) != 0)
+    /* execute the operation */
+    result = harp_product_get_smoothed_column_using_collocated_dataset(product, operation->variable_name,
+                                                                       operation->unit, operation->num_dimensions,
+                                                                       operation->dimension_type,
+                                                                       operation->axis_variable_name,
+                                                                       operation->axis_unit, collocation_result,
+                                                                       &variable);
+    if (operation->cached_collocation_result == NULL)
     {
         harp_collocation_result_delete(collocation_result);
-        return -1;
     }
-
-    /* execute the operation */
-    if (harp_product_get_smoothed_column_using_collocated_dataset(product, operation->variable_name, operation->unit,
-                                                                  operation->num_dimensions, operation->dimension_type,
-                                                                  operation->axis_variable_name, operation->axis_unit,
-                                                                  collocation_result, &variable) != 0)
+    if (result != 0)
     {
-        harp_collocation_result_delete(collocation_result);
         return -1;
     }
-    harp_collocation_result_delete(collocation_result);
 
     if (harp_product_has_variable(product, variable->name))
     {
@@ -960,32 +1406,28 @@ static int execute_regrid(harp_product *product, harp_operation_regrid *operatio
 
 static int execute_regrid_collocated_dataset(harp_product *product, harp_operation_regrid_collocated_dataset *operation)
 {
-    harp_collocation_result *collocation_result = NULL;
+    harp_collocation_result *collocation_result = operation->cached_collocation_result;
+    int result;
 
-    if (harp_collocation_result_read(operation->collocation_result, &collocation_result) != 0)
+    if (collocation_result == NULL)
     {
-        return -1;
+        if (read_collocated_dataset(operation->collocation_result, operation->target_dataset, operation->dataset_dir,
+                                    &collocation_result) != 0)
+        {
+            return -1;
+        }
     }
 
-    if (operation->target_dataset == 'a')
-    {
-        harp_collocation_result_swap_datasets(collocation_result);
-    }
-    if (harp_dataset_import(collocation_result->dataset_b, operation->dataset_dir, NULL) != 0)
-    {
-        harp_collocation_result_delete(collocation_result);
-        return -1;
-    }
+    result = harp_product_regrid_with_collocated_dataset(product, operation->dimension_type,
+                                                         operation->axis_variable_name, operation->axis_unit,
+                                                         collocation_result);
 
-    if (harp_product_regrid_with_collocated_dataset(product, operation->dimension_type, operation->axis_variable_name,
-                                                    operation->axis_unit, collocation_result) != 0)
+    if (operation->cached_collocation_result == NULL)
     {
         harp_collocation_result_delete(collocation_result);
-        return -1;
     }
 
-    harp_collocation_result_delete(collocation_result);
-    return 0;
+    return result;
 }
 
 static int execute_regrid_collocated_product(harp_product *product, harp_operation_regrid_collocated_product *operation)
@@ -1113,7 +1555,8 @@ static int execute_set(harp_product *product, harp_operation_set *operation)
 
 static int execute_smooth_collocated_dataset(harp_product *product, harp_operation_smooth_collocated_dataset *operation)
 {
-    harp_collocation_result *collocation_result = NULL;
+    harp_collocation_result *collocation_result = operation->cached_collocation_result;
+    int result;
 
     if (operation->dimension_type != harp_dimension_vertical)
     {
@@ -1122,32 +1565,26 @@ static int execute_smooth_collocated_dataset(harp_product *product, harp_operati
         return -1;
     }
 
-    if (harp_collocation_result_read(operation->collocation_result, &collocation_result) != 0)
+    if (collocation_result == NULL)
     {
-        return -1;
+        if (read_collocated_dataset(operation->collocation_result, operation->target_dataset, operation->dataset_dir,
+                                    &collocation_result) != 0)
+        {
+            return -1;
+        }
     }
 
-    if (operation->target_dataset == 'a')
-    {
-        harp_collocation_result_swap_datasets(collocation_result);
-    }
-    if (harp_dataset_import(collocation_result->dataset_b, operation->dataset_dir, NULL) != 0)
-    {
-        harp_collocation_result_delete(collocation_result);
-        return -1;
-    }
+    result = harp_product_smooth_vertical_with_collocated_dataset(product, operation->num_variables,
+                                                                  (const char **)operation->variable_name,
+                                                                  operation->axis_variable_name, operation->axis_unit,
+                                                                  collocation_result);
 
-    if (harp_product_smooth_vertical_with_collocated_dataset(product, operation->num_variables,
-                                                             (const char **)operation->variable_name,
-                                                             operation->axis_variable_name, operation->axis_unit,
-                                                             collocation_result) != 0)
+    if (operation->cached_collocation_result == NULL)
     {
         harp_collocation_result_delete(collocation_result);
-        return -1;
     }
 
-    harp_collocation_result_delete(collocation_result);
-    return 0;
+    return result;
 }
 
 static int execute_smooth_collocated_product(harp_product *product, harp_operation_smooth_collocated_product *operation)
@@ -1247,12 +1684,38 @@ static int execute_wrap(harp_product *product, harp_operation_wrap *operation)
     return 0;
 }
 
+static const char *get_operation_name(const harp_operation *operation);
+
+static void trace_operation(const harp_trace_span *span, const harp_product *product, const harp_program *program,
+                            int first_index)
+{
+    char details[64];
+
+    if (program->current_index > first_index)
+    {
+        /* consecutive filter operations that were executed together */
+        sprintf(details, "operations %d-%d", first_index + 1, program->current_index + 1);
+    }
+    else
+    {
+        sprintf(details, "operation %d", first_index + 1);
+    }
+    harp_trace_end(span, "operation", get_operation_name(program->operation[first_index]), product, details);
+}
+
 /* this will start with the operation at program->current_index */
-int harp_product_execute_program(harp_product *product, harp_program *program)
+int harp_product_continue_program(harp_product *product, harp_program *program)
 {
     while (program->current_index < program->num_operations)
     {
         harp_operation *operation = program->operation[program->current_index];
+        int first_index = program->current_index;
+        harp_trace_span span;
+
+        if (harp_option_trace)
+        {
+            harp_trace_begin(&span, product);
+        }
 
         /* note that some consecutive filter operations can be executed together for optimization purposes */
         /* so the filter functions below may increase program->current_index itself */
@@ -1433,6 +1896,11 @@ int harp_product_execute_program(harp_product *product, harp_program *program)
                 break;
         }
 
+        if (harp_option_trace)
+        {
+            trace_operation(&span, product, program, first_index);
+        }
+
         if (harp_product_is_empty(product))
         {
             /* don't perform any of the remaining actions; just return the empty product */
@@ -1444,6 +1912,91 @@ int harp_product_execute_program(harp_product *product, harp_program *program)
     return 0;
 }
 
+/* Load the resources of the operations of a compiled program.
+ * Collocation result files (and the dataset metadata that collocated dataset operations need) are read once here
+ * instead of at each execution of the program.
+ */
+static int program_load_resources(harp_program *program)
+{
+    int i;
+
+    for (i = 0; i < program->num_operations; i++)
+    {
+        harp_operation *operation = program->operation[i];
+
+        switch (operation->type)
+        {
+            case operation_collocation_filter:
+                {
+                    harp_operation_collocation_filter *collocation_filter;
+
+                    collocation_filter = (harp_operation_collocation_filter *)operation;
+                    if (harp_collocation_result_read_range(collocation_filter->filename,
+                                                           collocation_filter->min_collocation_index,
+                                                           collocation_filter->max_collocation_index, NULL, NULL,
+                                                           &collocation_filter->cached_collocation_result) != 0)
+                    {
+                        return -1;
+                    }
+                }
+                break;
+            case operation_bin_collocated:
+                {
+                    harp_operation_bin_collocated *bin_collocated = (harp_operation_bin_collocated *)operation;
+
+                    if (read_collocated_dataset(bin_collocated->collocation_result, bin_collocated->target_dataset,
+                                                NULL, &bin_collocated->cached_collocation_result) != 0)
+                    {
+                        return -1;
+                    }
+                }
+                break;
+            case operation_derive_smoothed_column_collocated_dataset:
+                {
+                    harp_operation_derive_smoothed_column_collocated_dataset *derive_smoothed;
+
+                    derive_smoothed = (harp_operation_derive_smoothed_column_collocated_dataset *)operation;
+                    if (read_collocated_dataset(derive_smoothed->collocation_result, derive_smoothed->target_dataset,
+                                                derive_smoothed->dataset_dir,
+                                                &derive_smoothed->cached_collocation_result) != 0)
+                    {
+                        return -1;
+                    }
+                }
+                break;
+            case operation_regrid_collocated_dataset:
+                {
+                    harp_operation_regrid_collocated_dataset *regrid = (harp_operation_regrid_collocated_dataset *)
+                        operation;
+
+                    if (read_collocated_dataset(regrid->collocation_result, regrid->target_dataset, regrid->dataset_dir,
+                                                &regrid->cached_collocation_result) != 0)
+                    {
+                        return -1;
+                    }
+                }
+                break;
+            case operation_smooth_collocated_dataset:
+                {
+                    harp_operation_smooth_collocated_dataset *smooth = (harp_operation_smooth_collocated_dataset *)
+                        operation;
+
+                    if (read_collocated_dataset(smooth->collocation_result, smooth->target_dataset, smooth->dataset_dir,
+                                                &smooth->cached_collocation_result) != 0)
+                    {
+                        return -1;
+                    }
+                }
+                break;
+            default:
+                /* area masks are already read when the operation is parsed */
+                break;
+        }
+    }
+
+    return 0;
+}
+
 /** \addtogroup harp_product
  * @{
  */
@@ -1480,7 +2033,7 @@ LIBHARP_API int harp_product_execute_operations(harp_product *product, const cha
         return -1;
     }
 
-    if (harp_product_execute_program(product, program) != 0)
+    if (harp_product_continue_program(product, program) != 0)
     {
         harp_program_delete(program);
         return -1;
@@ -1491,6 +2044,295 @@ LIBHARP_API int harp_product_execute_operations(harp_product *product, const cha
     return 0;
 }
 
+/** Compile one or more operations into a program.
+ * The operations are parsed and all resources that the operations refer to (such as area mask files, collocation
+ * result files, and the metadata of collocated datasets) are loaded once. The resulting program can then be executed
+ * on any number of products using harp_product_execute_program() or harp_import_with_program(), which is more
+ * efficient than passing the same operations string for each product.
+ * Compiling a program does not change the global HARP options. Changes to the options made by 'set' operations in the
+ * program only apply during an execution of the program.
+ * The program should be removed with harp_program_delete() once it is no longer needed.
+ * \param  operations Operations to compile; should be specified as a semi-colon separated string of operations.
+ * \param  program Pointer to the C variable where the compiled program will be stored.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_program_compile(const char *operations, harp_program **program)
+{
+    harp_program *compiled_program;
+
+    if (operations == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "operations is NULL");
+        return -1;
+    }
+    if (program == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "program is NULL");
+        return -1;
+    }
+
+    if (harp_program_from_string(operations, &compiled_program) != 0)
+    {
+        return -1;
+    }
+
+    /* options are captured and restored per execution, so undo the changes made by harp_program_new() */
+    harp_set_option_regrid_out_of_bounds(compiled_program->option_regrid_out_of_bounds);
+    compiled_program->restore_options = 0;
+
+    if (program_load_resources(compiled_program) != 0)
+    {
+        harp_program_delete(compiled_program);
+        return -1;
+    }
+
+    *program = compiled_program;
+
+    return 0;
+}
+
+/** Execute a compiled program on a product.
+ * The program is always executed from its first operation, so the same program can be executed on multiple products.
+ * If one of the operations results in an empty product then the function will immediately return with
+ * the empty product (and return code 0) and will not execute any of the remaining actions anymore.
+ * The global HARP options will have the same values after the execution as before the execution.
+ * \param  product Product that the operations should be executed on.
+ * \param  program Program that was created using harp_program_compile().
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_product_execute_program(harp_product *product, harp_program *program)
+{
+    int result;
+
+    if (product == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "product is NULL");
+        return -1;
+    }
+    if (program == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "program is NULL");
+        return -1;
+    }
+
+    harp_program_begin_execution(program);
+    result = harp_product_continue_program(product, program);
+    harp_program_end_execution(program);
+
+    return result;
+}
+
 /**
  * @}
  */
+
+static const char *get_operation_name(const harp_operation *operation)
+{
+    switch (operation->type)
+    {
+        case operation_area_covers_area_filter:
+            return "area_covers_area";
+        case operation_area_covers_point_filter:
+            return "area_covers_point";
+        case operation_area_inside_area_filter:
+            return "area_inside_area";
+        case operation_area_intersects_area_filter:
+            return "area_intersects_area";
+        case operation_bin_collocated:
+            return "bin (collocated)";
+        case operation_bin_full:
+            return "bin";
+        case operation_bin_spatial:
+            return "bin_spatial";
+        case operation_bin_with_variables:
+            return "bin (variables)";
+        case operation_bit_mask_filter:
+            return "bit mask filter";
+        case operation_clamp:
+            return "clamp";
+        case operation_collocation_filter:
+            return "collocate";
+        case operation_comparison_filter:
+            return "comparison filter";
+        case operation_derive_variable:
+            return "derive";
+        case operation_derive_smoothed_column_collocated_dataset:
+            return "derive_smoothed_column (collocated dataset)";
+        case operation_derive_smoothed_column_collocated_product:
+            return "derive_smoothed_column (collocated product)";
+        case operation_exclude_variable:
+            return "exclude";
+        case operation_flatten:
+            return "flatten";
+        case operation_index_comparison_filter:
+            return "index comparison filter";
+        case operation_index_membership_filter:
+            return "index membership filter";
+        case operation_keep_variable:
+            return "keep";
+        case operation_longitude_range_filter:
+            return "longitude range filter";
+        case operation_membership_filter:
+            return "membership filter";
+        case operation_point_distance_filter:
+            return "point_distance";
+        case operation_point_in_area_filter:
+            return "point_in_area";
+        case operation_regrid:
+            return "regrid";
+        case operation_regrid_collocated_dataset:
+            return "regrid (collocated dataset)";
+        case operation_regrid_collocated_product:
+            return "regrid (collocated product)";
+        case operation_rename:
+            return "rename";
+        case operation_set:
+            return "set";
+        case operation_smooth_collocated_dataset:
+            return "smooth (collocated dataset)";
+        case operation_smooth_collocated_product:
+            return "smooth (collocated product)";
+        case operation_sort:
+            return "sort";
+        case operation_squash:
+            return "squash";
+        case operation_string_comparison_filter:
+            return "string comparison filter";
+        case operation_string_membership_filter:
+            return "string membership filter";
+        case operation_valid_range_filter:
+            return "valid";
+        case operation_wrap:
+            return "wrap";
+    }
+
+    assert(0);
+    exit(1);
+}
+
+/* Determine whether an operation can be performed as part of the ingestion (when it is at the start of a program).
+ * This should be kept in sync with evaluate_ingestion_mask() in harp-ingestion.c.
+ */
+static int is_ingestion_operation(const harp_operation *operation)
+{
+    switch (operation->type)
+    {
+        case operation_area_covers_area_filter:
+        case operation_area_covers_point_filter:
+        case operation_area_inside_area_filter:
+        case operation_area_intersects_area_filter:
+        case operation_bit_mask_filter:
+        case operation_comparison_filter:
+        case operation_exclude_variable:
+        case operation_index_comparison_filter:
+        case operation_index_membership_filter:
+        case operation_keep_variable:
+        case operation_longitude_range_filter:
+        case operation_membership_filter:
+        case operation_point_distance_filter:
+        case operation_point_in_area_filter:
+        case operation_string_comparison_filter:
+        case operation_string_membership_filter:
+        case operation_valid_range_filter:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/** Print the execution plan for a list of operations.
+ * \ingroup harp_documentation
+ * The operations are parsed and optimized in the same way as is done by harp_import() and
+ * harp_product_execute_operations(), and the resulting list of operations is printed in the order in which it will be
+ * executed. Operations that can be performed as part of the ingestion of a product (when it is not in HARP format) are
+ * marked as such. Consecutive filters that are evaluated together are marked as well. For value filters on different
+ * variables this is only the case if, at execution time, both variables turn out to be one dimensional with the same
+ * dimension.
+ * The \a print function parameter should be a function that resembles printf().
+ * \param operations Operations to explain; should be specified as a semi-colon separated string of operations.
+ * \param print Reference to a printf compatible function.
+ * \return
+ *   \arg \c  0, Succes.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_doc_list_operations(const char *operations, int (*print) (const char *, ...))
+{
+    harp_program *program;
+    int ingestion = 1;
+    int i;
+
+    if (operations == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "operations is NULL");
+        return -1;
+    }
+
+    if (harp_program_from_string(operations, &program) != 0)
+    {
+        return -1;
+    }
+
+    for (i = 0; i < program->num_operations; i++)
+    {
+        harp_operation *operation = program->operation[i];
+
+        print("%d: %s", i + 1, get_operation_name(operation));
+        if (harp_operation_is_value_filter(operation))
+        {
+            const char *variable_name;
+
+            if (harp_operation_get_variable_name(operation, &variable_name) == 0)
+            {
+                print(" on '%s'", variable_name);
+                if (i > 0 && harp_operation_is_value_filter(program->operation[i - 1]))
+                {
+                    const char *previous_variable_name;
+
+                    if (harp_operation_get_variable_name(program->operation[i - 1], &previous_variable_name) == 0)
+                    {
+                        if (strcmp(variable_name, previous_variable_name) == 0)
+                        {
+                            print(" (combined with previous filter)");
+                        }
+                        else
+                        {
+                            print(" (combined with previous filter if both variables are one dimensional with the "
+                                  "same dimension)");
+                        }
+                    }
+                }
+            }
+        }
+        else if (i > 0 && ((harp_operation_is_point_filter(operation) &&
+                            harp_operation_is_point_filter(program->operation[i - 1])) ||
+                           (harp_operation_is_polygon_filter(operation) &&
+                            harp_operation_is_polygon_filter(program->operation[i - 1]))))
+        {
+            print(" (combined with previous filter)");
+        }
+        if (ingestion)
+        {
+            if (is_ingestion_operation(operation))
+            {
+                print(" [ingestion]");
+            }
+            else
+            {
+                if (operation->type == operation_collocation_filter)
+                {
+                    print(" [ingestion prefilter]");
+                }
+                ingestion = 0;
+            }
+        }
+        print("\n");
+    }
+
+    harp_program_delete(program);
+
+    return 0;
+}
@@ -35,7 +35,7 @@
 #include "harp-operation.h"
 
 /* HARP programs are lists of harp_operations */
-typedef struct harp_program_struct
+struct harp_program_struct
 {
     int num_operations;
     harp_operation **operation;
@@ -46,16 +46,21 @@ typedef struct harp_program_struct
     int option_enable_aux_afgl86;
     int option_enable_aux_usstd76;
     int option_regrid_out_of_bounds;
-} harp_program;
+    /* whether harp_program_delete() should restore the initial global HARP options (not for compiled programs) */
+    int restore_options;
+};
 
 int harp_program_new(harp_program **new_program);
-void harp_program_delete(harp_program *program);
+void harp_program_reset(harp_program *program);
+void harp_program_begin_execution(harp_program *program);
+void harp_program_end_execution(harp_program *program);
+void harp_program_optimize(harp_program *program);
 int harp_program_add_operation(harp_program *program, harp_operation *operation);
 
 /* Parser */
 int harp_program_from_string(const char *str, harp_program **new_program);
 
 /* Execution */
-int harp_product_execute_program(harp_product *product, harp_program *program);
+int harp_product_continue_program(harp_product *product, harp_program *program);
 
 #endif
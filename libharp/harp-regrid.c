@@ -1416,7 +1416,7 @@ LIBHARP_API int harp_product_regrid_with_collocated_dataset(harp_product *produc
         }
         else
         {
-            if (harp_product_append(merged_product, collocated_product) != 0)
+            if (harp_product_append_move(merged_product, collocated_product) != 0)
             {
                 harp_add_error_message(" for collocated dataset");
                 harp_product_delete(collocated_product);
@@ -0,0 +1,472 @@
+/*
+ * Copyright (C) 2015-2020 S[&]T, The Netherlands.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "harp-internal.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef HAVE_GETTIMEOFDAY
+#include <sys/time.h>
+#endif
+
+/* A trace event records a single timed step (an operation or an ingestion phase) together with the state of the
+ * product before and after that step.
+ */
+typedef struct trace_event_struct
+{
+    const char *category;
+    char *name;
+    char *details;
+    double start_time;
+    double duration;
+    long dimension_before[HARP_NUM_DIM_TYPES];
+    long dimension_after[HARP_NUM_DIM_TYPES];
+    int64_t size_before;
+    int64_t size_after;
+    int num_variables_before;
+    int num_variables_after;
+} trace_event;
+
+int harp_option_trace = 0;
+
+static trace_event *trace_event_list = NULL;
+static long trace_num_events = 0;
+static long trace_num_dropped_events = 0;
+static double trace_start_time = -1;
+
+static double get_time(void)
+{
+#ifdef HAVE_GETTIMEOFDAY
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + tv.tv_usec * 1.0e-6;
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static void get_product_state(const harp_product *product, long *dimension, int64_t *size, int *num_variables)
+{
+    int i;
+
+    if (product == NULL)
+    {
+        for (i = 0; i < HARP_NUM_DIM_TYPES; i++)
+        {
+            dimension[i] = 0;
+        }
+        *size = 0;
+        *num_variables = 0;
+        return;
+    }
+
+    for (i = 0; i < HARP_NUM_DIM_TYPES; i++)
+    {
+        dimension[i] = product->dimension[i];
+    }
+    harp_product_get_storage_size(product, 0, size);
+    *num_variables = product->num_variables;
+}
+
+/* Start a trace span for a step that is about to be performed on the product (which may be NULL).
+ * Callers should only call this function (and harp_trace_end()) if harp_option_trace is set.
+ */
+void harp_trace_begin(harp_trace_span *span, const harp_product *product)
+{
+    get_product_state(product, span->dimension, &span->storage_size, &span->num_variables);
+    span->start_time = get_time();
+    if (trace_start_time < 0)
+    {
+        trace_start_time = span->start_time;
+    }
+}
+
+/* Finish a trace span and record it as an event. The details string is optional (can be NULL).
+ * Tracing should never cause the traced step to fail, so if the event cannot be stored it is only counted as dropped.
+ */
+void harp_trace_end(const harp_trace_span *span, const char *category, const char *name, const harp_product *product,
+                    const char *details)
+{
+    trace_event *event;
+    double end_time;
+
+    end_time = get_time();
+
+    if (trace_num_events % BLOCK_SIZE == 0)
+    {
+        trace_event *new_event_list;
+
+        new_event_list = (trace_event *)realloc(trace_event_list,
+                                                (trace_num_events + BLOCK_SIZE) * sizeof(trace_event));
+        if (new_event_list == NULL)
+        {
+            trace_num_dropped_events++;
+            return;
+        }
+        trace_event_list = new_event_list;
+    }
+
+    event = &trace_event_list[trace_num_events];
+    event->category = category;
+    event->name = strdup(name);
+    if (event->name == NULL)
+    {
+        trace_num_dropped_events++;
+        return;
+    }
+    event->details = NULL;
+    if (details != NULL)
+    {
+        event->details = strdup(details);
+        if (event->details == NULL)
+        {
+            free(event->name);
+            trace_num_dropped_events++;
+            return;
+        }
+    }
+    event->start_time = span->start_time - trace_start_time;
+    event->duration = end_time - span->start_time;
+    memcpy(event->dimension_before, span->dimension, HARP_NUM_DIM_TYPES * sizeof(long));
+    event->size_before = span->storage_size;
+    event->num_variables_before = span->num_variables;
+    get_product_state(product, event->dimension_after, &event->size_after, &event->num_variables_after);
+
+    trace_num_events++;
+}
+
+static void print_dimension_changes(const trace_event *event, int (*print) (const char *, ...))
+{
+    int first = 1;
+    int i;
+
+    for (i = 0; i < HARP_NUM_DIM_TYPES; i++)
+    {
+        if (event->dimension_before[i] == event->dimension_after[i])
+        {
+            continue;
+        }
+        if (first)
+        {
+            print("%38s", "");
+        }
+        else
+        {
+            print(", ");
+        }
+        print("%s %ld -> %ld", harp_get_dimension_type_name(i), event->dimension_before[i],
+              event->dimension_after[i]);
+        if (event->dimension_before[i] > 0)
+        {
+            print(" (%.1f%%)", 100.0 * event->dimension_after[i] / event->dimension_before[i]);
+        }
+        first = 0;
+    }
+    if (!first)
+    {
+        print("\n");
+    }
+}
+
+/* Write a string as a JSON string value (including the quotes). */
+static void write_json_string(FILE *f, const char *str)
+{
+    fputc('"', f);
+    while (*str != '\0')
+    {
+        unsigned char c = (unsigned char)*str;
+
+        if (c == '"' || c == '\\')
+        {
+            fprintf(f, "\\%c", c);
+        }
+        else if (c < 0x20)
+        {
+            fprintf(f, "\\u%04x", c);
+        }
+        else
+        {
+            fputc(c, f);
+        }
+        str++;
+    }
+    fputc('"', f);
+}
+
+static void write_chrome_trace_event(FILE *f, const trace_event *event)
+{
+    int i;
+
+    /* complete events ('X') with timestamps and durations in microseconds */
+    fprintf(f, "{\"name\":");
+    write_json_string(f, event->name);
+    fprintf(f, ",\"cat\":");
+    write_json_string(f, event->category);
+    fprintf(f, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1,\"args\":{", event->start_time * 1.0e6,
+            event->duration * 1.0e6);
+    fprintf(f, "\"bytes_before\":%.0f,\"bytes_after\":%.0f", (double)event->size_before,
+            (double)event->size_after);
+    fprintf(f, ",\"num_variables_before\":%d,\"num_variables_after\":%d", event->num_variables_before,
+            event->num_variables_after);
+    for (i = 0; i < HARP_NUM_DIM_TYPES; i++)
+    {
+        if (event->dimension_before[i] > 0 || event->dimension_after[i] > 0)
+        {
+            fprintf(f, ",\"%s_before\":%ld,\"%s_after\":%ld", harp_get_dimension_type_name(i),
+                    event->dimension_before[i], harp_get_dimension_type_name(i), event->dimension_after[i]);
+        }
+    }
+    if (event->details != NULL)
+    {
+        fprintf(f, ",\"details\":");
+        write_json_string(f, event->details);
+    }
+    fprintf(f, "}}");
+}
+
+/** \addtogroup harp_general
+ * @{
+ */
+
+/** Enable/disable tracing of operations and ingestion.
+ * If tracing is enabled, HARP records for each executed operation and for each phase of an ingestion the wall clock
+ * time, the dimension lengths, number of variables, and storage size of the product before and after the step, and
+ * step specific details (such as the selectivity of the ingestion mask and the number of variables that were read).
+ * Recorded events can be shown with harp_trace_print_summary() and saved with harp_trace_write_chrome_trace().
+ *
+ * Tracing can also be enabled by setting the HARP_TRACE environment variable before calling harp_init(). If this
+ * variable is set to a value other than "0" or "1", the value is used as the path of a Chrome trace file to which all
+ * events are written by the final harp_done() call. In both cases a summary is printed to stderr by harp_done().
+ * \param enable
+ *   \arg 0: Disable tracing (default).
+ *   \arg 1: Enable tracing.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_set_option_trace(int enable)
+{
+    if (enable != 0 && enable != 1)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "enable argument (%d) is not valid (%s:%u)", enable, __FILE__,
+                       __LINE__);
+        return -1;
+    }
+
+    harp_option_trace = enable;
+
+    return 0;
+}
+
+/** Retrieve the current setting for tracing of operations and ingestion.
+ * \see harp_set_option_trace()
+ * \return
+ *   \arg \c 0, Tracing is disabled.
+ *   \arg \c 1, Tracing is enabled.
+ */
+LIBHARP_API int harp_get_option_trace(void)
+{
+    return harp_option_trace;
+}
+
+/** Remove all trace events that have been recorded so far.
+ * The start time of the trace is reset as well (event times are relative to the first event after this call).
+ */
+LIBHARP_API void harp_trace_clear(void)
+{
+    long i;
+
+    for (i = 0; i < trace_num_events; i++)
+    {
+        free(trace_event_list[i].name);
+        if (trace_event_list[i].details != NULL)
+        {
+            free(trace_event_list[i].details);
+        }
+    }
+    if (trace_event_list != NULL)
+    {
+        free(trace_event_list);
+        trace_event_list = NULL;
+    }
+    trace_num_events = 0;
+    trace_num_dropped_events = 0;
+    trace_start_time = -1;
+}
+
+static int print_to_stderr(const char *message, ...)
+{
+    va_list ap;
+    int result;
+
+    va_start(ap, message);
+    result = vfprintf(stderr, message, ap);
+    va_end(ap);
+
+    return result;
+}
+
+/** Print a summary of all recorded trace events.
+ * The summary contains a table with one row per event (in order of completion) with the duration of the step, the
+ * storage size of the product (in MB) before and after the step, and any changes in dimension lengths, followed by a
+ * table with the number of events and total duration per operation/ingestion phase.
+ * \param print Reference to a printf compatible function (if NULL, the summary is printed to stderr).
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_trace_print_summary(int (*print) (const char *, ...))
+{
+    char *counted;
+    long i;
+    long j;
+
+    if (print == NULL)
+    {
+        print = print_to_stderr;
+    }
+
+    print("trace events: %ld", trace_num_events);
+    if (trace_num_dropped_events > 0)
+    {
+        print(" (%ld dropped)", trace_num_dropped_events);
+    }
+    print("\n");
+    if (trace_num_events == 0)
+    {
+        return 0;
+    }
+
+    print("  time [s]  before [MB]   after [MB]  event\n");
+    for (i = 0; i < trace_num_events; i++)
+    {
+        const trace_event *event = &trace_event_list[i];
+
+        print("%10.6f %12.3f %12.3f  %s: %s", event->duration, event->size_before / 1.0e6,
+              event->size_after / 1.0e6, event->category, event->name);
+        if (event->details != NULL)
+        {
+            print(" (%s)", event->details);
+        }
+        if (event->num_variables_before != event->num_variables_after)
+        {
+            print(" [variables %d -> %d]", event->num_variables_before, event->num_variables_after);
+        }
+        print("\n");
+        print_dimension_changes(event, print);
+    }
+
+    counted = calloc(trace_num_events, sizeof(char));
+    if (counted == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       trace_num_events * sizeof(char), __FILE__, __LINE__);
+        return -1;
+    }
+
+    print("\n     count  total [s]  event\n");
+    for (i = 0; i < trace_num_events; i++)
+    {
+        const trace_event *event = &trace_event_list[i];
+        double total_duration = 0;
+        long count = 0;
+
+        if (counted[i])
+        {
+            continue;
+        }
+        for (j = i; j < trace_num_events; j++)
+        {
+            if (strcmp(trace_event_list[j].category, event->category) == 0 &&
+                strcmp(trace_event_list[j].name, event->name) == 0)
+            {
+                total_duration += trace_event_list[j].duration;
+                counted[j] = 1;
+                count++;
+            }
+        }
+        print("%10ld %10.6f  %s: %s\n", count, total_duration, event->category, event->name);
+    }
+
+    free(counted);
+
+    return 0;
+}
+
+/** Write all recorded trace events to a file in the Chrome trace event format.
+ * The resulting JSON file can be loaded in chrome://tracing or https://ui.perfetto.dev. Each event is stored as a
+ * complete event with the product dimension lengths, number of variables, and storage size (in bytes) before and
+ * after the step, and the step specific details as arguments.
+ * \param filename Path of the file to which the trace should be written.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_trace_write_chrome_trace(const char *filename)
+{
+    FILE *f;
+    long i;
+
+    if (filename == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "filename is NULL (%s:%u)", __FILE__, __LINE__);
+        return -1;
+    }
+
+    f = fopen(filename, "w");
+    if (f == NULL)
+    {
+        harp_set_error(HARP_ERROR_FILE_OPEN, "error opening file '%s' (%s)", filename, strerror(errno));
+        return -1;
+    }
+
+    fprintf(f, "{\"traceEvents\":[");
+    for (i = 0; i < trace_num_events; i++)
+    {
+        fprintf(f, i == 0 ? "\n" : ",\n");
+        write_chrome_trace_event(f, &trace_event_list[i]);
+    }
+    fprintf(f, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+    if (fclose(f) != 0)
+    {
+        harp_set_error(HARP_ERROR_FILE_CLOSE, "error closing file '%s' (%s)", filename, strerror(errno));
+        return -1;
+    }
+
+    return 0;
+}
+
+/** @} */
@@ -39,6 +39,8 @@
 #include "udunits2.h"
 
 static char *harp_udunits2_xml_path = NULL;
+/* set if harp_udunits2_xml_path only refers to the location of the bundled unit database */
+static int harp_udunits2_xml_path_is_bundled = 0;
 
 static ut_system *unit_system = NULL;
 
@@ -105,14 +107,14 @@ static void handle_udunits_error(void)
  * \ingroup harp_general
  * This function should be called before harp_init() is called.
  *
- * The HARP C library uses the udunits2 library to perform unit conversions. The xml configuration files for udunits2
- * are included with a HARP installation and a default absolute path to these xml files is built into the library.
+ * The HARP C library uses the udunits2 library to perform unit conversions. The unit database that is included with
+ * HARP is compiled into the library, so by default no xml configuration files need to be read.
  *
- * If the HARP installation ends up in a different location on disk compared to what was provided at build time then
- * you will either need to set the UDUNITS2_XML_PATH environment variable or call one of the functions
- * harp_set_udunits2_xml_path() or harp_set_udunits2_xml_path_conditional() to set the path programmatically.
+ * If you want HARP to use a different unit database then you can either set the UDUNITS2_XML_PATH environment
+ * variable or call this function to set the path programmatically. The xml files will then be read (instead of using
+ * the compiled-in unit database) on first use of a unit.
  *
- * The path should be an absolute path to the udunits2.xml file that was included with the HARP installation.
+ * The path should be an absolute path to the main udunits2 xml file of the unit database.
  *
  * Specifying a path using this function will prevent HARP from using the UDUNITS2_XML_PATH environment variable.
  * If you still want HARP to acknowledge the UDUNITS2_XML_PATH environment variable then use something like this in
@@ -136,6 +138,7 @@ LIBHARP_API int harp_set_udunits2_xml_path(const char *path)
         free(harp_udunits2_xml_path);
         harp_udunits2_xml_path = NULL;
     }
+    harp_udunits2_xml_path_is_bundled = 0;
     if (path == NULL)
     {
         return 0;
@@ -155,12 +158,13 @@ LIBHARP_API int harp_set_udunits2_xml_path(const char *path)
  * \ingroup harp_general
  * This function should be called before harp_init() is called.
  *
- * The HARP C library uses the udunits2 library to perform unit conversions. The xml configuration files for udunits2
- * are included with a HARP installation and a default absolute path to the main xml file is built into the library.
+ * The HARP C library uses the udunits2 library to perform unit conversions. The unit database that is included with
+ * HARP is compiled into the library. The xml configuration files of this database are also included with a HARP
+ * installation and this function can be used to locate them.
  *
- * If the HARP installation ends up in a different location on disk compared to what was provided at build time then
- * you will either need to set the UDUNITS2_XML_PATH environment variable or call one of the functions
- * harp_set_udunits2_xml_path() or harp_set_udunits2_xml_path_conditional() to set the path programmatically.
+ * A path that is set with this function is only used as a fallback in case the compiled-in unit database can not be
+ * initialized. To use a different unit database, use harp_set_udunits2_xml_path() or the UDUNITS2_XML_PATH
+ * environment variable instead.
  *
  * This function will try to find the file with filename \a file in the provided searchpath \a searchpath.
  * The first directory in the searchpath where the file \a file exists will be appended with the relative location
@@ -231,6 +235,7 @@ LIBHARP_API int harp_set_udunits2_xml_path_conditional(const char *file, const c
             return -1;
         }
         free(path);
+        harp_udunits2_xml_path_is_bundled = 1;
     }
 
     return 0;
@@ -242,7 +247,16 @@ static int unit_system_init(void)
     {
         ut_set_error_message_handler(ut_ignore);
 
-        unit_system = ut_read_xml(harp_udunits2_xml_path);
+        /* only read the xml files when a unit database other than the bundled one was requested */
+        if ((harp_udunits2_xml_path == NULL || harp_udunits2_xml_path_is_bundled) &&
+            getenv("UDUNITS2_XML_PATH") == NULL)
+        {
+            unit_system = ut_read_builtin();
+        }
+        if (unit_system == NULL)
+        {
+            unit_system = ut_read_xml(harp_udunits2_xml_path);
+        }
         if (unit_system == NULL)
         {
             handle_udunits_error();
@@ -265,6 +279,7 @@ static void unit_system_done(void)
             free(harp_udunits2_xml_path);
             harp_udunits2_xml_path = NULL;
         }
+        harp_udunits2_xml_path_is_bundled = 0;
     }
 }
 
@@ -318,6 +318,50 @@ int harp_variable_set_enumeration_values_using_flag_meanings(harp_variable *vari
     return 0;
 }
 
+/* Rearrange a dimension of a (non-string) variable into a newly allocated data block using multiple threads. */
+static int rearrange_dimension_parallel(harp_variable *variable, int dim_index, long num_dim_elements,
+                                        const long *dim_element_ids, long num_groups, long num_block_elements)
+{
+    long element_size = harp_get_size_for_type(variable->data_type);
+    long block_size = num_block_elements * element_size;
+    long new_num_elements = num_groups * num_dim_elements * num_block_elements;
+    char *source_data = (char *)variable->data.ptr;
+    char *target_data;
+    long i;
+
+    assert(variable->data_type != harp_type_string);
+
+    target_data = (char *)malloc((size_t)new_num_elements * element_size);
+    if (target_data == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       new_num_elements * element_size, __FILE__, __LINE__);
+        return -1;
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) num_threads(harp_get_num_threads())
+#endif
+    for (i = 0; i < num_groups * num_dim_elements; i++)
+    {
+        long group = i / num_dim_elements;
+        long to_id = i % num_dim_elements;
+
+        memcpy(&target_data[i * block_size],
+               &source_data[(group * variable->dimension[dim_index] + dim_element_ids[to_id]) * block_size],
+               (size_t)block_size);
+    }
+
+    free(variable->data.ptr);
+    variable->data.ptr = target_data;
+
+    /* update variable properties */
+    variable->num_elements = new_num_elements;
+    variable->dimension[dim_index] = num_dim_elements;
+
+    return 0;
+}
+
 /** Rearrange the data of a variable in one dimension.
  * This function allows data of a variable to be rearranged according to the order of the indices in dim_element_id.
  * The number of indices (num_dim_elements) in dim_element_id does not have to correspond to the number of
@@ -418,6 +462,16 @@ int harp_variable_rearrange_dimension(harp_variable *variable, int dim_index, lo
     element_size = harp_get_size_for_type(variable->data_type);
     filter_block_size = num_block_elements * element_size;
 
+    /* Large variables are rearranged out-of-place using multiple threads (strings are always rearranged in-place, such
+     * that duplicated strings are handled by a single code path).
+     */
+    if (variable->data_type != harp_type_string && harp_get_num_threads() > 1 &&
+        variable->num_elements * element_size >= HARP_PARALLEL_MIN_VARIABLE_SIZE)
+    {
+        return rearrange_dimension_parallel(variable, dim_index, num_dim_elements, dim_element_ids, num_groups,
+                                            num_block_elements);
+    }
+
     /* If num_dim_elements > dimension[dim_index] then increase the memory for variable->data. */
     if (num_dim_elements > variable->dimension[dim_index])
     {
@@ -504,8 +558,8 @@ int harp_variable_rearrange_dimension(harp_variable *variable, int dim_index, lo
             memmove(to_ptr, from_ptr, (size_t)(variable->dimension[dim_index] * filter_block_size));
         }
 
-        /* remove all strings for blocks that will be removed */
-        if (variable->data_type == harp_type_string)
+        /* remove all strings for blocks that will be removed (strings in a string arena are released with the arena) */
+        if (variable->data_type == harp_type_string && variable->string_arena == NULL)
         {
             long j;
 
@@ -598,11 +652,11 @@ int harp_variable_rearrange_dimension(harp_variable *variable, int dim_index, lo
                     memcpy(&to_ptr[to_id * filter_block_size], &to_ptr[from_id * filter_block_size],
                            (size_t)filter_block_size);
 
-                    if (variable->data_type == harp_type_string)
+                    if (variable->data_type == harp_type_string && variable->string_arena == NULL)
                     {
                         char **string_data;
 
-                        /* duplicate all strings in the block */
+                        /* duplicate all strings in the block (strings in a string arena can be shared) */
                         string_data = (char **)&to_ptr[to_id * filter_block_size];
                         for (k = 0; k < num_block_elements; k++)
                         {
@@ -768,8 +822,8 @@ int harp_variable_filter_dimension(harp_variable *variable, int dim_index, const
             }
             else
             {
-                /* remove all strings for the items that get discarded */
-                if (variable->data_type == harp_type_string)
+                /* remove all strings for the items that get discarded (unless they are part of a string arena) */
+                if (variable->data_type == harp_type_string && variable->string_arena == NULL)
                 {
                     char **string_data = (char **)from_ptr;
                     long k;
@@ -865,7 +919,7 @@ int harp_variable_resize_dimension(harp_variable *variable, int dim_index, long
             long from_offset = i * variable->dimension[dim_index] * num_block_elements;
             long to_offset = i * length * num_block_elements;
 
-            if (variable->data_type == harp_type_string)
+            if (variable->data_type == harp_type_string && variable->string_arena == NULL)
             {
                 /* remove trailing strings */
                 for (j = length * num_block_elements; j < variable->dimension[dim_index] * num_block_elements; j++)
@@ -1058,11 +1112,13 @@ int harp_variable_add_dimension(harp_variable *variable, int dim_index, harp_dim
 
             memmove(to_ptr, from_ptr, (size_t)(num_block_elements * element_size));
 
-            if (variable->data_type == harp_type_string && j != 0)
+            if (variable->data_type == harp_type_string && variable->string_arena == NULL && j != 0)
             {
                 char **string_data = (char **)to_ptr;
 
-                /* duplicate all strings in the block (except for the first block) */
+                /* duplicate all strings in the block (except for the first block); strings in a string arena are
+                 * shared instead
+                 */
                 for (k = 0; k < num_block_elements; k++)
                 {
                     if (string_data[k] != NULL)
@@ -1289,6 +1345,7 @@ LIBHARP_API int harp_variable_new(const char *name, harp_data_type data_type, in
     variable->unit = NULL;
     variable->num_enum_values = 0;
     variable->enum_name = NULL;
+    variable->string_arena = NULL;
 
     variable->num_elements = 1;
     for (i = 0; i < num_dimensions; i++)
@@ -1327,6 +1384,48 @@ LIBHARP_API int harp_variable_new(const char *name, harp_data_type data_type, in
     return 0;
 }
 
+/* Copy all (non-NULL) strings of string_data into a newly allocated string arena and let the elements of string_data
+ * point to these copies. The previous storage of the strings is not released. On failure string_data is left
+ * unmodified.
+ */
+static int copy_strings_to_arena(long num_elements, char **string_data, char **arena)
+{
+    size_t size = 0;
+    char *next;
+    long i;
+
+    for (i = 0; i < num_elements; i++)
+    {
+        if (string_data[i] != NULL)
+        {
+            size += strlen(string_data[i]) + 1;
+        }
+    }
+
+    *arena = malloc(size > 0 ? size : 1);
+    if (*arena == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       size > 0 ? size : 1, __FILE__, __LINE__);
+        return -1;
+    }
+
+    next = *arena;
+    for (i = 0; i < num_elements; i++)
+    {
+        if (string_data[i] != NULL)
+        {
+            size_t length = strlen(string_data[i]) + 1;
+
+            memcpy(next, string_data[i], length);
+            string_data[i] = next;
+            next += length;
+        }
+    }
+
+    return 0;
+}
+
 /** Delete variable.
  * Remove variable and all attached attributes.
  * \param variable HARP variable
@@ -1343,7 +1442,7 @@ LIBHARP_API void harp_variable_delete(harp_variable *variable)
     }
     if (variable->data.ptr != NULL)
     {
-        if (variable->data_type == harp_type_string)
+        if (variable->data_type == harp_type_string && variable->string_arena == NULL)
         {
             long i;
 
@@ -1357,6 +1456,10 @@ LIBHARP_API void harp_variable_delete(harp_variable *variable)
         }
         free(variable->data.ptr);
     }
+    if (variable->string_arena != NULL)
+    {
+        free(variable->string_arena);
+    }
     if (variable->description != NULL)
     {
         free(variable->description);
@@ -1418,6 +1521,7 @@ LIBHARP_API int harp_variable_copy(const harp_variable *other_variable, harp_var
     variable->valid_max = other_variable->valid_max;
     variable->num_enum_values = 0;
     variable->enum_name = NULL;
+    variable->string_arena = NULL;
 
     variable->name = strdup(other_variable->name);
     if (variable->name == NULL)
@@ -1484,11 +1588,28 @@ LIBHARP_API int harp_variable_copy(const harp_variable *other_variable, harp_var
         harp_variable_delete(variable);
         return -1;
     }
-    if (variable->data_type == harp_type_string)
+    if (variable->data_type == harp_type_string && harp_option_string_arena)
+    {
+        /* store all strings of the copy in a single string arena */
+        memcpy(variable->data.ptr, other_variable->data.ptr,
+               (size_t)variable->num_elements * harp_get_size_for_type(harp_type_string));
+        if (copy_strings_to_arena(variable->num_elements, variable->data.string_data, &variable->string_arena) != 0)
+        {
+            /* the string elements still point to the strings of other_variable */
+            memset(variable->data.ptr, 0, (size_t)variable->num_elements * harp_get_size_for_type(harp_type_string));
+            harp_variable_delete(variable);
+            return -1;
+        }
+    }
+    else if (variable->data_type == harp_type_string)
     {
         memset(variable->data.ptr, 0, (size_t)variable->num_elements * harp_get_size_for_type(harp_type_string));
         for (i = 0; i < variable->num_elements; i++)
         {
+            if (other_variable->data.string_data[i] == NULL)
+            {
+                continue;
+            }
             variable->data.string_data[i] = strdup(other_variable->data.string_data[i]);
             if (variable->data.string_data[i] == NULL)
             {
@@ -1538,21 +1659,13 @@ LIBHARP_API int harp_variable_copy_attributes(const harp_variable *variable, har
     return 0;
 }
 
-/** Append one variable to another.
- * Both variables need to have the 'time' dimension as first dimension.
- * And all non-time dimensions need to be the same for both variables.
- * \param variable Variable to which data should be appended.
- * \param other_variable Variable that should be appended.
- * \return
- *   \arg \c 0, Success.
- *   \arg \c -1, Error occurred (check #harp_errno).
+/* Check whether \a other_variable can be appended to \a variable.
+ * Both variables need to have the same name, data type, and dimensions (except for the length of the time dimension,
+ * which should be the first dimension for both variables).
  */
-LIBHARP_API int harp_variable_append(harp_variable *variable, const harp_variable *other_variable)
+int harp_variable_check_appendable(const harp_variable *variable, const harp_variable *other_variable)
 {
-    void *data;
-    long element_size;
-    long new_num_elements;
-    long i;
+    int i;
 
     if (strcmp(variable->name, other_variable->name) != 0)
     {
@@ -1599,6 +1712,35 @@ LIBHARP_API int harp_variable_append(harp_variable *variable, const harp_variabl
         }
     }
 
+    return 0;
+}
+
+/** Append one variable to another.
+ * Both variables need to have the 'time' dimension as first dimension.
+ * And all non-time dimensions need to be the same for both variables.
+ * \param variable Variable to which data should be appended.
+ * \param other_variable Variable that should be appended.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_variable_append(harp_variable *variable, const harp_variable *other_variable)
+{
+    void *data;
+    long element_size;
+    long new_num_elements;
+    long i;
+
+    if (harp_variable_check_appendable(variable, other_variable) != 0)
+    {
+        return -1;
+    }
+    /* the appended strings are allocated individually, so this should also be the case for the existing strings */
+    if (harp_variable_materialize_string_data(variable) != 0)
+    {
+        return -1;
+    }
+
     element_size = harp_get_size_for_type(variable->data_type);
     new_num_elements = variable->num_elements + other_variable->num_elements;
     data = realloc(variable->data.ptr, (size_t)new_num_elements * element_size);
@@ -1616,6 +1758,10 @@ LIBHARP_API int harp_variable_append(harp_variable *variable, const harp_variabl
                (size_t)other_variable->num_elements * element_size);
         for (i = 0; i < other_variable->num_elements; i++)
         {
+            if (other_variable->data.string_data[i] == NULL)
+            {
+                continue;
+            }
             variable->data.string_data[variable->num_elements + i] = strdup(other_variable->data.string_data[i]);
             if (variable->data.string_data[variable->num_elements + i] == NULL)
             {
@@ -1637,7 +1783,94 @@ LIBHARP_API int harp_variable_append(harp_variable *variable, const harp_variabl
     return 0;
 }
 
+/* Append one variable to another while taking over the string data of the other variable.
+ * This is the same as harp_variable_append(), except that for variables of type string the strings of
+ * other_variable are moved instead of duplicated (the string elements of other_variable will be set to NULL).
+ * This avoids a strdup()/free() per element when other_variable is deleted after the append.
+ * Strings of other_variable that are stored in a string arena are duplicated (as with harp_variable_append()).
+ */
+int harp_variable_append_move(harp_variable *variable, harp_variable *other_variable)
+{
+    void *data;
+    long element_size;
+    long new_num_elements;
+
+    if (variable->data_type != harp_type_string || other_variable->string_arena != NULL)
+    {
+        return harp_variable_append(variable, other_variable);
+    }
+
+    if (harp_variable_check_appendable(variable, other_variable) != 0)
+    {
+        return -1;
+    }
+    if (harp_variable_materialize_string_data(variable) != 0)
+    {
+        return -1;
+    }
+
+    element_size = harp_get_size_for_type(variable->data_type);
+    new_num_elements = variable->num_elements + other_variable->num_elements;
+    data = realloc(variable->data.ptr, (size_t)new_num_elements * element_size);
+    if (data == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       (size_t)new_num_elements * element_size, __FILE__, __LINE__);
+        return -1;
+    }
+    variable->data.ptr = data;
+
+    memcpy(&variable->data.string_data[variable->num_elements], other_variable->data.string_data,
+           (size_t)other_variable->num_elements * element_size);
+    memset(other_variable->data.string_data, 0, (size_t)other_variable->num_elements * element_size);
+
+    variable->dimension[0] += other_variable->dimension[0];
+    variable->num_elements += other_variable->num_elements;
+
+    return 0;
+}
+
+/** Detach the data block from a variable.
+ * Ownership of the data block of the variable is transferred to the caller, which then becomes responsible for
+ * releasing the memory using harp_free(). This allows the data to be handed over to another owner without having to
+ * make a copy. After this call the variable no longer has a data block and the only valid operation on the variable
+ * is harp_variable_delete().
+ * This function is not supported for variables of type string.
+ * \param variable Variable from which the data block should be detached.
+ * \param data Pointer to the location where the pointer to the data block will be stored.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_variable_detach_data(harp_variable *variable, void **data)
+{
+    if (variable == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "variable is NULL (%s:%u)", __FILE__, __LINE__);
+        return -1;
+    }
+    if (data == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "data is NULL (%s:%u)", __FILE__, __LINE__);
+        return -1;
+    }
+    if (variable->data_type == harp_type_string)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "cannot detach data of variable '%s' of type string",
+                       variable->name);
+        return -1;
+    }
+
+    *data = variable->data.ptr;
+    variable->data.ptr = NULL;
+
+    return 0;
+}
+
 /** Change the name of a variable.
+ * A variable that is part of a product should not be renamed directly (the product keeps an index on the names of its
+ * variables). Detach the variable from the product with harp_product_detach_variable() first, rename it, and then add
+ * it to the product again with harp_product_add_variable().
  * \param variable The variable for which the name should be changed.
  * \param name The new name of the variable.
  * \return
@@ -1646,6 +1879,8 @@ LIBHARP_API int harp_variable_append(harp_variable *variable, const harp_variabl
  */
 LIBHARP_API int harp_variable_rename(harp_variable *variable, const char *name)
 {
+    char *name_copy;
+
     if (variable == NULL)
     {
         harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "variable is NULL (%s:%u)", __FILE__, __LINE__);
@@ -1657,20 +1892,19 @@ LIBHARP_API int harp_variable_rename(harp_variable *variable, const char *name)
         return -1;
     }
 
-    /* Set variable name */
-    if (variable->name != NULL)
-    {
-        free(variable->name);
-    }
-
-    variable->name = strdup(name);
-
-    if (variable->name == NULL)
+    /* Set variable name (the old name is kept if the new name can not be allocated) */
+    name_copy = strdup(name);
+    if (name_copy == NULL)
     {
         harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not duplicate string) (%s:%u)", __FILE__,
                        __LINE__);
         return -1;
     }
+    if (variable->name != NULL)
+    {
+        free(variable->name);
+    }
+    variable->name = name_copy;
 
     return 0;
 }
@@ -1899,6 +2133,10 @@ LIBHARP_API int harp_variable_set_string_data_element(harp_variable *variable, l
         harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "str is NULL (%s:%u)", __FILE__, __LINE__);
         return -1;
     }
+    if (harp_variable_materialize_string_data(variable) != 0)
+    {
+        return -1;
+    }
 
     if (variable->data.string_data[index] != NULL)
     {
@@ -1917,6 +2155,69 @@ LIBHARP_API int harp_variable_set_string_data_element(harp_variable *variable, l
     return 0;
 }
 
+/** Make sure that each string element of a variable is individually allocated.
+ * If the strings of a variable are stored in a string arena (see harp_set_option_string_arena()) then each string is
+ * copied into its own allocated block of memory and the string arena is released. After this call the elements of
+ * the string_data array of the variable can be freed and replaced individually.
+ * For variables that are not of type string or that do not use a string arena this function does nothing.
+ * \param variable Variable whose string data should be materialized.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_variable_materialize_string_data(harp_variable *variable)
+{
+    char **string_data;
+    long i;
+
+    if (variable == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "variable is NULL (%s:%u)", __FILE__, __LINE__);
+        return -1;
+    }
+    if (variable->data_type != harp_type_string || variable->string_arena == NULL)
+    {
+        return 0;
+    }
+
+    /* the copies are first stored in a separate array, such that the variable is left unmodified on failure */
+    string_data = calloc(variable->num_elements > 0 ? variable->num_elements : 1, sizeof(char *));
+    if (string_data == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       variable->num_elements * sizeof(char *), __FILE__, __LINE__);
+        return -1;
+    }
+    for (i = 0; i < variable->num_elements; i++)
+    {
+        if (variable->data.string_data[i] != NULL)
+        {
+            string_data[i] = strdup(variable->data.string_data[i]);
+            if (string_data[i] == NULL)
+            {
+                harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not duplicate string) (%s:%u)", __FILE__,
+                               __LINE__);
+                while (i > 0)
+                {
+                    i--;
+                    if (string_data[i] != NULL)
+                    {
+                        free(string_data[i]);
+                    }
+                }
+                free(string_data);
+                return -1;
+            }
+        }
+    }
+    free(variable->data.ptr);
+    variable->data.string_data = string_data;
+    free(variable->string_arena);
+    variable->string_arena = NULL;
+
+    return 0;
+}
+
 /** Convert the data for the variable such that it matches the given data type.
  * The memory for the block holding the data for the attribute will be resized to match the new data type if needed.
  * You cannot convert string data to numeric data or vice-versa. Conversion from floating point to integer data (or
@@ -38,9 +38,15 @@
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #define MAX_NAME_LENGTH 128
 
+/* minimum number of multiply-add operations before smoothing is spread over multiple threads */
+#define SMOOTH_MIN_PARALLEL_WORK 100000
+
 typedef enum profile_resample_type_enum
 {
     profile_resample_skip,
@@ -853,6 +859,127 @@ static long get_unpadded_vector_length(double *vector, long vector_length)
     return vector_length;
 }
 
+/* dot product using multiple accumulators (this allows the compiler to vectorize the loop) */
+static double dot_product(const double *a, const double *b, long length)
+{
+    double sum0 = 0;
+    double sum1 = 0;
+    double sum2 = 0;
+    double sum3 = 0;
+    long i;
+
+    for (i = 0; i + 4 <= length; i += 4)
+    {
+        sum0 += a[i] * b[i];
+        sum1 += a[i + 1] * b[i + 1];
+        sum2 += a[i + 2] * b[i + 2];
+        sum3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < length; i++)
+    {
+        sum0 += a[i] * b[i];
+    }
+
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
+/* dot product of a with a compacted vector b, where b[i] corresponds to a[index[i]] */
+static double compact_dot_product(const double *a, const long *index, const double *b, long length)
+{
+    double sum0 = 0;
+    double sum1 = 0;
+    long i;
+
+    for (i = 0; i + 2 <= length; i += 2)
+    {
+        sum0 += a[index[i]] * b[i];
+        sum1 += a[index[i + 1]] * b[i + 1];
+    }
+    if (i < length)
+    {
+        sum0 += a[index[i]] * b[i];
+    }
+
+    return sum0 + sum1;
+}
+
+/* Smooth all blocks of the profiles of a single sample.
+ * The profiles (minus apriori) of all blocks are first compacted to their valid (non-NaN) levels. Each row of the
+ * averaging kernel is then applied to all blocks, such that the averaging kernel is only traversed once per sample.
+ * The buffers vector and valid_index need to be able to hold num_blocks * max_vertical_elements elements and num_valid
+ * needs to be able to hold num_blocks elements.
+ */
+static void smooth_vertical_sample(double *data, long num_blocks, long max_vertical_elements,
+                                   long num_vertical_elements, const double *avk, const double *apriori,
+                                   double *vector, long *valid_index, long *num_valid)
+{
+    long i, l;
+
+    for (l = 0; l < num_blocks; l++)
+    {
+        const double *block_data = &data[l * max_vertical_elements];
+        double *block_vector = &vector[l * max_vertical_elements];
+        long *block_index = &valid_index[l * max_vertical_elements];
+        long count = 0;
+
+        for (i = 0; i < num_vertical_elements; i++)
+        {
+            double value = block_data[i];
+
+            if (apriori != NULL)
+            {
+                value -= apriori[i];
+            }
+            if (!harp_isnan(value))
+            {
+                block_index[count] = i;
+                block_vector[count] = value;
+                count++;
+            }
+        }
+        num_valid[l] = count;
+    }
+
+    for (i = 0; i < num_vertical_elements; i++)
+    {
+        const double *avk_row = &avk[i * max_vertical_elements];
+
+        for (l = 0; l < num_blocks; l++)
+        {
+            double *block_data = &data[l * max_vertical_elements];
+            double value = block_data[i];
+
+            /* levels for which the profile (or apriori) is NaN are left as is */
+            if (apriori != NULL)
+            {
+                value -= apriori[i];
+            }
+            if (harp_isnan(value))
+            {
+                continue;
+            }
+
+            /* since level i is valid there is at least one valid level in the block */
+            if (num_valid[l] == num_vertical_elements)
+            {
+                value = dot_product(avk_row, &vector[l * max_vertical_elements], num_vertical_elements);
+            }
+            else
+            {
+                value = compact_dot_product(avk_row, &valid_index[l * max_vertical_elements],
+                                            &vector[l * max_vertical_elements], num_valid[l]);
+            }
+
+            /* add the apriori again */
+            if (apriori != NULL)
+            {
+                value += apriori[i];
+            }
+            block_data[i] = value;
+        }
+    }
+}
+
 /** \addtogroup harp_variable
  * @{
  */
@@ -878,10 +1005,10 @@ static long get_unpadded_vector_length(double *vector, long vector_length)
 LIBHARP_API int harp_variable_smooth_vertical(harp_variable *variable, harp_variable *vertical_axis,
                                               harp_variable *averaging_kernel, harp_variable *apriori)
 {
-    double *vector = NULL;
     long max_vertical_elements;
+    long num_samples;
     long num_blocks;
-    long k, l;
+    int out_of_memory = 0;
 
     if (variable == NULL)
     {
@@ -971,84 +1098,84 @@ LIBHARP_API int harp_variable_smooth_vertical(harp_variable *variable, harp_vari
         }
     }
 
-    /* allocate memory for the temporary vertical profile vector */
-    vector = malloc(max_vertical_elements * sizeof(double));
-    if (!vector)
+    /* calculate the number of blocks in this datetime slice of the variable */
+    num_samples = variable->dimension[0];
+    if (num_samples == 0 || max_vertical_elements == 0)
     {
-        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
-                       max_vertical_elements * sizeof(double), __FILE__, __LINE__);
-        return -1;
+        return 0;
     }
+    num_blocks = variable->num_elements / num_samples / max_vertical_elements;
 
-    /* calculate the number of blocks in this datetime slice of the variable */
-    num_blocks = variable->num_elements / variable->dimension[0] / max_vertical_elements;
-
-    for (k = 0; k < variable->dimension[0]; k++)
+    /* samples are independent, so they can be smoothed in parallel (each thread uses its own buffers) */
+#ifdef _OPENMP
+#pragma omp parallel if (num_samples > 1 && \
+                         num_samples * num_blocks * max_vertical_elements * max_vertical_elements > \
+                         SMOOTH_MIN_PARALLEL_WORK) num_threads(harp_get_num_threads())
+#endif
     {
-        long num_vertical_elements = max_vertical_elements;
+        double *vector;
+        long *valid_index;
+        long *num_valid;
+        long k;
 
-        if (vertical_axis != NULL)
+        vector = malloc(num_blocks * max_vertical_elements * sizeof(double));
+        valid_index = malloc(num_blocks * max_vertical_elements * sizeof(long));
+        num_valid = malloc(num_blocks * sizeof(long));
+        if (vector == NULL || valid_index == NULL || num_valid == NULL)
         {
-            num_vertical_elements =
-                get_unpadded_vector_length(&vertical_axis->data.double_data[k * max_vertical_elements],
-                                           max_vertical_elements);
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            out_of_memory = 1;
         }
 
-        for (l = 0; l < num_blocks; l++)
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (k = 0; k < num_samples; k++)
         {
-            long blockoffset = (k * num_blocks + l) * max_vertical_elements;
-            long i, j;
+            long num_vertical_elements = max_vertical_elements;
 
-            /* store profile in temporary vector */
-            for (i = 0; i < num_vertical_elements; i++)
+            if (vector == NULL || valid_index == NULL || num_valid == NULL)
             {
-                vector[i] = variable->data.double_data[blockoffset + i];
+                continue;
             }
-
-            /* subtract a priori */
-            if (apriori != NULL)
+            if (vertical_axis != NULL)
             {
-                for (i = 0; i < num_vertical_elements; i++)
-                {
-                    vector[i] -= apriori->data.double_data[k * max_vertical_elements + i];
-                }
+                num_vertical_elements =
+                    get_unpadded_vector_length(&vertical_axis->data.double_data[k * max_vertical_elements],
+                                               max_vertical_elements);
             }
 
-            /* multiply by avk */
-            for (i = 0; i < num_vertical_elements; i++)
-            {
-                if (!harp_isnan(vector[i]))
-                {
-                    long avk_offset = (k * max_vertical_elements + i) * max_vertical_elements;
-                    long num_valid = 0;
-
-                    variable->data.double_data[blockoffset + i] = 0;
-                    for (j = 0; j < num_vertical_elements; j++)
-                    {
-                        if (!harp_isnan(vector[j]))
-                        {
-                            variable->data.double_data[blockoffset + i] +=
-                                averaging_kernel->data.double_data[avk_offset + j] * vector[j];
-                            num_valid++;
-                        }
-                    }
-
-                    /* add the apriori again */
-                    if (apriori != NULL)
-                    {
-                        variable->data.double_data[blockoffset + i] +=
-                            apriori->data.double_data[k * max_vertical_elements + i];
-                    }
-                    else if (num_valid == 0)
-                    {
-                        variable->data.double_data[blockoffset + i] = harp_nan();
-                    }
-                }
-            }
+            smooth_vertical_sample(&variable->data.double_data[k * num_blocks * max_vertical_elements], num_blocks,
+                                   max_vertical_elements, num_vertical_elements,
+                                   &averaging_kernel->data.double_data[k * max_vertical_elements *
+                                                                       max_vertical_elements],
+                                   apriori == NULL ? NULL : &apriori->data.double_data[k * max_vertical_elements],
+                                   vector, valid_index, num_valid);
+        }
+
+        if (vector != NULL)
+        {
+            free(vector);
+        }
+        if (valid_index != NULL)
+        {
+            free(valid_index);
+        }
+        if (num_valid != NULL)
+        {
+            free(num_valid);
         }
     }
 
-    free(vector);
+    if (out_of_memory)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       num_blocks * max_vertical_elements * (sizeof(double) + sizeof(long)) +
+                       num_blocks * sizeof(long), __FILE__, __LINE__);
+        return -1;
+    }
 
     return 0;
 }
@@ -1426,7 +1553,7 @@ LIBHARP_API int harp_product_smooth_vertical_with_collocated_dataset(harp_produc
         }
         else
         {
-            if (harp_product_append(merged_product, collocated_product) != 0)
+            if (harp_product_append_move(merged_product, collocated_product) != 0)
             {
                 harp_product_delete(collocated_product);
                 harp_product_delete(merged_product);
@@ -2050,7 +2177,7 @@ LIBHARP_API int harp_product_get_smoothed_column_using_collocated_dataset(harp_p
         }
         else
         {
-            if (harp_product_append(merged_product, collocated_product) != 0)
+            if (harp_product_append_move(merged_product, collocated_product) != 0)
             {
                 harp_product_delete(collocated_product);
                 harp_product_delete(merged_product);
@@ -30,6 +30,8 @@
  */
 
 #include "harp-internal.h"
+#include "harp-ingestion.h"
+#include "harp-program.h"
 
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -42,6 +44,9 @@
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "coda.h"
 
@@ -55,6 +60,9 @@ int harp_option_enable_aux_afgl86 = 0;
 int harp_option_enable_aux_usstd76 = 0;
 int harp_option_hdf5_compression = 0;
 int harp_option_regrid_out_of_bounds = 0;
+int harp_option_collocated_product_cache_size = 256;
+int harp_option_num_threads = 0;
+int harp_option_string_arena = 0;
 
 typedef enum file_format_enum
 {
@@ -172,6 +180,35 @@ static int auxiliary_data_init(void)
     return 0;
 }
 
+/* HARP_TRACE=1 enables tracing; any other value (except 0) is also used as the path of the Chrome trace file */
+static void trace_init(void)
+{
+    const char *trace = getenv("HARP_TRACE");
+
+    if (trace != NULL && *trace != '\0' && strcmp(trace, "0") != 0)
+    {
+        harp_option_trace = 1;
+    }
+}
+
+static void trace_done(void)
+{
+    const char *trace = getenv("HARP_TRACE");
+
+    if (trace != NULL && *trace != '\0' && strcmp(trace, "0") != 0)
+    {
+        harp_trace_print_summary(NULL);
+        if (strcmp(trace, "1") != 0)
+        {
+            if (harp_trace_write_chrome_trace(trace) != 0)
+            {
+                fprintf(stderr, "WARNING: %s\n", harp_errno_to_string(harp_errno));
+            }
+        }
+    }
+    harp_trace_clear();
+}
+
 /** \defgroup harp_general HARP General
  * The HARP General module contains all general and miscellaneous functions and procedures of HARP.
  */
@@ -450,6 +487,128 @@ LIBHARP_API int harp_get_option_regrid_out_of_bounds(void)
     return harp_option_regrid_out_of_bounds;
 }
 
+/** Set the maximum amount of memory to use for caching collocated products.
+ * Operations that use a collocated dataset (such as smoothing and regridding against collocated products) import the
+ * products of the collocated dataset that they need. These products are kept in memory, such that a product that is
+ * needed again (e.g. by the next product that is processed) does not have to be imported again. Once the cache would
+ * exceed its maximum size, the least recently used products are removed from the cache.
+ * The default maximum size is 256MB.
+ * \param size The maximum total size of the cached products in MB, or 0 to disable the cache.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_set_option_collocated_product_cache_size(int size)
+{
+    if (size < 0)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "size argument (%d) is not valid (%s:%u)", size, __FILE__,
+                       __LINE__);
+        return -1;
+    }
+
+    harp_option_collocated_product_cache_size = size;
+    harp_collocated_product_cache_trim();
+
+    return 0;
+}
+
+/** Retrieve the maximum amount of memory (in MB) that is used for caching collocated products.
+ * \see harp_set_option_collocated_product_cache_size()
+ * \return The maximum total size of the cached products in MB (0 means that the cache is disabled).
+ */
+LIBHARP_API int harp_get_option_collocated_product_cache_size(void)
+{
+    return harp_option_collocated_product_cache_size;
+}
+
+/** Set the maximum number of threads that HARP may use for parallel computations.
+ * Operations such as filtering and rearranging the dimensions of a product process (parts of) variables in parallel.
+ * This option only has an effect if HARP was built with OpenMP support.
+ * The default value of 0 means that the OpenMP default is used (which can be set with the OMP_NUM_THREADS environment
+ * variable). Setting this option to 1 disables parallel processing. Results do not depend on the number of threads.
+ * \param num_threads The maximum number of threads, or 0 to use the OpenMP default.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_set_option_num_threads(int num_threads)
+{
+    if (num_threads < 0)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "num_threads argument (%d) is not valid (%s:%u)", num_threads,
+                       __FILE__, __LINE__);
+        return -1;
+    }
+
+    harp_option_num_threads = num_threads;
+
+    return 0;
+}
+
+/** Retrieve the maximum number of threads that HARP may use for parallel computations.
+ * \see harp_set_option_num_threads()
+ * \return The maximum number of threads (0 means that the OpenMP default is used).
+ */
+LIBHARP_API int harp_get_option_num_threads(void)
+{
+    return harp_option_num_threads;
+}
+
+/** Enable/disable the use of string arenas for variables of type string.
+ * By default, each string element of a variable of type string is allocated individually. If this option is enabled,
+ * operations that create many strings at once (importing a netCDF product, copying a variable) store all strings of a
+ * variable in a single block of memory (a string arena), and filtering and rearranging such a variable only moves the
+ * string pointers around. This avoids a malloc()/free() per string element.
+ * The elements of the string_data array of a variable that uses a string arena should not be freed or replaced
+ * directly. Code that modifies string elements directly should first call harp_variable_materialize_string_data().
+ * HARP functions that modify string elements (such as harp_variable_set_string_data_element()) do this automatically.
+ * \param enable
+ *   \arg 0: Allocate each string individually (default).
+ *   \arg 1: Use string arenas.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_set_option_string_arena(int enable)
+{
+    if (enable != 0 && enable != 1)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "enable argument (%d) is not valid (%s:%u)", enable, __FILE__,
+                       __LINE__);
+        return -1;
+    }
+
+    harp_option_string_arena = enable;
+
+    return 0;
+}
+
+/** Retrieve the current setting for the use of string arenas.
+ * \see harp_set_option_string_arena()
+ * \return
+ *   \arg \c 0, Each string is allocated individually.
+ *   \arg \c 1, String arenas are used.
+ */
+LIBHARP_API int harp_get_option_string_arena(void)
+{
+    return harp_option_string_arena;
+}
+
+/* Return the number of threads to use for a parallel region (always 1 if HARP was built without OpenMP support). */
+int harp_get_num_threads(void)
+{
+#ifdef _OPENMP
+    if (harp_option_num_threads > 0)
+    {
+        return harp_option_num_threads;
+    }
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
 /** Initializes the HARP C library.
  * This function should be called before any other HARP C library function is called (except for
  * harp_set_coda_definition_path(), harp_set_coda_definition_path_conditional(), and harp_set_warning_handler()).
@@ -483,6 +642,7 @@ LIBHARP_API int harp_init(void)
         {
             return -1;
         }
+        trace_init();
     }
 
     harp_init_counter++;
@@ -508,37 +668,32 @@ LIBHARP_API void harp_done(void)
         harp_init_counter--;
         if (harp_init_counter == 0)
         {
+            harp_collocated_product_cache_done();
             harp_unit_done();
             harp_derived_variable_list_done();
             harp_ingestion_done();
+            trace_done();
         }
     }
 }
 
+/** Free a memory block that was allocated by the HARP C library.
+ * This function should be used to release memory of which ownership was transferred to the caller by a HARP function
+ * (such as the data block returned by harp_variable_detach_data()). This makes sure that the memory is released by the
+ * same C runtime that allocated it.
+ * \param ptr Pointer to the memory block that should be freed (can be NULL).
+ */
+LIBHARP_API void harp_free(void *ptr)
+{
+    free(ptr);
+}
+
 /** @} */
 
-/** Import a product from a file.
- * \ingroup harp_product
- * This will first try to import the file as an HDF4, HDF5, or netCDF file that complies to the HARP Data Format.
- * If the file is not stored using the HARP format then it will try to import it using one of the available ingestion
- * modules.
- * The \a options parameter is optional (can be NULL) and describes the ingestion options. The parameter is only
- * applicable if the file is not already using the HARP format and needs to be converted using one of the ingestion
- * modules.
- * The \a operations parameter is optional (can be NULL) and provides the list of operations that will be performed as
- * part of the import. Some operations, such as filters, can already be performed as part of an import and this may thus
- * be faster than using a harp_product_execute_operations() after a full import of the product.
- * \param[in] filename Path to the file that is to be imported.
- * \param[in] operations string (optional) containing actions to apply as part of the import; should be specified as a
- * semi-colon separated string of operations.
- * \param[in] options Ingestion module specific options (optional); should be specified as a semi-colon separated
- * string of key=value pair; only used if the file is not in HARP format.
- * \param[out] product Pointer to a location where a pointer to the ingested product will be stored.
- * \return
- *   \arg \c 0, Success.
- *   \arg \c -1, Error occurred (check #harp_errno).
+/* Import a file that is stored using the HARP format.
+ * If the file is not a HARP product then -1 is returned and harp_errno is set to HARP_ERROR_UNSUPPORTED_PRODUCT.
  */
-LIBHARP_API int harp_import(const char *filename, const char *operations, const char *options, harp_product **product)
+static int import_harp_file(const char *filename, harp_product **product)
 {
     harp_product *imported_product;
     file_format format;
@@ -574,38 +729,113 @@ LIBHARP_API int harp_import(const char *filename, const char *operations, const
             harp_set_error(HARP_ERROR_UNSUPPORTED_PRODUCT, NULL);
             result = -1;
     }
-
     if (result != 0)
     {
-        if (harp_errno != HARP_ERROR_UNSUPPORTED_PRODUCT)
+        return -1;
+    }
+
+    if (harp_product_verify(imported_product) != 0)
+    {
+        harp_product_delete(imported_product);
+        return -1;
+    }
+
+    /* set source_product if it was empty; we need this for the 'collocate_xxx()' operations to work */
+    if (imported_product->source_product == NULL)
+    {
+        if (harp_product_set_source_product(imported_product, filename) != 0)
         {
+            harp_product_delete(imported_product);
             return -1;
         }
+    }
 
-        /* try ingest */
-        if (harp_ingest(filename, operations, options, &imported_product) != 0)
+    *product = imported_product;
+
+    return 0;
+}
+
+/* Import a product using an already parsed program and ingestion option list.
+ * The program is reset before use, so the same program can be used for importing multiple products.
+ */
+static int import_with_program(const char *filename, harp_program *program, const harp_ingestion_options *option_list,
+                               harp_product **product)
+{
+    harp_product *imported_product;
+
+    harp_program_reset(program);
+
+    if (import_harp_file(filename, &imported_product) != 0)
+    {
+        if (harp_errno != HARP_ERROR_UNSUPPORTED_PRODUCT)
         {
             return -1;
         }
+
+        /* try ingest */
+        return harp_ingest_with_program(filename, program, option_list, product);
     }
-    else
+
+    if (harp_product_continue_program(imported_product, program) != 0)
+    {
+        harp_product_delete(imported_product);
+        return -1;
+    }
+
+    *product = imported_product;
+
+    return 0;
+}
+
+/** Import a product from a file.
+ * \ingroup harp_product
+ * This will first try to import the file as an HDF4, HDF5, or netCDF file that complies to the HARP Data Format.
+ * If the file is not stored using the HARP format then it will try to import it using one of the available ingestion
+ * modules.
+ * The \a options parameter is optional (can be NULL) and describes the ingestion options. The parameter is only
+ * applicable if the file is not already using the HARP format and needs to be converted using one of the ingestion
+ * modules.
+ * The \a operations parameter is optional (can be NULL) and provides the list of operations that will be performed as
+ * part of the import. Some operations, such as filters, can already be performed as part of an import and this may thus
+ * be faster than using a harp_product_execute_operations() after a full import of the product.
+ * \param[in] filename Path to the file that is to be imported.
+ * \param[in] operations string (optional) containing actions to apply as part of the import; should be specified as a
+ * semi-colon separated string of operations.
+ * \param[in] options Ingestion module specific options (optional); should be specified as a semi-colon separated
+ * string of key=value pair; only used if the file is not in HARP format.
+ * \param[out] product Pointer to a location where a pointer to the ingested product will be stored.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_import(const char *filename, const char *operations, const char *options, harp_product **product)
+{
+    harp_product *imported_product;
+    harp_trace_span span;
+
+    if (harp_option_trace)
+    {
+        harp_trace_begin(&span, NULL);
+    }
+    if (import_harp_file(filename, &imported_product) != 0)
     {
-        if (harp_product_verify(imported_product) != 0)
+        if (harp_errno != HARP_ERROR_UNSUPPORTED_PRODUCT)
         {
-            harp_product_delete(imported_product);
             return -1;
         }
 
-        /* set source_product if it was empty; we need this for the 'collocate_xxx()' operations to work */
-        if (imported_product->source_product == NULL)
+        /* try ingest */
+        if (harp_ingest(filename, operations, options, &imported_product) != 0)
         {
-            if (harp_product_set_source_product(imported_product, filename) != 0)
-            {
-                harp_product_delete(imported_product);
-                return -1;
-            }
+            return -1;
+        }
+    }
+    else
+    {
+        if (harp_option_trace)
+        {
+            harp_trace_end(&span, "import", "read", imported_product, harp_basename(filename));
         }
-
         if (operations != NULL)
         {
             if (harp_product_execute_operations(imported_product, operations) != 0)
@@ -621,91 +851,327 @@ LIBHARP_API int harp_import(const char *filename, const char *operations, const
     return 0;
 }
 
-/** Test import of a product.
+/** Import a product from a file using a compiled program.
  * \ingroup harp_product
- * If the product is a HARP product then verify that the product is a HARP compliant netCDF/HDF4/HDF5 product.
- * Otherwise, try to import the product using an applicable ingestion module and test the ingestion for all possible
- * ingestion options.
- * Results are printed using the provided \a print function.
- * The \a print function parameter should be a function that resembles printf().
- * \param[in] filename Filename of the product to import.
- * \param[in] print Reference to a printf compatible function.
+ * This function behaves the same as harp_import(), but uses a program that was created with harp_program_compile()
+ * instead of an operations string. Since parsing of the operations and loading of resources that the operations refer
+ * to (such as area mask files and collocation result files) is then only performed once, this is more efficient than
+ * calling harp_import() with the same operations for each file of a larger set of files.
+ * The \a program parameter is optional (can be NULL), in which case no operations are performed.
+ * \param[in] filename Path to the file that is to be imported.
+ * \param[in] program Compiled program (optional) containing actions to apply as part of the import.
+ * \param[in] options Ingestion module specific options (optional); should be specified as a semi-colon separated
+ * string of key=value pair; only used if the file is not in HARP format.
+ * \param[out] product Pointer to a location where a pointer to the ingested product will be stored.
  * \return
  *   \arg \c 0, Success.
- *   \arg \c 1, Import failed (error is already printed, #harp_errno should be ignored).
  *   \arg \c -1, Error occurred (check #harp_errno).
  */
-LIBHARP_API int harp_import_test(const char *filename, int (*print) (const char *, ...))
+LIBHARP_API int harp_import_with_program(const char *filename, harp_program *program, const char *options,
+                                         harp_product **product)
 {
-    harp_product *product;
-    file_format format;
+    harp_ingestion_options *option_list;
     int result;
-    int i;
 
-    print("product: %s\n", filename);
-
-    if (determine_file_format(filename, &format) != 0)
+    if (filename == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "filename is NULL (%s:%u)", __FILE__, __LINE__);
+        return -1;
+    }
+    if (product == NULL)
     {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "product is NULL (%s:%u)", __FILE__, __LINE__);
         return -1;
     }
 
-    switch (format)
+    if (program == NULL)
     {
-        case format_hdf4:
-#ifdef HAVE_HDF4
-            result = harp_import_hdf4(filename, &product);
-#else
-            harp_set_error(HARP_ERROR_UNSUPPORTED_PRODUCT, NULL);
-            result = -1;
-#endif
-            break;
-        case format_hdf5:
-#ifdef HAVE_HDF5
-            result = harp_import_hdf5(filename, &product);
-#else
-            harp_set_error(HARP_ERROR_UNSUPPORTED_PRODUCT, NULL);
-            result = -1;
-#endif
-            break;
-        case format_netcdf:
-            result = harp_import_netcdf(filename, &product);
-            break;
-        default:
-            harp_set_error(HARP_ERROR_UNSUPPORTED_PRODUCT, NULL);
-            result = -1;
+        return harp_import(filename, NULL, options, product);
     }
 
-    if (result != 0)
+    if (options == NULL)
     {
-        if (harp_errno != HARP_ERROR_UNSUPPORTED_PRODUCT)
+        if (harp_ingestion_options_new(&option_list) != 0)
         {
             return -1;
         }
-        /* try ingest */
-        return harp_ingest_test(filename, print);
-    }
-
-    print("import:");
-    if (harp_product_verify(product) != 0)
-    {
-        print(" [FAIL]\n");
-        print("ERROR: %s\n", harp_errno_to_string(harp_errno));
-        harp_product_delete(product);
-        return 1;
     }
-    print(" (%d variables", product->num_variables);
-    for (i = 0; i < HARP_NUM_DIM_TYPES; i++)
+    else
     {
-        if (product->dimension[i] > 0)
+        if (harp_ingestion_options_from_string(options, &option_list) != 0)
         {
-            print(", %s=%ld", harp_get_dimension_type_name(i), product->dimension[i]);
+            return -1;
         }
     }
-    print(") [OK]\n");
 
-    harp_product_delete(product);
+    harp_program_begin_execution(program);
+    result = import_with_program(filename, program, option_list, product);
+    harp_program_end_execution(program);
 
-    return 0;
+    harp_ingestion_options_delete(option_list);
+
+    return result;
+}
+
+static int import_multiple(int num_files, const char **filename, harp_program *program,
+                           const harp_ingestion_options *option_list, harp_program *reduce_program,
+                           harp_product **product)
+{
+    harp_product *merged_product = NULL;
+    int i;
+
+    for (i = 0; i < num_files; i++)
+    {
+        harp_product *imported_product;
+
+        if (import_with_program(filename[i], program, option_list, &imported_product) != 0)
+        {
+            harp_add_error_message(" (while importing '%s')", filename[i]);
+            if (merged_product != NULL)
+            {
+                harp_product_delete(merged_product);
+            }
+            return -1;
+        }
+        if (harp_product_is_empty(imported_product))
+        {
+            harp_product_delete(imported_product);
+            continue;
+        }
+        if (merged_product == NULL)
+        {
+            merged_product = imported_product;
+            /* if this remains the only product then make sure it still looks like it was the result of a merge */
+            if (harp_product_append(merged_product, NULL) != 0)
+            {
+                harp_product_delete(merged_product);
+                return -1;
+            }
+        }
+        else
+        {
+            if (harp_product_append_move(merged_product, imported_product) != 0)
+            {
+                harp_product_delete(imported_product);
+                harp_product_delete(merged_product);
+                return -1;
+            }
+            harp_product_delete(imported_product);
+        }
+        if (reduce_program != NULL)
+        {
+            /* perform reduction operations on the partially merged product after each append */
+            harp_program_reset(reduce_program);
+            if (harp_product_continue_program(merged_product, reduce_program) != 0)
+            {
+                harp_product_delete(merged_product);
+                return -1;
+            }
+        }
+    }
+
+    if (merged_product == NULL)
+    {
+        /* all imported products were empty */
+        if (harp_product_new(&merged_product) != 0)
+        {
+            return -1;
+        }
+    }
+
+    *product = merged_product;
+
+    return 0;
+}
+
+/** Import multiple products and merge them into a single product.
+ * \ingroup harp_product
+ * Each file is imported using the same \a operations and \a options as would be used by harp_import() and all
+ * non-empty products are appended (in the order of the \a filename list) into a single merged product (see
+ * harp_product_append()).
+ * The \a operations, \a options, and \a reduce_operations strings are only parsed once, which makes this function
+ * more efficient than calling harp_import() for each file individually.
+ * The \a reduce_operations parameter is optional (can be NULL) and provides a list of operations that will be
+ * performed on the partially merged product after each append. This allows for memory efficient application of time
+ * reduction operations (such as bin()).
+ * If all imported products are empty then an empty product will be returned (see harp_product_is_empty()).
+ * \param[in] num_files Number of files to import.
+ * \param[in] filename Array of paths to the files that are to be imported.
+ * \param[in] operations string (optional) containing actions to apply as part of the import of each file; should be
+ * specified as a semi-colon separated string of operations.
+ * \param[in] options Ingestion module specific options (optional); should be specified as a semi-colon separated
+ * string of key=value pair; only used if a file is not in HARP format.
+ * \param[in] reduce_operations string (optional) containing actions to apply after each append; should be specified
+ * as a semi-colon separated string of operations.
+ * \param[out] product Pointer to a location where a pointer to the merged product will be stored.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_import_multiple(int num_files, const char **filename, const char *operations,
+                                     const char *options, const char *reduce_operations, harp_product **product)
+{
+    harp_ingestion_options *option_list;
+    harp_program *program;
+    harp_program *reduce_program = NULL;
+    int result;
+
+    if (num_files < 0)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "num_files argument is negative (%s:%u)", __FILE__, __LINE__);
+        return -1;
+    }
+    if (num_files > 0 && filename == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "filename is NULL (%s:%u)", __FILE__, __LINE__);
+        return -1;
+    }
+    if (product == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "product is NULL (%s:%u)", __FILE__, __LINE__);
+        return -1;
+    }
+
+    if (operations == NULL)
+    {
+        if (harp_program_new(&program) != 0)
+        {
+            return -1;
+        }
+    }
+    else
+    {
+        if (harp_program_from_string(operations, &program) != 0)
+        {
+            return -1;
+        }
+    }
+
+    if (options == NULL)
+    {
+        if (harp_ingestion_options_new(&option_list) != 0)
+        {
+            harp_program_delete(program);
+            return -1;
+        }
+    }
+    else
+    {
+        if (harp_ingestion_options_from_string(options, &option_list) != 0)
+        {
+            harp_program_delete(program);
+            return -1;
+        }
+    }
+
+    if (reduce_operations != NULL)
+    {
+        if (harp_program_from_string(reduce_operations, &reduce_program) != 0)
+        {
+            harp_ingestion_options_delete(option_list);
+            harp_program_delete(program);
+            return -1;
+        }
+    }
+
+    result = import_multiple(num_files, filename, program, option_list, reduce_program, product);
+
+    /* delete the programs in reverse order of creation such that the global options end up at their initial values */
+    if (reduce_program != NULL)
+    {
+        harp_program_delete(reduce_program);
+    }
+    harp_ingestion_options_delete(option_list);
+    harp_program_delete(program);
+
+    return result;
+}
+
+/** Test import of a product.
+ * \ingroup harp_product
+ * If the product is a HARP product then verify that the product is a HARP compliant netCDF/HDF4/HDF5 product.
+ * Otherwise, try to import the product using an applicable ingestion module and test the ingestion for all possible
+ * ingestion options.
+ * Results are printed using the provided \a print function.
+ * The \a print function parameter should be a function that resembles printf().
+ * \param[in] filename Filename of the product to import.
+ * \param[in] print Reference to a printf compatible function.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c 1, Import failed (error is already printed, #harp_errno should be ignored).
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_import_test(const char *filename, int (*print) (const char *, ...))
+{
+    harp_product *product;
+    file_format format;
+    int result;
+    int i;
+
+    print("product: %s\n", filename);
+
+    if (determine_file_format(filename, &format) != 0)
+    {
+        return -1;
+    }
+
+    switch (format)
+    {
+        case format_hdf4:
+#ifdef HAVE_HDF4
+            result = harp_import_hdf4(filename, &product);
+#else
+            harp_set_error(HARP_ERROR_UNSUPPORTED_PRODUCT, NULL);
+            result = -1;
+#endif
+            break;
+        case format_hdf5:
+#ifdef HAVE_HDF5
+            result = harp_import_hdf5(filename, &product);
+#else
+            harp_set_error(HARP_ERROR_UNSUPPORTED_PRODUCT, NULL);
+            result = -1;
+#endif
+            break;
+        case format_netcdf:
+            result = harp_import_netcdf(filename, &product);
+            break;
+        default:
+            harp_set_error(HARP_ERROR_UNSUPPORTED_PRODUCT, NULL);
+            result = -1;
+    }
+
+    if (result != 0)
+    {
+        if (harp_errno != HARP_ERROR_UNSUPPORTED_PRODUCT)
+        {
+            return -1;
+        }
+        /* try ingest */
+        return harp_ingest_test(filename, print);
+    }
+
+    print("import:");
+    if (harp_product_verify(product) != 0)
+    {
+        print(" [FAIL]\n");
+        print("ERROR: %s\n", harp_errno_to_string(harp_errno));
+        harp_product_delete(product);
+        return 1;
+    }
+    print(" (%d variables", product->num_variables);
+    for (i = 0; i < HARP_NUM_DIM_TYPES; i++)
+    {
+        if (product->dimension[i] > 0)
+        {
+            print(", %s=%ld", harp_get_dimension_type_name(i), product->dimension[i]);
+        }
+    }
+    print(") [OK]\n");
+
+    harp_product_delete(product);
+
+    return 0;
 }
 
 /** Retrieve global attributes from a product file.
@@ -844,6 +1310,372 @@ LIBHARP_API int harp_export(const char *filename, const char *export_format, con
     return 0;
 }
 
+struct harp_export_writer_struct
+{
+    file_format format;
+    char *filename;
+    /* variable definitions of the first appended product (with a time dimension of length 1) */
+    harp_product *template_product;
+    int has_datetime_range;
+    double datetime_range[2];
+#ifdef HAVE_HDF5
+    harp_hdf5_writer *hdf5_writer;
+#endif
+    harp_netcdf_writer *netcdf_writer;
+};
+
+static void export_writer_delete(harp_export_writer *writer)
+{
+    if (writer->filename != NULL)
+    {
+        free(writer->filename);
+    }
+    if (writer->template_product != NULL)
+    {
+        harp_product_delete(writer->template_product);
+    }
+    free(writer);
+}
+
+/* Create a product that contains the definitions of all variables of \a product (with a time dimension of length 1).
+ * This is used to verify that subsequently appended products are compatible with the content of the output file.
+ */
+static int export_writer_create_template(const harp_product *product, harp_product **new_template_product)
+{
+    harp_product *template_product;
+    int i;
+
+    if (harp_product_new(&template_product) != 0)
+    {
+        return -1;
+    }
+    for (i = 0; i < product->num_variables; i++)
+    {
+        const harp_variable *variable = product->variable[i];
+        harp_variable *template_variable;
+        long dimension[HARP_MAX_NUM_DIMS];
+        int j;
+
+        for (j = 0; j < variable->num_dimensions; j++)
+        {
+            dimension[j] = variable->dimension[j];
+        }
+        dimension[0] = 1;
+
+        if (harp_variable_new(variable->name, variable->data_type, variable->num_dimensions, variable->dimension_type,
+                              dimension, &template_variable) != 0)
+        {
+            harp_product_delete(template_product);
+            return -1;
+        }
+        if (harp_variable_copy_attributes(variable, template_variable) != 0)
+        {
+            harp_variable_delete(template_variable);
+            harp_product_delete(template_product);
+            return -1;
+        }
+        if (harp_product_add_variable(template_product, template_variable) != 0)
+        {
+            harp_variable_delete(template_variable);
+            harp_product_delete(template_product);
+            return -1;
+        }
+    }
+
+    *new_template_product = template_product;
+    return 0;
+}
+
+/* Verify that \a product can be appended to the output file and extend non-time dimensions of the product where
+ * needed. This follows the same rules as harp_product_append(), except that dimensions of the output file can not grow.
+ */
+static int export_writer_align_product(const harp_product *template_product, harp_product *product)
+{
+    harp_dimension_type dimension_type;
+    int i;
+
+    for (i = 0; i < template_product->num_variables; i++)
+    {
+        if (!harp_product_has_variable(product, template_product->variable[i]->name))
+        {
+            harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "product does not have variable '%s'",
+                           template_product->variable[i]->name);
+            return -1;
+        }
+    }
+    for (i = 0; i < product->num_variables; i++)
+    {
+        if (!harp_product_has_variable(template_product, product->variable[i]->name))
+        {
+            harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "variable '%s' is not present in the output file",
+                           product->variable[i]->name);
+            return -1;
+        }
+    }
+
+    for (dimension_type = 0; dimension_type < HARP_NUM_DIM_TYPES; dimension_type++)
+    {
+        if (dimension_type == harp_dimension_time)
+        {
+            continue;
+        }
+        if (product->dimension[dimension_type] < template_product->dimension[dimension_type])
+        {
+            if (harp_product_resize_dimension(product, dimension_type, template_product->dimension[dimension_type]) !=
+                0)
+            {
+                return -1;
+            }
+        }
+        else if (product->dimension[dimension_type] > template_product->dimension[dimension_type])
+        {
+            harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "length of %s dimension (%ld) exceeds length in the output "
+                           "file (%ld)", harp_get_dimension_type_name(dimension_type),
+                           product->dimension[dimension_type], template_product->dimension[dimension_type]);
+            return -1;
+        }
+    }
+
+    for (i = 0; i < template_product->num_variables; i++)
+    {
+        harp_variable *variable;
+
+        if (harp_product_get_variable_by_name(product, template_product->variable[i]->name, &variable) != 0)
+        {
+            return -1;
+        }
+        if (harp_variable_check_appendable(template_product->variable[i], variable) != 0)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/** Open a writer for incremental export of products to a file.
+ * \ingroup harp_product
+ * The export writer allows products to be appended one by one (along the time dimension) to a single HDF5 or netCDF
+ * file that complies to the HARP Data Format, without having to keep the merged product in memory.
+ * The result is the same as performing harp_product_append() on all products and exporting the merged product,
+ * except that the file uses an unlimited (netCDF) or extendable (HDF5) time dimension.
+ *
+ * The file itself is created when the first non-empty product is appended. The first product determines the set of
+ * variables, the lengths of all non-time dimensions, the maximum length of string values, and the global 'history'
+ * attribute. The datetime_start and datetime_stop global attributes are written when the writer is closed.
+ * \param filename Path to the file to which the products are to be exported.
+ * \param format Either "hdf5" or "netcdf" (incremental export to "hdf4" is not supported).
+ * \param writer Pointer to the location where the new export writer will be stored.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_export_writer_open(const char *filename, const char *format, harp_export_writer **writer)
+{
+    harp_export_writer *new_writer;
+    file_format export_format;
+
+    if (filename == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "filename is NULL");
+        return -1;
+    }
+    if (format == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "format is NULL");
+        return -1;
+    }
+
+    export_format = format_from_string(format);
+    switch (export_format)
+    {
+        case format_hdf4:
+            harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "incremental export is not supported for format '%s'", format);
+            return -1;
+        case format_hdf5:
+#ifndef HAVE_HDF5
+            harp_set_error(HARP_ERROR_NO_HDF5_SUPPORT, NULL);
+            return -1;
+#endif
+        case format_netcdf:
+            break;
+        default:
+            harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "unsupported export format '%s'", format);
+            return -1;
+    }
+
+    new_writer = (harp_export_writer *)malloc(sizeof(harp_export_writer));
+    if (new_writer == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       sizeof(harp_export_writer), __FILE__, __LINE__);
+        return -1;
+    }
+    new_writer->format = export_format;
+    new_writer->template_product = NULL;
+    new_writer->has_datetime_range = 0;
+    new_writer->datetime_range[0] = harp_plusinf();
+    new_writer->datetime_range[1] = harp_mininf();
+#ifdef HAVE_HDF5
+    new_writer->hdf5_writer = NULL;
+#endif
+    new_writer->netcdf_writer = NULL;
+    new_writer->filename = strdup(filename);
+    if (new_writer->filename == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not duplicate string) (%s:%u)", __FILE__,
+                       __LINE__);
+        export_writer_delete(new_writer);
+        return -1;
+    }
+
+    *writer = new_writer;
+    return 0;
+}
+
+/** Append a product to the file of an export writer.
+ * \ingroup harp_product
+ * Empty products are ignored.
+ * The product is modified in the same way as harp_product_append() would modify it: the 'index' variable is removed,
+ * all variables are made time dependent, the source_product attribute is removed, and non-time dimensions are extended
+ * to the length that was used in the file. The product remains owned by the caller.
+ * It is an error if the product does not have exactly the same variables as the first appended product, if a non-time
+ * dimension is longer than in the first appended product, or if a string value is longer than the longest string
+ * value of the variable in the first appended product.
+ * \param writer Export writer.
+ * \param product Product that should be appended to the file.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_export_writer_append(harp_export_writer *writer, harp_product *product)
+{
+    double datetime_start;
+    double datetime_stop;
+    int result;
+
+    if (writer == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "writer is NULL");
+        return -1;
+    }
+    if (product == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "product is NULL");
+        return -1;
+    }
+
+    if (harp_product_is_empty(product))
+    {
+        return 0;
+    }
+
+    /* update the product as if it was the result of a merge */
+    if (harp_product_append(product, NULL) != 0)
+    {
+        return -1;
+    }
+
+    if (writer->template_product == NULL)
+    {
+        if (export_writer_create_template(product, &writer->template_product) != 0)
+        {
+            return -1;
+        }
+#ifdef HAVE_HDF5
+        if (writer->format == format_hdf5)
+        {
+            result = harp_hdf5_writer_new(writer->filename, product, &writer->hdf5_writer);
+        }
+        else
+#endif
+        {
+            result = harp_netcdf_writer_new(writer->filename, product, &writer->netcdf_writer);
+        }
+        if (result != 0)
+        {
+            harp_product_delete(writer->template_product);
+            writer->template_product = NULL;
+            return -1;
+        }
+    }
+    else
+    {
+        if (export_writer_align_product(writer->template_product, product) != 0)
+        {
+            return -1;
+        }
+#ifdef HAVE_HDF5
+        if (writer->format == format_hdf5)
+        {
+            result = harp_hdf5_writer_append(writer->hdf5_writer, product);
+        }
+        else
+#endif
+        {
+            result = harp_netcdf_writer_append(writer->netcdf_writer, product);
+        }
+        if (result != 0)
+        {
+            return -1;
+        }
+    }
+
+    if (harp_product_get_datetime_range(product, &datetime_start, &datetime_stop) == 0)
+    {
+        if (datetime_start < writer->datetime_range[0])
+        {
+            writer->datetime_range[0] = datetime_start;
+        }
+        if (datetime_stop > writer->datetime_range[1])
+        {
+            writer->datetime_range[1] = datetime_stop;
+        }
+        writer->has_datetime_range = 1;
+    }
+
+    return 0;
+}
+
+/** Finalize the file of an export writer and delete the writer.
+ * \ingroup harp_product
+ * If no (non-empty) product was appended then no file will have been created.
+ * The writer is always deleted, also when an error occurs.
+ * \param writer Export writer.
+ * \return
+ *   \arg \c 0, Success.
+ *   \arg \c -1, Error occurred (check #harp_errno).
+ */
+LIBHARP_API int harp_export_writer_close(harp_export_writer *writer)
+{
+    const double *datetime_range = NULL;
+    int result = 0;
+
+    if (writer == NULL)
+    {
+        return 0;
+    }
+
+    if (writer->has_datetime_range)
+    {
+        datetime_range = writer->datetime_range;
+    }
+#ifdef HAVE_HDF5
+    if (writer->hdf5_writer != NULL)
+    {
+        result = harp_hdf5_writer_close(writer->hdf5_writer, datetime_range);
+    }
+#endif
+    if (writer->netcdf_writer != NULL)
+    {
+        result = harp_netcdf_writer_close(writer->netcdf_writer, datetime_range);
+    }
+
+    export_writer_delete(writer);
+
+    return result;
+}
+
 /**
  * Return a string describing the dimension type.
  */
@@ -315,9 +315,17 @@ static void harp_matlab_import(int nlhs, mxArray *plhs[], int nrhs, const mxArra
         }
     }
 
-    for (i = 0; i < num_files; i++)
+    if (num_files == 1)
+    {
+        if (harp_import(filenames[0], operations, option, &product) != 0)
+        {
+            harp_matlab_harp_error();
+        }
+    }
+    else
     {
-        if (harp_import(filenames[i], operations, option, &product) != 0)
+        /* import and merge all files, parsing the operations and options only once */
+        if (harp_import_multiple(num_files, (const char **)filenames, operations, option, NULL, &product) != 0)
         {
             harp_matlab_harp_error();
         }
@@ -752,23 +752,36 @@ def _import_scalar(c_data_type, c_data):
     raise UnsupportedTypeError("unsupported C data type code '%d'" % c_data_type)
 
 
-def _import_array(c_data_type, c_num_elements, c_data):
+def _import_array(c_variable):
+    c_data_type = c_variable.data_type
+    c_num_elements = c_variable.num_elements
+
     if c_data_type == _lib.harp_type_string:
         data = numpy.empty((c_num_elements,), dtype=numpy.object)
         for i in range(c_num_elements):
             # NB. The _ffi.string() method returns a copy of the C string.
-            data[i] = _decode_string(_ffi.string(c_data.string_data[i]))
+            data[i] = _decode_string(_ffi.string(c_variable.data.string_data[i]))
         return data
 
-    # NB. The _ffi.buffer() method, as well as the numpy.frombuffer() method, provide a view on the C array; neither
-    # method incurs a copy.
-    c_data_buffer = _ffi.buffer(c_data.ptr, c_num_elements * _lib.harp_get_size_for_type(c_data_type))
-    return numpy.copy(numpy.frombuffer(c_data_buffer, dtype=_get_py_data_type(c_data_type)))
+    if c_num_elements == 0:
+        return numpy.empty((0,), dtype=_get_py_data_type(c_data_type))
+
+    # Take over ownership of the C array instead of copying it. The C array will be released (using harp_free()) once
+    # the cdata object gets garbage collected. The _ffi.buffer() method keeps a reference to the cdata object and the
+    # numpy.frombuffer() method keeps a reference to the buffer, which ties the life time of the C array to that of
+    # the numpy array. Neither method incurs a copy.
+    c_data_ptr = _ffi.new("void **")
+    if _lib.harp_variable_detach_data(c_variable, c_data_ptr) != 0:
+        raise CLibraryError()
+    c_data = _ffi.gc(_ffi.cast("char *", c_data_ptr[0]), _lib.harp_free)
+
+    c_data_buffer = _ffi.buffer(c_data, c_num_elements * _lib.harp_get_size_for_type(c_data_type))
+    return numpy.frombuffer(c_data_buffer, dtype=_get_py_data_type(c_data_type))
 
 
 def _import_variable(c_variable):
     # Import variable data.
-    data = _import_array(c_variable.data_type, c_variable.num_elements, c_variable.data)
+    data = _import_array(c_variable)
 
     num_dimensions = c_variable.num_dimensions
     if num_dimensions == 0:
@@ -838,8 +851,15 @@ def _export_array(data, c_variable):
         size = c_variable.num_elements * _lib.harp_get_size_for_type(c_variable.data_type)
         shape = data.shape if isinstance(data, numpy.ndarray) else ()
 
+        py_data_type = _get_py_data_type(c_variable.data_type)
+        if isinstance(data, numpy.ndarray) and data.dtype == py_data_type and data.flags["C_CONTIGUOUS"]:
+            # The memory layout of the numpy array already matches that of the C array, so the data can be copied
+            # with a single memmove() without going through the numpy casting machinery.
+            _ffi.memmove(c_variable.data.ptr, data, size)
+            return
+
         c_data_buffer = _ffi.buffer(c_variable.data.ptr, size)
-        c_data = numpy.reshape(numpy.frombuffer(c_data_buffer, dtype=_get_py_data_type(c_variable.data_type)), shape)
+        c_data = numpy.reshape(numpy.frombuffer(c_data_buffer, dtype=py_data_type), shape)
         numpy.copyto(c_data, data, casting="safe")
     elif isinstance(data, numpy.ndarray):
         for index, element in enumerate(data.flat):
@@ -1117,41 +1137,17 @@ def import_product(filename, operations="", options="", reduce_operations="", po
     if filenames is not None:
         if len(filenames) == 0:
             raise Error("no files matching '%s'" % (filename))
-        # Return the merged concatenation of all products
-        merged_product_ptr = None
-        try:
-            for file in filenames:
-                c_product_ptr = _ffi.new("harp_product **")
-
-                # Import the product as a C product.
-                if _lib.harp_import(_encode_path(file), _encode_string(operations), _encode_string(options),
-                                    c_product_ptr) != 0:
-                    raise CLibraryError()
-                if _lib.harp_product_is_empty(c_product_ptr[0]) == 1:
-                    _lib.harp_product_delete(c_product_ptr[0])
-                else:
-                    if merged_product_ptr is None:
-                        merged_product_ptr = c_product_ptr
-                        # if this remains the only product, make sure it still looks like it was the result of a merge
-                        if _lib.harp_product_append(merged_product_ptr[0], _ffi.NULL) != 0:
-                            raise CLibraryError()
-                    else:
-                        try:
-                            if _lib.harp_product_append(merged_product_ptr[0], c_product_ptr[0]) != 0:
-                                raise CLibraryError()
-                        finally:
-                            _lib.harp_product_delete(c_product_ptr[0])
-                    if reduce_operations:
-                        # perform reduction operations on the partially merged product after each append
-                        if _lib.harp_product_execute_operations(merged_product_ptr[0],
-                                                                _encode_string(reduce_operations)) != 0:
-                            raise CLibraryError()
-        except:
-            if merged_product_ptr is not None:
-                _lib.harp_product_delete(merged_product_ptr[0])
-            raise
+        # Return the merged concatenation of all products. The import and merge is performed by the C library, which
+        # only needs to parse the operations and options once.
+        c_filenames = [_ffi.new("char[]", _encode_path(file)) for file in filenames]
+        c_reduce_operations = _encode_string(reduce_operations) if reduce_operations else _ffi.NULL
+        merged_product_ptr = _ffi.new("harp_product **")
+        if _lib.harp_import_multiple(len(c_filenames), c_filenames, _encode_string(operations),
+                                     _encode_string(options), c_reduce_operations, merged_product_ptr) != 0:
+            raise CLibraryError()
 
-        if merged_product_ptr is None:
+        if _lib.harp_product_is_empty(merged_product_ptr[0]) == 1:
+            _lib.harp_product_delete(merged_product_ptr[0])
             raise NoDataError()
 
         try:
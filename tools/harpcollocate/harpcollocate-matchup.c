@@ -59,6 +59,7 @@ typedef struct cache_variables_struct
     harp_variable *longitude;   /* copy */
     harp_variable *latitude_bounds;     /* copy */
     harp_variable *longitude_bounds;    /* copy */
+    double *point_vector;       /* unit vectors of latitude/longitude (see harp_geometry_get_point_unit_vectors) */
     harp_variable **criterium;  /* references */
 } cache_variables;
 
@@ -101,6 +102,8 @@ typedef struct collocation_info_struct
     cache_variables variables_b;
 
     double *difference;
+    uint8_t *point_distance_mask;       /* point_distance criterium result for the current sample of A against all of B */
+    long point_distance_mask_size;
 } collocation_info;
 
 static void collocation_criterium_delete(collocation_criterium *criterium)
@@ -303,6 +306,10 @@ static void collocation_info_delete(collocation_info *info)
         {
             harp_variable_delete(info->variables_a.longitude_bounds);
         }
+        if (info->variables_a.point_vector != NULL)
+        {
+            free(info->variables_a.point_vector);
+        }
         if (info->variables_a.criterium != NULL)
         {
             free(info->variables_a.criterium);
@@ -323,6 +330,10 @@ static void collocation_info_delete(collocation_info *info)
         {
             harp_variable_delete(info->variables_b.longitude_bounds);
         }
+        if (info->variables_b.point_vector != NULL)
+        {
+            free(info->variables_b.point_vector);
+        }
         if (info->variables_b.criterium != NULL)
         {
             free(info->variables_b.criterium);
@@ -331,6 +342,10 @@ static void collocation_info_delete(collocation_info *info)
         {
             free(info->difference);
         }
+        if (info->point_distance_mask != NULL)
+        {
+            free(info->point_distance_mask);
+        }
         free(info);
     }
 }
@@ -378,14 +393,18 @@ static int collocation_info_new(collocation_info **new_info)
     info->variables_a.longitude = NULL;
     info->variables_a.latitude_bounds = NULL;
     info->variables_a.longitude_bounds = NULL;
+    info->variables_a.point_vector = NULL;
     info->variables_a.criterium = NULL;
     info->variables_b.index = NULL;
     info->variables_b.latitude = NULL;
     info->variables_b.longitude = NULL;
     info->variables_b.latitude_bounds = NULL;
     info->variables_b.longitude_bounds = NULL;
+    info->variables_b.point_vector = NULL;
     info->variables_b.criterium = NULL;
     info->difference = NULL;
+    info->point_distance_mask = NULL;
+    info->point_distance_mask_size = 0;
 
     if (harp_dataset_new(&info->dataset_a) != 0)
     {
@@ -796,14 +815,19 @@ static int collocation_info_update(collocation_info *info)
     return 0;
 }
 
-static void reindex_collocation_indices(harp_collocation_result *collocation_result)
+static int reindex_collocation_indices(harp_collocation_result *collocation_result)
 {
     long i;
 
     for (i = 0; i < collocation_result->num_pairs; i++)
     {
-        collocation_result->pair[i]->collocation_index = i;
+        if (harp_collocation_result_set_collocation_index(collocation_result, i, i) != 0)
+        {
+            return -1;
+        }
     }
+
+    return 0;
 }
 
 static int perform_matchup_on_measurements(collocation_info *info, long index_a, long product_b_index, long index_b)
@@ -825,6 +849,11 @@ static int perform_matchup_on_measurements(collocation_info *info, long index_a,
     {
         if (i == info->point_distance_index)
         {
+            /* only calculate the exact distance for pairs that passed the bulk distance test */
+            if (!info->criterium[i]->use_modulo && !info->point_distance_mask[index_b])
+            {
+                return 0;
+            }
             latitude_a = info->variables_a.latitude->data.double_data[index_a];
             longitude_a = info->variables_a.longitude->data.double_data[index_a];
             latitude_b = info->variables_b.latitude->data.double_data[index_b];
@@ -948,11 +977,15 @@ static int perform_matchup_on_measurements(collocation_info *info, long index_a,
 
                 for (i = 0; i < info->collocation_result->num_pairs; i++)
                 {
-                    harp_collocation_pair *pair = info->collocation_result->pair[i];
+                    harp_collocation_pair pair;
 
-                    if (pair->product_index_a == product_index && pair->sample_index_a == sample_index)
+                    if (harp_collocation_result_get_pair(info->collocation_result, i, &pair) != 0)
+                    {
+                        return -1;
+                    }
+                    if (pair.product_index_a == product_index && pair.sample_index_a == sample_index)
                     {
-                        if (pair->difference[info->nearest_neighbour_x_criterium_index] <=
+                        if (pair.difference[info->nearest_neighbour_x_criterium_index] <=
                             info->difference[info->nearest_neighbour_x_criterium_index])
                         {
                             /* existing pair is closer -> ignore the new pair */
@@ -987,11 +1020,15 @@ static int perform_matchup_on_measurements(collocation_info *info, long index_a,
 
                 for (i = 0; i < info->collocation_result->num_pairs; i++)
                 {
-                    harp_collocation_pair *pair = info->collocation_result->pair[i];
+                    harp_collocation_pair pair;
 
-                    if (pair->product_index_b == product_index && pair->sample_index_b == sample_index)
+                    if (harp_collocation_result_get_pair(info->collocation_result, i, &pair) != 0)
                     {
-                        if (pair->difference[info->nearest_neighbour_y_criterium_index] <=
+                        return -1;
+                    }
+                    if (pair.product_index_b == product_index && pair.sample_index_b == sample_index)
+                    {
+                        if (pair.difference[info->nearest_neighbour_y_criterium_index] <=
                             info->difference[info->nearest_neighbour_y_criterium_index])
                         {
                             /* existing pair is closer -> ignore the new pair */
@@ -1018,8 +1055,14 @@ static int perform_matchup_on_measurements(collocation_info *info, long index_a,
     }
     else
     {
-        collocation_index =
-            info->collocation_result->pair[info->collocation_result->num_pairs - 1]->collocation_index + 1;
+        harp_collocation_pair pair;
+
+        if (harp_collocation_result_get_pair(info->collocation_result, info->collocation_result->num_pairs - 1,
+                                             &pair) != 0)
+        {
+            return -1;
+        }
+        collocation_index = pair.collocation_index + 1;
     }
     if (harp_collocation_result_add_pair(info->collocation_result, collocation_index, info->product_a->source_product,
                                          info->variables_a.index->data.int32_data[index_a],
@@ -1033,12 +1076,49 @@ static int perform_matchup_on_measurements(collocation_info *info, long index_a,
     return 0;
 }
 
+/* Determine for sample index_a of A which samples of B are within the point distance criterium */
+static int update_point_distance_mask(collocation_info *info, long index_a, long num_points_b)
+{
+    double distance;
+
+    if (num_points_b > info->point_distance_mask_size)
+    {
+        uint8_t *mask;
+
+        mask = realloc(info->point_distance_mask, num_points_b * sizeof(uint8_t));
+        if (mask == NULL)
+        {
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                           num_points_b * sizeof(uint8_t), __FILE__, __LINE__);
+            return -1;
+        }
+        info->point_distance_mask = mask;
+        info->point_distance_mask_size = num_points_b;
+    }
+
+    /* convert the threshold to the HARP length unit (the inverse of the point_distance_conversion_factor) */
+    distance = info->criterium[info->point_distance_index]->value / info->point_distance_conversion_factor;
+
+    return harp_geometry_get_point_distance_mask(info->variables_a.latitude->data.double_data[index_a],
+                                                 info->variables_a.longitude->data.double_data[index_a], distance,
+                                                 num_points_b, info->variables_b.point_vector,
+                                                 info->point_distance_mask);
+}
+
 static int perform_matchup_on_products(collocation_info *info, long product_b_index)
 {
     long i, j;
 
     for (i = 0; i < info->product_a->dimension[harp_dimension_time]; i++)
     {
+        if (info->point_distance_index >= 0 && !info->criterium[info->point_distance_index]->use_modulo)
+        {
+            if (update_point_distance_mask(info, i, info->product_b[product_b_index]->dimension[harp_dimension_time])
+                != 0)
+            {
+                return -1;
+            }
+        }
         for (j = 0; j < info->product_b[product_b_index]->dimension[harp_dimension_time]; j++)
         {
             if (perform_matchup_on_measurements(info, i, product_b_index, j) != 0)
@@ -1302,6 +1382,25 @@ static int assign_variables(collocation_info *info, cache_variables *cache, harp
         {
             return -1;
         }
+        if (info->point_distance_index >= 0)
+        {
+            long num_points = cache->latitude->num_elements;
+            double *point_vector;
+
+            point_vector = realloc(cache->point_vector, 3 * num_points * sizeof(double));
+            if (point_vector == NULL && num_points > 0)
+            {
+                harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                               3 * num_points * sizeof(double), __FILE__, __LINE__);
+                return -1;
+            }
+            cache->point_vector = point_vector;
+            if (harp_geometry_get_point_unit_vectors(num_points, cache->latitude->data.double_data,
+                                                     cache->longitude->data.double_data, cache->point_vector) != 0)
+            {
+                return -1;
+            }
+        }
     }
     if (harp_product_has_variable(product, "latitude_bounds"))
     {
@@ -1600,7 +1699,11 @@ int matchup(int argc, char *argv[])
             collocation_info_delete(info);
             return -1;
         }
-        reindex_collocation_indices(info->collocation_result);
+        if (reindex_collocation_indices(info->collocation_result) != 0)
+        {
+            collocation_info_delete(info);
+            return -1;
+        }
     }
 
     if (harp_collocation_result_write(argv[argc - 1], info->collocation_result) != 0)
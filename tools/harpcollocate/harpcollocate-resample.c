@@ -148,6 +148,8 @@ static int resample_info_update(resample_info *info)
 
 int resample_nearest_a(harp_collocation_result *collocation_result, int difference_index)
 {
+    harp_collocation_pair pair;
+    harp_collocation_pair prev_pair;
     long i;
 
     if (harp_collocation_result_sort_by_a(collocation_result) != 0)
@@ -156,11 +158,17 @@ int resample_nearest_a(harp_collocation_result *collocation_result, int differen
     }
     for (i = collocation_result->num_pairs - 1; i > 0; i--)
     {
-        if (collocation_result->pair[i]->product_index_a == collocation_result->pair[i - 1]->product_index_a &&
-            collocation_result->pair[i]->sample_index_a == collocation_result->pair[i - 1]->sample_index_a)
+        if (harp_collocation_result_get_pair(collocation_result, i, &pair) != 0)
         {
-            if (collocation_result->pair[i]->difference[difference_index] >=
-                collocation_result->pair[i - 1]->difference[difference_index])
+            return -1;
+        }
+        if (harp_collocation_result_get_pair(collocation_result, i - 1, &prev_pair) != 0)
+        {
+            return -1;
+        }
+        if (pair.product_index_a == prev_pair.product_index_a && pair.sample_index_a == prev_pair.sample_index_a)
+        {
+            if (pair.difference[difference_index] >= prev_pair.difference[difference_index])
             {
                 if (harp_collocation_result_remove_pair_at_index(collocation_result, i) != 0)
                 {
@@ -182,6 +190,8 @@ int resample_nearest_a(harp_collocation_result *collocation_result, int differen
 
 int resample_nearest_b(harp_collocation_result *collocation_result, int difference_index)
 {
+    harp_collocation_pair pair;
+    harp_collocation_pair prev_pair;
     long i;
 
     if (harp_collocation_result_sort_by_b(collocation_result) != 0)
@@ -190,11 +200,17 @@ int resample_nearest_b(harp_collocation_result *collocation_result, int differen
     }
     for (i = collocation_result->num_pairs - 1; i > 0; i--)
     {
-        if (collocation_result->pair[i]->product_index_b == collocation_result->pair[i - 1]->product_index_b &&
-            collocation_result->pair[i]->sample_index_b == collocation_result->pair[i - 1]->sample_index_b)
+        if (harp_collocation_result_get_pair(collocation_result, i, &pair) != 0)
+        {
+            return -1;
+        }
+        if (harp_collocation_result_get_pair(collocation_result, i - 1, &prev_pair) != 0)
+        {
+            return -1;
+        }
+        if (pair.product_index_b == prev_pair.product_index_b && pair.sample_index_b == prev_pair.sample_index_b)
         {
-            if (collocation_result->pair[i]->difference[difference_index] >=
-                collocation_result->pair[i - 1]->difference[difference_index])
+            if (pair.difference[difference_index] >= prev_pair.difference[difference_index])
             {
                 if (harp_collocation_result_remove_pair_at_index(collocation_result, i) != 0)
                 {
@@ -53,9 +53,15 @@ static long get_index_for_collocation_index(const harp_collocation_result *collo
     {
         /* Determine the index that splits the search space into two (approximately) equal halves. */
         long pivot_index = lower_index + ((upper_index - lower_index) / 2);
+        harp_collocation_pair pair;
+
+        if (harp_collocation_result_get_pair(collocation_result, pivot_index, &pair) != 0)
+        {
+            return -1;
+        }
 
         /* If the pivot equals the index to be found, terminate early. */
-        if (collocation_result->pair[pivot_index]->collocation_index == collocation_index)
+        if (pair.collocation_index == collocation_index)
         {
             return pivot_index;
         }
@@ -63,7 +69,7 @@ static long get_index_for_collocation_index(const harp_collocation_result *collo
         /* If the pivot is smaller than the index to be found, search the upper sub array, otherwise search the lower
          * sub array.
          */
-        if (collocation_result->pair[pivot_index]->collocation_index < collocation_index)
+        if (pair.collocation_index < collocation_index)
         {
             lower_index = pivot_index + 1;
         }
@@ -73,6 +73,8 @@ static void print_help(void)
     printf("        If a file is a .pth file then the file paths from that text file\n");
     printf("        (one per line) are used. These file paths can be absolute or\n");
     printf("        relative and can point to files, directories, or other .pth files.\n");
+    printf("        A file can also be a catalog file created with harpdump --catalog,\n");
+    printf("        in which case the cached metadata from the catalog is used.\n");
     printf("\n");
     printf("        Options:\n");
     printf("            -d '<diffvariable> <value> [unit]'\n");
@@ -35,10 +35,67 @@
 
 #include "harp.h"
 
+#include <sys/types.h>
+#include <sys/stat.h>
 #include <assert.h>
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#ifdef HAVE_DIRENT_H
+#include <dirent.h>
+#endif
+#ifdef HAVE_GETTIMEOFDAY
+#include <sys/time.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef HAVE_SYS_WAIT_H
+#include <sys/wait.h>
+#endif
+#if defined(HAVE_FORK) && defined(HAVE_SYS_WAIT_H) && defined(HAVE_UNISTD_H) && !defined(WIN32)
+#define HARPCONVERT_WORKER_POOL
+#include <signal.h>
+#endif
+
+#ifdef WIN32
+#include "windows.h"
+#endif
+
+#define BATCH_BLOCK_SIZE 64
+#define LIST_LINE_LENGTH 4096
+
+typedef struct convert_settings_struct
+{
+    const char *operations;
+    /* compiled version of the operations (only used in batch mode) */
+    harp_program *program;
+    const char *options;
+    const char *output_format;
+    int update_history;
+} convert_settings;
+
+typedef struct batch_struct
+{
+    convert_settings settings;
+    const char *output_directory;
+    const char *output_pattern;
+    int num_workers;
+    long num_files;
+    char **filename;
+    /* command line (for the product history) */
+    int argc;
+    char **argv;
+} batch;
+
+typedef struct batch_counts_struct
+{
+    long num_converted;
+    long num_empty;
+    long num_failed;
+} batch_counts;
 
 static int print_warning(const char *message, va_list ap)
 {
@@ -92,9 +149,50 @@ static void print_help()
     printf("            --no-history\n");
     printf("                Do not update the global history attribute.\n");
     printf("\n");
+    printf("            --trace <trace file>\n");
+    printf("                Time each ingestion phase and operation, print a summary\n");
+    printf("                to stderr, and write the trace events to <trace file> in\n");
+    printf("                the Chrome trace event format (viewable in chrome://tracing\n");
+    printf("                or https://ui.perfetto.dev).\n");
+    printf("\n");
     printf("        If the imported product is empty, a warning will be printed and the\n");
     printf("        tool will return with exit code 2 (without writing a file).\n");
     printf("\n");
+    printf("    harpconvert --batch [options] [-j, --jobs <n>] [-l, --list <list file>]\n");
+    printf("                [--output-pattern <pattern>] [<input>...] <output directory>\n");
+    printf("        Convert multiple products within a single HARP session, which avoids\n");
+    printf("        initializing HARP (and CODA) for each product. Each input can be a\n");
+    printf("        product file or a directory (all files in the directory will be\n");
+    printf("        converted). For each product the result of the conversion and the\n");
+    printf("        time it took are reported. A product that could not be converted\n");
+    printf("        does not stop the conversion of the remaining products.\n");
+    printf("\n");
+    printf("        Options:\n");
+    printf("            -a, --operations, -o, --options, -f, --format,\n");
+    printf("            --hdf5-compression, --no-history\n");
+    printf("                See above; these apply to each of the products.\n");
+    printf("\n");
+    printf("            -j, --jobs <n>\n");
+    printf("                Number of products to convert in parallel using worker\n");
+    printf("                processes (only on platforms that support fork()).\n");
+    printf("                Default is 1.\n");
+    printf("\n");
+    printf("            -l, --list <list file>\n");
+    printf("                Text file with the paths of input products, one path per\n");
+    printf("                line. Empty lines and lines starting with '#' are ignored.\n");
+    printf("                This option can be provided multiple times.\n");
+    printf("\n");
+    printf("            --output-pattern <pattern>\n");
+    printf("                Filename of each output product in the output directory.\n");
+    printf("                Each '{name}' in the pattern is replaced by the filename of\n");
+    printf("                the input product without its extension.\n");
+    printf("                Default is '{name}.nc' ('{name}.hdf' for hdf4 and '{name}.h5'\n");
+    printf("                for hdf5 output). It is an error if two input products\n");
+    printf("                would be written to the same output file.\n");
+    printf("\n");
+    printf("        Empty products are reported and skipped. If any of the products could\n");
+    printf("        not be converted, the tool will return with exit code 1.\n");
+    printf("\n");
     printf("    harpconvert --generate-documentation [output directory]\n");
     printf("        Generate a series of documentation files in the specified output\n");
     printf("        directory. The documentation describes the set of supported foreign\n");
@@ -136,62 +234,161 @@ static int generate_doc(int argc, char *argv[])
     return 0;
 }
 
-static int convert(int argc, char *argv[])
+static double get_time(void)
+{
+#ifdef HAVE_GETTIMEOFDAY
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + tv.tv_usec * 1.0e-6;
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static int is_directory(const char *path)
+{
+    struct stat statbuf;
+
+    if (stat(path, &statbuf) != 0)
+    {
+        if (errno == ENOENT)
+        {
+            harp_set_error(HARP_ERROR_FILE_NOT_FOUND, "could not find '%s'", path);
+        }
+        else
+        {
+            harp_set_error(HARP_ERROR_FILE_OPEN, "could not open '%s' (%s)", path, strerror(errno));
+        }
+        return -1;
+    }
+
+    return (statbuf.st_mode & S_IFDIR) ? 1 : 0;
+}
+
+/* Parse an option that applies to the conversion of a product.
+ * Returns 1 if argv[*i] was handled (*i will then point to the last argument that was consumed), 0 if argv[*i] is not
+ * a conversion option, and -1 on error.
+ */
+static int parse_convert_option(int argc, char *argv[], int *i, convert_settings *settings)
+{
+    if ((strcmp(argv[*i], "-a") == 0 || strcmp(argv[*i], "--operations") == 0) && *i + 1 < argc &&
+        argv[*i + 1][0] != '-')
+    {
+        settings->operations = argv[*i + 1];
+        (*i)++;
+        return 1;
+    }
+    if ((strcmp(argv[*i], "-f") == 0 || strcmp(argv[*i], "--format") == 0) && *i + 1 < argc &&
+        argv[*i + 1][0] != '-')
+    {
+        settings->output_format = argv[*i + 1];
+        (*i)++;
+        return 1;
+    }
+    if ((strcmp(argv[*i], "-o") == 0 || strcmp(argv[*i], "--options") == 0) && *i + 1 < argc &&
+        argv[*i + 1][0] != '-')
+    {
+        settings->options = argv[*i + 1];
+        (*i)++;
+        return 1;
+    }
+    if (strcmp(argv[*i], "--hdf5-compression") == 0 && *i + 1 < argc && argv[*i + 1][0] != '-')
+    {
+        if (harp_set_option_hdf5_compression(atoi(argv[*i + 1])) != 0)
+        {
+            fprintf(stderr, "ERROR: invalid hdf5 compression argument: '%s'\n", argv[*i]);
+            print_help();
+            return -1;
+        }
+        (*i)++;
+        return 1;
+    }
+    if (strcmp(argv[*i], "--no-history") == 0)
+    {
+        settings->update_history = 0;
+        return 1;
+    }
+
+    return 0;
+}
+
+static int convert_file(const char *input_filename, const char *output_filename, const convert_settings *settings,
+                        int argc, char *argv[])
 {
     harp_product *product;
-    const char *operations = NULL;
-    const char *options = NULL;
-    const char *output_filename = NULL;
-    const char *output_format = "netcdf";
-    const char *input_filename = NULL;
-    int update_history = 1;
-    int i;
 
-    for (i = 1; i < argc; i++)
+    if (settings->program != NULL)
     {
-        if ((strcmp(argv[i], "-a") == 0 || strcmp(argv[i], "--operations") == 0) && i + 1 < argc &&
-            argv[i + 1][0] != '-')
+        if (harp_import_with_program(input_filename, settings->program, settings->options, &product) != 0)
         {
-            operations = argv[i + 1];
-            i++;
+            return -1;
         }
-        else if ((strcmp(argv[i], "-f") == 0 || strcmp(argv[i], "--format") == 0) && i + 1 < argc
-                 && argv[i + 1][0] != '-')
+    }
+    else if (harp_import(input_filename, settings->operations, settings->options, &product) != 0)
+    {
+        return -1;
+    }
+
+    if (harp_product_is_empty(product))
+    {
+        harp_product_delete(product);
+        return -2;
+    }
+
+    if (settings->update_history)
+    {
+        /* Update the product history */
+        if (harp_product_update_history(product, "harpconvert", argc, argv) != 0)
         {
-            output_format = argv[i + 1];
-            i++;
+            harp_product_delete(product);
+            return -1;
         }
-        else if ((strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--options") == 0) && i + 1 < argc
-                 && argv[i + 1][0] != '-')
+    }
+
+    /* Export the product */
+    if (harp_export(output_filename, settings->output_format, product) != 0)
+    {
+        harp_product_delete(product);
+        return -1;
+    }
+
+    harp_product_delete(product);
+    return 0;
+}
+
+static int convert(int argc, char *argv[])
+{
+    convert_settings settings = { NULL, NULL, NULL, "netcdf", 1 };
+    const char *trace_filename = NULL;
+    int result;
+    int i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc && argv[i + 1][0] != '-')
         {
-            options = argv[i + 1];
+            trace_filename = argv[i + 1];
             i++;
+            continue;
         }
-        else if (strcmp(argv[i], "--hdf5-compression") == 0 && i + 1 < argc && argv[i + 1][0] != '-')
+        result = parse_convert_option(argc, argv, &i, &settings);
+        if (result == -1)
         {
-            if (harp_set_option_hdf5_compression(atoi(argv[i + 1])) != 0)
-            {
-                fprintf(stderr, "ERROR: invalid hdf5 compression argument: '%s'\n", argv[i]);
-                print_help();
-                return -1;
-            }
-            i++;
+            return -1;
         }
-        else if (strcmp(argv[i], "--no-history") == 0)
+        if (result == 1)
         {
-            update_history = 0;
+            continue;
         }
-        else if (argv[i][0] != '-')
+        if (argv[i][0] != '-')
         {
             /* Assume the next argument is an input file. */
             break;
         }
-        else
-        {
-            fprintf(stderr, "ERROR: invalid argument: '%s'\n", argv[i]);
-            print_help();
-            return -1;
-        }
+        fprintf(stderr, "ERROR: invalid argument: '%s'\n", argv[i]);
+        print_help();
+        return -1;
     }
 
     if (i != argc - 2)
@@ -201,106 +398,921 @@ static int convert(int argc, char *argv[])
         return -1;
     }
 
-    input_filename = argv[argc - 2];
-    output_filename = argv[argc - 1];
+    if (trace_filename != NULL)
+    {
+        harp_set_option_trace(1);
+    }
 
-    if (harp_import(input_filename, operations, options, &product) != 0)
+    result = convert_file(argv[argc - 2], argv[argc - 1], &settings, argc, argv);
+
+    if (trace_filename != NULL)
     {
-        return -1;
+        harp_trace_print_summary(NULL);
+        if (harp_trace_write_chrome_trace(trace_filename) != 0)
+        {
+            fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
+            if (result == 0)
+            {
+                result = -3;
+            }
+        }
+        harp_trace_clear();
     }
 
-    if (harp_product_is_empty(product))
+    return result;
+}
+
+static void batch_done(batch *b)
+{
+    if (b->settings.program != NULL)
     {
-        harp_product_delete(product);
-        return -2;
+        harp_program_delete(b->settings.program);
+    }
+    if (b->filename != NULL)
+    {
+        long i;
+
+        for (i = 0; i < b->num_files; i++)
+        {
+            free(b->filename[i]);
+        }
+        free(b->filename);
     }
+}
 
-    if (update_history)
+static int batch_add_file(batch *b, const char *filename)
+{
+    if (b->num_files % BATCH_BLOCK_SIZE == 0)
     {
-        /* Update the product history */
-        if (harp_product_update_history(product, "harpconvert", argc, argv) != 0)
+        char **new_filename;
+
+        new_filename = (char **)realloc(b->filename, (b->num_files + BATCH_BLOCK_SIZE) * sizeof(char *));
+        if (new_filename == NULL)
         {
-            harp_product_delete(product);
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                           (b->num_files + BATCH_BLOCK_SIZE) * sizeof(char *), __FILE__, __LINE__);
             return -1;
         }
+        b->filename = new_filename;
     }
 
-    /* Export the product */
-    if (harp_export(output_filename, output_format, product) != 0)
+    b->filename[b->num_files] = strdup(filename);
+    if (b->filename[b->num_files] == NULL)
     {
-        harp_product_delete(product);
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not duplicate string) (%s:%u)", __FILE__,
+                       __LINE__);
         return -1;
     }
+    b->num_files++;
 
-    harp_product_delete(product);
     return 0;
 }
 
-int main(int argc, char *argv[])
+static int batch_add_directory_file(batch *b, const char *directory, const char *name)
 {
-    int result;
+    char *filename;
 
-    if (argc == 1 || strcmp(argv[1], "-h") == 0 || strcmp(argv[1], "--help") == 0)
+    filename = malloc(strlen(directory) + 1 + strlen(name) + 1);
+    if (filename == NULL)
     {
-        print_help();
-        exit(0);
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       (long)strlen(directory) + 1 + strlen(name) + 1, __FILE__, __LINE__);
+        return -1;
     }
+#ifdef WIN32
+    sprintf(filename, "%s\\%s", directory, name);
+#else
+    sprintf(filename, "%s/%s", directory, name);
+#endif
 
-    if (strcmp(argv[1], "-v") == 0 || strcmp(argv[1], "--version") == 0)
+    if (batch_add_file(b, filename) != 0)
     {
-        print_version();
-        exit(0);
+        free(filename);
+        return -1;
     }
+    free(filename);
 
-    if (argc < 2)
+    return 0;
+}
+
+static int compare_filename(const void *a, const void *b)
+{
+    return strcmp(*(const char **)a, *(const char **)b);
+}
+
+/* Add all files (but not subdirectories) of a directory in alphabetical order. */
+static int batch_add_directory(batch *b, const char *directory)
+{
+    long first_index = b->num_files;
+#ifdef WIN32
+    WIN32_FIND_DATA FileData;
+    HANDLE hSearch;
+    BOOL fFinished;
+    char *pattern;
+
+    pattern = malloc(strlen(directory) + 4 + 1);
+    if (pattern == NULL)
     {
-        fprintf(stderr, "ERROR: invalid arguments\n");
-        print_help();
-        exit(1);
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       (long)strlen(directory) + 4 + 1, __FILE__, __LINE__);
+        return -1;
     }
+    sprintf(pattern, "%s\\*.*", directory);
+    hSearch = FindFirstFile(pattern, &FileData);
+    free(pattern);
 
-    if (harp_set_coda_definition_path_conditional(argv[0], NULL, "../share/coda/definitions") != 0)
+    if (hSearch == INVALID_HANDLE_VALUE)
     {
-        fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
-        exit(1);
+        if (GetLastError() == ERROR_FILE_NOT_FOUND || GetLastError() == ERROR_NO_MORE_FILES)
+        {
+            /* no files found */
+            return 0;
+        }
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "could not access directory '%s'", directory);
+        return -1;
     }
-    if (harp_set_udunits2_xml_path_conditional(argv[0], NULL, "../share/harp/udunits2.xml") != 0)
+
+    fFinished = FALSE;
+    while (!fFinished)
     {
-        fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
-        exit(1);
+        if (!(FileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+        {
+            if (batch_add_directory_file(b, directory, FileData.cFileName) != 0)
+            {
+                FindClose(hSearch);
+                return -1;
+            }
+        }
+
+        if (!FindNextFile(hSearch, &FileData))
+        {
+            if (GetLastError() == ERROR_NO_MORE_FILES)
+            {
+                fFinished = TRUE;
+            }
+            else
+            {
+                harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "could not retrieve directory entry");
+                FindClose(hSearch);
+                return -1;
+            }
+        }
     }
+    FindClose(hSearch);
+#else
+    DIR *dirp = NULL;
+    struct dirent *dp = NULL;
 
-    harp_set_warning_handler(print_warning);
+    dirp = opendir(directory);
+    if (dirp == NULL)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "could not open directory %s", directory);
+        return -1;
+    }
 
-    if (harp_init() != 0)
+    while ((dp = readdir(dirp)) != NULL)
     {
-        fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
-        exit(1);
+        long index = b->num_files;
+        int result;
+
+        if (strcmp(dp->d_name, ".") == 0 || strcmp(dp->d_name, "..") == 0)
+        {
+            continue;
+        }
+
+        if (batch_add_directory_file(b, directory, dp->d_name) != 0)
+        {
+            closedir(dirp);
+            return -1;
+        }
+
+        /* skip subdirectories */
+        result = is_directory(b->filename[index]);
+        if (result == -1)
+        {
+            closedir(dirp);
+            return -1;
+        }
+        if (result)
+        {
+            free(b->filename[index]);
+            b->num_files--;
+        }
     }
 
-    if (strcmp(argv[1], "--generate-documentation") == 0)
+    closedir(dirp);
+#endif
+
+    qsort(&b->filename[first_index], b->num_files - first_index, sizeof(char *), compare_filename);
+
+    return 0;
+}
+
+static int batch_add_path(batch *b, const char *path)
+{
+    if (is_directory(path) == 1)
     {
-        result = generate_doc(argc, argv);
+        return batch_add_directory(b, path);
     }
-    else
+
+    /* paths that can not be accessed will be reported when converting them */
+    return batch_add_file(b, path);
+}
+
+static int batch_add_list_file(batch *b, const char *list_filename)
+{
+    char line[LIST_LINE_LENGTH];
+    FILE *stream;
+
+    stream = fopen(list_filename, "r");
+    if (stream == NULL)
     {
-        result = convert(argc, argv);
+        harp_set_error(HARP_ERROR_FILE_OPEN, "could not open list file '%s' (%s)", list_filename, strerror(errno));
+        return -1;
     }
 
-    if (result == -1)
+    while (fgets(line, LIST_LINE_LENGTH, stream) != NULL)
     {
-        if (harp_errno != HARP_SUCCESS)
+        long length = (long)strlen(line);
+
+        /* strip trailing whitespace (including the newline) */
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r' || line[length - 1] == ' ' ||
+                              line[length - 1] == '\t'))
         {
-            fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
+            length--;
+        }
+        line[length] = '\0';
+
+        if (length == 0 || line[0] == '#')
+        {
+            continue;
+        }
+
+        if (batch_add_path(b, line) != 0)
+        {
+            fclose(stream);
+            return -1;
         }
-        harp_done();
-        exit(1);
     }
-    else if (result == -2)
+
+    if (ferror(stream))
     {
-        harp_report_warning("product is empty");
-        harp_done();
-        exit(2);
+        harp_set_error(HARP_ERROR_FILE_READ, "error reading list file '%s'", list_filename);
+        fclose(stream);
+        return -1;
+    }
+
+    fclose(stream);
+
+    return 0;
+}
+
+/* Determine the output path for an input product by substituting the filename of the input product (without path
+ * and extension) for each '{name}' in the output pattern.
+ */
+static int get_output_filename(const batch *b, const char *input_filename, char **output_filename)
+{
+    const char *name;
+    const char *pattern;
+    const char *extension;
+    char *filename;
+    long name_length;
+    long length;
+    long i;
+
+    name = input_filename;
+    for (i = 0; input_filename[i] != '\0'; i++)
+    {
+#ifdef WIN32
+        if (input_filename[i] == '/' || input_filename[i] == '\\')
+#else
+        if (input_filename[i] == '/')
+#endif
+        {
+            name = &input_filename[i + 1];
+        }
+    }
+    extension = strrchr(name, '.');
+    name_length = (extension == NULL || extension == name) ? (long)strlen(name) : (long)(extension - name);
+
+    pattern = b->output_pattern;
+    length = (long)strlen(b->output_directory) + 1;
+    for (i = 0; pattern[i] != '\0'; i++)
+    {
+        if (strncmp(&pattern[i], "{name}", 6) == 0)
+        {
+            length += name_length;
+            i += 5;
+        }
+        else
+        {
+            length++;
+        }
+    }
+
+    filename = malloc(length + 1);
+    if (filename == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)", length + 1,
+                       __FILE__, __LINE__);
+        return -1;
+    }
+
+#ifdef WIN32
+    sprintf(filename, "%s\\", b->output_directory);
+#else
+    sprintf(filename, "%s/", b->output_directory);
+#endif
+    length = (long)strlen(filename);
+    for (i = 0; pattern[i] != '\0'; i++)
+    {
+        if (strncmp(&pattern[i], "{name}", 6) == 0)
+        {
+            memcpy(&filename[length], name, name_length);
+            length += name_length;
+            i += 5;
+        }
+        else
+        {
+            filename[length] = pattern[i];
+            length++;
+        }
+    }
+    filename[length] = '\0';
+
+    *output_filename = filename;
+    return 0;
+}
+
+typedef struct output_entry_struct
+{
+    char *filename;
+    long index;
+} output_entry;
+
+static int compare_output_entries(const void *a, const void *b)
+{
+    const output_entry *entry_a = (const output_entry *)a;
+    const output_entry *entry_b = (const output_entry *)b;
+    int result;
+
+    result = strcmp(entry_a->filename, entry_b->filename);
+    if (result == 0)
+    {
+        return entry_a->index < entry_b->index ? -1 : (entry_a->index > entry_b->index);
+    }
+
+    return result;
+}
+
+/* Verify that no two input products map to the same output file (e.g. input files with the same name in different
+ * directories), since the product that is converted last would then silently replace the other.
+ */
+static int check_output_filenames(const batch *b)
+{
+    output_entry *entry;
+    long i;
+    int result = 0;
+
+    if (b->num_files < 2)
+    {
+        return 0;
+    }
+
+    entry = (output_entry *)malloc(b->num_files * sizeof(output_entry));
+    if (entry == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       b->num_files * sizeof(output_entry), __FILE__, __LINE__);
+        return -1;
+    }
+    for (i = 0; i < b->num_files; i++)
+    {
+        entry[i].index = i;
+        if (get_output_filename(b, b->filename[i], &entry[i].filename) != 0)
+        {
+            while (i > 0)
+            {
+                i--;
+                free(entry[i].filename);
+            }
+            free(entry);
+            return -1;
+        }
+    }
+
+    qsort(entry, b->num_files, sizeof(output_entry), compare_output_entries);
+    for (i = 1; i < b->num_files; i++)
+    {
+        if (strcmp(entry[i - 1].filename, entry[i].filename) == 0)
+        {
+            harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "input products '%s' and '%s' would both be written to '%s' "
+                           "(use --output-pattern to create unique output filenames)",
+                           b->filename[entry[i - 1].index], b->filename[entry[i].index], entry[i].filename);
+            result = -1;
+            break;
+        }
+    }
+
+    for (i = 0; i < b->num_files; i++)
+    {
+        free(entry[i].filename);
+    }
+    free(entry);
+
+    return result;
+}
+
+/* Convert a single product of the batch and report the result.
+ * Returns the result of convert_file() (0 = converted, -1 = failed, -2 = product is empty).
+ */
+static int batch_convert_file(batch *b, long index)
+{
+    const char *input_filename = b->filename[index];
+    char *output_filename = NULL;
+    double start_time;
+    int result;
+
+    start_time = get_time();
+    result = get_output_filename(b, input_filename, &output_filename);
+    if (result == 0)
+    {
+        result = convert_file(input_filename, output_filename, &b->settings, b->argc, b->argv);
+    }
+
+    if (result == 0)
+    {
+        printf("%s -> %s (%.3f s)\n", input_filename, output_filename, get_time() - start_time);
+    }
+    else if (result == -2)
+    {
+        printf("%s: product is empty, skipped (%.3f s)\n", input_filename, get_time() - start_time);
+    }
+    else
+    {
+        fprintf(stderr, "ERROR: %s: %s\n", input_filename, harp_errno_to_string(harp_errno));
+    }
+    fflush(stdout);
+    fflush(stderr);
+
+    if (output_filename != NULL)
+    {
+        free(output_filename);
+    }
+
+    return result;
+}
+
+static void update_counts(batch_counts *counts, int result)
+{
+    if (result == 0)
+    {
+        counts->num_converted++;
+    }
+    else if (result == -2)
+    {
+        counts->num_empty++;
+    }
+    else
+    {
+        counts->num_failed++;
+    }
+}
+
+#ifdef HARPCONVERT_WORKER_POOL
+/* Convert the products of the batch using a pool of worker processes.
+ * The library is not thread-safe, so the workers are processes that are forked after HARP was initialized; they inherit
+ * what the parent already set up (such as the compiled operations). Ingestion modules are only initialized once a
+ * product of their product class is encountered, so each worker initializes the modules it needs itself (this is a
+ * one-time cost per worker and product class). The parent hands out the indices of the products through a pipe, so a
+ * worker picks up the next product as soon as it is done with its previous one. Each worker records the result per
+ * product in its own temporary file, which the parent reads once all workers have finished. A product for which no
+ * result was recorded (e.g. because its worker crashed) counts as failed.
+ */
+static int batch_convert_parallel(batch *b, batch_counts *counts)
+{
+    FILE **stream;
+    pid_t *pid;
+    signed char *file_result;
+    int fd[2];
+    int result = 0;
+    long i;
+    int k;
+
+    file_result = malloc(b->num_files * sizeof(signed char));
+    if (file_result == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       b->num_files * sizeof(signed char), __FILE__, __LINE__);
+        return -1;
+    }
+    stream = (FILE **)malloc(b->num_workers * sizeof(FILE *));
+    if (stream == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       b->num_workers * sizeof(FILE *), __FILE__, __LINE__);
+        free(file_result);
+        return -1;
+    }
+    pid = (pid_t *)malloc(b->num_workers * sizeof(pid_t));
+    if (pid == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       b->num_workers * sizeof(pid_t), __FILE__, __LINE__);
+        free(stream);
+        free(file_result);
+        return -1;
+    }
+    for (i = 0; i < b->num_files; i++)
+    {
+        /* 1 = no result */
+        file_result[i] = 1;
+    }
+    for (k = 0; k < b->num_workers; k++)
+    {
+        stream[k] = NULL;
+        pid[k] = -1;
+    }
+
+    if (pipe(fd) != 0)
+    {
+        harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "could not create pipe (%s)", strerror(errno));
+        free(pid);
+        free(stream);
+        free(file_result);
+        return -1;
+    }
+
+    /* make sure buffered output does not get duplicated by the workers */
+    fflush(NULL);
+
+    for (k = 0; k < b->num_workers; k++)
+    {
+        stream[k] = tmpfile();
+        if (stream[k] == NULL)
+        {
+            harp_set_error(HARP_ERROR_FILE_OPEN, "could not create temporary file (%s)", strerror(errno));
+            result = -1;
+            break;
+        }
+        pid[k] = fork();
+        if (pid[k] < 0)
+        {
+            harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "could not create worker process (%s)", strerror(errno));
+            result = -1;
+            break;
+        }
+        if (pid[k] == 0)
+        {
+            /* worker process */
+            close(fd[1]);
+            while (read(fd[0], &i, sizeof(long)) == sizeof(long))
+            {
+                fprintf(stream[k], "%ld %d\n", i, batch_convert_file(b, i));
+                fflush(stream[k]);
+            }
+            _exit(0);
+        }
+    }
+    close(fd[0]);
+
+    if (result == 0)
+    {
+        void (*sigpipe_handler) (int);
+
+        /* if all workers are gone, writing to the pipe should fail with EPIPE instead of terminating harpconvert */
+        sigpipe_handler = signal(SIGPIPE, SIG_IGN);
+
+        /* hand out the products; each index is written separately, which is atomic for pipes */
+        for (i = 0; i < b->num_files; i++)
+        {
+            ssize_t num_written;
+
+            do
+            {
+                num_written = write(fd[1], &i, sizeof(long));
+            } while (num_written < 0 && errno == EINTR);
+            if (num_written != sizeof(long))
+            {
+                /* all workers are gone (EPIPE); the remaining products will be reported as failed */
+                break;
+            }
+        }
+        close(fd[1]);
+
+        if (sigpipe_handler != SIG_ERR)
+        {
+            signal(SIGPIPE, sigpipe_handler);
+        }
+    }
+    else
+    {
+        close(fd[1]);
+    }
+
+    /* wait for all workers that were started */
+    for (k = 0; k < b->num_workers; k++)
+    {
+        if (pid[k] > 0)
+        {
+            int status;
+
+            while (waitpid(pid[k], &status, 0) < 0 && errno == EINTR)
+            {
+            }
+        }
+    }
+
+    for (k = 0; k < b->num_workers; k++)
+    {
+        if (stream[k] != NULL)
+        {
+            int file_status;
+
+            rewind(stream[k]);
+            while (fscanf(stream[k], "%ld %d", &i, &file_status) == 2)
+            {
+                if (i >= 0 && i < b->num_files)
+                {
+                    file_result[i] = (signed char)file_status;
+                }
+            }
+            fclose(stream[k]);
+        }
+    }
+
+    if (result == 0)
+    {
+        for (i = 0; i < b->num_files; i++)
+        {
+            if (file_result[i] == 1)
+            {
+                fprintf(stderr, "ERROR: %s: conversion did not complete (worker process terminated)\n",
+                        b->filename[i]);
+                file_result[i] = -1;
+            }
+            update_counts(counts, file_result[i]);
+        }
+    }
+
+    free(pid);
+    free(stream);
+    free(file_result);
+
+    return result;
+}
+#endif
+
+static int batch_convert(int argc, char *argv[])
+{
+    batch_counts counts = { 0, 0, 0 };
+    double start_time;
+    batch b;
+    int result;
+    int i;
+
+    b.settings.operations = NULL;
+    b.settings.program = NULL;
+    b.settings.options = NULL;
+    b.settings.output_format = "netcdf";
+    b.settings.update_history = 1;
+    b.output_directory = NULL;
+    b.output_pattern = NULL;
+    b.num_workers = 1;
+    b.num_files = 0;
+    b.filename = NULL;
+    b.argc = argc;
+    b.argv = argv;
+
+    for (i = 2; i < argc; i++)
+    {
+        result = parse_convert_option(argc, argv, &i, &b.settings);
+        if (result == -1)
+        {
+            batch_done(&b);
+            return -1;
+        }
+        if (result == 1)
+        {
+            continue;
+        }
+        if ((strcmp(argv[i], "-j") == 0 || strcmp(argv[i], "--jobs") == 0) && i + 1 < argc && argv[i + 1][0] != '-')
+        {
+            char *endptr;
+
+            b.num_workers = (int)strtol(argv[i + 1], &endptr, 10);
+            if (*endptr != '\0' || b.num_workers < 1)
+            {
+                fprintf(stderr, "ERROR: invalid number of jobs '%s'\n", argv[i + 1]);
+                print_help();
+                batch_done(&b);
+                return -1;
+            }
+            i++;
+        }
+        else if ((strcmp(argv[i], "-l") == 0 || strcmp(argv[i], "--list") == 0) && i + 1 < argc &&
+                 argv[i + 1][0] != '-')
+        {
+            if (batch_add_list_file(&b, argv[i + 1]) != 0)
+            {
+                batch_done(&b);
+                return -1;
+            }
+            i++;
+        }
+        else if (strcmp(argv[i], "--output-pattern") == 0 && i + 1 < argc && argv[i + 1][0] != '-')
+        {
+            b.output_pattern = argv[i + 1];
+            i++;
+        }
+        else if (argv[i][0] != '-')
+        {
+            /* assume all arguments from here on are inputs followed by the output directory */
+            break;
+        }
+        else
+        {
+            fprintf(stderr, "ERROR: invalid argument: '%s'\n", argv[i]);
+            print_help();
+            batch_done(&b);
+            return -1;
+        }
+    }
+
+    if (i >= argc)
+    {
+        fprintf(stderr, "ERROR: output directory not specified\n");
+        print_help();
+        batch_done(&b);
+        return -1;
+    }
+    b.output_directory = argv[argc - 1];
+    for (; i < argc - 1; i++)
+    {
+        if (batch_add_path(&b, argv[i]) != 0)
+        {
+            batch_done(&b);
+            return -1;
+        }
+    }
+
+    result = is_directory(b.output_directory);
+    if (result != 1)
+    {
+        if (result == 0)
+        {
+            harp_set_error(HARP_ERROR_INVALID_ARGUMENT, "'%s' is not a directory", b.output_directory);
+        }
+        batch_done(&b);
+        return -1;
+    }
+
+    if (b.output_pattern == NULL)
+    {
+        if (strcmp(b.settings.output_format, "hdf4") == 0)
+        {
+            b.output_pattern = "{name}.hdf";
+        }
+        else if (strcmp(b.settings.output_format, "hdf5") == 0)
+        {
+            b.output_pattern = "{name}.h5";
+        }
+        else
+        {
+            b.output_pattern = "{name}.nc";
+        }
+    }
+
+    if (check_output_filenames(&b) != 0)
+    {
+        batch_done(&b);
+        return -1;
+    }
+
+    if (b.settings.operations != NULL)
+    {
+        /* parse the operations (and load the files that they refer to) only once for all products */
+        if (harp_program_compile(b.settings.operations, &b.settings.program) != 0)
+        {
+            batch_done(&b);
+            return -1;
+        }
+    }
+
+    if (b.num_workers > b.num_files)
+    {
+        b.num_workers = b.num_files > 0 ? (int)b.num_files : 1;
+    }
+
+    start_time = get_time();
+#ifdef HARPCONVERT_WORKER_POOL
+    if (b.num_workers > 1)
+    {
+        if (batch_convert_parallel(&b, &counts) != 0)
+        {
+            batch_done(&b);
+            return -1;
+        }
+    }
+    else
+#endif
+    {
+        long index;
+
+        for (index = 0; index < b.num_files; index++)
+        {
+            update_counts(&counts, batch_convert_file(&b, index));
+        }
+    }
+
+    printf("%ld product(s) converted, %ld empty, %ld failed (%.3f s)\n", counts.num_converted, counts.num_empty,
+           counts.num_failed, get_time() - start_time);
+
+    batch_done(&b);
+
+    if (counts.num_failed > 0)
+    {
+        /* errors have already been reported per product */
+        return -3;
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    int result;
+
+    if (argc == 1 || strcmp(argv[1], "-h") == 0 || strcmp(argv[1], "--help") == 0)
+    {
+        print_help();
+        exit(0);
+    }
+
+    if (strcmp(argv[1], "-v") == 0 || strcmp(argv[1], "--version") == 0)
+    {
+        print_version();
+        exit(0);
+    }
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "ERROR: invalid arguments\n");
+        print_help();
+        exit(1);
+    }
+
+    if (harp_set_coda_definition_path_conditional(argv[0], NULL, "../share/coda/definitions") != 0)
+    {
+        fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
+        exit(1);
+    }
+    if (harp_set_udunits2_xml_path_conditional(argv[0], NULL, "../share/harp/udunits2.xml") != 0)
+    {
+        fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
+        exit(1);
+    }
+
+    harp_set_warning_handler(print_warning);
+
+    if (harp_init() != 0)
+    {
+        fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
+        exit(1);
+    }
+
+    if (strcmp(argv[1], "--generate-documentation") == 0)
+    {
+        result = generate_doc(argc, argv);
+    }
+    else if (strcmp(argv[1], "--batch") == 0)
+    {
+        result = batch_convert(argc, argv);
+    }
+    else
+    {
+        result = convert(argc, argv);
+    }
+
+    if (result == -1)
+    {
+        if (harp_errno != HARP_SUCCESS)
+        {
+            fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
+        }
+        harp_done();
+        exit(1);
+    }
+    else if (result == -2)
+    {
+        harp_report_warning("product is empty");
+        harp_done();
+        exit(2);
+    }
+    else if (result == -3)
+    {
+        harp_done();
+        exit(1);
     }
     else if (result == 1)
     {
@@ -35,10 +35,21 @@
 
 #include "harp.h"
 
+#include <sys/types.h>
 #include <assert.h>
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef HAVE_SYS_WAIT_H
+#include <sys/wait.h>
+#endif
+#if defined(HAVE_FORK) && defined(HAVE_SYS_WAIT_H) && defined(HAVE_UNISTD_H) && !defined(WIN32)
+#define HARPDUMP_WORKER_POOL
+#endif
 
 static int print_warning(const char *message, va_list ap)
 {
@@ -96,6 +107,26 @@ static void print_help()
     printf("                of an <option name>=<value> pair. An option list needs to be\n");
     printf("                provided as a single expression.\n");
     printf("\n");
+    printf("    harpdump --catalog <catalog file> [options] <file|dir> [<file|dir> ...]\n");
+    printf("        Create or update a catalog file with the metadata of all files in the\n");
+    printf("        dataset. Only files that are not yet in the catalog or that were\n");
+    printf("        modified since they were added are read. The catalog file can be\n");
+    printf("        used as dataset path for the other HARP tools.\n");
+    printf("\n");
+    printf("            -o, --options <option list>\n");
+    printf("                List of options to pass to the ingestion module.\n");
+    printf("                Only applicable if the input product is not in HARP format.\n");
+    printf("                Options are separated by semi-colons. Each option consists\n");
+    printf("                of an <option name>=<value> pair. An option list needs to be\n");
+    printf("                provided as a single expression.\n");
+    printf("\n");
+    printf("            -j, --jobs <n>\n");
+    printf("                Number of worker processes to use for reading the metadata of\n");
+    printf("                new or modified files (default: 1).\n");
+    printf("\n");
+    printf("            -p, --print\n");
+    printf("                Print metadata for all files in the dataset in csv format.\n");
+    printf("\n");
     printf("    harpdump --list-derivations [options] [input product file]\n");
     printf("        List all available variable conversions. If an input product file is\n");
     printf("        specified, limit the list to variable conversions that are possible\n");
@@ -119,6 +150,12 @@ static void print_help()
     printf("            -t, --target <variable_name>\n");
     printf("                Only show derivations that produce the given variable.\n");
     printf("\n");
+    printf("    harpdump --explain <operation list>\n");
+    printf("        Show the order in which the operations will be executed after\n");
+    printf("        optimization. Operations that can be performed as part of the\n");
+    printf("        ingestion of a product (if it is not in HARP format) are marked\n");
+    printf("        with [ingestion].\n");
+    printf("\n");
     printf("\n");
     printf("    harpdump -h, --help\n");
     printf("        Show help (this text).\n");
@@ -197,6 +234,18 @@ static int list_derivations(int argc, char *argv[])
     return 0;
 }
 
+static int explain(int argc, char *argv[])
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "ERROR: invalid arguments\n");
+        print_help();
+        exit(1);
+    }
+
+    return harp_doc_list_operations(argv[2], printf);
+}
+
 static int dump_dataset(int argc, char *argv[])
 {
     const char *options = NULL;
@@ -244,6 +293,366 @@ static int dump_dataset(int argc, char *argv[])
     return 0;
 }
 
+#ifdef HARPDUMP_WORKER_POOL
+/* Read the metadata of the given files into the catalog using worker processes.
+ * The library is not thread-safe, so the workers are forked processes. Each worker gets a consecutive part of the file
+ * list (passed as a .pth file) and creates its own partial catalog file next to the catalog file. The parent then
+ * merges the partial catalogs into the catalog. Parts of workers that succeeded are always merged, so a rerun only
+ * needs to read the files of the workers that failed.
+ */
+static int scan_files_parallel(long num_files, char **filename, const char *options, const char *catalog_filename,
+                               int num_workers)
+{
+    char **part_filename;
+    int *part_status;
+    pid_t *pid;
+    int num_failed = 0;
+    int result = 0;
+    int k;
+
+    if (num_workers > num_files)
+    {
+        num_workers = (int)num_files;
+    }
+
+    /* part_filename[2 * k] is the .pth file and part_filename[2 * k + 1] the partial catalog of worker k */
+    part_filename = (char **)malloc(2 * num_workers * sizeof(char *));
+    if (part_filename == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       2 * num_workers * sizeof(char *), __FILE__, __LINE__);
+        return -1;
+    }
+    part_status = (int *)malloc(num_workers * sizeof(int));
+    if (part_status == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       num_workers * sizeof(int), __FILE__, __LINE__);
+        free(part_filename);
+        return -1;
+    }
+    pid = (pid_t *)malloc(num_workers * sizeof(pid_t));
+    if (pid == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       num_workers * sizeof(pid_t), __FILE__, __LINE__);
+        free(part_status);
+        free(part_filename);
+        return -1;
+    }
+    for (k = 0; k < num_workers; k++)
+    {
+        part_filename[2 * k] = NULL;
+        part_filename[2 * k + 1] = NULL;
+        /* 1 = failed */
+        part_status[k] = 1;
+        pid[k] = -1;
+    }
+
+    for (k = 0; k < num_workers && result == 0; k++)
+    {
+        long first = ((long)k * num_files) / num_workers;
+        long last = ((long)(k + 1) * num_files) / num_workers;
+        FILE *stream;
+        long i;
+
+        part_filename[2 * k] = malloc(strlen(catalog_filename) + 32);
+        part_filename[2 * k + 1] = malloc(strlen(catalog_filename) + 32);
+        if (part_filename[2 * k] == NULL || part_filename[2 * k + 1] == NULL)
+        {
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                           strlen(catalog_filename) + 32, __FILE__, __LINE__);
+            result = -1;
+            break;
+        }
+        sprintf(part_filename[2 * k], "%s.%ld.part%d.pth", catalog_filename, (long)getpid(), k);
+        sprintf(part_filename[2 * k + 1], "%s.%ld.part%d.csv", catalog_filename, (long)getpid(), k);
+
+        stream = fopen(part_filename[2 * k], "w");
+        if (stream == NULL)
+        {
+            harp_set_error(HARP_ERROR_FILE_OPEN, "could not open '%s' for writing (%s)", part_filename[2 * k],
+                           strerror(errno));
+            result = -1;
+            break;
+        }
+        for (i = first; i < last; i++)
+        {
+            fprintf(stream, "%s\n", filename[i]);
+        }
+        if (fclose(stream) != 0)
+        {
+            harp_set_error(HARP_ERROR_FILE_WRITE, "could not write '%s' (%s)", part_filename[2 * k],
+                           strerror(errno));
+            result = -1;
+            break;
+        }
+    }
+
+    /* make sure buffered output does not get duplicated by the workers */
+    fflush(NULL);
+
+    for (k = 0; k < num_workers && result == 0; k++)
+    {
+        pid[k] = fork();
+        if (pid[k] < 0)
+        {
+            harp_set_error(HARP_ERROR_IMPORT, "could not create worker process (%s)", strerror(errno));
+            result = -1;
+            break;
+        }
+        if (pid[k] == 0)
+        {
+            harp_dataset *dataset;
+
+            /* worker process */
+            if (harp_dataset_new(&dataset) != 0)
+            {
+                fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
+                fflush(stderr);
+                _exit(1);
+            }
+            if (harp_dataset_import_with_catalog(dataset, part_filename[2 * k], options, part_filename[2 * k + 1])
+                != 0)
+            {
+                fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
+                fflush(stderr);
+                _exit(1);
+            }
+            _exit(0);
+        }
+    }
+
+    /* wait for all workers that were started */
+    for (k = 0; k < num_workers; k++)
+    {
+        if (pid[k] > 0)
+        {
+            int status;
+
+            while (waitpid(pid[k], &status, 0) < 0 && errno == EINTR)
+            {
+            }
+            if (WIFEXITED(status))
+            {
+                part_status[k] = WEXITSTATUS(status);
+            }
+            if (part_status[k] != 0)
+            {
+                num_failed++;
+            }
+        }
+    }
+
+    /* merge the partial catalogs of the workers that succeeded into the catalog */
+    for (k = 0; k < num_workers; k++)
+    {
+        if (result == 0 && pid[k] > 0 && part_status[k] == 0)
+        {
+            harp_dataset *dataset;
+
+            if (harp_dataset_new(&dataset) != 0)
+            {
+                result = -1;
+            }
+            else
+            {
+                if (harp_dataset_import_with_catalog(dataset, part_filename[2 * k + 1], options, catalog_filename)
+                    != 0)
+                {
+                    result = -1;
+                }
+                harp_dataset_delete(dataset);
+            }
+        }
+    }
+
+    if (result == 0 && num_failed > 0)
+    {
+        harp_set_error(HARP_ERROR_IMPORT, "reading metadata failed for %d of %d worker processes", num_failed,
+                       num_workers);
+        result = -1;
+    }
+
+    for (k = 0; k < 2 * num_workers; k++)
+    {
+        if (part_filename[k] != NULL)
+        {
+            remove(part_filename[k]);
+            free(part_filename[k]);
+        }
+    }
+    free(pid);
+    free(part_status);
+    free(part_filename);
+
+    return result;
+}
+
+/* Read the metadata of all files that are new or outdated in the catalog using num_workers worker processes */
+static int update_catalog_parallel(int num_paths, char **path, const char *options, const char *catalog_filename,
+                                   int num_workers)
+{
+    char **filename = NULL;
+    long num_files = 0;
+    long i;
+    int result = 0;
+    int k;
+
+    for (k = 0; k < num_paths && result == 0; k++)
+    {
+        char **path_filename;
+        long num_path_files;
+
+        if (harp_dataset_get_outdated_catalog_files(path[k], options, catalog_filename, &num_path_files,
+                                                    &path_filename) != 0)
+        {
+            result = -1;
+            break;
+        }
+        if (num_path_files > 0)
+        {
+            char **new_filename;
+
+            new_filename = (char **)realloc(filename, (num_files + num_path_files) * sizeof(char *));
+            if (new_filename == NULL)
+            {
+                harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                               (num_files + num_path_files) * sizeof(char *), __FILE__, __LINE__);
+                for (i = 0; i < num_path_files; i++)
+                {
+                    harp_free(path_filename[i]);
+                }
+                harp_free(path_filename);
+                result = -1;
+                break;
+            }
+            filename = new_filename;
+            for (i = 0; i < num_path_files; i++)
+            {
+                filename[num_files + i] = path_filename[i];
+            }
+            num_files += num_path_files;
+            harp_free(path_filename);
+        }
+    }
+
+    /* with a single file there is nothing to distribute; the regular import will read it */
+    if (result == 0 && num_files > 1)
+    {
+        result = scan_files_parallel(num_files, filename, options, catalog_filename, num_workers);
+    }
+
+    for (i = 0; i < num_files; i++)
+    {
+        harp_free(filename[i]);
+    }
+    if (filename != NULL)
+    {
+        free(filename);
+    }
+
+    return result;
+}
+#endif
+
+static int update_catalog(int argc, char *argv[])
+{
+    const char *options = NULL;
+    const char *catalog_filename;
+    harp_dataset *dataset;
+    int num_workers = 1;
+    int print = 0;
+    int i;
+
+    if (argc < 4 || argv[2][0] == '-')
+    {
+        fprintf(stderr, "ERROR: invalid arguments\n");
+        print_help();
+        return -1;
+    }
+    catalog_filename = argv[2];
+
+    for (i = 3; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--options") == 0) && i + 1 < argc && argv[i + 1][0] != '-')
+        {
+            options = argv[i + 1];
+            i++;
+        }
+        else if ((strcmp(argv[i], "-j") == 0 || strcmp(argv[i], "--jobs") == 0) && i + 1 < argc &&
+                 argv[i + 1][0] != '-')
+        {
+            char *endptr;
+
+            num_workers = (int)strtol(argv[i + 1], &endptr, 10);
+            if (*endptr != '\0' || num_workers < 1)
+            {
+                fprintf(stderr, "ERROR: invalid number of jobs '%s'\n", argv[i + 1]);
+                print_help();
+                return -1;
+            }
+            i++;
+        }
+        else if (strcmp(argv[i], "-p") == 0 || strcmp(argv[i], "--print") == 0)
+        {
+            print = 1;
+        }
+        else if (argv[i][0] != '-')
+        {
+            /* assume all arguments from here on are files */
+            break;
+        }
+        else
+        {
+            fprintf(stderr, "ERROR: invalid arguments\n");
+            print_help();
+            return -1;
+        }
+    }
+
+    if (i == argc)
+    {
+        fprintf(stderr, "ERROR: invalid arguments\n");
+        print_help();
+        return -1;
+    }
+
+#ifdef HARPDUMP_WORKER_POOL
+    if (num_workers > 1)
+    {
+        if (update_catalog_parallel(argc - i, &argv[i], options, catalog_filename, num_workers) != 0)
+        {
+            return -1;
+        }
+    }
+#endif
+
+    if (harp_dataset_new(&dataset) != 0)
+    {
+        return -1;
+    }
+
+    /* this reads the metadata of all files that are not yet (or no longer) up-to-date in the catalog */
+    while (i < argc)
+    {
+        if (harp_dataset_import_with_catalog(dataset, argv[i], options, catalog_filename) != 0)
+        {
+            harp_dataset_delete(dataset);
+            return -1;
+        }
+        i++;
+    }
+
+    if (print)
+    {
+        harp_dataset_print(dataset, printf);
+    }
+
+    harp_dataset_delete(dataset);
+    return 0;
+}
+
 static int dump(int argc, char *argv[])
 {
     const char *operations = NULL;
@@ -383,6 +792,24 @@ int main(int argc, char *argv[])
             exit(1);
         }
     }
+    else if (strcmp(argv[1], "--explain") == 0)
+    {
+        if (explain(argc, argv) != 0)
+        {
+            fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
+            harp_done();
+            exit(1);
+        }
+    }
+    else if (strcmp(argv[1], "--catalog") == 0)
+    {
+        if (update_catalog(argc, argv) != 0)
+        {
+            fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
+            harp_done();
+            exit(1);
+        }
+    }
     else if (strcmp(argv[1], "--dataset") == 0)
     {
         if (dump_dataset(argc, argv) != 0)
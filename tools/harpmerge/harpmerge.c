@@ -35,9 +35,20 @@
 
 #include "harp.h"
 
+#include <sys/types.h>
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef HAVE_SYS_WAIT_H
+#include <sys/wait.h>
+#endif
+#if defined(HAVE_FORK) && defined(HAVE_SYS_WAIT_H) && defined(HAVE_UNISTD_H) && !defined(WIN32)
+#define HARPMERGE_WORKER_POOL
+#endif
 
 static int print_warning(const char *message, va_list ap)
 {
@@ -96,7 +107,28 @@ static void print_help()
     printf("                provided as a single expression.\n");
     printf("\n");
     printf("            -l, --list\n");
-    printf("                Print to stdout each filename that is currently being merged.\n");
+    printf("                Print to stdout each filename that will be merged.\n");
+    printf("                Without --stream the full list is printed before the\n");
+    printf("                products are imported.\n");
+    printf("\n");
+    printf("            -j, --jobs <n>\n");
+    printf("                Number of worker processes that import the products in\n");
+    printf("                parallel (only on platforms that support fork()).\n");
+    printf("                Each worker merges a consecutive part of the products\n");
+    printf("                (applying the reduce operations after each append) into a\n");
+    printf("                temporary file next to the output file, after which the\n");
+    printf("                parts are merged. Cannot be combined with --stream or\n");
+    printf("                --trace.\n");
+    printf("                Default is 1.\n");
+    printf("\n");
+    printf("            -s, --stream\n");
+    printf("                Append each product directly to the output file instead of\n");
+    printf("                creating the merged product in memory first.\n");
+    printf("                This keeps memory usage limited to that of a single product.\n");
+    printf("                All products need to have the same variables and the\n");
+    printf("                non-time dimensions of the first product can not be exceeded.\n");
+    printf("                Cannot be combined with reduce or post operations and is\n");
+    printf("                only supported for the netcdf and hdf5 output formats.\n");
     printf("\n");
     printf("            -f, --format <format>\n");
     printf("                Output format:\n");
@@ -111,6 +143,12 @@ static void print_help()
     printf("            --no-history\n");
     printf("                Do not update the global history attribute.\n");
     printf("\n");
+    printf("            --trace <trace file>\n");
+    printf("                Time each ingestion phase and operation, print a summary\n");
+    printf("                to stderr, and write the trace events to <trace file> in\n");
+    printf("                the Chrome trace event format (viewable in chrome://tracing\n");
+    printf("                or https://ui.perfetto.dev).\n");
+    printf("\n");
     printf("        If the merged product is empty, a warning will be printed and the\n");
     printf("        tool will return with exit code 2 (without writing a file).\n");
     printf("\n");
@@ -122,8 +160,235 @@ static void print_help()
     printf("\n");
 }
 
-int merge_dataset(harp_product **merged_product, harp_dataset *dataset, const char *operations, const char *options,
-                  const char *reduce_operations, int verbose)
+/* Add the filenames of the dataset (sorted by source_product value) to the list of files to merge */
+static int add_dataset_files(harp_dataset *dataset, int *num_files, char ***filename)
+{
+    char **new_filename;
+    int i;
+
+    new_filename = (char **)realloc(*filename, (*num_files + dataset->num_products) * sizeof(char *));
+    if (new_filename == NULL && *num_files + dataset->num_products > 0)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       (*num_files + dataset->num_products) * sizeof(char *), __FILE__, __LINE__);
+        return -1;
+    }
+    *filename = new_filename;
+
+    for (i = 0; i < dataset->num_products; i++)
+    {
+        const char *dataset_filename = dataset->metadata[dataset->sorted_index[i]]->filename;
+
+        (*filename)[*num_files] = strdup(dataset_filename);
+        if ((*filename)[*num_files] == NULL)
+        {
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not duplicate string) (%s:%u)", __FILE__,
+                           __LINE__);
+            return -1;
+        }
+        (*num_files)++;
+    }
+
+    return 0;
+}
+
+static void free_files(int num_files, char **filename)
+{
+    int i;
+
+    for (i = 0; i < num_files; i++)
+    {
+        free(filename[i]);
+    }
+    if (filename != NULL)
+    {
+        free(filename);
+    }
+}
+
+#ifdef HARPMERGE_WORKER_POOL
+/* Import and merge the products using a pool of worker processes.
+ * The library is not thread-safe, so the workers are forked processes. Each worker merges a consecutive part of the
+ * file list with harp_import_multiple() (applying the reduce operations after each append) and stores its partially
+ * merged product in a temporary file next to the output file. The parent then merges the parts, in order, into the
+ * final product (again applying the reduce operations after each append). A worker that fails reports its own error,
+ * which does not affect the other workers; the merge as a whole fails if any of the workers failed.
+ */
+static int merge_files_parallel(int num_files, char **filename, int num_workers, const char *operations,
+                                const char *options, const char *reduce_operations, const char *output_filename,
+                                harp_product **merged_product)
+{
+    const char **stored_filename;
+    char **part_filename;
+    int *part_status;
+    pid_t *pid;
+    int num_parts = 0;
+    int num_failed = 0;
+    int result = 0;
+    int k;
+
+    if (num_workers > num_files)
+    {
+        num_workers = num_files;
+    }
+
+    part_filename = (char **)malloc(num_workers * sizeof(char *));
+    if (part_filename == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       num_workers * sizeof(char *), __FILE__, __LINE__);
+        return -1;
+    }
+    part_status = (int *)malloc(num_workers * sizeof(int));
+    if (part_status == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       num_workers * sizeof(int), __FILE__, __LINE__);
+        free(part_filename);
+        return -1;
+    }
+    pid = (pid_t *)malloc(num_workers * sizeof(pid_t));
+    if (pid == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       num_workers * sizeof(pid_t), __FILE__, __LINE__);
+        free(part_status);
+        free(part_filename);
+        return -1;
+    }
+    stored_filename = (const char **)malloc(num_workers * sizeof(const char *));
+    if (stored_filename == NULL)
+    {
+        harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                       num_workers * sizeof(const char *), __FILE__, __LINE__);
+        free(pid);
+        free(part_status);
+        free(part_filename);
+        return -1;
+    }
+    for (k = 0; k < num_workers; k++)
+    {
+        part_filename[k] = NULL;
+        /* 1 = failed */
+        part_status[k] = 1;
+        pid[k] = -1;
+    }
+
+    /* make sure buffered output does not get duplicated by the workers */
+    fflush(NULL);
+
+    for (k = 0; k < num_workers; k++)
+    {
+        int first = (int)(((long)k * num_files) / num_workers);
+        int last = (int)(((long)(k + 1) * num_files) / num_workers);
+
+        part_filename[k] = malloc(strlen(output_filename) + 32);
+        if (part_filename[k] == NULL)
+        {
+            harp_set_error(HARP_ERROR_OUT_OF_MEMORY, "out of memory (could not allocate %lu bytes) (%s:%u)",
+                           strlen(output_filename) + 32, __FILE__, __LINE__);
+            result = -1;
+            break;
+        }
+        sprintf(part_filename[k], "%s.%ld.part%d", output_filename, (long)getpid(), k);
+
+        pid[k] = fork();
+        if (pid[k] < 0)
+        {
+            harp_set_error(HARP_ERROR_IMPORT, "could not create worker process (%s)", strerror(errno));
+            result = -1;
+            break;
+        }
+        if (pid[k] == 0)
+        {
+            harp_product *product;
+
+            /* worker process; exit code 0 = part stored, 2 = part is empty, 1 = error */
+            if (harp_import_multiple(last - first, (const char **)&filename[first], operations, options,
+                                     reduce_operations, &product) != 0)
+            {
+                fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
+                fflush(stderr);
+                _exit(1);
+            }
+            if (harp_product_is_empty(product))
+            {
+                _exit(2);
+            }
+            if (harp_export(part_filename[k], "netcdf", product) != 0)
+            {
+                fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
+                fflush(stderr);
+                _exit(1);
+            }
+            _exit(0);
+        }
+    }
+
+    /* wait for all workers that were started */
+    for (k = 0; k < num_workers; k++)
+    {
+        if (pid[k] > 0)
+        {
+            int status;
+
+            while (waitpid(pid[k], &status, 0) < 0 && errno == EINTR)
+            {
+            }
+            if (WIFEXITED(status))
+            {
+                part_status[k] = WEXITSTATUS(status);
+            }
+            if (part_status[k] == 1)
+            {
+                num_failed++;
+            }
+        }
+    }
+
+    if (result == 0 && num_failed > 0)
+    {
+        harp_set_error(HARP_ERROR_IMPORT, "import failed for %d of %d worker processes", num_failed, num_workers);
+        result = -1;
+    }
+
+    if (result == 0)
+    {
+        /* merge the non-empty parts in order */
+        for (k = 0; k < num_workers; k++)
+        {
+            if (part_status[k] == 0)
+            {
+                stored_filename[num_parts] = part_filename[k];
+                num_parts++;
+            }
+        }
+        result = harp_import_multiple(num_parts, stored_filename, NULL, NULL, reduce_operations, merged_product);
+    }
+
+    /* remove all parts, also those of workers that failed or were killed halfway an export */
+    for (k = 0; k < num_workers; k++)
+    {
+        if (part_filename[k] != NULL)
+        {
+            if (pid[k] > 0)
+            {
+                remove(part_filename[k]);
+            }
+            free(part_filename[k]);
+        }
+    }
+    free(stored_filename);
+    free(pid);
+    free(part_status);
+    free(part_filename);
+
+    return result;
+}
+#endif
+
+int stream_dataset(harp_export_writer *writer, int *num_appended, harp_dataset *dataset, const char *operations,
+                   const char *options, int update_history, int argc, char *argv[], int verbose)
 {
     int i;
 
@@ -145,38 +410,80 @@ int merge_dataset(harp_product **merged_product, harp_dataset *dataset, const ch
         }
         if (!harp_product_is_empty(product))
         {
-            if (*merged_product == NULL)
+            if (*num_appended == 0 && update_history)
             {
-                *merged_product = product;
-                /* if this remains the only product then make sure it still looks like it was the result of a merge */
-                if (harp_product_append(*merged_product, NULL) != 0)
-                {
-                    return -1;
-                }
-            }
-            else
-            {
-                if (harp_product_append(*merged_product, product) != 0)
+                /* the history of the first product ends up in the merged product */
+                if (harp_product_update_history(product, "harpmerge", argc, argv) != 0)
                 {
                     harp_product_delete(product);
                     return -1;
                 }
-                harp_product_delete(product);
             }
-            if (reduce_operations != NULL)
+            if (harp_export_writer_append(writer, product) != 0)
             {
-                /* perform reduction operations on the partially merged product after each append */
-                if (harp_product_execute_operations(*merged_product, reduce_operations) != 0)
-                {
-                    return -1;
-                }
+                harp_product_delete(product);
+                return -1;
             }
+            (*num_appended)++;
+        }
+        harp_product_delete(product);
+    }
+
+    return 0;
+}
+
+static int merge_stream(int argc, char *argv[], int i, const char *operations, const char *options,
+                        const char *output_filename, const char *output_format, int update_history, int verbose)
+{
+    harp_export_writer *writer;
+    int num_appended = 0;
+
+    if (harp_export_writer_open(output_filename, output_format, &writer) != 0)
+    {
+        return -1;
+    }
+
+    while (i < argc - 1)
+    {
+        harp_dataset *dataset;
+
+        if (harp_dataset_new(&dataset) != 0)
+        {
+            harp_export_writer_close(writer);
+            return -1;
+        }
+        if (harp_dataset_import(dataset, argv[i], options) != 0)
+        {
+            harp_dataset_delete(dataset);
+            harp_export_writer_close(writer);
+            return -1;
+        }
+        if (stream_dataset(writer, &num_appended, dataset, operations, options, update_history, argc, argv, verbose)
+            != 0)
+        {
+            harp_dataset_delete(dataset);
+            harp_export_writer_close(writer);
+            return -1;
         }
+        harp_dataset_delete(dataset);
+        i++;
+    }
+
+    if (harp_export_writer_close(writer) != 0)
+    {
+        return -1;
+    }
+    if (num_appended == 0)
+    {
+        return -2;
     }
 
     return 0;
 }
 
+/* path of the Chrome trace file (if tracing was requested with --trace) */
+static const char *trace_filename = NULL;
+
 static int merge(int argc, char *argv[])
 {
     harp_product *merged_product = NULL;
@@ -186,8 +493,13 @@ static int merge(int argc, char *argv[])
     const char *options = NULL;
     const char *output_filename = NULL;
     const char *output_format = "netcdf";
+    char **filename = NULL;
+    int num_files = 0;
+    int num_workers = 1;
     int update_history = 1;
     int verbose = 0;
+    int stream = 0;
+    int result;
     int i;
 
     /* parse arguments after list/'export format' */
@@ -227,6 +539,24 @@ static int merge(int argc, char *argv[])
         {
             verbose = 1;
         }
+        else if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--stream") == 0)
+        {
+            stream = 1;
+        }
+        else if ((strcmp(argv[i], "-j") == 0 || strcmp(argv[i], "--jobs") == 0) && i + 1 < argc &&
+                 argv[i + 1][0] != '-')
+        {
+            char *endptr;
+
+            num_workers = (int)strtol(argv[i + 1], &endptr, 10);
+            if (*endptr != '\0' || num_workers < 1)
+            {
+                fprintf(stderr, "ERROR: invalid number of jobs '%s'\n", argv[i + 1]);
+                print_help();
+                return -1;
+            }
+            i++;
+        }
         else if (strcmp(argv[i], "--hdf5-compression") == 0 && i + 1 < argc && argv[i + 1][0] != '-')
         {
             if (harp_set_option_hdf5_compression(atoi(argv[i + 1])) != 0)
@@ -241,6 +571,12 @@ static int merge(int argc, char *argv[])
         {
             update_history = 0;
         }
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc && argv[i + 1][0] != '-')
+        {
+            trace_filename = argv[i + 1];
+            harp_set_option_trace(1);
+            i++;
+        }
         else if (argv[i][0] != '-')
         {
             /* Assume the next argument is the dataset directory path. */
@@ -262,33 +598,84 @@ static int merge(int argc, char *argv[])
     }
     output_filename = argv[argc - 1];
 
+    if (trace_filename != NULL && num_workers > 1)
+    {
+        /* the trace events of the worker processes would get lost */
+        fprintf(stderr, "ERROR: tracing cannot be combined with multiple jobs\n");
+        print_help();
+        return -1;
+    }
+
+    if (stream)
+    {
+        if (reduce_operations != NULL || post_operations != NULL)
+        {
+            fprintf(stderr, "ERROR: streaming mode cannot be combined with reduce or post operations\n");
+            print_help();
+            return -1;
+        }
+        if (num_workers > 1)
+        {
+            fprintf(stderr, "ERROR: streaming mode cannot be combined with multiple jobs\n");
+            print_help();
+            return -1;
+        }
+        return merge_stream(argc, argv, i, operations, options, output_filename, output_format, update_history,
+                            verbose);
+    }
+
     while (i < argc - 1)
     {
         harp_dataset *dataset;
 
         if (harp_dataset_new(&dataset) != 0)
         {
+            free_files(num_files, filename);
             return -1;
         }
         if (harp_dataset_import(dataset, argv[i], options) != 0)
         {
             harp_dataset_delete(dataset);
+            free_files(num_files, filename);
             return -1;
         }
-        if (merge_dataset(&merged_product, dataset, operations, options, reduce_operations, verbose) != 0)
+        if (add_dataset_files(dataset, &num_files, &filename) != 0)
         {
-            harp_product_delete(merged_product);
             harp_dataset_delete(dataset);
+            free_files(num_files, filename);
             return -1;
         }
         harp_dataset_delete(dataset);
         i++;
     }
 
-    if (merged_product == NULL)
+    if (verbose)
     {
-        return -2;
+        for (i = 0; i < num_files; i++)
+        {
+            printf("%s\n", filename[i]);
+        }
+    }
+
+    /* the operations, options, and reduce operations are only parsed once for all files */
+#ifdef HARPMERGE_WORKER_POOL
+    if (num_workers > 1 && num_files > 1)
+    {
+        result = merge_files_parallel(num_files, filename, num_workers, operations, options, reduce_operations,
+                                      output_filename, &merged_product);
     }
+    else
+#endif
+    {
+        result = harp_import_multiple(num_files, (const char **)filename, operations, options, reduce_operations,
+                                      &merged_product);
+    }
+    free_files(num_files, filename);
+    if (result != 0)
+    {
+        return -1;
+    }
+
     if (harp_product_is_empty(merged_product))
     {
         harp_product_delete(merged_product);
@@ -373,6 +760,18 @@ int main(int argc, char *argv[])
 
     result = merge(argc, argv);
 
+    if (trace_filename != NULL)
+    {
+        harp_trace_print_summary(NULL);
+        if (harp_trace_write_chrome_trace(trace_filename) != 0)
+        {
+            fprintf(stderr, "ERROR: %s\n", harp_errno_to_string(harp_errno));
+            harp_done();
+            exit(1);
+        }
+        harp_trace_clear();
+    }
+
     if (result == -1)
     {
         if (harp_errno != HARP_SUCCESS)
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2015-2020 S[&]T, The Netherlands.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Compiled-in unit-system.
+ *
+ * The table below is generated at build-time by udunits2-compile, which reads
+ * the bundled udunits2.xml with "ut_compile_xml()" and records every
+ * modification that the XML reader makes to the unit-system (including all
+ * Latin-1/UTF-8 and non-breaking space variants of names and symbols).
+ * Replaying these operations results in the same unit-system as
+ * "ut_read_xml()" without the cost of parsing the XML files.
+ */
+
+/*LINTLIBRARY*/
+
+#include <config.h>
+
+#include <stddef.h>
+
+#include "udunits2.h"
+
+typedef enum {
+    UT_OP_BASE,
+    UT_OP_DIMENSIONLESS,
+    UT_OP_DEF,
+    UT_OP_NAME_TO_UNIT,
+    UT_OP_UNIT_TO_NAME,
+    UT_OP_SYMBOL_TO_UNIT,
+    UT_OP_UNIT_TO_SYMBOL,
+    UT_OP_SECOND,
+    UT_OP_NAME_PREFIX,
+    UT_OP_SYMBOL_PREFIX
+} BuiltinOpType;
+
+typedef struct {
+    BuiltinOpType       type;
+    const char*         id;
+    ut_encoding         encoding;
+    double              value;
+} BuiltinOp;
+
+static const BuiltinOp  builtinOps[] = {
+#include "udunits2-builtin.inc"
+};
+
+#define NUM_BUILTIN_OPS (sizeof(builtinOps) / sizeof(builtinOps[0]))
+
+
+/*
+ * Returns the unit-system that was compiled into the library from the
+ * bundled XML unit database.
+ *
+ * Returns:
+ *	NULL	Failure.  "ut_get_status()" will be
+ *		    UT_OS		Operating-system error.  See "errno".
+ *		    UT_PARSE		Couldn't replay the compiled unit-system.
+ *	else	Pointer to the compiled-in unit-system.
+ */
+ut_system*
+ut_read_builtin(void)
+{
+    ut_system*  system;
+    ut_unit*    unit = NULL;
+    ut_status   status = UT_SUCCESS;
+    size_t      i;
+
+    ut_set_status(UT_SUCCESS);
+
+    system = ut_new_system();
+
+    if (system == NULL) {
+        ut_handle_error_message("Couldn't create new unit-system");
+        return NULL;
+    }
+
+    for (i = 0; i < NUM_BUILTIN_OPS && status == UT_SUCCESS; i++) {
+        const BuiltinOp*        op = &builtinOps[i];
+
+        switch (op->type) {
+        case UT_OP_BASE:
+        case UT_OP_DIMENSIONLESS:
+        case UT_OP_DEF:
+            ut_free(unit);              /* NULL safe */
+
+            if (op->type == UT_OP_BASE) {
+                unit = ut_new_base_unit(system);
+            }
+            else if (op->type == UT_OP_DIMENSIONLESS) {
+                unit = ut_new_dimensionless_unit(system);
+            }
+            else {
+                unit = ut_parse(system, op->id, op->encoding);
+            }
+
+            if (unit == NULL)
+                status = ut_get_status() == UT_SUCCESS ? UT_PARSE :
+                    ut_get_status();
+            break;
+        case UT_OP_NAME_TO_UNIT:
+            status = ut_map_name_to_unit(op->id, op->encoding, unit);
+            break;
+        case UT_OP_UNIT_TO_NAME:
+            status = ut_map_unit_to_name(unit, op->id, op->encoding);
+            break;
+        case UT_OP_SYMBOL_TO_UNIT:
+            status = ut_map_symbol_to_unit(op->id, op->encoding, unit);
+            break;
+        case UT_OP_UNIT_TO_SYMBOL:
+            status = ut_map_unit_to_symbol(unit, op->id, op->encoding);
+            break;
+        case UT_OP_SECOND:
+            status = ut_set_second(unit);
+            break;
+        case UT_OP_NAME_PREFIX:
+            status = ut_add_name_prefix(system, op->id, op->value);
+            break;
+        case UT_OP_SYMBOL_PREFIX:
+            status = ut_add_symbol_prefix(system, op->id, op->value);
+            break;
+        }
+    }
+
+    ut_free(unit);                      /* NULL safe */
+
+    if (status != UT_SUCCESS) {
+        ut_free_system(system);
+        ut_set_status(status);
+        ut_handle_error_message("Couldn't replay operation %lu of compiled-in "
+            "unit-system", (unsigned long)i);
+
+        return NULL;
+    }
+
+    ut_set_status(UT_SUCCESS);
+
+    return system;
+}
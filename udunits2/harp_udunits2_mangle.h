@@ -46,6 +46,7 @@
 #define ut_are_convertible harp_ut_are_convertible
 #define ut_clone harp_ut_clone
 #define ut_compare harp_ut_compare
+#define ut_compile_xml harp_ut_compile_xml
 #define ut_decode_time harp_ut_decode_time
 #define ut_delete_buffer harp_ut_delete_buffer
 #define ut_divide harp_ut_divide
@@ -83,6 +84,7 @@
 #define ut_offset_by_time harp_ut_offset_by_time
 #define ut_parse harp_ut_parse
 #define ut_raise harp_ut_raise
+#define ut_read_builtin harp_ut_read_builtin
 #define ut_read_xml harp_ut_read_xml
 #define ut_root harp_ut_root
 #define ut_same_system harp_ut_same_system
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2015-2020 S[&]T, The Netherlands.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Build-time tool that converts the bundled udunits2 XML database into the
+ * operation table of the compiled-in unit-system (see builtin.c).
+ *
+ * Usage: udunits2-compile <udunits2.xml> <output file>
+ */
+
+#include <stdio.h>
+
+#include "udunits2.h"
+
+int main(int argc, char *argv[])
+{
+    FILE *output;
+
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: %s <udunits2.xml> <output file>\n", argv[0]);
+        return 1;
+    }
+
+    output = fopen(argv[2], "w");
+    if (output == NULL)
+    {
+        fprintf(stderr, "ERROR: could not create %s\n", argv[2]);
+        return 1;
+    }
+
+    fprintf(output, "/* generated by udunits2-compile -- do not edit */\n");
+    if (ut_compile_xml(argv[1], output) != UT_SUCCESS)
+    {
+        fprintf(stderr, "ERROR: could not compile unit database %s\n", argv[1]);
+        fclose(output);
+        remove(argv[2]);
+        return 1;
+    }
+    if (fclose(output) != 0)
+    {
+        fprintf(stderr, "ERROR: could not write %s\n", argv[2]);
+        remove(argv[2]);
+        return 1;
+    }
+
+    return 0;
+}
@@ -10,6 +10,7 @@
 
 #include <stdarg.h>
 #include <stddef.h>
+#include <stdio.h>
 
 #include "harp_udunits2_mangle.h"
 
@@ -267,6 +268,41 @@ ut_read_xml(
     const char*	path);
 
 
+/*
+ * Writes the modifications that "ut_read_xml()" makes to a new unit-system as
+ * C array initializers.  This is used at build-time to create the compiled-in
+ * unit-system of "ut_read_builtin()".
+ *
+ * Arguments:
+ *	path	The pathname of the XML file or NULL.  See "ut_read_xml()".
+ *	output	The stream to which the initializers are written.
+ * Returns:
+ *	UT_SUCCESS	Success.
+ *	UT_OS		Operating-system error while writing.  See "errno".
+ *	else		The status of "ut_read_xml()".
+ */
+EXTERNL ut_status
+ut_compile_xml(
+    const char*	path,
+    FILE*	output);
+
+
+/*
+ * Returns the unit-system that was compiled into the library from the
+ * bundled XML unit database.  The result is identical to that of
+ * "ut_read_xml()" for the bundled database, but no XML is parsed and no
+ * files are accessed.
+ *
+ * Returns:
+ *	NULL	Failure.  "ut_get_status()" will be
+ *		    UT_OS		Operating-system error.  See "errno".
+ *		    UT_PARSE		Couldn't replay the compiled unit-system.
+ *	else	Pointer to the compiled-in unit-system.
+ */
+EXTERNL ut_system*
+ut_read_builtin(void);
+
+
 /*
  * Returns a new unit-system.  On success, the unit-system will only contain
  * the dimensionless unit one.  See "ut_get_dimensionless_unit_one()".
@@ -98,6 +98,72 @@ static File*            currFile = NULL;
 static ut_system*	unitSystem = NULL;
 static char*            text = NULL;
 static size_t           nbytes = 0;
+static FILE*            compileFile = NULL;
+
+
+/*
+ * Writes a string as a C string literal to the compilation output.
+ *
+ * Arguments:
+ *      string          Pointer to the string.
+ */
+static void
+emitString(
+    const char* const   string)
+{
+    const unsigned char*        cp;
+
+    (void)fputc('"', compileFile);
+
+    for (cp = (const unsigned char*)string; *cp; cp++) {
+        if (*cp < 0x20 || *cp >= 0x7f || *cp == '"' || *cp == '\\' ||
+                *cp == '?') {
+            (void)fprintf(compileFile, "\\%03o", *cp);
+        }
+        else {
+            (void)fputc(*cp, compileFile);
+        }
+    }
+
+    (void)fputc('"', compileFile);
+}
+
+
+/*
+ * Records a modification of the unit-system in the compilation output.  Does
+ * nothing unless called from within "ut_compile_xml()".  The operation names
+ * must match the "BuiltinOpType" enumeration of "builtin.c".
+ *
+ * Arguments:
+ *      op              Name of the operation.
+ *      id              Pointer to the identifier, definition, or prefix
+ *                      of the operation or NULL.
+ *      encoding        The encoding of "id".
+ *      value           The value of a prefix.
+ */
+static void
+emitOp(
+    const char* const   op,
+    const char* const   id,
+    const ut_encoding   encoding,
+    const double        value)
+{
+    if (compileFile == NULL)
+        return;
+
+    (void)fprintf(compileFile, "    {%s, ", op);
+
+    if (id == NULL) {
+        (void)fputs("NULL", compileFile);
+    }
+    else {
+        emitString(id);
+    }
+
+    (void)fprintf(compileFile, ", %s, %.17g},\n",
+        encoding == UT_LATIN1 ? "UT_LATIN1" :
+        encoding == UT_UTF8 ? "UT_UTF8" : "UT_ASCII", value);
+}
 
 
 /*
@@ -555,6 +621,8 @@ mapUnitToId(
         ut_handle_error_message("Couldn't map unit to %s \"%s\"", desc, id);
     }
     else {
+        emitOp(isName ? "UT_OP_UNIT_TO_NAME" : "UT_OP_UNIT_TO_SYMBOL", id,
+            encoding, 0);
         success = 1;
     }
 
@@ -713,6 +781,9 @@ mapIdToUnit(
 	    XML_StopParser(currFile->parser, 0);
 	}
 	else {
+            emitOp(isName ? "UT_OP_NAME_TO_UNIT" : "UT_OP_SYMBOL_TO_UNIT", id,
+                encoding, 0);
+
 	    if (prev != NULL) {
 		char	buf[128];
 		int	nchar = ut_format(prev, buf, sizeof(buf),
@@ -1212,6 +1283,7 @@ endBase(
 	XML_StopParser(currFile->parser, 0);
     }
     else {
+        emitOp("UT_OP_BASE", NULL, UT_ASCII, 0);
 	currFile->isBase = 1;
     }
 }
@@ -1270,6 +1342,7 @@ endDimensionless(
 	XML_StopParser(currFile->parser, 0);
     }
     else {
+        emitOp("UT_OP_DIMENSIONLESS", NULL, UT_ASCII, 0);
 	currFile->isDimensionless = 1;
     }
 }
@@ -1336,6 +1409,9 @@ endDef(
                 "Couldn't parse unit specification \"%s\"", text);
 	    XML_StopParser(currFile->parser, 0);
 	}
+        else {
+            emitOp("UT_OP_DEF", text, currFile->textEncoding, 0);
+        }
     }
 }
 
@@ -1408,6 +1484,7 @@ endName(
 		XML_StopParser(currFile->parser, 0);
 	    }
 	    else {
+                emitOp("UT_OP_NAME_PREFIX", text, UT_ASCII, currFile->value);
 		currFile->prefixAdded = 1;
 	    }
 	}
@@ -1458,6 +1535,9 @@ endName(
                             "Couldn't set \"second\" unit in unit-system");
                         XML_StopParser(currFile->parser, 0);
                     }
+                    else {
+                        emitOp("UT_OP_SECOND", NULL, UT_ASCII, 0);
+                    }
                 }                       /* unit was 'second' unit */
             }                           /* unit mapped to singular name */
         }                               /* singular name specified */
@@ -1667,6 +1747,7 @@ endSymbol(
             XML_StopParser(currFile->parser, 0);
         }
         else {
+            emitOp("UT_OP_SYMBOL_PREFIX", text, UT_ASCII, currFile->value);
             currFile->prefixAdded = 1;
         }
     }
@@ -2215,3 +2296,43 @@ ut_read_xml(
 
     return unitSystem;
 }
+
+
+/**
+ * Writes the modifications that "ut_read_xml()" makes to a new unit-system as
+ * C array initializers of the form {operation, identifier, encoding, value}.
+ * The output is used to build the compiled-in unit-system of
+ * "ut_read_builtin()", which can be initialized without parsing XML.
+ *
+ * @param path      The pathname of the XML file or NULL.  See "ut_read_xml()".
+ * @param output    The stream to which the initializers are written.
+ * @retval UT_SUCCESS   Success.
+ * @retval UT_OS        Operating-system error while writing.  See "errno".
+ * @return          Otherwise, the status of "ut_read_xml()".
+ */
+ut_status
+ut_compile_xml(
+    const char*	path,
+    FILE*       output)
+{
+    ut_system*  system;
+
+    compileFile = output;
+    system = ut_read_xml(path);
+    compileFile = NULL;
+
+    if (system == NULL)
+        return ut_get_status();
+
+    ut_free_system(system);
+
+    if (ferror(output)) {
+        ut_set_status(UT_OS);
+        ut_handle_error_message("Couldn't write compiled unit-system: %s",
+            strerror(errno));
+
+        return UT_OS;
+    }
+
+    return UT_SUCCESS;
+}